@@ -0,0 +1,104 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <cstdlib>
+
+
+namespace
+{
+    // Drawable which changes the view of its target and clears it before drawing,
+    // like a widget rendering itself into its own area of a window
+    class Panel : public sf::Drawable
+    {
+    public:
+
+        explicit Panel(const sf::FloatRect& area) :
+        m_shape(sf::Vector2f(area.width, area.height))
+        {
+            m_shape.setPosition(area.left, area.top);
+            m_shape.setFillColor(sf::Color::Green);
+        }
+
+    private:
+
+        virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const
+        {
+            sf::View previousView = target.getView();
+
+            target.setView(sf::View(sf::FloatRect(0.f, 0.f, 64.f, 64.f)));
+            target.clear(sf::Color::Blue);
+
+            target.pushGLStates();
+            target.popGLStates();
+
+            target.draw(m_shape, states);
+            target.setView(previousView);
+        }
+
+        sf::RectangleShape m_shape;
+    };
+
+    struct Recording
+    {
+        sf::DrawList*       list;
+        const sf::Drawable* first;
+        const sf::Drawable* second;
+    };
+
+    // Record the drawables on a thread which has no OpenGL context
+    void record(Recording* recording)
+    {
+        recording->list->clear();
+        recording->list->draw(*recording->first);
+        recording->list->draw(*recording->second);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::RenderTexture target;
+    if (!target.create(64, 64))
+        return EXIT_FAILURE;
+
+    sf::RectangleShape square(sf::Vector2f(16.f, 16.f));
+    square.setFillColor(sf::Color::Red);
+    Panel panel(sf::FloatRect(32.f, 32.f, 16.f, 16.f));
+
+    sf::DrawList list;
+    Recording recording = {&list, &square, &panel};
+
+    sf::Thread thread(&record, &recording);
+    thread.launch();
+    thread.wait();
+
+    std::cout << "Recorded " << list.getDrawCount() << " draw calls (expected 2)" << std::endl;
+
+    // Calls to setView and clear during the recording must be ignored:
+    // both squares are replayed, over the content of the target
+    target.clear(sf::Color::Black);
+    target.draw(list);
+    target.display();
+
+    sf::Image image = target.getTexture().copyToImage();
+    bool squareDrawn = (image.getPixel(8, 8) == sf::Color::Red);
+    bool panelDrawn = (image.getPixel(40, 40) == sf::Color::Green);
+    bool targetKept = (image.getPixel(60, 4) == sf::Color::Black);
+
+    std::cout << "Square drawn: " << (squareDrawn ? "yes" : "no") << ", "
+              << "panel drawn: " << (panelDrawn ? "yes" : "no") << ", "
+              << "target left uncleared: " << (targetKept ? "yes" : "no") << std::endl;
+
+    bool success = (list.getDrawCount() == 2) && squareDrawn && panelDrawn && targetKept;
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
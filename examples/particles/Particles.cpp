@@ -0,0 +1,87 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <SFML/OpenGL.hpp>
+#include <iostream>
+#include <cstdlib>
+
+
+namespace
+{
+    const std::size_t  particleCount = 1000000;
+    const int          frameCount    = 60;
+    const unsigned int textureSize   = 1024;
+
+    float random(float min, float max)
+    {
+        return min + (max - min) * std::rand() / static_cast<float>(RAND_MAX);
+    }
+
+    // Fill a particle system with a million long-lived particles
+    void emitParticles(sf::ParticleSystem& particles)
+    {
+        std::srand(1);
+
+        for (std::size_t i = 0; i < particleCount; ++i)
+        {
+            sf::Vector2f position(random(0.f, textureSize), random(0.f, textureSize));
+            sf::Vector2f velocity(random(-50.f, 50.f), random(-50.f, 50.f));
+            sf::Color    color(static_cast<sf::Uint8>(std::rand() % 256), 128, 255);
+
+            particles.emit(position, velocity, color, sf::Color::Transparent, sf::seconds(random(100.f, 110.f)));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Render the particles off-screen, so that the results don't depend on the vertical sync
+    sf::RenderTexture target;
+    if (!target.create(textureSize, textureSize))
+        return EXIT_FAILURE;
+
+    std::cout << "Updating and drawing " << particleCount << " particles, average of " << frameCount << " frames" << std::endl;
+
+    for (unsigned int threadCount = 1; threadCount <= 8; threadCount *= 2)
+    {
+        sf::ParticleSystem particles(particleCount);
+        particles.setThreadCount(threadCount);
+        particles.setAcceleration(sf::Vector2f(0.f, 50.f));
+        particles.setParticleSize(sf::Vector2f(2.f, 2.f));
+
+        sf::Clock clock;
+        emitParticles(particles);
+        sf::Time emitTime = clock.getElapsedTime();
+
+        sf::Time updateTime;
+        sf::Time drawTime;
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+            clock.restart();
+            particles.update(sf::seconds(1.f / 60.f));
+            updateTime += clock.restart();
+
+            // Wait for the GPU to finish drawing, so that the upload and the drawing are measured too
+            target.clear();
+            target.draw(particles);
+            target.display();
+            glFinish();
+            drawTime += clock.restart();
+        }
+
+        std::cout << threadCount << " thread(s): emit " << emitTime.asMilliseconds() << " ms, "
+                  << "update " << updateTime.asMicroseconds() / frameCount << " us, "
+                  << "upload and draw " << drawTime.asMicroseconds() / frameCount << " us" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+
+namespace
+{
+    const std::size_t nodeCount  = 10000;
+    const int         frameCount = 200;
+
+    // Scene node which only counts how many times it is drawn,
+    // so that the traversal is measured rather than the rendering
+    class CountingNode : public sf::SceneNode
+    {
+    public:
+
+        CountingNode() : m_drawCount(0) {}
+
+        unsigned int getDrawCount() const
+        {
+            return m_drawCount;
+        }
+
+    private:
+
+        virtual void drawCurrent(sf::RenderTarget&, const sf::RenderStates&) const
+        {
+            ++m_drawCount;
+        }
+
+        mutable unsigned int m_drawCount;
+    };
+
+    // The same hierarchy built by hand, combining the transforms in every draw call
+    class ManualNode : public sf::Drawable, public sf::Transformable
+    {
+    public:
+
+        ManualNode() : m_drawCount(0) {}
+
+        void attachChild(ManualNode& child)
+        {
+            m_children.push_back(&child);
+        }
+
+        unsigned int getDrawCount() const
+        {
+            return m_drawCount;
+        }
+
+    private:
+
+        virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const
+        {
+            ++m_drawCount;
+
+            states.transform *= getTransform();
+            for (std::size_t i = 0; i < m_children.size(); ++i)
+                target.draw(*m_children[i], states);
+        }
+
+        std::vector<ManualNode*> m_children;
+        mutable unsigned int     m_drawCount;
+    };
+
+    // Link the nodes either as a single chain or as children of the first node
+    template <typename T>
+    void buildTree(T* nodes, bool deep)
+    {
+        for (std::size_t i = 1; i < nodeCount; ++i)
+        {
+            nodes[deep ? i - 1 : 0].attachChild(nodes[i]);
+            nodes[i].setPosition(1.f, 1.f);
+            nodes[i].setRotation(1.f);
+        }
+    }
+
+    // Draw the tree for a number of frames, rotating a node in the middle of it
+    // every frame if requested, and return the average time of a frame
+    template <typename T>
+    sf::Int64 drawTree(sf::RenderTarget& target, T* nodes, bool animate)
+    {
+        sf::Clock clock;
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+            if (animate)
+                nodes[nodeCount / 2].rotate(1.f);
+
+            target.draw(nodes[0]);
+        }
+
+        return clock.getElapsedTime().asMicroseconds() / frameCount;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::RenderTexture target;
+    if (!target.create(64, 64))
+        return EXIT_FAILURE;
+
+    std::cout << "Traversing " << nodeCount << " nodes, average of " << frameCount << " frames" << std::endl;
+
+    for (int shape = 0; shape < 2; ++shape)
+    {
+        bool deep = (shape == 0);
+
+        // Scene nodes are not copyable, so they can't be stored in a vector
+        CountingNode* sceneNodes  = new CountingNode[nodeCount];
+        ManualNode*   manualNodes = new ManualNode[nodeCount];
+        buildTree(sceneNodes, deep);
+        buildTree(manualNodes, deep);
+
+        sf::Int64 sceneTime  = drawTree(target, sceneNodes, true);
+        sf::Int64 staticTime = drawTree(target, sceneNodes, false);
+        sf::Int64 manualTime = drawTree(target, manualNodes, true);
+
+        // Every node must have been visited once per frame
+        bool complete = (sceneNodes[nodeCount - 1].getDrawCount() == 2 * frameCount) &&
+                        (manualNodes[nodeCount - 1].getDrawCount() == frameCount);
+
+        delete[] sceneNodes;
+        delete[] manualNodes;
+
+        std::cout << (deep ? "Deep chain" : "Wide tree") << ": "
+                  << "scene nodes " << sceneTime << " us, "
+                  << "static scene nodes " << staticTime << " us, "
+                  << "manual transforms " << manualTime << " us"
+                  << (complete ? "" : " (incomplete traversal!)") << std::endl;
+
+        if (!complete)
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,170 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <SFML/OpenGL.hpp>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    const std::size_t  outlinePointCount = 10000;
+    const std::size_t  holePointCount    = 1000;
+    const unsigned int textureSize       = 1024;
+    const float        pi                = 3.141592654f;
+    const sf::Vector2f center(textureSize / 2.f, textureSize / 2.f);
+
+    float random(float min, float max)
+    {
+        return min + (max - min) * std::rand() / static_cast<float>(RAND_MAX);
+    }
+
+    // Build a star-shaped contour around the center of the texture, with a random
+    // radius at every point: deeply concave, but never self-intersecting
+    std::vector<sf::Vector2f> makeStar(std::size_t pointCount, float minRadius, float maxRadius)
+    {
+        std::vector<sf::Vector2f> points(pointCount);
+        for (std::size_t i = 0; i < pointCount; ++i)
+        {
+            float angle = 2.f * pi * i / pointCount;
+            float radius = random(minRadius, maxRadius);
+            points[i] = center + sf::Vector2f(radius * std::cos(angle), radius * std::sin(angle));
+        }
+
+        return points;
+    }
+
+    // Find the edge of a star contour which lies in the direction of a point, seen from the center
+    std::size_t getStarSector(const std::vector<sf::Vector2f>& star, const sf::Vector2f& point)
+    {
+        sf::Vector2f direction = point - center;
+        float angle = std::atan2(direction.y, direction.x);
+        if (angle < 0.f)
+            angle += 2.f * pi;
+
+        return static_cast<std::size_t>(angle / (2.f * pi) * star.size()) % star.size();
+    }
+
+    // Tell whether a point is inside a star contour: the center and the point must
+    // be on the same side of the edge which crosses the ray between them
+    bool isInsideStar(const std::vector<sf::Vector2f>& star, const sf::Vector2f& point)
+    {
+        std::size_t index = getStarSector(star, point);
+        sf::Vector2f start = star[index];
+        sf::Vector2f edge = star[(index + 1) % star.size()] - start;
+
+        float pointSide = edge.x * (point.y - start.y) - edge.y * (point.x - start.x);
+        float centerSide = edge.x * (center.y - start.y) - edge.y * (center.x - start.x);
+
+        return (pointSide > 0.f) == (centerSide > 0.f);
+    }
+
+    // Compute the distance from a point to the closest edge of a star contour; only the
+    // edges of the neighboring sectors are considered, the others are much farther away
+    float getDistanceToStar(const std::vector<sf::Vector2f>& star, const sf::Vector2f& point)
+    {
+        std::size_t index = getStarSector(star, point);
+        float distance = static_cast<float>(textureSize);
+
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            sf::Vector2f start = star[(index + star.size() + i - 2) % star.size()];
+            sf::Vector2f edge = star[(index + star.size() + i - 1) % star.size()] - start;
+            sf::Vector2f toPoint = point - start;
+
+            float length = edge.x * edge.x + edge.y * edge.y;
+            float t = (length > 0.f) ? (toPoint.x * edge.x + toPoint.y * edge.y) / length : 0.f;
+            t = std::min(std::max(t, 0.f), 1.f);
+
+            sf::Vector2f offset = toPoint - edge * t;
+            distance = std::min(distance, std::sqrt(offset.x * offset.x + offset.y * offset.y));
+        }
+
+        return distance;
+    }
+
+    // Draw the polygon and wait for the GPU, so that the whole cost of the draw is measured
+    sf::Time drawPolygon(sf::RenderTexture& target, const sf::PolygonShape& polygon)
+    {
+        sf::Clock clock;
+        target.clear(sf::Color::Black);
+        target.draw(polygon);
+        target.display();
+        glFinish();
+
+        return clock.getElapsedTime();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::RenderTexture target;
+    if (!target.create(textureSize, textureSize))
+        return EXIT_FAILURE;
+
+    std::srand(1);
+    std::vector<sf::Vector2f> outline = makeStar(outlinePointCount, 150.f, 500.f);
+    std::vector<sf::Vector2f> hole = makeStar(holePointCount, 40.f, 140.f);
+
+    sf::PolygonShape polygon(outline.size());
+    for (std::size_t i = 0; i < outline.size(); ++i)
+        polygon.setPoint(i, outline[i]);
+
+    std::size_t holeIndex = polygon.addHole(hole.size());
+    for (std::size_t i = 0; i < hole.size(); ++i)
+        polygon.setHolePoint(holeIndex, i, hole[i]);
+
+    polygon.setFillColor(sf::Color::White);
+
+    std::cout << "Polygon of " << outline.size() << " points with a hole of " << hole.size() << " points" << std::endl;
+
+    // The first draw triangulates the polygon, the next ones reuse the cached triangles
+    sf::Time firstTime = drawPolygon(target, polygon);
+    sf::Time cachedTime = drawPolygon(target, polygon);
+
+    polygon.setPoint(0, outline[0]);
+    sf::Time changedTime = drawPolygon(target, polygon);
+
+    std::cout << "First draw " << firstTime.asMicroseconds() << " us, "
+              << "cached draw " << cachedTime.asMicroseconds() << " us, "
+              << "draw after a change " << changedTime.asMicroseconds() << " us" << std::endl;
+
+    // Compare every pixel with the expected shape; pixels too close to
+    // the contours are skipped, as their coverage depends on rasterization
+    sf::Image image = target.getTexture().copyToImage();
+    std::size_t errors = 0;
+    std::size_t tested = 0;
+
+    for (unsigned int y = 0; y < textureSize; ++y)
+    {
+        for (unsigned int x = 0; x < textureSize; ++x)
+        {
+            sf::Vector2f point(x + 0.5f, y + 0.5f);
+            if ((getDistanceToStar(outline, point) < 1.f) || (getDistanceToStar(hole, point) < 1.f))
+                continue;
+
+            bool inside = isInsideStar(outline, point) && !isInsideStar(hole, point);
+            bool filled = image.getPixel(x, y).r > 128;
+
+            ++tested;
+            if (inside != filled)
+                ++errors;
+        }
+    }
+
+    std::cout << "Checked " << tested << " pixels: " << errors << " wrong" << std::endl;
+
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_DRAWLIST_HPP
+#define SFML_DRAWLIST_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Recorded sequence of draw calls that can be built
+///        without an OpenGL context and replayed later
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API DrawList : private RenderTarget
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty draw list.
+    ///
+    ////////////////////////////////////////////////////////////
+    DrawList();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the recorded draw calls
+    ///
+    /// The memory is kept, so that a list rebuilt every frame
+    /// doesn't allocate once it has reached its final size.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of recorded draw calls
+    ///
+    /// \return Number of draw calls
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getDrawCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the view the list will be replayed with
+    ///
+    /// The recorded draw calls are replayed with the view of the
+    /// target the list is drawn to, whatever the view of the list.
+    /// Giving that view to the list lets drawables which cull
+    /// their content against the view of the target, such as
+    /// sf::TileMap and sf::SpatialIndex, record only what will
+    /// be visible. Until a view is set, they record everything.
+    ///
+    /// \param view View of the target the list will be drawn to
+    ///
+    /// \see getView
+    ///
+    ////////////////////////////////////////////////////////////
+    void setView(const View& view);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the view the list will be replayed with
+    ///
+    /// \see setView
+    ///
+    ////////////////////////////////////////////////////////////
+    using RenderTarget::getView;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a view was given to the list
+    ///
+    /// \see setView
+    ///
+    ////////////////////////////////////////////////////////////
+    using RenderTarget::isViewKnown;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record draw calls
+    ///
+    /// The list supports the same draw functions as render
+    /// targets: drawables, vertex arrays, vertex buffers and
+    /// index buffers, and other draw lists.
+    ///
+    ////////////////////////////////////////////////////////////
+    using RenderTarget::draw;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record instanced draw calls
+    ///
+    /// The instance data is copied into the list.
+    ///
+    ////////////////////////////////////////////////////////////
+    using RenderTarget::drawInstanced;
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the rendering region of the target
+    ///
+    /// A draw list has no rendering region.
+    ///
+    /// \return Always (0, 0)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate or deactivate the target for rendering
+    ///
+    /// A draw list has no OpenGL context: the functions of
+    /// sf::RenderTarget which would need one, when called by a
+    /// drawable during the recording, do nothing.
+    ///
+    /// \param active True to activate, false to deactivate
+    ///
+    /// \return Always false
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setActive(bool active = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Keep the recorded draw calls recorded
+    ///
+    /// The draw calls of a list are only submitted when the
+    /// list is drawn to a target. The functions of
+    /// sf::RenderTarget which submit the queue first, such as
+    /// setView and clear, do nothing when a drawable calls them
+    /// during the recording.
+    ///
+    /// \return Always false
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool submitQueue();
+};
+
+} // namespace sf
+
+
+#endif // SFML_DRAWLIST_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DrawList
+/// \ingroup graphics
+///
+/// sf::DrawList records draw calls together with their render
+/// states instead of executing them. Drawing a list to a render
+/// target with sf::RenderTarget::draw replays the recorded draw
+/// calls in order, combined with the transform of the render
+/// states passed to that draw call.
+///
+/// Recording runs the CPU side of drawing (shape and text
+/// geometry updates, vertex copies) but issues no OpenGL
+/// command, so lists can be built on worker threads and
+/// replayed on the thread that owns the render target.
+/// A single list must not be used by several threads at the
+/// same time, and it must not be replayed while another
+/// thread is still recording into it.
+///
+/// Drawables receive the list as a sf::RenderTarget while they
+/// are recorded. The functions of the target which can't be
+/// recorded, such as clear, setView or pushGLStates, do
+/// nothing when they call them: the recorded draw calls are
+/// replayed with the view of the target the list is drawn to.
+///
+/// Vertices and indices of vertex arrays are copied into the
+/// list. Textures, shaders, vertex buffers and index buffers
+/// are referenced: they must stay alive until the list has
+/// been replayed. Drawables such as sf::Text may still need
+/// a context to load resources (font glyphs for example);
+/// SFML takes care of that, but the shared resource must not
+/// be used by several threads at the same time.
+///
+/// Usage example:
+/// \code
+/// // on a worker thread
+/// list.clear();
+/// for (std::size_t i = first; i < last; ++i)
+///     list.draw(sprites[i]);
+///
+/// // on the render thread, once the worker is done
+/// window.draw(list);
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
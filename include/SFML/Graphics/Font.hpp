@@ -253,6 +253,19 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the amount of graphics memory used by the font
+    ///
+    /// This is the sum of the memory used by the glyph textures
+    /// of all the character sizes loaded so far.
+    ///
+    /// \return Estimated memory usage, in bytes
+    ///
+    /// \see GraphicsMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getMemoryUsage() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -190,6 +190,105 @@ namespace Glsl
 
 #endif // SFML_DOXYGEN
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Computes the std140 layout of a uniform block
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API Std140
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Types of the members of a uniform block
+        ///
+        ////////////////////////////////////////////////////////////
+        enum Type
+        {
+            Float, ///< \p float in GLSL
+            Vec2,  ///< \p vec2 in GLSL
+            Vec3,  ///< \p vec3 in GLSL
+            Vec4,  ///< \p vec4 in GLSL
+            Int,   ///< \p int in GLSL
+            Ivec2, ///< \p ivec2 in GLSL
+            Ivec3, ///< \p ivec3 in GLSL
+            Ivec4, ///< \p ivec4 in GLSL
+            Bool,  ///< \p bool in GLSL
+            Bvec2, ///< \p bvec2 in GLSL
+            Bvec3, ///< \p bvec3 in GLSL
+            Bvec4, ///< \p bvec4 in GLSL
+            Mat3,  ///< \p mat3 in GLSL
+            Mat4   ///< \p mat4 in GLSL
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates the layout of an empty block.
+        ///
+        ////////////////////////////////////////////////////////////
+        Std140();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Append a member to the block
+        ///
+        /// Members must be added in the order in which they are
+        /// declared in the block.
+        ///
+        /// \param type        Type of the member
+        /// \param arrayLength Number of elements if the member is an array, 0 otherwise
+        ///
+        /// \return Offset of the member in the block, in bytes
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t add(Type type, std::size_t arrayLength = 0);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the size of the block
+        ///
+        /// \return Size of the block with the members added so far, in bytes
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t getSize() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the base alignment of a member
+        ///
+        /// \param type  Type of the member
+        /// \param array True if the member is an array
+        ///
+        /// \return Alignment of the member, in bytes
+        ///
+        ////////////////////////////////////////////////////////////
+        static std::size_t getAlignment(Type type, bool array = false);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the space taken by an element of an array
+        ///
+        /// \param type Type of the elements
+        ///
+        /// \return Distance between two elements of an array, in bytes
+        ///
+        ////////////////////////////////////////////////////////////
+        static std::size_t getArrayStride(Type type);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the size of a single member
+        ///
+        /// \param type Type of the member
+        ///
+        /// \return Size of the member, in bytes
+        ///
+        ////////////////////////////////////////////////////////////
+        static std::size_t getTypeSize(Type type);
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        std::size_t m_size; ///< Offset of the end of the last member
+    };
+
 } // namespace Glsl
 } // namespace sf
 
@@ -202,7 +301,7 @@ namespace Glsl
 ///
 /// \details The sf::Glsl namespace contains types that match
 /// their equivalents in GLSL, the OpenGL shading language.
-/// These types are exclusively used by the sf::Shader class.
+/// These types are used by the sf::Shader and sf::UniformBuffer classes.
 ///
 /// Types that already exist in SFML, such as \ref sf::Vector2<T>
 /// and \ref sf::Vector3<T>, are reused as typedefs, so you can use
@@ -222,6 +321,21 @@ namespace Glsl
 /// Furthermore, they can be converted from sf::Transform
 /// objects.
 ///
-/// \see sf::Shader
+/// sf::Glsl::Std140 computes the offsets of the members of a
+/// uniform block declared with the std140 layout, to fill a
+/// sf::UniformBuffer:
+/// \code
+/// // layout(std140) uniform Camera { mat4 view; float time; vec4 lights[8]; };
+/// sf::Glsl::Std140 layout;
+/// std::size_t view   = layout.add(sf::Glsl::Std140::Mat4);
+/// std::size_t time   = layout.add(sf::Glsl::Std140::Float);
+/// std::size_t lights = layout.add(sf::Glsl::Std140::Vec4, 8);
+///
+/// sf::UniformBuffer camera;
+/// camera.create(layout.getSize());
+/// camera.setUniform(time, 1.5f);
+/// \endcode
+///
+/// \see sf::Shader, sf::UniformBuffer
 ///
 ////////////////////////////////////////////////////////////
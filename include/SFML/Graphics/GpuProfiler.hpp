@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GPUPROFILER_HPP
+#define SFML_GPUPROFILER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Measure the GPU time spent in named zones of rendering
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GpuProfiler : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Timings accumulated for a zone
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API ZoneStatistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates statistics with no sample.
+        ///
+        ////////////////////////////////////////////////////////////
+        ZoneStatistics();
+
+        Time         lastTime;    ///< GPU time of the most recent sample
+        Time         totalTime;   ///< GPU time of all the samples
+        Time         minTime;     ///< Shortest sample
+        Time         maxTime;     ///< Longest sample
+        unsigned int sampleCount; ///< Number of samples
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Utility class that times a zone for the lifetime of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API Scope : NonCopyable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Begin the zone
+        ///
+        /// \param profiler Profiler collecting the timings
+        /// \param target   Render target in which the zone draws
+        /// \param name     Name of the zone
+        ///
+        ////////////////////////////////////////////////////////////
+        Scope(GpuProfiler& profiler, RenderTarget& target, const std::string& name);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief End the zone
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Scope();
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        GpuProfiler&  m_profiler; ///< Profiler collecting the timings
+        RenderTarget& m_target;   ///< Render target in which the zone draws
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param queryCount Number of timer queries per context; it
+    ///                   bounds the number of zones whose result
+    ///                   is not read back yet
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit GpuProfiler(std::size_t queryCount = 64);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GpuProfiler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin a zone
+    ///
+    /// Every draw call issued to \a target until the matching
+    /// endZone() is accounted to the zone. Zones can be nested.
+    /// Results that are ready are collected at the same time.
+    ///
+    /// \param target Render target in which the zone draws
+    /// \param name   Name of the zone
+    ///
+    /// \see endZone
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginZone(RenderTarget& target, const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the most recently begun zone
+    ///
+    /// \param target Render target in which the zone draws
+    ///
+    /// \see beginZone
+    ///
+    ////////////////////////////////////////////////////////////
+    void endZone(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Collect the results that are ready, without waiting for the GPU
+    ///
+    /// Results are also collected by beginZone(), so calling this
+    /// function is only needed to get the last results sooner.
+    ///
+    /// \param target Render target whose context ran the zones
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timings of a zone
+    ///
+    /// Results arrive a few frames after the zone ran, once the
+    /// GPU has executed it.
+    ///
+    /// \param name Name of the zone
+    ///
+    /// \return Timings of the zone (no sample if the zone is unknown)
+    ///
+    ////////////////////////////////////////////////////////////
+    const ZoneStatistics& getZoneStatistics(const std::string& name) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the names of the zones that have been begun so far
+    ///
+    /// \return Names of the zones, in alphabetical order
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<std::string> getZoneNames() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the zones and their timings
+    ///
+    /// Results of zones still in flight are discarded.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports GPU timer queries
+    ///
+    /// If timer queries are not supported, zones can still be
+    /// begun and ended but they never get any sample.
+    ///
+    /// \return True if GPU timing is supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief States of a query
+    ///
+    ////////////////////////////////////////////////////////////
+    enum QueryState
+    {
+        Free,   ///< The query can be used for a new zone
+        Open,   ///< The zone has begun but not ended yet
+        Pending ///< The zone has ended, its result is not read back yet
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pair of timestamp queries surrounding a zone
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Query
+    {
+        unsigned int    begin; ///< Timestamp query issued when the zone begins
+        unsigned int    end;   ///< Timestamp query issued when the zone ends
+        ZoneStatistics* zone;  ///< Zone receiving the result, null if discarded
+        QueryState      state; ///< Current state of the query
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Ring of queries of a context
+    ///
+    ////////////////////////////////////////////////////////////
+    struct QueryRing
+    {
+        std::vector<Query> queries; ///< Queries of the ring
+        std::size_t        next;    ///< Index of the next query to use
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate a target and get the query ring of its context
+    ///
+    /// \param target Render target to activate
+    ///
+    /// \return Query ring of the context, or null on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    QueryRing* getRing(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read back the results of a ring that are ready
+    ///
+    /// \param ring Ring of the active context
+    ///
+    ////////////////////////////////////////////////////////////
+    void collect(QueryRing& ring);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<std::string, ZoneStatistics> ZoneMap;
+    typedef std::map<Uint64, QueryRing> RingMap;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t         m_queryCount; ///< Number of queries per context
+    ZoneMap             m_zones;      ///< Timings of the zones, by name
+    RingMap             m_rings;      ///< Query rings, by context
+    std::vector<Query*> m_openZones;  ///< Stack of zones begun and not ended yet, null if not timed
+};
+
+} // namespace sf
+
+
+#endif // SFML_GPUPROFILER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GpuProfiler
+/// \ingroup graphics
+///
+/// sf::GpuProfiler measures how long the GPU takes to execute
+/// the draw calls issued between beginZone() and endZone(),
+/// and aggregates the timings per zone name. It is meant to
+/// find which passes of a frame (a blur, a post-processing
+/// chain, the UI...) are expensive on the GPU, which CPU timers
+/// can't see because OpenGL commands run asynchronously.
+///
+/// Zones are timed with timestamp queries. Their results are
+/// read back only once the GPU has produced them, so profiling
+/// never stalls the pipeline: the timings lag a few frames
+/// behind. The number of zones in flight is bounded by the
+/// number of queries passed to the constructor; zones that
+/// find no free query are not timed.
+///
+/// Zones can be nested and can span any sequence of draw calls
+/// on a sf::RenderWindow or sf::RenderTexture. When timer
+/// queries are not supported (see isAvailable()), zones are
+/// silently ignored.
+///
+/// Usage example:
+/// \code
+/// sf::GpuProfiler profiler;
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     {
+///         sf::GpuProfiler::Scope zone(profiler, window, "bloom");
+///         bloom.apply(window);
+///     }
+///     window.display();
+///
+///     std::cout << profiler.getZoneStatistics("bloom").lastTime.asMicroseconds() << std::endl;
+/// }
+/// \endcode
+///
+/// \see sf::RenderTarget::getStatistics
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GRAPHICSMEMORY_HPP
+#define SFML_GRAPHICSMEMORY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Give access to the amount of graphics memory
+///        allocated by SFML
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GraphicsMemory
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Kinds of graphics resources
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Category
+    {
+        Textures,       ///< Textures created with sf::Texture
+        RenderTextures, ///< Textures and attachments of sf::RenderTexture
+        VertexBuffers,  ///< Buffers created with sf::VertexBuffer
+        IndexBuffers,   ///< Buffers created with sf::IndexBuffer
+        FontPages,      ///< Glyph textures of sf::Font
+        UniformBuffers, ///< Buffers created with sf::UniformBuffer
+
+        CategoryCount   ///< Keep last -- the total number of categories
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding memory statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Statistics
+    {
+        Statistics();
+
+        Uint64       bytes;        ///< Number of bytes currently allocated
+        Uint64       paddingBytes; ///< Part of the allocated bytes wasted in padding
+        Uint64       peakBytes;    ///< Highest number of bytes allocated at the same time
+        unsigned int count;        ///< Number of resources currently holding memory
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory statistics of a category of resources
+    ///
+    /// \param category Category of resources
+    ///
+    /// \return Statistics of the category
+    ///
+    ////////////////////////////////////////////////////////////
+    static Statistics getStatistics(Category category);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory statistics of all the resources
+    ///
+    /// \return Statistics summed over all the categories
+    ///
+    ////////////////////////////////////////////////////////////
+    static Statistics getTotalStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the peak values to the current allocations
+    ///
+    /// This is useful to measure the peak memory usage of a
+    /// specific part of a program, like a level or a frame.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resetPeaks();
+};
+
+} // namespace sf
+
+
+#endif // SFML_GRAPHICSMEMORY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GraphicsMemory
+/// \ingroup graphics
+///
+/// sf::GraphicsMemory provides statistics about the memory
+/// allocated by SFML in the graphics card: textures, render
+/// textures (including their depth, stencil and multisample
+/// attachments), vertex and index buffers and font glyph pages.
+///
+/// The values are computed from the sizes and formats requested
+/// to the driver, so they are estimations of the actual video
+/// memory usage: drivers may add their own alignment or keep
+/// additional copies of the data. They are however a reliable
+/// way to enforce memory budgets and to detect leaks, since
+/// every allocation is matched by a deallocation when the
+/// resource is destroyed.
+///
+/// The padding bytes count memory that is allocated but not
+/// usable, for example when a texture must be enlarged to a
+/// power of two size because the graphics card doesn't support
+/// non-power-of-two textures.
+///
+/// The memory used by a single resource can be retrieved with
+/// the getMemoryUsage function of sf::Texture, sf::RenderTexture,
+/// sf::VertexBuffer, sf::IndexBuffer and sf::Font.
+///
+/// Usage example:
+/// \code
+/// sf::GraphicsMemory::Statistics stats = sf::GraphicsMemory::getTotalStatistics();
+/// if (stats.bytes > budget)
+///     std::cout << "Graphics memory budget exceeded: " << stats.bytes << " bytes" << std::endl;
+///
+/// sf::GraphicsMemory::Statistics textures = sf::GraphicsMemory::getStatistics(sf::GraphicsMemory::Textures);
+/// std::cout << textures.count << " textures, " << textures.paddingBytes << " bytes wasted in padding" << std::endl;
+/// \endcode
+///
+////////////////////////////////////////////////////////////
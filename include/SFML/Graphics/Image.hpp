@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <string>
@@ -38,6 +39,7 @@
 namespace sf
 {
 class InputStream;
+class Transform;
 
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading, manipulating and saving images
@@ -45,6 +47,21 @@ class InputStream;
 ////////////////////////////////////////////////////////////
 class SFML_GRAPHICS_API Image
 {
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Storage formats of the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    enum PixelFormat
+    {
+        RGBA8,  ///< 8 bits red, green, blue and alpha channels (default)
+        RGB8,   ///< 8 bits red, green and blue channels
+        RG8,    ///< 8 bits red and green channels
+        R8,     ///< 8 bits red channel
+        RGBA16F ///< 16 bits half float red, green, blue and alpha channels
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -64,17 +81,22 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Create the image and fill it with a unique color
     ///
+    /// Channels that are not stored by \a format are dropped
+    /// from \a color.
+    ///
     /// \param width  Width of the image
     /// \param height Height of the image
     /// \param color  Fill color
+    /// \param format Storage format of the pixels
     ///
     ////////////////////////////////////////////////////////////
-    void create(unsigned int width, unsigned int height, const Color& color = Color(0, 0, 0));
+    void create(unsigned int width, unsigned int height, const Color& color = Color(0, 0, 0), PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Create the image from an array of pixels
     ///
-    /// The \a pixel array is assumed to contain 32-bits RGBA pixels,
+    /// The \a pixel array is assumed to contain pixels stored
+    /// in the given \a format (32-bits RGBA pixels by default),
     /// and have the given \a width and \a height. If not, this is
     /// an undefined behavior.
     /// If \a pixels is null, an empty image is created.
@@ -82,9 +104,10 @@ public:
     /// \param width  Width of the image
     /// \param height Height of the image
     /// \param pixels Array of pixels to copy to the image
+    /// \param format Storage format of the pixels
     ///
     ////////////////////////////////////////////////////////////
-    void create(unsigned int width, unsigned int height, const Uint8* pixels);
+    void create(unsigned int width, unsigned int height, const Uint8* pixels, PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
@@ -92,16 +115,21 @@ public:
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
+    /// The pixels are decoded directly to the requested \a format.
+    /// When fewer than 4 channels are requested, grayscale images
+    /// are decoded to the red channel (and alpha to the green
+    /// channel with RG8).
     /// If this function fails, the image is left unchanged.
     ///
     /// \param filename Path of the image file to load
+    /// \param format   Storage format of the pixels
     ///
     /// \return True if loading was successful
     ///
     /// \see loadFromMemory, loadFromStream, saveToFile
     ///
     ////////////////////////////////////////////////////////////
-    bool loadFromFile(const std::string& filename);
+    bool loadFromFile(const std::string& filename, PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file in memory
@@ -109,17 +137,19 @@ public:
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
+    /// The pixels are decoded directly to the requested \a format.
     /// If this function fails, the image is left unchanged.
     ///
-    /// \param data Pointer to the file data in memory
-    /// \param size Size of the data to load, in bytes
+    /// \param data   Pointer to the file data in memory
+    /// \param size   Size of the data to load, in bytes
+    /// \param format Storage format of the pixels
     ///
     /// \return True if loading was successful
     ///
     /// \see loadFromFile, loadFromStream
     ///
     ////////////////////////////////////////////////////////////
-    bool loadFromMemory(const void* data, std::size_t size);
+    bool loadFromMemory(const void* data, std::size_t size, PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a custom stream
@@ -127,16 +157,18 @@ public:
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
+    /// The pixels are decoded directly to the requested \a format.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param stream Source stream to read from
+    /// \param format Storage format of the pixels
     ///
     /// \return True if loading was successful
     ///
     /// \see loadFromFile, loadFromMemory
     ///
     ////////////////////////////////////////////////////////////
-    bool loadFromStream(InputStream& stream);
+    bool loadFromStream(InputStream& stream, PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save the image to a file on disk
@@ -145,6 +177,8 @@ public:
     /// the extension. The supported image formats are bmp, png,
     /// tga and jpg. The destination file is overwritten
     /// if it already exists. This function fails if the image is empty.
+    /// RGBA16F images are converted to 8 bits per channel
+    /// before being saved.
     ///
     /// \param filename Path of the file to save
     ///
@@ -163,12 +197,31 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the storage format of the pixels
+    ///
+    /// \return Pixel format of the image
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelFormat getPixelFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of a pixel stored in the given format
+    ///
+    /// \param format Pixel format
+    ///
+    /// \return Size of a single pixel, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getBytesPerPixel(PixelFormat format);
+
     ////////////////////////////////////////////////////////////
     /// \brief Create a transparency mask from a specified color-key
     ///
     /// This function sets the alpha value of every pixel matching
     /// the given color to \a alpha (0 by default), so that they
     /// become transparent.
+    /// It has no effect on images whose format has no alpha channel.
     ///
     /// \param color Color to make transparent
     /// \param alpha Alpha value to assign to transparent pixels
@@ -188,6 +241,8 @@ public:
     /// If \a applyAlpha is set to true, the transparency of
     /// source pixels is applied. If it is false, the pixels are
     /// copied unchanged with their alpha value.
+    /// If the two images have different pixel formats, the
+    /// source pixels are converted to the format of this image.
     ///
     /// \param source     Source image to copy
     /// \param destX      X coordinate of the destination position
@@ -198,12 +253,63 @@ public:
     ////////////////////////////////////////////////////////////
     void copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0), bool applyAlpha = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Composite pixels from another image onto this one
+    ///
+    /// The source pixels are modulated by \a tint, then
+    /// combined with the pixels of this image using the factors
+    /// and equations of \a mode, exactly like a sprite drawn
+    /// with the same texture rectangle, color and blend mode
+    /// into a render target. This makes it possible to
+    /// reproduce rendering results without an OpenGL context.
+    ///
+    /// If \a sourceRect is empty, the whole image is blended.
+    /// Source pixels without an alpha channel are opaque, and
+    /// so are destination pixels when this image has none.
+    /// Pixels falling outside this image are ignored.
+    ///
+    /// \param source     Source image to blend
+    /// \param destX      X coordinate of the destination position
+    /// \param destY      Y coordinate of the destination position
+    /// \param sourceRect Sub-rectangle of the source image to blend
+    /// \param mode       Blend mode to apply
+    /// \param tint       Color modulating the source pixels
+    ///
+    /// \see copy
+    ///
+    ////////////////////////////////////////////////////////////
+    void blend(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0),
+               const BlendMode& mode = BlendAlpha, const Color& tint = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Composite transformed pixels from another image onto this one
+    ///
+    /// This overload maps the source rectangle through
+    /// \a transform, the way sf::Sprite does: the local point
+    /// (0, 0) is the top-left corner of \a sourceRect, and
+    /// the transformed point is a position in this image, in
+    /// pixels. Pixels whose center falls inside the transformed
+    /// rectangle are blended, with the source sampled at the
+    /// nearest pixel (no smoothing).
+    ///
+    /// \param source     Source image to blend
+    /// \param transform  Transform from source rectangle coordinates to this image
+    /// \param sourceRect Sub-rectangle of the source image to blend
+    /// \param mode       Blend mode to apply
+    /// \param tint       Color modulating the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void blend(const Image& source, const Transform& transform, const IntRect& sourceRect = IntRect(0, 0, 0, 0),
+               const BlendMode& mode = BlendAlpha, const Color& tint = Color::White);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the color of a pixel
     ///
     /// This function doesn't check the validity of the pixel
     /// coordinates, using out-of-range values will result in
     /// an undefined behavior.
+    /// Channels that are not stored by the pixel format of
+    /// the image are ignored.
     ///
     /// \param x     X coordinate of pixel to change
     /// \param y     Y coordinate of pixel to change
@@ -220,6 +326,9 @@ public:
     /// This function doesn't check the validity of the pixel
     /// coordinates, using out-of-range values will result in
     /// an undefined behavior.
+    /// Channels that are not stored by the pixel format of the
+    /// image are returned as 0 for green and blue, and 255 for
+    /// alpha, which matches how OpenGL samples such textures.
     ///
     /// \param x X coordinate of pixel to get
     /// \param y Y coordinate of pixel to get
@@ -234,9 +343,10 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Get a read-only pointer to the array of pixels
     ///
-    /// The returned value points to an array of RGBA pixels made of
-    /// 8 bits integers components. The size of the array is
-    /// width * height * 4 (getSize().x * getSize().y * 4).
+    /// The returned value points to an array of pixels stored in
+    /// the format of the image (RGBA pixels made of 8 bits integers
+    /// components by default). The size of the array is
+    /// width * height * getBytesPerPixel(getPixelFormat()).
     /// Warning: the returned pointer may become invalid if you
     /// modify the image, so you should never store it for too long.
     /// If the image is empty, a null pointer is returned.
@@ -264,6 +374,7 @@ private:
     // Member data
     ////////////////////////////////////////////////////////////
     Vector2u           m_size;   ///< Image size
+    PixelFormat        m_format; ///< Storage format of the pixels
     std::vector<Uint8> m_pixels; ///< Pixels of the image
 };
 
@@ -282,14 +393,16 @@ private:
 /// functions to load, read, write and save pixels, as well
 /// as many other useful functions.
 ///
-/// sf::Image can handle a unique internal representation of
-/// pixels, which is RGBA 32 bits. This means that a pixel
-/// must be composed of 8 bits red, green, blue and alpha
-/// channels -- just like a sf::Color.
-/// All the functions that return an array of pixels follow
-/// this rule, and all parameters that you pass to sf::Image
-/// functions (such as loadFromMemory) must use this
-/// representation as well.
+/// By default, sf::Image stores pixels as RGBA 32 bits. This
+/// means that a pixel is composed of 8 bits red, green, blue
+/// and alpha channels -- just like a sf::Color.
+/// Images that don't need all of these channels, like
+/// heightmaps or masks, can be created or loaded with a more
+/// compact sf::Image::PixelFormat, such as sf::Image::R8 which
+/// only stores 1 byte per pixel. All the functions that return
+/// or take an array of pixels use the pixel format of the image.
+/// When such an image is uploaded to a sf::Texture, the texture
+/// uses the matching OpenGL internal format.
 ///
 /// A sf::Image can be copied, but it is a heavy resource and
 /// if possible you should always use [const] references to
@@ -317,6 +430,11 @@ private:
 /// // Save the image to a file
 /// if (!image.saveToFile("result.png"))
 ///     return -1;
+///
+/// // Load a heightmap with a single 8 bits channel
+/// sf::Image heightmap;
+/// if (!heightmap.loadFromFile("heightmap.png", sf::Image::R8))
+///     return -1;
 /// \endcode
 ///
 /// \see sf::Texture
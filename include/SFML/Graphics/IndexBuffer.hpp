@@ -0,0 +1,411 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INDEXBUFFER_HPP
+#define SFML_INDEXBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Index buffer storage for indexed drawing
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API IndexBuffer : private GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of indices
+    ///
+    ////////////////////////////////////////////////////////////
+    enum IndexType
+    {
+        Index16, ///< 16-bit indices (sf::Uint16), up to 65536 vertices
+        Index32  ///< 32-bit indices (sf::Uint32)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Usage specifiers
+    ///
+    /// If data is going to be updated once or more every frame,
+    /// set the usage to Stream. If data is going to be set once
+    /// and used for a long time without being modified, set the
+    /// usage to Static. For everything else Dynamic should be a
+    /// good compromise.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Usage
+    {
+        Stream,  ///< Constantly changing data
+        Dynamic, ///< Occasionally changing data
+        Static   ///< Rarely changing data
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty index buffer of 16-bit indices.
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IndexBuffer with a specific index type
+    ///
+    /// Creates an empty index buffer and sets its index type to \p type.
+    ///
+    /// \param type Type of indices
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IndexBuffer(IndexType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IndexBuffer with a specific usage specifier
+    ///
+    /// Creates an empty index buffer of 16-bit indices and sets
+    /// its usage to \p usage.
+    ///
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IndexBuffer(Usage usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IndexBuffer with a specific index type and usage specifier
+    ///
+    /// Creates an empty index buffer and sets its index type
+    /// to \p type and usage to \p usage.
+    ///
+    /// \param type  Type of indices
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer(IndexType type, Usage usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer(const IndexBuffer& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~IndexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the index buffer
+    ///
+    /// Creates the index buffer and allocates enough graphics
+    /// memory to hold \p indexCount indices. Any previously
+    /// allocated memory is freed in the process.
+    ///
+    /// In order to deallocate previously allocated memory pass 0
+    /// as \p indexCount. Don't forget to recreate with a non-zero
+    /// value when graphics memory should be allocated again.
+    ///
+    /// \param indexCount Number of indices worth of memory to allocate
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t indexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the index count
+    ///
+    /// \return Number of indices in the index buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getIndexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the whole buffer from an array of 16-bit indices
+    ///
+    /// The \a indices array is assumed to have the same size as
+    /// the \a created buffer. The index type of the buffer must
+    /// be Index16.
+    ///
+    /// \param indices Array of indices to copy to the buffer
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint16* indices);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of 16-bit indices
+    ///
+    /// This function behaves like VertexBuffer::update: if
+    /// \p offset is 0 and \p indexCount is greater than the size
+    /// of the buffer, the buffer is enlarged; if \p offset is not
+    /// 0 and the updated region exceeds the buffer, the update
+    /// fails. The index type of the buffer must be Index16.
+    ///
+    /// \param indices    Array of indices to copy to the buffer
+    /// \param indexCount Number of indices to copy
+    /// \param offset     Offset in the buffer to copy to, in indices
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint16* indices, std::size_t indexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the whole buffer from an array of 32-bit indices
+    ///
+    /// The \a indices array is assumed to have the same size as
+    /// the \a created buffer. The index type of the buffer must
+    /// be Index32.
+    ///
+    /// \param indices Array of indices to copy to the buffer
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint32* indices);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of 32-bit indices
+    ///
+    /// See the 16-bit overload for the rules applied to
+    /// \p offset and \p indexCount. The index type of the buffer
+    /// must be Index32.
+    ///
+    /// \param indices    Array of indices to copy to the buffer
+    /// \param indexCount Number of indices to copy
+    /// \param offset     Offset in the buffer to copy to, in indices
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint32* indices, std::size_t indexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the contents of another buffer into this buffer
+    ///
+    /// Both buffers must have the same index type.
+    ///
+    /// \param indexBuffer Index buffer whose contents to copy into this index buffer
+    ///
+    /// \return True if the copy was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const IndexBuffer& indexBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer& operator =(const IndexBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this index buffer with those of another
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(IndexBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the amount of graphics memory used by the index buffer
+    ///
+    /// \return Estimated memory usage, in bytes
+    ///
+    /// \see GraphicsMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getMemoryUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the index buffer.
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the index buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of the indices stored in the buffer
+    ///
+    /// \return Index type
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexType getIndexType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the usage specifier of this index buffer
+    ///
+    /// After changing the usage specifier, the index buffer has
+    /// to be updated with new data for the usage specifier to
+    /// take effect.
+    ///
+    /// The default usage is sf::IndexBuffer::Stream.
+    ///
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUsage(Usage usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage specifier of this index buffer
+    ///
+    /// \return Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    Usage getUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind an index buffer for rendering
+    ///
+    /// This function is not part of the graphics API, it mustn't be
+    /// used when drawing SFML entities. It must be used only if you
+    /// mix sf::IndexBuffer with OpenGL code.
+    ///
+    /// \param indexBuffer Pointer to the index buffer to bind, can be null to use no index buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const IndexBuffer* indexBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports index buffers
+    ///
+    /// Index buffers are available whenever vertex buffers are.
+    ///
+    /// \return True if index buffers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size in bytes of an index type
+    ///
+    /// \param type Type of indices
+    ///
+    /// \return Size of a single index, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getIndexSize(IndexType type);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from raw index data
+    ///
+    /// \param indices    Array of indices to copy to the buffer
+    /// \param indexCount Number of indices to copy
+    /// \param offset     Offset in the buffer to copy to, in indices
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool updateData(const void* indices, std::size_t indexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy a range of indices back to client memory
+    ///
+    /// Reading buffers back is not supported on OpenGL ES.
+    ///
+    /// \param firstIndex Index of the first index to read
+    /// \param indexCount Number of indices to read
+    /// \param indices    Array receiving the indices, in the type of the buffer
+    ///
+    /// \return True if the indices were read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readIndices(std::size_t firstIndex, std::size_t indexCount, void* indices) const;
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_buffer; ///< Internal buffer identifier
+    std::size_t  m_size;   ///< Size in indices of the currently allocated buffer
+    IndexType    m_type;   ///< Type of the indices
+    Usage        m_usage;  ///< How this index buffer is to be used
+};
+
+} // namespace sf
+
+
+#endif // SFML_INDEXBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::IndexBuffer
+/// \ingroup graphics
+///
+/// sf::IndexBuffer stores indices in graphics memory. Indices
+/// refer to vertices of a sf::VertexBuffer or of a vertex array
+/// and allow to draw primitives that share vertices without
+/// duplicating them: a quad needs 4 vertices and 6 indices
+/// instead of 6 vertices, and a grid of tiles can share the
+/// vertices of adjacent cells.
+///
+/// Indices are either 16-bit (the default, enough for up to
+/// 65536 vertices) or 32-bit. On OpenGL ES, 32-bit indices
+/// require the OES_element_index_uint extension.
+///
+/// sf::IndexBuffer is not a drawable by itself, it is used
+/// with the indexed overloads of sf::RenderTarget::draw.
+///
+/// Example:
+/// \code
+/// sf::Vertex vertices[4];
+/// sf::Uint16 indices[6] = {0, 1, 2, 2, 1, 3};
+/// ...
+/// sf::VertexBuffer quad(sf::Triangles, sf::VertexBuffer::Static);
+/// quad.create(4);
+/// quad.update(vertices);
+///
+/// sf::IndexBuffer quadIndices(sf::IndexBuffer::Index16, sf::IndexBuffer::Static);
+/// quadIndices.create(6);
+/// quadIndices.update(indices);
+/// ...
+/// window.draw(quad, quadIndices);
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
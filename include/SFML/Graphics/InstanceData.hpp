@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_INSTANCEDATA_HPP
+#define SFML_INSTANCEDATA_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Define the per-instance attributes of an instanced draw
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API InstanceData
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The transform is the identity, the color is white and
+    /// the texture rectangle is (0, 0, 1, 1), which leaves the
+    /// texture coordinates of the mesh unchanged.
+    ///
+    ////////////////////////////////////////////////////////////
+    InstanceData();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the instance from its transform
+    ///
+    /// \param theTransform Instance transform
+    ///
+    ////////////////////////////////////////////////////////////
+    InstanceData(const Transform& theTransform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the instance from its transform and color
+    ///
+    /// \param theTransform Instance transform
+    /// \param theColor     Instance color
+    ///
+    ////////////////////////////////////////////////////////////
+    InstanceData(const Transform& theTransform, const Color& theColor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the instance from its transform, color and texture rectangle
+    ///
+    /// \param theTransform   Instance transform
+    /// \param theColor       Instance color
+    /// \param theTextureRect Instance texture rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    InstanceData(const Transform& theTransform, const Color& theColor, const FloatRect& theTextureRect);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Transform transform;   ///< Transform applied to the mesh vertices, before the render states transform
+    Color     color;       ///< Color multiplied with the mesh vertex colors
+    FloatRect textureRect; ///< Rectangle, in pixels, into which the mesh texture coordinates are mapped
+};
+
+} // namespace sf
+
+
+#endif // SFML_INSTANCEDATA_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::InstanceData
+/// \ingroup graphics
+///
+/// sf::InstanceData holds the attributes that change from one
+/// copy of a mesh to the next when it is drawn with
+/// sf::RenderTarget::drawInstanced: a transform, a color
+/// and a texture rectangle.
+///
+/// The transform is applied to the mesh vertices before the
+/// transform of the render states. The color is multiplied
+/// (modulated) with the color of each mesh vertex.
+///
+/// The texture rectangle maps the texture coordinates of the
+/// mesh: a coordinate (u, v) becomes
+/// (left + u * width, top + v * height). A mesh whose texture
+/// coordinates span (0, 0) to (1, 1) can therefore display a
+/// different sub-rectangle of a texture atlas for each instance.
+/// The default rectangle (0, 0, 1, 1) leaves the coordinates
+/// untouched, so meshes with regular pixel coordinates work
+/// as usual.
+///
+/// Usage example:
+/// \code
+/// // a unit quad, textured with the unit square
+/// sf::VertexBuffer quad(sf::TriangleStrip, sf::VertexBuffer::Static);
+/// sf::Vertex vertices[] =
+/// {
+///     sf::Vertex(sf::Vector2f( 0,  0), sf::Vector2f(0, 0)),
+///     sf::Vertex(sf::Vector2f( 0, 32), sf::Vector2f(0, 1)),
+///     sf::Vertex(sf::Vector2f(32,  0), sf::Vector2f(1, 0)),
+///     sf::Vertex(sf::Vector2f(32, 32), sf::Vector2f(1, 1))
+/// };
+/// quad.create(4);
+/// quad.update(vertices);
+///
+/// std::vector<sf::InstanceData> instances(1000);
+/// for (std::size_t i = 0; i < instances.size(); ++i)
+/// {
+///     instances[i].transform.translate(positions[i]);
+///     instances[i].textureRect = sf::FloatRect(32.f * frames[i], 0.f, 32.f, 32.f);
+/// }
+///
+/// window.drawInstanced(quad, &instances[0], instances.size(), &atlas);
+/// \endcode
+///
+/// \see sf::RenderTarget::drawInstanced
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_OVERDRAWREPORT_HPP
+#define SFML_OVERDRAWREPORT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Shader;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Result of an overdraw analysis of a render target
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API OverdrawReport
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw call recorded during the analysis
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Draw
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Draw();
+
+        const Texture* texture;     ///< Texture of the draw call's render states
+        const Shader*  shader;      ///< Shader of the draw call's render states
+        BlendMode      blendMode;   ///< Blend mode of the draw call's render states
+        Uint64         sampleCount; ///< Number of pixels written by the draw call
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty report.
+    ///
+    ////////////////////////////////////////////////////////////
+    OverdrawReport();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the heat map color of an overdraw count
+    ///
+    /// Pixels drawn once are dark blue; the color goes through
+    /// cyan, green, yellow, orange, red and magenta as the count
+    /// grows, and pixels drawn 8 times or more are white.
+    /// Pixels never drawn are black.
+    ///
+    /// \param overdraw Number of times a pixel was drawn
+    ///
+    /// \return Color of the pixel in the heat map
+    ///
+    ////////////////////////////////////////////////////////////
+    static Color getHeatMapColor(unsigned int overdraw);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Image               heatMap;          ///< Overdraw of each pixel, as colors of getHeatMapColor
+    std::vector<Uint64> histogram;        ///< Number of pixels drawn 0, 1, 2, ... 255 or more times
+    std::vector<Draw>   draws;            ///< Draw calls since the target was cleared, in submission order
+    bool                hasSampleCounts;  ///< Do the draw calls have sample counts (occlusion queries supported)?
+    Uint64              fragmentCount;    ///< Total number of pixels written
+    unsigned int        maxOverdraw;      ///< Highest overdraw of a pixel, saturated at 255
+    float               averageOverdraw;  ///< Number of pixels written per pixel of the target
+};
+
+} // namespace sf
+
+
+#endif // SFML_OVERDRAWREPORT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::OverdrawReport
+/// \ingroup graphics
+///
+/// sf::OverdrawReport is returned by
+/// sf::RenderTarget::getOverdrawReport. It tells how many
+/// times each pixel of the target was written since it was
+/// last cleared, which is where fill rate goes.
+///
+/// The heat map has the size of the target and shows the
+/// overdraw of each pixel with the colors of
+/// getHeatMapColor. The histogram counts the pixels by
+/// overdraw: histogram[0] is the number of pixels never
+/// drawn, histogram[1] the number of pixels drawn exactly
+/// once, and so on; the last entry also counts the pixels
+/// drawn more than 255 times.
+///
+/// When occlusion queries are supported, each recorded draw
+/// call tells how many pixels it wrote. A draw call whose
+/// sample count is close to the number of pixels of the
+/// target is a full-screen layer; if it is drawn below
+/// other opaque full-screen layers, it is wasted fill rate.
+///
+/// Usage example:
+/// \code
+/// window.setOverdrawAnalysis(true);
+///
+/// window.clear();
+/// drawScene(window);
+///
+/// sf::OverdrawReport report = window.getOverdrawReport();
+/// report.heatMap.saveToFile("overdraw.png");
+///
+/// sf::Uint64 pixels = window.getSize().x * window.getSize().y;
+/// for (std::size_t i = 0; i < report.draws.size(); ++i)
+/// {
+///     if (report.draws[i].sampleCount >= pixels * 9 / 10)
+///         std::cout << "draw #" << i << " covers the whole screen" << std::endl;
+/// }
+/// \endcode
+///
+/// \see sf::RenderTarget::setOverdrawAnalysis
+///
+////////////////////////////////////////////////////////////
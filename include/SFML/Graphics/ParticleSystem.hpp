@@ -0,0 +1,428 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PARTICLESYSTEM_HPP
+#define SFML_PARTICLESYSTEM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+namespace priv
+{
+    class WorkerPool;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Large set of short-lived textured quads, updated
+///        in bulk
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ParticleSystem : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty particle system which can hold
+    /// 1000 particles.
+    ///
+    ////////////////////////////////////////////////////////////
+    ParticleSystem();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the particle system with a capacity
+    ///
+    /// \param capacity Maximum number of living particles
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ParticleSystem(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ParticleSystem();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of living particles
+    ///
+    /// All the memory used by the particles is allocated here:
+    /// emitting and updating particles never allocates.
+    /// If the new capacity is lower than the current number
+    /// of particles, the extra particles are removed.
+    ///
+    /// \param capacity Maximum number of living particles
+    ///
+    /// \see getCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCapacity(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of living particles
+    ///
+    /// \return Capacity of the particle system
+    ///
+    /// \see setCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of living particles
+    ///
+    /// \return Number of particles
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getParticleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Emit a particle of constant color
+    ///
+    /// The position and velocity are expressed in the local
+    /// coordinate system of the particle system.
+    ///
+    /// \param position Initial position of the particle
+    /// \param velocity Initial velocity of the particle, in units per second
+    /// \param color    Color of the particle
+    /// \param lifetime Time after which the particle dies
+    ///
+    /// \return True if the particle was emitted, false if the system is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool emit(const Vector2f& position, const Vector2f& velocity, const Color& color, Time lifetime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Emit a particle whose color changes over its lifetime
+    ///
+    /// The color of the particle is linearly interpolated from
+    /// \a startColor to \a endColor during its lifetime.
+    ///
+    /// \param position   Initial position of the particle
+    /// \param velocity   Initial velocity of the particle, in units per second
+    /// \param startColor Color of the particle when it is emitted
+    /// \param endColor   Color of the particle when it dies
+    /// \param lifetime   Time after which the particle dies
+    ///
+    /// \return True if the particle was emitted, false if the system is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool emit(const Vector2f& position, const Vector2f& velocity, const Color& startColor, const Color& endColor, Time lifetime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Advance the simulation of all the particles
+    ///
+    /// Moves the particles according to their velocity and
+    /// the acceleration of the system, updates their color,
+    /// removes the particles whose lifetime has elapsed and
+    /// rebuilds the quads of the living particles.
+    ///
+    /// \param elapsed Time elapsed since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the acceleration applied to all the particles
+    ///
+    /// The default acceleration is (0, 0).
+    ///
+    /// \param acceleration Acceleration, in units per second squared
+    ///
+    /// \see getAcceleration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAcceleration(const Vector2f& acceleration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the acceleration applied to all the particles
+    ///
+    /// \return Acceleration, in units per second squared
+    ///
+    /// \see setAcceleration
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getAcceleration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the quad of each particle
+    ///
+    /// The quads are centered on the position of the particles.
+    /// The default size is (1, 1). The new size applies from
+    /// the next call to update().
+    ///
+    /// \param size Size of a particle
+    ///
+    /// \see getParticleSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParticleSize(const Vector2f& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the quad of each particle
+    ///
+    /// \return Size of a particle
+    ///
+    /// \see setParticleSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getParticleSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the texture of the particles
+    ///
+    /// \a texture can be NULL to draw untextured particles.
+    /// The texture must exist as long as the particle system
+    /// uses it.
+    ///
+    /// \param texture   Texture of the particles
+    /// \param resetRect Should the texture rect be reset to the size of the new texture?
+    ///
+    /// \see getTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture, bool resetRect = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of the particles
+    ///
+    /// \return Pointer to the texture, or NULL if there's none
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the part of the texture displayed by each particle
+    ///
+    /// The new rectangle applies from the next call to update().
+    ///
+    /// \param rectangle Rectangle defining the region of the texture
+    ///
+    /// \see getTextureRect, setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(const IntRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the part of the texture displayed by each particle
+    ///
+    /// \return Texture rectangle of the particles
+    ///
+    /// \see setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads updating the particles
+    ///
+    /// The particles are split in blocks which are updated in
+    /// parallel. The default is a single thread, which is
+    /// the best choice for small systems. The extra threads
+    /// are created here and sleep between two updates.
+    ///
+    /// \param count Number of threads, at least 1
+    ///
+    /// \see getThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads updating the particles
+    ///
+    /// \return Number of threads
+    ///
+    /// \see setThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the particles to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the blocks of particles not yet taken by another thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateBlocks();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the blocks of particles of a system, from a worker thread
+    ///
+    /// \param system Particle system to update
+    ///
+    ////////////////////////////////////////////////////////////
+    static void updateBlocksTask(void* system);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a range of particles and write their quads
+    ///
+    /// \param begin Index of the first particle of the range
+    /// \param end   Index past the last particle of the range
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateRange(std::size_t begin, std::size_t end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the particles whose lifetime has elapsed
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeDeadParticles();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Attributes of the particles, each stored in its own array
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Attribute
+    {
+        PositionX,
+        PositionY,
+        VelocityX,
+        VelocityY,
+        Red,
+        Green,
+        Blue,
+        Alpha,
+        RedSpeed,
+        GreenSpeed,
+        BlueSpeed,
+        AlphaSpeed,
+        Lifetime,
+
+        AttributeCount
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<float>                m_attributes[AttributeCount]; ///< Attributes of the particles, one array per attribute
+    std::size_t                       m_capacity;                   ///< Maximum number of living particles
+    std::size_t                       m_count;                      ///< Number of living particles
+    Vector2f                          m_acceleration;               ///< Acceleration applied to all the particles
+    Vector2f                          m_particleSize;               ///< Size of the quad of a particle
+    const Texture*                    m_texture;                    ///< Texture of the particles
+    IntRect                           m_textureRect;                ///< Part of the texture displayed by a particle
+    unsigned int                      m_threadCount;                ///< Number of threads updating the particles
+    float                             m_elapsed;                    ///< Time step of the update in progress, in seconds
+    std::size_t                       m_nextBlock;                  ///< Next block of particles to hand to a thread
+    Mutex                             m_blockMutex;                 ///< Protects m_nextBlock
+    priv::WorkerPool*                 m_workers;                    ///< Threads helping the calling thread to update the particles
+    std::vector<Vertex>               m_vertices;                   ///< Quads of the living particles, rebuilt by update()
+    mutable std::vector<VertexBuffer> m_batches;                    ///< Quads of the living particles in graphics memory, in batches of 16-bit indexable size
+    mutable IndexBuffer               m_indices;                    ///< Indices of the quads of a full batch, shared by all the batches
+    mutable std::vector<Uint16>       m_quadIndices;                ///< Indices of the quads of a full batch, when buffers are not available
+    mutable bool                      m_needUpload;                 ///< Have the quads changed since they were uploaded?
+};
+
+} // namespace sf
+
+
+#endif // SFML_PARTICLESYSTEM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ParticleSystem
+/// \ingroup graphics
+///
+/// sf::ParticleSystem simulates and draws a large number of
+/// particles: small quads which move in a straight line or
+/// under a constant acceleration, change color over their
+/// lifetime and die after it has elapsed.
+///
+/// The particles are stored as a structure of arrays: each
+/// attribute (position, velocity, color, remaining lifetime)
+/// is kept in its own contiguous array, so that update()
+/// streams through memory and its loops can be vectorized
+/// by the compiler. The update can also be split across
+/// several threads with setThreadCount().
+///
+/// All the memory is allocated when the capacity is set.
+/// Dead particles are replaced by the last living ones, so
+/// that the living particles always stay packed at the start
+/// of the arrays and their slots are recycled by the next
+/// emitted particles, without any allocation. As a side
+/// effect, the drawing order of the particles is not stable.
+///
+/// update() writes the quads of the living particles, and
+/// the next draw uploads them to streaming vertex buffers,
+/// which are drawn with a shared index buffer. When vertex
+/// buffers are not available, the quads are drawn as vertex
+/// arrays.
+///
+/// Usage example:
+/// \code
+/// sf::ParticleSystem sparks(100000);
+/// sparks.setTexture(&sparkTexture, true);
+/// sparks.setParticleSize(sf::Vector2f(4, 4));
+/// sparks.setAcceleration(sf::Vector2f(0, 300));
+/// sparks.setThreadCount(4);
+///
+/// // When something explodes
+/// for (int i = 0; i < 500; ++i)
+///     sparks.emit(position, randomVelocity(), sf::Color::Yellow, sf::Color::Transparent, sf::seconds(1.5f));
+///
+/// // Every frame
+/// sparks.update(clock.restart());
+/// window.draw(sparks);
+/// \endcode
+///
+/// \see sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
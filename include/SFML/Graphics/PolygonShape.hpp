@@ -0,0 +1,422 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_POLYGONSHAPE_HPP
+#define SFML_POLYGONSHAPE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Specialized shape representing any simple polygon,
+///        possibly concave and with holes
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API PolygonShape : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param pointCount Number of points of the outer boundary
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PolygonShape(std::size_t pointCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of points of the outer boundary
+    ///
+    /// \a count must be greater than 2 to define a valid shape.
+    ///
+    /// \param count New number of points of the outer boundary
+    ///
+    /// \see getPointCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPointCount(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of points of the outer boundary
+    ///
+    /// \return Number of points of the outer boundary
+    ///
+    /// \see setPointCount
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPointCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of a point of the outer boundary
+    ///
+    /// Don't forget that the polygon must remain simple: its
+    /// boundary must not cross itself nor any of the holes.
+    /// Points can be given in either winding order.
+    /// The result is undefined if \a index is out of the valid range.
+    ///
+    /// \param index Index of the point to change, in range [0 .. getPointCount() - 1]
+    /// \param point New position of the point
+    ///
+    /// \see getPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPoint(std::size_t index, const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a point of the outer boundary
+    ///
+    /// The result is undefined if \a index is out of the valid range.
+    ///
+    /// \param index Index of the point to get, in range [0 .. getPointCount() - 1]
+    ///
+    /// \return Position of the index-th point of the outer boundary
+    ///
+    /// \see setPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getPoint(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a hole to the polygon
+    ///
+    /// The points of the new hole must then be defined with
+    /// setHolePoint. A hole must lie inside the outer boundary
+    /// and must not cross it nor any other hole.
+    ///
+    /// \param pointCount Number of points of the hole
+    ///
+    /// \return Index of the new hole
+    ///
+    /// \see setHolePoint, removeHoles
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addHole(std::size_t pointCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the holes of the polygon
+    ///
+    /// \see addHole
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeHoles();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of holes of the polygon
+    ///
+    /// \return Number of holes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getHoleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of points of a hole
+    ///
+    /// \param hole Index of the hole, in range [0 .. getHoleCount() - 1]
+    ///
+    /// \return Number of points of the hole
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getHolePointCount(std::size_t hole) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of a point of a hole
+    ///
+    /// The result is undefined if \a hole or \a index is out
+    /// of the valid range.
+    ///
+    /// \param hole  Index of the hole, in range [0 .. getHoleCount() - 1]
+    /// \param index Index of the point to change, in range [0 .. getHolePointCount(hole) - 1]
+    /// \param point New position of the point
+    ///
+    /// \see getHolePoint
+    ///
+    ////////////////////////////////////////////////////////////
+    void setHolePoint(std::size_t hole, std::size_t index, const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a point of a hole
+    ///
+    /// The result is undefined if \a hole or \a index is out
+    /// of the valid range.
+    ///
+    /// \param hole  Index of the hole, in range [0 .. getHoleCount() - 1]
+    /// \param index Index of the point to get, in range [0 .. getHolePointCount(hole) - 1]
+    ///
+    /// \return Position of the point
+    ///
+    /// \see setHolePoint
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getHolePoint(std::size_t hole, std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture of the shape
+    ///
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the shape uses it. \a texture can be
+    /// NULL to disable texturing. If \a resetRect is true, the
+    /// texture rect is adjusted to the size of the new texture.
+    ///
+    /// \param texture   New texture
+    /// \param resetRect Should the texture rect be reset to the size of the new texture?
+    ///
+    /// \see getTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture, bool resetRect = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sub-rectangle of the texture that the shape will display
+    ///
+    /// The texture rect is mapped onto the bounding rectangle
+    /// of the outer boundary.
+    ///
+    /// \param rect Rectangle defining the region of the texture to display
+    ///
+    /// \see getTextureRect, setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(const IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the fill color of the shape
+    ///
+    /// By default, the shape's fill color is opaque white.
+    ///
+    /// \param color New color of the shape
+    ///
+    /// \see getFillColor, setOutlineColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFillColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the outline color of the shape
+    ///
+    /// By default, the shape's outline color is opaque white.
+    ///
+    /// \param color New outline color of the shape
+    ///
+    /// \see getOutlineColor, setFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutlineColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the thickness of the shape's outline
+    ///
+    /// The outline surrounds the outer boundary and every hole.
+    /// Positive values expand it away from the filled area,
+    /// negative values towards it, and zero disables it.
+    /// By default, the outline thickness is 0.
+    ///
+    /// \param thickness New outline thickness
+    ///
+    /// \see getOutlineThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutlineThickness(float thickness);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture of the shape
+    ///
+    /// \return Pointer to the shape's texture, or NULL if there's none
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sub-rectangle of the texture displayed by the shape
+    ///
+    /// \return Texture rectangle of the shape
+    ///
+    /// \see setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fill color of the shape
+    ///
+    /// \return Fill color of the shape
+    ///
+    /// \see setFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getFillColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the outline color of the shape
+    ///
+    /// \return Outline color of the shape
+    ///
+    /// \see setOutlineColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getOutlineColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the outline thickness of the shape
+    ///
+    /// \return Outline thickness of the shape
+    ///
+    /// \see setOutlineThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    float getOutlineThickness() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the entity
+    ///
+    /// The returned rectangle is in local coordinates, which means
+    /// that it ignores the transformations (translation, rotation,
+    /// scale, ...) that are applied to the entity.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global (non-minimal) bounding rectangle of the entity
+    ///
+    /// The returned rectangle is in global coordinates, which means
+    /// that it takes into account the transformations (translation,
+    /// rotation, scale, ...) that are applied to the entity.
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the shape to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the outdated parts of the geometry
+    ///
+    ////////////////////////////////////////////////////////////
+    void update() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the fill vertices' texture coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateTexCoords() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the outline vertices' position
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateOutline() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<std::vector<Vector2f> > m_contours;           ///< Outer boundary of the polygon, followed by its holes
+    const Texture*                      m_texture;            ///< Texture of the shape
+    IntRect                             m_textureRect;        ///< Rectangle defining the area of the source texture to display
+    Color                               m_fillColor;          ///< Fill color
+    Color                               m_outlineColor;       ///< Outline color
+    float                               m_outlineThickness;   ///< Thickness of the shape's outline
+    mutable std::vector<Vertex>         m_vertices;           ///< Points of all the contours, with their fill color and texture coordinates
+    mutable std::vector<Uint16>         m_indices;            ///< Triangles of the fill, when there are few enough points for 16-bit indices
+    mutable std::vector<Uint32>         m_wideIndices;        ///< Triangles of the fill, otherwise
+    mutable VertexArray                 m_outlineVertices;    ///< Triangles of the outline
+    mutable FloatRect                   m_insideBounds;       ///< Bounding rectangle of the inside (fill)
+    mutable FloatRect                   m_bounds;             ///< Bounding rectangle of the whole shape (outline + fill)
+    mutable bool                        m_needTriangulation;  ///< Have the points changed since the last triangulation?
+    mutable bool                        m_needOutlineUpdate;  ///< Must the outline be computed again?
+};
+
+} // namespace sf
+
+
+#endif // SFML_POLYGONSHAPE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PolygonShape
+/// \ingroup graphics
+///
+/// This class inherits all the functions of sf::Transformable
+/// (position, rotation, scale, bounds, ...) and offers the
+/// same texture, color and outline properties as sf::Shape.
+///
+/// Unlike sf::ConvexShape, which draws its points as a
+/// triangle fan and is therefore limited to convex polygons,
+/// sf::PolygonShape triangulates its outline: it can display
+/// any simple polygon, concave or not, with any number of
+/// holes. The triangulation runs in O(n log n) and is cached:
+/// it is computed again only when points change, not when
+/// the colors, texture or transform of the shape change.
+/// The fill is drawn as indexed triangles in a single draw
+/// call.
+///
+/// Usage example:
+/// \code
+/// sf::PolygonShape frame(4);
+/// frame.setPoint(0, sf::Vector2f(0, 0));
+/// frame.setPoint(1, sf::Vector2f(100, 0));
+/// frame.setPoint(2, sf::Vector2f(100, 100));
+/// frame.setPoint(3, sf::Vector2f(0, 100));
+///
+/// std::size_t hole = frame.addHole(3);
+/// frame.setHolePoint(hole, 0, sf::Vector2f(20, 20));
+/// frame.setHolePoint(hole, 1, sf::Vector2f(80, 20));
+/// frame.setHolePoint(hole, 2, sf::Vector2f(50, 80));
+///
+/// frame.setFillColor(sf::Color::Red);
+/// frame.setOutlineThickness(2);
+/// window.draw(frame);
+/// \endcode
+///
+/// \see sf::ConvexShape, sf::Shape
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,403 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_POLYLINE_HPP
+#define SFML_POLYLINE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Open line made of thick segments
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API Polyline : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shapes of the corners between two segments
+    ///
+    ////////////////////////////////////////////////////////////
+    enum JoinStyle
+    {
+        MiterJoin, ///< Sharp corner, replaced by a bevel when it is too long
+        RoundJoin, ///< Corner rounded by a circular arc
+        BevelJoin  ///< Corner cut by a straight edge
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shapes of the two ends of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    enum CapStyle
+    {
+        ButtCap,   ///< The line stops exactly at its end points
+        SquareCap, ///< The line is extended by half its thickness
+        RoundCap   ///< The line ends with a half disc
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param thickness Thickness of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Polyline(float thickness = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a point at the end of the line
+    ///
+    /// Only the geometry of the new segment, of the corner it
+    /// makes with the previous segment and of the caps is
+    /// computed and uploaded at the next draw: appending a
+    /// point costs the same whatever the length of the line.
+    ///
+    /// \param point Position of the new point
+    ///
+    ////////////////////////////////////////////////////////////
+    void addPoint(const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the position of a point
+    ///
+    /// The geometry from the segment preceding the point up to
+    /// the end of the line is computed again: moving the last
+    /// points is cheap, moving the first ones is not.
+    ///
+    /// \param index Index of the point to change, in range [0 .. getPointCount() - 1]
+    /// \param point New position of the point
+    ///
+    /// \see getPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPoint(std::size_t index, const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a point
+    ///
+    /// \param index Index of the point to get, in range [0 .. getPointCount() - 1]
+    ///
+    /// \return Position of the point
+    ///
+    /// \see setPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getPoint(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of points of the line
+    ///
+    /// \return Number of points
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPointCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the points of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the thickness of the line
+    ///
+    /// \param thickness New thickness of the line
+    ///
+    /// \see getThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThickness(float thickness);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the thickness of the line
+    ///
+    /// \return Thickness of the line
+    ///
+    /// \see setThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    float getThickness() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the color of the line
+    ///
+    /// The default color is white.
+    ///
+    /// \param color New color of the line
+    ///
+    /// \see getColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of the line
+    ///
+    /// \return Color of the line
+    ///
+    /// \see setColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the shape of the corners between segments
+    ///
+    /// The default style is sf::Polyline::MiterJoin.
+    ///
+    /// \param style New join style
+    ///
+    /// \see getJoinStyle, setMiterLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    void setJoinStyle(JoinStyle style);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shape of the corners between segments
+    ///
+    /// \return Join style
+    ///
+    /// \see setJoinStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    JoinStyle getJoinStyle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the shape of the two ends of the line
+    ///
+    /// The default style is sf::Polyline::ButtCap.
+    ///
+    /// \param style New cap style
+    ///
+    /// \see getCapStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCapStyle(CapStyle style);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shape of the two ends of the line
+    ///
+    /// \return Cap style
+    ///
+    /// \see setCapStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    CapStyle getCapStyle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the longest miter allowed by sf::Polyline::MiterJoin
+    ///
+    /// The limit is the ratio between the length of the miter
+    /// and half the thickness of the line. Sharper corners
+    /// are beveled. The default limit is 4.
+    ///
+    /// \param limit New miter limit, at least 1
+    ///
+    /// \see getMiterLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMiterLimit(float limit);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the longest miter allowed by sf::Polyline::MiterJoin
+    ///
+    /// \return Miter limit
+    ///
+    /// \see setMiterLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    float getMiterLimit() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the line
+    ///
+    /// The returned rectangle is in local coordinates, which means
+    /// that it ignores the transformations (translation, rotation,
+    /// scale, ...) that are applied to the entity.
+    /// It includes the thickness, the joins and the caps.
+    ///
+    /// \return Local bounding rectangle of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the line
+    ///
+    /// The returned rectangle is in global coordinates, which means
+    /// that it takes into account the transformations (translation,
+    /// rotation, scale, ...) that are applied to the entity.
+    ///
+    /// \return Global bounding rectangle of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the line to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tessellate the segments added since the last update, and the caps
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateGeometry() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the geometry from a segment to the end of the line
+    ///
+    /// \param segment Index of the first segment to tessellate again
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateFrom(std::size_t segment);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the triangles of the corner at a point
+    ///
+    /// \param point    Position of the corner
+    /// \param incoming Direction of the segment ending at the point
+    /// \param outgoing Direction of the segment starting at the point
+    ///
+    ////////////////////////////////////////////////////////////
+    void addJoin(const Vector2f& point, const Vector2f& incoming, const Vector2f& outgoing) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the triangles of a cap
+    ///
+    /// \param point     End point of the line
+    /// \param direction Direction pointing out of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    void addCap(const Vector2f& point, const Vector2f& direction) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a fan of triangles along a circular arc
+    ///
+    /// \param center Center of the arc
+    /// \param from   Offset of the first point of the arc from its center
+    /// \param angle  Signed angle covered by the arc, in radians
+    ///
+    ////////////////////////////////////////////////////////////
+    void addArc(const Vector2f& center, const Vector2f& from, float angle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a triangle
+    ///
+    /// \param a First point of the triangle
+    /// \param b Second point of the triangle
+    /// \param c Third point of the triangle
+    ///
+    ////////////////////////////////////////////////////////////
+    void addTriangle(const Vector2f& a, const Vector2f& b, const Vector2f& c) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vector2f>            m_points;      ///< Points of the line
+    float                            m_thickness;   ///< Thickness of the line
+    Color                            m_color;       ///< Color of the line
+    JoinStyle                        m_joinStyle;   ///< Shape of the corners
+    CapStyle                         m_capStyle;    ///< Shape of the ends
+    float                            m_miterLimit;  ///< Longest miter, relative to half the thickness
+    mutable std::vector<Vertex>      m_vertices;    ///< Triangles of the segments and joins, followed by the caps
+    mutable std::vector<std::size_t> m_segments;    ///< First vertex of the geometry of each tessellated segment
+    mutable std::vector<Vector2f>    m_directions;  ///< Direction of each tessellated segment, inherited by empty segments
+    mutable std::size_t              m_bodySize;    ///< Number of vertices of the segments and joins
+    mutable FloatRect                m_bodyBounds;  ///< Bounding rectangle of the segments and joins
+    mutable FloatRect                m_bounds;      ///< Bounding rectangle of the whole geometry
+    mutable bool                     m_needUpdate;  ///< Must the geometry be updated?
+    mutable VertexBuffer             m_buffer;      ///< Geometry in graphics memory
+    mutable std::size_t              m_uploaded;    ///< Number of vertices at the start of the geometry which are up to date in the buffer
+};
+
+} // namespace sf
+
+
+#endif // SFML_POLYLINE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Polyline
+/// \ingroup graphics
+///
+/// sf::Polyline draws an open line of any thickness through
+/// a list of points. Unlike sf::Lines and sf::LineStrip,
+/// which are always one pixel wide, the line is made of
+/// triangles: it scales with the view and can be as thick
+/// as needed. The corners between segments are mitered,
+/// rounded or beveled, and the ends of the line can be
+/// extended with square or round caps.
+///
+/// The whole line is a single stream of triangles, drawn
+/// with one draw call whatever its number of points. The
+/// geometry is built incrementally: appending a point only
+/// tessellates the new segment, its corner and the caps,
+/// and only these vertices are uploaded to the vertex buffer
+/// at the next draw. This makes sf::Polyline suitable for
+/// live charts which grow by a few points every frame.
+///
+/// Each segment and each corner is a separate piece of
+/// geometry, so the pieces overlap slightly on the inner
+/// side of the corners. This is invisible with opaque
+/// colors; with translucent colors, draw the line to a
+/// render texture first and draw that texture translucent.
+///
+/// When vertex buffers are not available, the geometry is
+/// drawn as a vertex array.
+///
+/// Usage example:
+/// \code
+/// sf::Polyline chart(2.f);
+/// chart.setColor(sf::Color::Green);
+/// chart.setJoinStyle(sf::Polyline::RoundJoin);
+///
+/// // Every frame
+/// chart.addPoint(sf::Vector2f(time, value));
+/// window.draw(chart);
+/// \endcode
+///
+/// \see sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
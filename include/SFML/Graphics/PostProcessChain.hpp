@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_POSTPROCESSCHAIN_HPP
+#define SFML_POSTPROCESSCHAIN_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+class RenderTexture;
+class Shader;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Sequence of full-screen shader passes applied to a texture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API PostProcessChain : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty chain, which allocates its intermediate
+    /// render textures from a pool of its own.
+    ///
+    ////////////////////////////////////////////////////////////
+    PostProcessChain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the chain with a shared pool
+    ///
+    /// Chains that share a pool reuse the same intermediate
+    /// render textures when they are applied one after the other.
+    /// The pool must outlive the chain.
+    ///
+    /// \param pool Pool to allocate intermediate render textures from
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PostProcessChain(RenderTexturePool& pool);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Gives the intermediate render textures back to the pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PostProcessChain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a pass to the chain
+    ///
+    /// The shader of the pass reads the result of the previous
+    /// pass (or the input texture for the first pass) through
+    /// its uniform set to sf::Shader::CurrentTexture.
+    ///
+    /// It is important to note that \a shader must remain alive
+    /// as long as the chain uses it, no copy is made internally.
+    ///
+    /// \param shader Shader of the pass
+    ///
+    /// \return Index of the pass
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addPass(const Shader& shader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable a pass
+    ///
+    /// Disabled passes are skipped. All passes are enabled by
+    /// default.
+    ///
+    /// \param index   Index of the pass
+    /// \param enabled True to enable the pass, false to skip it
+    ///
+    /// \see isPassEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPassEnabled(std::size_t index, bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a pass is enabled
+    ///
+    /// \param index Index of the pass
+    ///
+    /// \return True if the pass is enabled
+    ///
+    /// \see setPassEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPassEnabled(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of passes in the chain
+    ///
+    /// \return Number of passes, enabled or not
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPassCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the passes
+    ///
+    /// The intermediate render textures are given back to the pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the passes over a texture and draw the result to a target
+    ///
+    /// All the enabled passes but the last one render into
+    /// intermediate render textures of the size of \a input,
+    /// which replace their whole contents. The last pass draws
+    /// directly to \a output, like a sprite showing the result
+    /// of the previous passes, with the transform and blend
+    /// mode of \a states. If no pass is enabled, \a input is
+    /// drawn as is.
+    ///
+    /// The intermediate render textures are kept from one call
+    /// to the next, so that applying the chain every frame
+    /// doesn't allocate anything. They are given back to the
+    /// pool when the size of the input changes.
+    ///
+    /// \param input  Texture to process
+    /// \param output Render target to draw the result to
+    /// \param states Render states of the final draw; its shader and texture are ignored
+    ///
+    /// \return True if the passes could be applied, false if intermediate render textures couldn't be created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool apply(const Texture& input, RenderTarget& output, const RenderStates& states = RenderStates::Default);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the intermediate render textures back to the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseTargets();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shader pass of the chain
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Pass
+    {
+        const Shader* shader;  ///< Shader applied by the pass
+        bool          enabled; ///< Is the pass applied?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool  m_ownPool;    ///< Pool used when none is given at construction
+    RenderTexturePool& m_pool;       ///< Pool to allocate intermediate render textures from
+    std::vector<Pass>  m_passes;     ///< Passes of the chain
+    RenderTexture*     m_targets[2]; ///< Intermediate render textures, written alternately
+    Vector2u           m_targetSize; ///< Size of the intermediate render textures
+};
+
+} // namespace sf
+
+
+#endif // SFML_POSTPROCESSCHAIN_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PostProcessChain
+/// \ingroup graphics
+///
+/// sf::PostProcessChain applies a list of fragment shaders to
+/// a texture, typically the contents of a sf::RenderTexture
+/// holding the rendered scene. Each pass reads the result of
+/// the previous one; intermediate results ping-pong between
+/// two render textures taken from a sf::RenderTexturePool, and
+/// the last pass draws straight to the final target.
+///
+/// Usage example:
+/// \code
+/// // The shaders read their input with "uniform sampler2D texture;"
+/// bloom.setUniform("texture", sf::Shader::CurrentTexture);
+/// blur.setUniform("texture", sf::Shader::CurrentTexture);
+/// tonemap.setUniform("texture", sf::Shader::CurrentTexture);
+///
+/// sf::PostProcessChain chain;
+/// chain.addPass(bloom);
+/// chain.addPass(blur);
+/// chain.addPass(tonemap);
+///
+/// // Every frame
+/// scene.clear();
+/// scene.draw(...);
+/// scene.display();
+///
+/// window.clear();
+/// chain.apply(scene.getTexture(), window);
+/// window.display();
+/// \endcode
+///
+/// \see sf::RenderTexturePool, sf::Shader
+///
+////////////////////////////////////////////////////////////
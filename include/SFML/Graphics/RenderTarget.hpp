@@ -37,13 +37,27 @@
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexFormat.hpp>
+#include <SFML/Graphics/InstanceData.hpp>
+#include <SFML/Graphics/OverdrawReport.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
 class VertexBuffer;
+class IndexBuffer;
+class DrawList;
+
+namespace priv
+{
+    class InstancedRenderer;
+    class OverdrawAnalyzer;
+    class ProgrammablePipeline;
+    class SoftwareRasterizer;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
@@ -53,6 +67,40 @@ class SFML_GRAPHICS_API RenderTarget : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Rendering backends
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Backend
+    {
+        FixedFunction, ///< Legacy matrix stack and client-side vertex arrays
+        Programmable   ///< Built-in shader, matrix uniforms and vertex attributes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rendering counters of a render target
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the counters to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        unsigned int drawCalls;        ///< Number of OpenGL draw calls
+        unsigned int vertices;         ///< Number of vertices (or indices) submitted, all instances included
+        unsigned int vertexCacheHits;  ///< Number of draws whose vertices were pre-transformed on the CPU
+        unsigned int textureChanges;   ///< Number of texture bindings
+        unsigned int shaderChanges;    ///< Number of draws using a different shader program than the previous one
+        unsigned int blendModeChanges; ///< Number of blend mode changes
+        unsigned int stateResets;      ///< Number of calls to resetGLStates
+        unsigned int contextSwitches;  ///< Number of times the target was activated after another target
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -114,6 +162,25 @@ public:
     ////////////////////////////////////////////////////////////
     const View& getDefaultView() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the draw calls will be rendered with the current view
+    ///
+    /// This is always the case for windows and render textures.
+    /// A draw list is replayed with the view of the target it is
+    /// drawn to, so its current view is only meaningful if it was
+    /// given one with sf::DrawList::setView.
+    ///
+    /// Drawables which skip what lies outside the view of the
+    /// target, such as sf::TileMap, must draw everything when
+    /// this function returns false.
+    ///
+    /// \return True if getView() can be used to cull the draw calls
+    ///
+    /// \see getView
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isViewKnown() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the viewport of a view, applied to this render target
     ///
@@ -268,6 +335,211 @@ public:
     ////////////////////////////////////////////////////////////
     void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices stored in a compact format
+    ///
+    /// The vertices are read directly by the graphics driver
+    /// when it supports the format. Otherwise, and when the
+    /// target records its draw calls or renders in software,
+    /// they are converted to sf::Vertex first.
+    ///
+    /// \param vertices    Pointer to the vertices, stored as described by \a format
+    /// \param vertexCount Number of vertices in the array
+    /// \param format      Layout of the vertices
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    /// \see VertexFormat::pack
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const void* vertices, std::size_t vertexCount, const VertexFormat& format,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by an array of vertices
+    ///
+    /// The primitives are assembled from the vertices referenced
+    /// by \a indices, which allows to share vertices between
+    /// primitives. Indices must be lower than \a vertexCount.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the 16-bit indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by an array of vertices
+    ///
+    /// On OpenGL ES, 32-bit indices require the OES_element_index_uint
+    /// extension.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the 32-bit indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by a vertex buffer and an index buffer
+    ///
+    /// The primitive type of the vertex buffer is used.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer referencing the vertices of \a vertexBuffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by a vertex buffer and an index buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer referencing the vertices of \a vertexBuffer
+    /// \param firstIndex   Index of the first index to render
+    /// \param indexCount   Number of indices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replay the draw calls recorded in a draw list
+    ///
+    /// The draw calls are replayed in the order they were
+    /// recorded. The transform of \a states is combined with
+    /// the transform of each recorded draw call; the other
+    /// render states are the recorded ones.
+    ///
+    /// \param drawList Draw list to replay
+    /// \param states   Render states whose transform is applied to the whole list
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const DrawList& drawList, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw many copies of a mesh stored in a vertex buffer
+    ///
+    /// Each instance transforms, colors and maps the texture
+    /// of the mesh according to its sf::InstanceData. All the
+    /// instances are rendered with a single draw call.
+    ///
+    /// When the system supports hardware instancing (see
+    /// ARB_draw_instanced and ARB_instanced_arrays) and no shader
+    /// is set in \a states, the instances are drawn with
+    /// glDrawArraysInstanced and a built-in shader. Otherwise they
+    /// are expanded into a temporary vertex array on the CPU, so
+    /// that a user shader receives regular vertices. Strip and fan
+    /// primitives are converted to lists during the expansion so
+    /// that consecutive instances stay disconnected.
+    ///
+    /// \param mesh          Vertex buffer holding the mesh
+    /// \param instances     Pointer to the instances
+    /// \param instanceCount Number of instances in the array
+    /// \param states        Render states to use for drawing
+    ///
+    /// \see sf::InstanceData
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const VertexBuffer& mesh, const InstanceData* instances, std::size_t instanceCount,
+                       const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw many copies of a mesh defined by an array of vertices
+    ///
+    /// This function behaves like the vertex buffer version of
+    /// drawInstanced, for meshes stored in client memory.
+    ///
+    /// \param vertices      Pointer to the vertices of the mesh
+    /// \param vertexCount   Number of vertices in the array
+    /// \param type          Type of primitives of the mesh
+    /// \param instances     Pointer to the instances
+    /// \param instanceCount Number of instances in the array
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                       const InstanceData* instances, std::size_t instanceCount,
+                       const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start recording draw calls instead of submitting them
+    ///
+    /// Until flushQueue() is called, draw calls that use vertex
+    /// arrays or vertex buffers are recorded along with their
+    /// render states. flushQueue() then submits them sorted by
+    /// layer, shader, texture and blend mode, so that the render
+    /// states change as rarely as possible.
+    ///
+    /// Draw calls that have the same layer may be reordered, so
+    /// they must not depend on each other's results (for example
+    /// they don't overlap). Draws in lower layers are submitted
+    /// first, and queueBarrier() can be used to force everything
+    /// recorded before it to be drawn before everything recorded
+    /// after it.
+    ///
+    /// The vertices and indices of vertex arrays are copied, but
+    /// textures, shaders, vertex buffers and index buffers are
+    /// referenced: they must stay alive and unchanged until the
+    /// queue is flushed. Clearing the target or changing its view
+    /// submits the recorded draws immediately, so that every draw
+    /// is rendered with the view that was active when it was
+    /// recorded; only the draws recorded between two view changes
+    /// are sorted together.
+    ///
+    /// If a queue is already open, this function does nothing.
+    ///
+    /// \see flushQueue, setQueueLayer, queueBarrier
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the layer of the draw calls recorded next
+    ///
+    /// Within the same barrier, draws with a lower layer are
+    /// submitted before draws with a higher layer. The layer is
+    /// reset to 0 by beginQueue().
+    ///
+    /// \param layer Layer of the next recorded draw calls
+    ///
+    /// \see beginQueue, queueBarrier
+    ///
+    ////////////////////////////////////////////////////////////
+    void setQueueLayer(int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Preserve the order between the draw calls recorded before and after this call
+    ///
+    /// Sorting never moves a draw call across a barrier.
+    ///
+    /// \see beginQueue, setQueueLayer
+    ///
+    ////////////////////////////////////////////////////////////
+    void queueBarrier();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit the recorded draw calls and stop recording
+    ///
+    /// \return Number of shader, texture and blend mode changes
+    ///         avoided by sorting the draw calls
+    ///
+    /// \see beginQueue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t flushQueue();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -366,6 +638,128 @@ public:
     ////////////////////////////////////////////////////////////
     void resetGLStates();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the rendering backend
+    ///
+    /// The fixed-function backend is the default in compatibility
+    /// contexts. The programmable backend replaces the matrix
+    /// stack with a built-in shader and is always used in core
+    /// profile contexts, which have no fixed-function pipeline.
+    /// If the programmable backend is not supported, the target
+    /// falls back to the fixed-function backend.
+    ///
+    /// With the programmable backend, custom shaders receive the
+    /// vertices through the \p sf_position (vec2), \p sf_color
+    /// (vec4) and \p sf_texCoords (vec2) attributes, and the
+    /// matrices through the \p sf_viewProjectionMatrix,
+    /// \p sf_modelMatrix and \p sf_textureMatrix uniforms (mat4).
+    /// The texture matrix converts texture coordinates, which
+    /// are in pixels, to normalized coordinates.
+    ///
+    /// The new backend takes effect at the next draw call.
+    ///
+    /// \param backend Backend to use
+    ///
+    /// \see getBackend
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBackend(Backend backend);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rendering backend in use
+    ///
+    /// \return Backend used by the last draw calls
+    ///
+    /// \see setBackend
+    ///
+    ////////////////////////////////////////////////////////////
+    Backend getBackend() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rendering counters of the current frame
+    ///
+    /// The counters accumulate from the last call to display()
+    /// or resetStatistics(), whichever came last.
+    ///
+    /// \return Counters of the frame in progress
+    ///
+    /// \see getFrameStatistics, resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rendering counters of the last completed frame
+    ///
+    /// display() saves the counters of the frame it ends, then
+    /// resets them for the next frame.
+    ///
+    /// \return Counters of the last frame ended by display()
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getFrameStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the rendering counters of the current frame
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the overdraw analysis mode
+    ///
+    /// While the analysis is enabled, draw calls don't render
+    /// their colors anymore: every pixel they write is added
+    /// to the target, so that the color of a pixel counts how
+    /// many times it was drawn. Textures, shaders and blend
+    /// modes are ignored, but the geometry and transforms are
+    /// not, so the counts reflect the fill rate spent by the
+    /// draw calls. Clearing the target resets the counts,
+    /// whatever the clear color.
+    ///
+    /// When occlusion queries are supported, the number of
+    /// pixels written by each draw call is measured as well.
+    ///
+    /// Counts saturate at 255. Multisampled render textures
+    /// cannot be analyzed.
+    ///
+    /// \param enabled True to enable the analysis, false to disable it
+    ///
+    /// \see getOverdrawReport
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOverdrawAnalysis(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the overdraw analysis mode is enabled
+    ///
+    /// \return True if the overdraw analysis is enabled
+    ///
+    /// \see setOverdrawAnalysis
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isOverdrawAnalysisEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Analyze the overdraw since the target was last cleared
+    ///
+    /// This function reads the target back, which stalls the
+    /// rendering; it is meant for debugging, not for every
+    /// frame. It must be called before display(). If the
+    /// overdraw analysis is disabled, an empty report is
+    /// returned.
+    ///
+    /// \return Heat map, histogram and draw calls of the analysis
+    ///
+    /// \see setOverdrawAnalysis
+    ///
+    ////////////////////////////////////////////////////////////
+    OverdrawReport getOverdrawReport();
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -383,8 +777,49 @@ protected:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief End the statistics of the current frame
+    ///
+    /// The derived classes must call this function when
+    /// a frame is displayed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void endStatisticsFrame();
+
 private:
 
+    friend class DrawList;
+    friend class SoftwareRenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw call recorded by the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    struct QueuedDraw
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Order draws by barrier, layer, shader, texture, blend mode and submission
+        ///
+        ////////////////////////////////////////////////////////////
+        bool operator <(const QueuedDraw& right) const;
+
+        std::size_t         barrier;       ///< Number of barriers recorded before the draw
+        int                 layer;         ///< Layer of the draw
+        Uint64              textureId;     ///< Cache identifier of the texture, 0 if none
+        std::size_t         sequence;      ///< Submission index, keeps the painter's order among equal states
+        RenderStates        states;        ///< Render states of the draw
+        PrimitiveType       type;          ///< Type of primitives to draw
+        const VertexBuffer* vertexBuffer;  ///< Vertex buffer to draw, null for queued vertices
+        const IndexBuffer*  indexBuffer;   ///< Index buffer to use, null for queued or no indices
+        std::size_t         firstVertex;   ///< First vertex in the vertex buffer or in the queued vertices
+        std::size_t         vertexCount;   ///< Number of vertices to draw
+        std::size_t         firstIndex;    ///< First index in the index buffer or in the queued indices
+        std::size_t         indexCount;    ///< Number of indices to draw, 0 for non-indexed draws
+        std::size_t         indexSize;     ///< Size of an index, in bytes
+        std::size_t         firstInstance; ///< First instance in the queued instances
+        std::size_t         instanceCount; ///< Number of instances, 0 for non-instanced draws
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
@@ -423,14 +858,26 @@ private:
     ////////////////////////////////////////////////////////////
     void applyShader(const Shader* shader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Scale the texture matrix for normalized texture coordinates
+    ///
+    /// The texture matrix is restored by the next texture change.
+    ///
+    /// \param texture Texture in use, can be null
+    /// \param range   Range of the normalized texture coordinates, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyTexCoordsRange(const Texture* texture, const Vector2f& range);
+
     ////////////////////////////////////////////////////////////
     /// \brief Setup environment for drawing
     ///
     /// \param useVertexCache Are we going to use the vertex cache?
     /// \param states         Render states to use for drawing
+    /// \param format         Layout of the vertices to draw
     ///
     ////////////////////////////////////////////////////////////
-    void setupDraw(bool useVertexCache, const RenderStates& states);
+    void setupDraw(bool useVertexCache, const RenderStates& states, const VertexFormat& format = VertexFormat::Default);
 
     ////////////////////////////////////////////////////////////
     /// \brief Draw the primitives
@@ -442,6 +889,57 @@ private:
     ////////////////////////////////////////////////////////////
     void drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives
+    ///
+    /// \param type       Type of primitives to draw
+    /// \param indices    Pointer to the indices, or offset in the bound index buffer
+    /// \param indexCount Number of indices to use when drawing
+    /// \param indexSize  Size of a single index, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawIndexedPrimitives(PrimitiveType type, const void* indices, std::size_t indexCount, std::size_t indexSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param indices     Pointer to the indices, or null to draw the vertices in order
+    /// \param indexCount  Number of indices in the array
+    /// \param indexSize   Size of a single index, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states,
+                      const void* indices, std::size_t indexCount, std::size_t indexSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw instanced primitives
+    ///
+    /// \param type          Type of primitives to draw
+    /// \param vertexCount   Number of vertices of a single instance
+    /// \param instanceCount Number of instances to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstancedPrimitives(PrimitiveType type, std::size_t vertexCount, std::size_t instanceCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw instances of a mesh
+    ///
+    /// \param mesh          Vertex buffer holding the mesh, or null to use \a vertices
+    /// \param vertices      Pointer to the vertices of the mesh, if \a mesh is null
+    /// \param vertexCount   Number of vertices of the mesh
+    /// \param type          Type of primitives of the mesh
+    /// \param instances     Pointer to the instances
+    /// \param instanceCount Number of instances in the array
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstances(const VertexBuffer* mesh, const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                       const InstanceData* instances, std::size_t instanceCount, const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Clean up environment after drawing
     ///
@@ -450,6 +948,68 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanupDraw(const RenderStates& states);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a draw call in the queue
+    ///
+    /// \param vertices     Pointer to the vertices, or null for a vertex buffer draw
+    /// \param vertexBuffer Vertex buffer to draw, or null for a vertex array draw
+    /// \param indexBuffer  Index buffer to use, or null
+    /// \param type         Type of primitives to draw
+    /// \param firstVertex  Index of the first vertex of the vertex buffer to draw
+    /// \param vertexCount  Number of vertices to draw
+    /// \param indices      Pointer to the client indices, or null
+    /// \param firstIndex   Index of the first index of the index buffer to use
+    /// \param indexCount   Number of indices to draw
+    /// \param indexSize    Size of an index, in bytes
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void queueDraw(const Vertex* vertices, const VertexBuffer* vertexBuffer, const IndexBuffer* indexBuffer, PrimitiveType type,
+                   std::size_t firstVertex, std::size_t vertexCount, const void* indices, std::size_t firstIndex,
+                   std::size_t indexCount, std::size_t indexSize, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record an instanced draw call in the queue
+    ///
+    /// \param mesh          Vertex buffer holding the mesh, or null
+    /// \param vertices      Pointer to the mesh vertices if \a mesh is null
+    /// \param vertexCount   Number of vertices of the mesh
+    /// \param type          Type of primitives of the mesh
+    /// \param instances     Pointer to the instance data
+    /// \param instanceCount Number of instances
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void queueInstances(const VertexBuffer* mesh, const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                        const InstanceData* instances, std::size_t instanceCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Execute a recorded draw call
+    ///
+    /// \param source    Render target or draw list that recorded the draw
+    /// \param draw      Recorded draw call
+    /// \param transform Transform combined with the recorded one
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawQueued(const RenderTarget& source, const QueuedDraw& draw, const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the recorded draw calls, leaving the queue open
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sort and draw the recorded draw calls, leaving the queue open
+    ///
+    /// Draw lists override this function: their draw calls
+    /// can only be submitted by drawing the list to a target.
+    ///
+    /// \return True if the draw calls were submitted, false if they stay recorded
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool submitQueue();
+
     ////////////////////////////////////////////////////////////
     /// \brief Render states cache
     ///
@@ -463,6 +1023,7 @@ private:
         bool      viewChanged;    ///< Has the current view changed since last draw?
         BlendMode lastBlendMode;  ///< Cached blending mode
         Uint64    lastTextureId;  ///< Cached texture
+        Uint32    lastProgram;    ///< Program used by the previous draw, for the statistics
         bool      texCoordsArrayEnabled; ///< Is GL_TEXTURE_COORD_ARRAY client state enabled?
         bool      useVertexCache; ///< Did we previously use the vertex cache?
         Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
@@ -473,8 +1034,29 @@ private:
     ////////////////////////////////////////////////////////////
     View        m_defaultView; ///< Default view
     View        m_view;        ///< Current view
+    bool        m_viewKnown;   ///< Will the draw calls be rendered with the current view?
     StatesCache m_cache;       ///< Render states cache
     Uint64      m_id;          ///< Unique number that identifies the RenderTarget
+    priv::InstancedRenderer*    m_instancedRenderer; ///< Hardware instancing resources, created on first use
+    std::vector<Vertex>         m_bufferVertices;    ///< Vertices read back from a vertex buffer, for CPU instancing and software targets
+    std::vector<Uint8>          m_bufferIndices;     ///< Indices read back from an index buffer, for software targets
+    std::vector<Vertex>         m_instanceVertices;  ///< Instances expanded on the CPU
+    std::vector<Vertex>         m_formatVertices;    ///< Compact vertices converted on the CPU
+    priv::ProgrammablePipeline* m_pipeline;          ///< Shader-based pipeline, null with the fixed-function backend
+    Backend                     m_backend;           ///< Requested rendering backend
+    std::vector<QueuedDraw>     m_queue;             ///< Recorded draw calls
+    std::vector<Vertex>         m_queueVertices;     ///< Vertices of the recorded vertex array draws
+    std::vector<Uint16>         m_queueIndices16;    ///< 16-bit indices of the recorded vertex array draws
+    std::vector<Uint32>         m_queueIndices32;    ///< 32-bit indices of the recorded vertex array draws
+    std::vector<InstanceData>   m_queueInstances;    ///< Instances of the recorded instanced draws
+    bool                        m_queueing;          ///< Are draw calls currently recorded?
+    int                         m_queueLayer;        ///< Layer of the next recorded draw calls
+    std::size_t                 m_queueBarrier;      ///< Number of barriers recorded so far
+    std::size_t                 m_queueAvoided;      ///< State changes avoided since the queue was opened
+    Statistics                  m_statistics;        ///< Counters of the current frame
+    Statistics                  m_frameStatistics;   ///< Counters of the last completed frame
+    priv::OverdrawAnalyzer*     m_overdraw;          ///< Overdraw analysis resources, null when the analysis is disabled
+    priv::SoftwareRasterizer*   m_rasterizer;        ///< CPU rasterizer replacing OpenGL, null for OpenGL targets
 };
 
 } // namespace sf
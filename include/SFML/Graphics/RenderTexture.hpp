@@ -233,6 +233,19 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the amount of graphics memory used by the render-texture
+    ///
+    /// The returned value includes the target texture and the
+    /// depth, stencil and multisample buffers attached to it.
+    ///
+    /// \return Estimated memory usage, in bytes
+    ///
+    /// \see GraphicsMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getMemoryUsage() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERTEXTUREPOOL_HPP
+#define SFML_RENDERTEXTUREPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/ContextSettings.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTexture;
+
+////////////////////////////////////////////////////////////
+/// \brief Recycles render textures of the same size and settings
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderTexturePool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty pool, which keeps up to 8 unused
+    /// render textures.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Destroys all the render textures of the pool, including
+    /// the ones that were acquired and not released yet.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a render texture for exclusive use
+    ///
+    /// If a render texture of the same size and with the same
+    /// depth, stencil, antialiasing and sRGB settings was
+    /// released to the pool, it is reused; otherwise a new one
+    /// is created.
+    ///
+    /// Reused render textures are reset to their default view,
+    /// with smoothing and repeating disabled, as if they had
+    /// just been created. Their contents are undefined.
+    ///
+    /// The render texture belongs to the pool, it must be
+    /// given back with release() rather than deleted.
+    ///
+    /// \param width    Width of the render texture
+    /// \param height   Height of the render texture
+    /// \param settings Additional settings for the underlying OpenGL texture and context
+    ///
+    /// \return Render texture, or null if it couldn't be created
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexture* acquire(unsigned int width, unsigned int height, const ContextSettings& settings = ContextSettings());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give back a render texture to the pool
+    ///
+    /// The render texture must have been acquired from this
+    /// pool, and must not be used after it is released. If the
+    /// pool already holds the maximum number of unused render
+    /// textures, the one that has been unused for the longest
+    /// time is destroyed.
+    ///
+    /// \param renderTexture Render texture to give back, can be null
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(RenderTexture* renderTexture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy all the unused render textures
+    ///
+    /// Render textures that are currently acquired are not
+    /// affected.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of unused render textures kept by the pool
+    ///
+    /// Unused render textures in excess are destroyed, starting
+    /// with the ones that have been unused for the longest time.
+    ///
+    /// \param count Maximum number of unused render textures
+    ///
+    /// \see getMaxIdleCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxIdleCount(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of unused render textures kept by the pool
+    ///
+    /// \return Maximum number of unused render textures
+    ///
+    /// \see setMaxIdleCount
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMaxIdleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of unused render textures in the pool
+    ///
+    /// \return Number of render textures ready to be reused
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getIdleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of render textures currently acquired
+    ///
+    /// \return Number of render textures not released yet
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getAcquiredCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render texture of the pool, with the parameters it was created with
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        RenderTexture*  renderTexture; ///< Render texture owned by the pool
+        unsigned int    width;         ///< Width of the render texture
+        unsigned int    height;        ///< Height of the render texture
+        ContextSettings settings;      ///< Settings the render texture was created with
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy unused render textures in excess
+    ///
+    ////////////////////////////////////////////////////////////
+    void trim();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Entry> m_idle;     ///< Unused render textures, from the oldest to the most recently released
+    std::vector<Entry> m_acquired; ///< Render textures currently acquired
+    std::size_t        m_maxIdle;  ///< Maximum number of unused render textures
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERTEXTUREPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderTexturePool
+/// \ingroup graphics
+///
+/// Creating a sf::RenderTexture is expensive: it allocates a
+/// texture, a frame buffer object with its depth and stencil
+/// buffers, and sometimes an OpenGL context. Effects that need
+/// temporary render textures every frame can acquire them from
+/// a sf::RenderTexturePool instead, and release them once they
+/// are done: the next request for the same size and settings
+/// gets the same render texture back, without any allocation.
+///
+/// Usage example:
+/// \code
+/// sf::RenderTexturePool pool;
+///
+/// // Every frame
+/// sf::RenderTexture* blur = pool.acquire(width / 2, height / 2);
+/// if (blur)
+/// {
+///     blur->clear();
+///     blur->draw(scene, &downsample);
+///     blur->display();
+///     window.draw(sf::Sprite(blur->getTexture()), &upsample);
+///     pool.release(blur);
+/// }
+/// \endcode
+///
+/// \see sf::RenderTexture, sf::PostProcessChain
+///
+////////////////////////////////////////////////////////////
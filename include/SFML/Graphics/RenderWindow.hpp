@@ -177,6 +177,15 @@ protected:
     ///
     ////////////////////////////////////////////////////////////
     virtual void onResize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called after the window has been displayed
+    ///
+    /// Ends the rendering statistics of the frame (see
+    /// getFrameStatistics).
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
 };
 
 } // namespace sf
@@ -0,0 +1,482 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SCENENODE_HPP
+#define SFML_SCENENODE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Transformable drawable object with children,
+///        forming a scene graph
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SceneNode : public Drawable, private Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a node without parent nor children.
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The node is detached from its parent, and its children
+    /// become root nodes.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~SceneNode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a child to the node
+    ///
+    /// The child is detached from its previous parent, if any,
+    /// and drawn after the children already attached. The node
+    /// doesn't take ownership of the child: it must be kept
+    /// alive as long as it is attached.
+    ///
+    /// A node can't be attached to itself or to one of its
+    /// descendants.
+    ///
+    /// \param child Node to attach
+    ///
+    /// \see detachChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachChild(SceneNode& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a child from the node
+    ///
+    /// This function does nothing if \a child is not a child
+    /// of this node.
+    ///
+    /// \param child Node to detach
+    ///
+    /// \see attachChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachChild(SceneNode& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the parent of the node
+    ///
+    /// \return Parent node, or null if the node is a root
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode* getParent();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the parent of the node (read-only)
+    ///
+    /// \return Parent node, or null if the node is a root
+    ///
+    ////////////////////////////////////////////////////////////
+    const SceneNode* getParent() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of children of the node
+    ///
+    /// \return Number of children
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChildCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a child of the node
+    ///
+    /// \param index Index of the child, in drawing order
+    ///
+    /// \return Reference to the child
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode& getChild(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a child of the node (read-only)
+    ///
+    /// \param index Index of the child, in drawing order
+    ///
+    /// \return Const reference to the child
+    ///
+    ////////////////////////////////////////////////////////////
+    const SceneNode& getChild(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of the node
+    ///
+    /// The position is relative to the parent of the node.
+    ///
+    /// \param x X coordinate of the new position
+    /// \param y Y coordinate of the new position
+    ///
+    /// \see sf::Transformable::setPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(float x, float y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of the node
+    ///
+    /// The position is relative to the parent of the node.
+    ///
+    /// \param position New position
+    ///
+    /// \see sf::Transformable::setPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the orientation of the node
+    ///
+    /// The rotation is relative to the parent of the node.
+    ///
+    /// \param angle New rotation, in degrees
+    ///
+    /// \see sf::Transformable::setRotation
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRotation(float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scale factors of the node
+    ///
+    /// The scale is relative to the parent of the node.
+    ///
+    /// \param factorX New horizontal scale factor
+    /// \param factorY New vertical scale factor
+    ///
+    /// \see sf::Transformable::setScale
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(float factorX, float factorY);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scale factors of the node
+    ///
+    /// The scale is relative to the parent of the node.
+    ///
+    /// \param factors New scale factors
+    ///
+    /// \see sf::Transformable::setScale
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(const Vector2f& factors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the local origin of the node
+    ///
+    /// \param x X coordinate of the new origin
+    /// \param y Y coordinate of the new origin
+    ///
+    /// \see sf::Transformable::setOrigin
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(float x, float y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the local origin of the node
+    ///
+    /// \param origin New origin
+    ///
+    /// \see sf::Transformable::setOrigin
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(const Vector2f& origin);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the node by a given offset
+    ///
+    /// \param offsetX X offset
+    /// \param offsetY Y offset
+    ///
+    /// \see sf::Transformable::move
+    ///
+    ////////////////////////////////////////////////////////////
+    void move(float offsetX, float offsetY);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the node by a given offset
+    ///
+    /// \param offset Offset
+    ///
+    /// \see sf::Transformable::move
+    ///
+    ////////////////////////////////////////////////////////////
+    void move(const Vector2f& offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rotate the node
+    ///
+    /// \param angle Angle of rotation, in degrees
+    ///
+    /// \see sf::Transformable::rotate
+    ///
+    ////////////////////////////////////////////////////////////
+    void rotate(float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scale the node
+    ///
+    /// \param factorX Horizontal scale factor
+    /// \param factorY Vertical scale factor
+    ///
+    /// \see sf::Transformable::scale
+    ///
+    ////////////////////////////////////////////////////////////
+    void scale(float factorX, float factorY);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scale the node
+    ///
+    /// \param factor Scale factors
+    ///
+    /// \see sf::Transformable::scale
+    ///
+    ////////////////////////////////////////////////////////////
+    void scale(const Vector2f& factor);
+
+    ////////////////////////////////////////////////////////////
+    // The getters of sf::Transformable are available unchanged
+    ////////////////////////////////////////////////////////////
+    using Transformable::getPosition;
+    using Transformable::getRotation;
+    using Transformable::getScale;
+    using Transformable::getOrigin;
+    using Transformable::getTransform;
+    using Transformable::getInverseTransform;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the transform of the node relative to the root
+    ///
+    /// The world transform combines the transforms of all the
+    /// ancestors of the node with its own. It is cached, and
+    /// only recomputed after the node or one of its ancestors
+    /// was moved, or after the node was attached elsewhere.
+    ///
+    /// \return World transform of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    const Transform& getWorldTransform() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the node content
+    ///
+    /// The returned rectangle is in local coordinates, which
+    /// means that it ignores the transformations of the node
+    /// and doesn't include its children. The default
+    /// implementation returns an empty rectangle, derived
+    /// classes which draw something override it.
+    ///
+    /// \return Local bounding rectangle of the node content
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the subtree
+    ///
+    /// The returned rectangle is in root coordinates and
+    /// contains the content of the node and of all its
+    /// descendants. It is cached, and only recomputed after
+    /// a change in the subtree.
+    ///
+    /// \return Global bounding rectangle of the subtree
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the content of the node
+    ///
+    /// This function is called for every node of the drawn
+    /// subtree, parents before their children. \a states
+    /// already contains the world transform of the node. The
+    /// default implementation draws nothing.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawCurrent(RenderTarget& target, const RenderStates& states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell that the local bounds of the node have changed
+    ///
+    /// Derived classes must call this function when the result
+    /// of getLocalBounds() changes, so that the cached bounds of
+    /// the node and of its ancestors are recomputed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateBounds();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the subtree to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the node and its descendants
+    ///
+    /// \param target    Render target to draw to
+    /// \param states    Render states of the node, to which the world transform is applied
+    /// \param transform Transform applied to the whole scene
+    /// \param identity  Is \a transform the identity?
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawSubtree(RenderTarget& target, RenderStates& states, const Transform& transform, bool identity) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell that the transform of the node has changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateTransform();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the world transforms of the subtree as outdated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateWorldTransform();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SceneNode*              m_parent;                    ///< Parent node, null for a root
+    std::vector<SceneNode*> m_children;                  ///< Child nodes, in drawing order
+    mutable Transform       m_worldTransform;            ///< Combined transform of the ancestors and of the node
+    mutable bool            m_worldTransformNeedUpdate;  ///< Does the world transform need to be recomputed?
+    mutable FloatRect       m_globalBounds;              ///< Bounds of the subtree, in root coordinates
+    mutable bool            m_globalBoundsNeedUpdate;    ///< Do the global bounds need to be recomputed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SCENENODE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SceneNode
+/// \ingroup graphics
+///
+/// sf::SceneNode organizes transformable objects in a
+/// hierarchy: a node is positioned, rotated and scaled
+/// relative to its parent, and drawing a node draws its
+/// whole subtree, parents before children.
+///
+/// Combining transforms by hand, through RenderStates::transform
+/// in every draw function, recomputes the whole hierarchy every
+/// frame. sf::SceneNode caches the world transform of each node
+/// and the bounds of each subtree instead. Changing the
+/// transform of a node marks the world transforms of its
+/// subtree as outdated, and stops at the nodes already marked;
+/// the bounds of its ancestors are marked the same way. Only the
+/// branches that changed are recomputed, lazily, the next time
+/// they are drawn or queried.
+///
+/// sf::SceneNode inherits sf::Transformable privately: it provides
+/// the same setters, which also mark the cached data as outdated,
+/// and exposes the getters unchanged. A node can't be converted
+/// to an sf::Transformable, so its transform can't be changed
+/// behind the back of the cache.
+///
+/// Drawing a node draws it at its world position, so a node
+/// which has a parent is drawn with the transforms of its
+/// ancestors. The transform of the render states passed to
+/// the draw call is applied to the whole subtree, like a camera.
+///
+/// The nodes of a tree don't own each other: the user is
+/// responsible for keeping them alive while they are attached.
+/// Destroying a node detaches it from the tree.
+///
+/// To draw something, derive from sf::SceneNode and override
+/// drawCurrent(), which receives render states that already
+/// contain the world transform of the node. Derived classes
+/// should also override getLocalBounds(), and call
+/// invalidateBounds() when its result changes.
+///
+/// Usage example:
+/// \code
+/// class SpriteNode : public sf::SceneNode
+/// {
+/// public:
+///
+///     explicit SpriteNode(const sf::Texture& texture) : m_sprite(texture) {}
+///
+///     virtual sf::FloatRect getLocalBounds() const
+///     {
+///         return m_sprite.getLocalBounds();
+///     }
+///
+/// private:
+///
+///     virtual void drawCurrent(sf::RenderTarget& target, const sf::RenderStates& states) const
+///     {
+///         target.draw(m_sprite, states);
+///     }
+///
+///     sf::Sprite m_sprite;
+/// };
+///
+/// SpriteNode ship(shipTexture);
+/// SpriteNode turret(turretTexture);
+/// turret.setPosition(10, 5);
+/// ship.attachChild(turret);
+///
+/// // The turret follows the ship
+/// ship.move(100, 0);
+/// turret.rotate(15);
+///
+/// window.draw(ship);
+/// \endcode
+///
+/// \see sf::Transformable, sf::Drawable
+///
+////////////////////////////////////////////////////////////
@@ -32,10 +32,12 @@
 #include <SFML/Graphics/Glsl.hpp>
 #include <SFML/Window/GlResource.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Vector3.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -44,6 +46,13 @@ class Color;
 class InputStream;
 class Texture;
 class Transform;
+class UniformBuffer;
+
+namespace priv
+{
+    class ProgrammablePipeline;
+    class InstancedRenderer;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Shader class (vertex, geometry and fragment)
@@ -51,6 +60,10 @@ class Transform;
 ////////////////////////////////////////////////////////////
 class SFML_GRAPHICS_API Shader : GlResource, NonCopyable
 {
+    friend class RenderTarget;
+    friend class priv::ProgrammablePipeline;
+    friend class priv::InstancedRenderer;
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -64,6 +77,18 @@ public:
         Fragment  ///< Fragment (pixel) shader
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Loading states of a shader
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Status
+    {
+        Unloaded,  ///< No program was loaded yet
+        Compiling, ///< An asynchronous load is in progress
+        Ready,     ///< The program is ready to be used
+        Failed     ///< The last load failed
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Special type that can be passed to setUniform(),
     ///        and that represents the texture of the object being drawn
@@ -81,6 +106,75 @@ public:
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Counters of the program binary cache
+    ///
+    /// \see getCacheStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API CacheStatistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the counters to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        CacheStatistics();
+
+        unsigned int hits;        ///< Number of programs loaded from the cache
+        unsigned int misses;      ///< Number of programs compiled from source while the cache was enabled
+        Time         loadTime;    ///< Total time spent loading programs from the cache
+        Time         compileTime; ///< Total time spent compiling and linking programs from source
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle to a uniform variable of a shader
+    ///
+    /// A handle is obtained once with getUniformHandle(), and
+    /// then given to setUniform() or setUniformArray() in place
+    /// of the name of the uniform, which saves looking the name
+    /// up every time. Handles remain valid until the shader is
+    /// loaded again.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API UniformHandle
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an invalid handle; setting a value through it
+        /// does nothing.
+        ///
+        ////////////////////////////////////////////////////////////
+        UniformHandle();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the handle refers to a uniform
+        ///
+        /// \return True if the uniform was found in the shader
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isValid() const;
+
+    private:
+
+        friend class Shader;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the handle from a uniform location
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit UniformHandle(int location);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        int m_location; ///< Location of the uniform in the program, -1 if invalid
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -287,6 +381,115 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromStream(InputStream& vertexShaderStream, InputStream& geometryShaderStream, InputStream& fragmentShaderStream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the vertex, geometry or fragment shader from a source code in memory, without waiting
+    ///
+    /// This function submits the compilation of the shader and
+    /// returns immediately. When the driver supports
+    /// GL_KHR_parallel_shader_compile, it compiles the shader in
+    /// its own threads; otherwise SFML compiles it in a thread
+    /// with a context of its own. Use getStatus() or isReady()
+    /// to know when the shader can be used.
+    ///
+    /// Until the shader is ready, drawing with it uses its
+    /// fallback shader instead (see setFallback), and its
+    /// uniforms cannot be set yet. Loading the shader again or
+    /// destroying it while the load is in progress waits for
+    /// the compilation to finish.
+    ///
+    /// \param shader String containing the source code of the shader
+    /// \param type   Type of shader (vertex, geometry or fragment)
+    ///
+    /// \return True if the compilation was submitted, false if shaders are not supported
+    ///
+    /// \see loadFromMemory, getStatus
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadAsync(const std::string& shader, Type type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading both the vertex and fragment shaders from source codes in memory, without waiting
+    ///
+    /// See loadAsync(const std::string&, Type) for details.
+    ///
+    /// \param vertexShader   String containing the source code of the vertex shader
+    /// \param fragmentShader String containing the source code of the fragment shader
+    ///
+    /// \return True if the compilation was submitted, false if shaders are not supported
+    ///
+    /// \see loadFromMemory, getStatus
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadAsync(const std::string& vertexShader, const std::string& fragmentShader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the vertex, geometry and fragment shaders from source codes in memory, without waiting
+    ///
+    /// See loadAsync(const std::string&, Type) for details.
+    ///
+    /// \param vertexShader   String containing the source code of the vertex shader
+    /// \param geometryShader String containing the source code of the geometry shader
+    /// \param fragmentShader String containing the source code of the fragment shader
+    ///
+    /// \return True if the compilation was submitted, false if shaders are not supported
+    ///
+    /// \see loadFromMemory, getStatus
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadAsync(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the loading state of the shader
+    ///
+    /// This function never waits for a compilation in progress.
+    ///
+    /// \return Current status of the shader
+    ///
+    /// \see isReady, loadAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    Status getStatus() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the shader is ready to be used
+    ///
+    /// This is a shortcut for getStatus() == Ready.
+    ///
+    /// \return True if the program of the shader is linked
+    ///
+    /// \see getStatus
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the shader to use while this one is not ready
+    ///
+    /// Drawing with a shader that is still compiling, or that
+    /// failed to load, uses its fallback instead. Fallbacks can
+    /// be chained; if no shader of the chain is ready, objects
+    /// are drawn with the default rendering, as if no shader
+    /// was given. There is no fallback by default.
+    ///
+    /// The fallback shader must outlive this one.
+    ///
+    /// \param fallback Shader to use instead of this one while it is not ready, or null
+    ///
+    /// \see getFallback
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFallback(const Shader* fallback);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader used while this one is not ready
+    ///
+    /// \return Fallback shader, or null if there is none
+    ///
+    /// \see setFallback
+    ///
+    ////////////////////////////////////////////////////////////
+    const Shader* getFallback() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p float uniform
     ///
@@ -545,6 +748,295 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Attach a uniform buffer to a uniform block
+    ///
+    /// \a name is the name of a uniform block declared in the
+    /// shader, for example "Camera" in
+    /// \code
+    /// layout(std140) uniform Camera
+    /// {
+    ///     mat4 view;
+    ///     float time;
+    /// };
+    /// \endcode
+    /// Its members are read from \a buffer, and updated
+    /// whenever the buffer changes: the same buffer can be
+    /// attached to many shaders, its values are uploaded only
+    /// once for all of them.
+    ///
+    /// It is important to note that \a buffer must remain alive
+    /// as long as the shader uses it, no copy is made internally.
+    ///
+    /// \param name   Name of the uniform block in GLSL
+    /// \param buffer Uniform buffer holding the values of the block
+    ///
+    /// \see UniformBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformBlock(const std::string& name, const UniformBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a handle to a uniform variable
+    ///
+    /// The handle can be given to the setUniform() and
+    /// setUniformArray() overloads in place of the name.
+    /// Setting uniforms through handles avoids searching the
+    /// name every time, which matters when many uniforms are
+    /// changed every frame.
+    ///
+    /// \code
+    /// sf::Shader::UniformHandle offset = shader.getUniformHandle("offset");
+    /// ...
+    /// shader.setUniform(offset, 0.5f);
+    /// \endcode
+    ///
+    /// \param name Name of the uniform variable in GLSL
+    ///
+    /// \return Handle to the uniform, invalid if the shader has no such uniform
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformHandle getUniformHandle(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p float uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param x      Value of the float scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec2 uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param vector Value of the vec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec3 uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param vector Value of the vec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec4 uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param vector Value of the vec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p int uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param x      Value of the int scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, int x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec2 uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param vector Value of the ivec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec3 uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param vector Value of the ivec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec4 uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param vector Value of the ivec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bool uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param x      Value of the bool scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, bool x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec2 uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param vector Value of the bvec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec3 uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param vector Value of the bvec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec4 uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param vector Value of the bvec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat3 matrix
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param matrix Value of the mat3 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Mat3& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat4 matrix
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param matrix Value of the mat4 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Mat4& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify a texture as \p sampler2D uniform
+    ///
+    /// \param handle  Handle of the uniform variable
+    /// \param texture Texture to assign
+    ///
+    /// \see setUniform(const std::string&, const Texture&)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify current texture as \p sampler2D uniform
+    ///
+    /// \param handle Handle of the uniform variable
+    ///
+    /// \see setUniform(const std::string&, CurrentTextureType)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, CurrentTextureType);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p float[] array uniform
+    ///
+    /// \param handle      Handle of the uniform variable
+    /// \param scalarArray pointer to array of \p float values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const float* scalarArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec2[] array uniform
+    ///
+    /// \param handle      Handle of the uniform variable
+    /// \param vectorArray pointer to array of \p vec2 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Vec2* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec3[] array uniform
+    ///
+    /// \param handle      Handle of the uniform variable
+    /// \param vectorArray pointer to array of \p vec3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Vec3* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec4[] array uniform
+    ///
+    /// \param handle      Handle of the uniform variable
+    /// \param vectorArray pointer to array of \p vec4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Vec4* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p mat3[] array uniform
+    ///
+    /// \param handle      Handle of the uniform variable
+    /// \param matrixArray pointer to array of \p mat3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Mat3* matrixArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p mat4[] array uniform
+    ///
+    /// \param handle      Handle of the uniform variable
+    /// \param matrixArray pointer to array of \p mat4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Mat4* matrixArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the deferred upload of uniforms
+    ///
+    /// Setting a uniform normally makes the shader's program
+    /// current, uploads the value and restores the previous
+    /// program, which requires an active context every time.
+    /// When uploads are deferred, setUniform() and
+    /// setUniformArray() only store the values on the CPU,
+    /// and the ones that changed are uploaded together the
+    /// next time the shader is bound, usually by the draw call
+    /// that uses it.
+    ///
+    /// Disabling deferred uploads uploads the pending values
+    /// immediately. Deferred uploads are disabled by default.
+    ///
+    /// \param deferred True to defer the upload of uniforms to bind time
+    ///
+    /// \see isUniformUploadDeferred
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformUploadDeferred(bool deferred);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the upload of uniforms is deferred
+    ///
+    /// \return True if uniforms are uploaded when the shader is bound
+    ///
+    /// \see setUniformUploadDeferred
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isUniformUploadDeferred() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Change a float parameter of the shader
     ///
@@ -644,6 +1136,10 @@ public:
     /// used when drawing SFML entities. It must be used only if you
     /// mix sf::Shader with OpenGL code.
     ///
+    /// This function always calls OpenGL, even when the shader
+    /// is already bound, so it can be used after changing the
+    /// OpenGL bindings directly.
+    ///
     /// \code
     /// sf::Shader s1, s2;
     /// ...
@@ -691,6 +1187,62 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isGeometryAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable the program binary cache
+    ///
+    /// Once a directory is set, the programs linked by the
+    /// load functions are saved there in the binary format of
+    /// the OpenGL driver. The next time the same sources are
+    /// loaded on the same renderer and driver version, the
+    /// program is loaded from its binary, which skips the
+    /// compilation and link steps. Binaries rejected by the
+    /// driver are compiled from source again and replaced.
+    ///
+    /// The directory must exist and be writable; it is not
+    /// created. An empty string disables the cache, which is
+    /// the default. The cache does nothing if the system
+    /// doesn't support program binaries, see isCacheAvailable().
+    ///
+    /// \param directory Directory where program binaries are stored, or empty to disable the cache
+    ///
+    /// \see getCacheDirectory, getCacheStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCacheDirectory(const std::string& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the directory of the program binary cache
+    ///
+    /// \return Directory where program binaries are stored, empty if the cache is disabled
+    ///
+    /// \see setCacheDirectory
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::string getCacheDirectory();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters of the program binary cache
+    ///
+    /// The compile time accounts for all the programs compiled
+    /// from source, whether the cache is enabled or not.
+    ///
+    /// \return Cache hits and misses, and the time spent loading and compiling programs
+    ///
+    /// \see setCacheDirectory
+    ///
+    ////////////////////////////////////////////////////////////
+    static CacheStatistics getCacheStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the system supports program binaries
+    ///
+    /// \return True if the program binary cache can be used, false otherwise
+    ///
+    /// \see setCacheDirectory
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isCacheAvailable();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -708,14 +1260,92 @@ private:
     ////////////////////////////////////////////////////////////
     bool compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit the compilation of the shader(s) and return immediately
+    ///
+    /// If one of the arguments is NULL, the corresponding shader
+    /// is not created.
+    ///
+    /// \param vertexShaderCode   Source code of the vertex shader
+    /// \param geometryShaderCode Source code of the geometry shader
+    /// \param fragmentShaderCode Source code of the fragment shader
+    ///
+    /// \return True if the compilation was submitted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool compileAsync(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the program and reset the internal state
+    ///
+    /// A load in progress is waited for and discarded.
+    ///
+    ////////////////////////////////////////////////////////////
+    void unload();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Adopt the program of an asynchronous load if it has finished
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateAsyncLoad() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader to draw with in place of this one
+    ///
+    /// \return This shader if it's ready, else the first ready shader of its fallbacks, or null
+    ///
+    ////////////////////////////////////////////////////////////
+    const Shader* getReadyShader() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether GLSL programs can be compiled and bound
+    ///
+    /// Unlike isAvailable(), this doesn't require multitexturing,
+    /// which is only needed to bind the textures of sampler
+    /// uniforms. Used by the programmable pipeline.
+    ///
+    /// \return True if GLSL programs are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isProgramAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a shader for rendering
+    ///
+    /// The rendering classes of SFML keep the state cache in
+    /// sync, so they let it skip the calls which would not
+    /// change anything.
+    ///
+    /// \param shader          Shader to bind, can be null to use no shader
+    /// \param force           Call OpenGL even if the state cache knows the bindings, as for user code
+    /// \param textureMatrices Load the texture matrices of the textures, which shaders
+    ///                        written for the programmable pipeline don't read
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const Shader* shader, bool force, bool textureMatrices);
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind all the textures used by the shader
     ///
     /// This function each texture to a different unit, and
     /// updates the corresponding variables in the shader accordingly.
     ///
+    /// \param force           Call OpenGL even if the state cache knows the bindings
+    /// \param textureMatrices Load the texture matrices of the textures
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindTextures(bool force, bool textureMatrices) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind all the uniform buffers used by the shader
+    ///
+    /// Each uniform block is bound to the binding point that
+    /// matches its index in the program.
+    ///
+    /// \param force Call OpenGL even if the state cache knows the bindings
+    ///
     ////////////////////////////////////////////////////////////
-    void bindTextures() const;
+    void bindUniformBlocks(bool force) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get the location ID of a shader uniform
@@ -727,6 +1357,56 @@ private:
     ////////////////////////////////////////////////////////////
     int getUniformLocation(const std::string& name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of uniform values
+    ///
+    ////////////////////////////////////////////////////////////
+    enum UniformType
+    {
+        Float1,  ///< float, or float array
+        Float2,  ///< vec2, or vec2 array
+        Float3,  ///< vec3, or vec3 array
+        Float4,  ///< vec4, or vec4 array
+        Int1,    ///< int or bool
+        Int2,    ///< ivec2 or bvec2
+        Int3,    ///< ivec3 or bvec3
+        Int4,    ///< ivec4 or bvec4
+        Matrix3, ///< mat3, or mat3 array
+        Matrix4  ///< mat4, or mat4 array
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the value of a uniform, now or at bind time
+    ///
+    /// \param handle Handle of the uniform
+    /// \param type   Type of the value
+    /// \param floats Components of a float type, null for integer types
+    /// \param ints   Components of an integer type, null for float types
+    /// \param count  Number of array elements
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformValue(UniformHandle handle, UniformType type, const float* floats, const int* ints, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the deferred uniforms that changed
+    ///
+    /// The program of the shader must be current.
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadDeferredUniforms() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload a uniform value to the current program
+    ///
+    /// \param location Location of the uniform
+    /// \param type     Type of the value
+    /// \param floats   Components of a float type, null for integer types
+    /// \param ints     Components of an integer type, null for float types
+    /// \param count    Number of array elements
+    ///
+    ////////////////////////////////////////////////////////////
+    static void uploadUniform(int location, UniformType type, const float* floats, const int* ints, std::size_t count);
+
     ////////////////////////////////////////////////////////////
     /// \brief RAII object to save and restore the program
     ///        binding while uniforms are being set
@@ -736,19 +1416,46 @@ private:
     ////////////////////////////////////////////////////////////
     struct UniformBinder;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compilation of a program in progress
+    ///
+    /// Implementation is private in the .cpp file.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct AsyncLoad;
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
+    struct DeferredUniform
+    {
+        UniformType        type;   ///< Type of the value
+        std::size_t        count;  ///< Number of array elements
+        std::vector<float> floats; ///< Components of a float type
+        std::vector<int>   ints;   ///< Components of an integer type
+        bool               dirty;  ///< Has the value changed since it was last uploaded?
+    };
+
     typedef std::map<int, const Texture*> TextureTable;
     typedef std::map<std::string, int> UniformTable;
+    typedef std::map<int, DeferredUniform> DeferredTable;
+    typedef std::map<unsigned int, const UniformBuffer*> UniformBlockTable;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  ///< OpenGL identifier for the program
-    int          m_currentTexture; ///< Location of the current texture in the shader
-    TextureTable m_textures;       ///< Texture variables in the shader, mapped to their location
-    UniformTable m_uniforms;       ///< Parameters location cache
+    mutable unsigned int  m_shaderProgram;  ///< OpenGL identifier for the program
+    int                   m_currentTexture; ///< Location of the current texture in the shader
+    TextureTable          m_textures;       ///< Texture variables in the shader, mapped to their location
+    UniformTable          m_uniforms;       ///< Parameters location cache
+    UniformBlockTable     m_uniformBlocks;  ///< Uniform buffers used by the shader, mapped to their block index
+    bool                  m_deferUniforms;  ///< Are uniform uploads deferred to bind time?
+    mutable DeferredTable m_deferred;       ///< Values of the deferred uniforms, mapped to their location
+    mutable bool          m_deferredDirty;  ///< Do some deferred uniforms need to be uploaded?
+    mutable Status        m_status;         ///< Loading state of the program
+    mutable AsyncLoad*    m_async;          ///< Asynchronous load in progress, if any
+    const Shader*         m_fallback;       ///< Shader used while this one is not ready
+    mutable int           m_pipelineLocations[4]; ///< Locations of the uniforms set by the programmable pipeline, -2 until queried
 };
 
 } // namespace sf
@@ -817,6 +1524,18 @@ private:
 /// The old setParameter() overloads are deprecated and will be removed in a
 /// future version. You should use their setUniform() equivalents instead.
 ///
+/// Uniforms that change often, such as per-object parameters,
+/// are cheaper to set through handles obtained once with
+/// getUniformHandle(). Combined with setUniformUploadDeferred(),
+/// setting a uniform only stores its value, and the values
+/// that changed are uploaded together when the shader is bound:
+/// \code
+/// sf::Shader::UniformHandle offset = shader.getUniformHandle("offset");
+/// shader.setUniformUploadDeferred(true);
+/// ...
+/// shader.setUniform(offset, 2.f);
+/// \endcode
+///
 /// The special Shader::CurrentTexture argument maps the
 /// given \p sampler2D uniform to the current texture of the
 /// object being drawn (which cannot be known in advance).
@@ -861,6 +1580,22 @@ private:
 /// second one doesn't impact the rendering process and can be
 /// easily inserted anywhere without impacting all the code.
 ///
+/// Compiling big shaders can take a while. loadAsync() submits
+/// the compilation and returns immediately, so that the
+/// application keeps running while the driver works; until
+/// the shader is ready, drawing with it uses its fallback:
+/// \code
+/// sf::Shader simple;
+/// simple.loadFromMemory(simpleCode, sf::Shader::Fragment);
+///
+/// sf::Shader fancy;
+/// fancy.setFallback(&simple);
+/// fancy.loadAsync(fancyCode, sf::Shader::Fragment);
+///
+/// // Drawn with "simple" until "fancy" is ready
+/// window.draw(sprite, &fancy);
+/// \endcode
+///
 /// Like sf::Texture that can be used as a raw OpenGL texture,
 /// sf::Shader can also be used directly as a raw shader for
 /// custom OpenGL geometry.
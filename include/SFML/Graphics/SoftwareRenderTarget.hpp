@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOFTWARERENDERTARGET_HPP
+#define SFML_SOFTWARERENDERTARGET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Target for 2D rendering on the CPU, into an image
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SoftwareRenderTarget : public RenderTarget
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs an empty target. You must call create to
+    /// have a valid target.
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    SoftwareRenderTarget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~SoftwareRenderTarget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the target
+    ///
+    /// The content of the target is transparent black, and the
+    /// view is reset to the default view of the new size.
+    ///
+    /// \param width  Width of the target, in pixels
+    /// \param height Height of the target, in pixels
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads used for rasterization
+    ///
+    /// The target is split into tiles which are rasterized in
+    /// parallel. With a count of 1, rasterization happens on
+    /// the calling thread only. The default is 4.
+    ///
+    /// \param count Number of threads
+    ///
+    /// \see getThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads used for rasterization
+    ///
+    /// \return Number of threads
+    ///
+    /// \see setThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the contents of the target image
+    ///
+    /// Draw calls are batched; this function rasterizes them
+    /// and copies the result to the image returned by getImage.
+    ///
+    ////////////////////////////////////////////////////////////
+    void display();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the target
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the image holding the rendered pixels
+    ///
+    /// The image is updated by display() only.
+    ///
+    /// \return Const reference to the target image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image& getImage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate the target for rendering
+    ///
+    /// A software target has no OpenGL context, there is
+    /// nothing to activate.
+    ///
+    /// \param active True to activate, false to deactivate
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setActive(bool active = true);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Image m_image; ///< Pixels of the last displayed frame
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOFTWARERENDERTARGET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoftwareRenderTarget
+/// \ingroup graphics
+///
+/// sf::SoftwareRenderTarget renders into an sf::Image with a
+/// rasterizer running on the CPU. It needs no window and no
+/// OpenGL context, which makes it usable on machines without
+/// a GPU or a display, for example to generate thumbnails or
+/// golden images in continuous integration.
+///
+/// It supports every primitive type, every blend mode, views
+/// and viewports, and textured vertices with smooth and
+/// repeated textures, so sprites, shapes, texts and vertex
+/// arrays render the same way as on a GPU target, apart
+/// from small rasterization differences.
+///
+/// Limitations:
+/// \li Shaders are ignored
+/// \li Vertex and index buffers are read back from graphics memory every time
+///     they are drawn, and cannot be drawn at all on OpenGL ES
+/// \li Textures are sf::Texture objects, which are copied back from graphics memory
+///     the first time they are drawn and every time they change; copies of the
+///     textures not drawn during a frame are released by display(). Creating
+///     them still requires an OpenGL implementation, which may be a software one
+///
+/// Draw calls are batched and rasterized in parallel tiles
+/// when display() is called, see setThreadCount.
+///
+/// Usage example:
+/// \code
+/// sf::SoftwareRenderTarget target;
+/// if (!target.create(256, 256))
+///     return -1;
+///
+/// target.clear(sf::Color::White);
+///
+/// sf::CircleShape circle(100.f);
+/// circle.setFillColor(sf::Color::Red);
+/// target.draw(circle);
+///
+/// target.display();
+/// target.getImage().saveToFile("thumbnail.png");
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::RenderTexture, sf::Image
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SPATIALINDEX_HPP
+#define SFML_SPATIALINDEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Spatial index of drawables, to draw only the
+///        visible ones
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpatialIndex : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param cellSize Size of the cells of the grid, in world units
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpatialIndex(float cellSize = 256.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a drawable to the index
+    ///
+    /// The index doesn't copy the drawable, it only keeps a
+    /// pointer to it: it must be kept alive as long as it is
+    /// in the index.
+    ///
+    /// \param drawable Drawable to add
+    /// \param bounds   Global bounds of the drawable, usually the result of its getGlobalBounds() function
+    ///
+    /// \return Identifier of the drawable in the index
+    ///
+    /// \see update, remove
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t insert(const Drawable& drawable, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the bounds of a drawable of the index
+    ///
+    /// Call this function after the drawable has moved or
+    /// changed size. Moving within the same cells only
+    /// updates the stored bounds.
+    ///
+    /// \param id     Identifier returned by insert()
+    /// \param bounds New global bounds of the drawable
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(std::size_t id, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a drawable from the index
+    ///
+    /// The identifier becomes invalid, and may be returned
+    /// again by a later call to insert().
+    ///
+    /// \param id Identifier returned by insert()
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(std::size_t id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the drawables from the index
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of drawables in the index
+    ///
+    /// \return Number of drawables
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the stored bounds of a drawable
+    ///
+    /// \param id Identifier returned by insert()
+    ///
+    /// \return Global bounds of the drawable
+    ///
+    ////////////////////////////////////////////////////////////
+    const FloatRect& getBounds(std::size_t id) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the drawables which intersect a rectangle
+    ///
+    /// The drawables are returned in the order in which they
+    /// were inserted, which is the order in which they must be
+    /// drawn. Reusing the same vector across calls avoids
+    /// allocations.
+    ///
+    /// \param area      Rectangle to test, in world coordinates
+    /// \param drawables Vector filled with the drawables found, cleared first
+    ///
+    ////////////////////////////////////////////////////////////
+    void query(const FloatRect& area, std::vector<const Drawable*>& drawables) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the drawables visible in a view
+    ///
+    /// The area tested is the bounding rectangle of the view,
+    /// rotated views included.
+    ///
+    /// \param view      View to test
+    /// \param drawables Vector filled with the drawables found, cleared first
+    ///
+    ////////////////////////////////////////////////////////////
+    void query(const View& view, std::vector<const Drawable*>& drawables) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the drawables visible in the current view of the target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the range of cells covered by a rectangle
+    ///
+    /// \param area   Rectangle, in world coordinates
+    /// \param left   Receives the first column
+    /// \param top    Receives the first row
+    /// \param right  Receives the last column
+    /// \param bottom Receives the last row
+    ///
+    ////////////////////////////////////////////////////////////
+    void getCellRange(const FloatRect& area, int& left, int& top, int& right, int& bottom) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an item to the cells covered by its bounds
+    ///
+    /// \param id Identifier of the item
+    ///
+    ////////////////////////////////////////////////////////////
+    void link(std::size_t id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an item from the cells it was added to
+    ///
+    /// \param id Identifier of the item
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlink(std::size_t id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Test an item against the area of a query
+    ///
+    /// \param id   Identifier of the item
+    /// \param area Area of the query
+    ///
+    ////////////////////////////////////////////////////////////
+    void testItem(std::size_t id, const FloatRect& area) const;
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::pair<int, int> CellKey;
+    typedef std::vector<std::size_t> Cell;
+    typedef std::map<CellKey, Cell> CellMap;
+
+    struct Item
+    {
+        const Drawable* drawable;  ///< Indexed drawable, null for a free slot
+        FloatRect       bounds;    ///< Global bounds of the drawable
+        int             left;      ///< First column of the covered cells
+        int             top;       ///< First row of the covered cells
+        int             right;     ///< Last column of the covered cells
+        int             bottom;    ///< Last row of the covered cells
+        bool            large;     ///< Does the item cover too many cells to be stored in them?
+        Uint64          order;     ///< Insertion number, to return the drawables in drawing order
+        mutable Uint64  lastQuery; ///< Number of the last query which tested the item
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    float                                m_cellSize;  ///< Size of the cells, in world units
+    CellMap                              m_cells;     ///< Non-empty cells, containing item identifiers
+    Cell                                 m_large;     ///< Items covering too many cells, tested by every query
+    std::vector<Item>                    m_items;     ///< Items, indexed by identifier
+    std::vector<std::size_t>             m_freeIds;   ///< Identifiers of the free item slots
+    std::size_t                          m_count;     ///< Number of drawables in the index
+    Uint64                               m_nextOrder; ///< Insertion number of the next drawable
+    mutable Uint64                       m_query;     ///< Number of the current query
+    mutable std::vector<std::size_t>     m_found;     ///< Identifiers found by the current query
+    mutable std::vector<const Drawable*> m_visible;   ///< Drawables visible in the last draw
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPATIALINDEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpatialIndex
+/// \ingroup graphics
+///
+/// When a scene contains many more drawables than what fits
+/// on screen, submitting all of them every frame wastes time
+/// transforming and rasterizing vertices that end up outside
+/// the view. sf::SpatialIndex stores drawables along with
+/// their bounds, and finds the ones that intersect an area or
+/// a view without testing all of them.
+///
+/// The index is a uniform grid: each drawable is registered
+/// in the cells covered by its bounds, and only the cells
+/// covered by a query are visited. The grid is unbounded,
+/// only the cells which contain something use memory. The
+/// cell size should be a few times the size of a typical
+/// drawable; drawables covering too many cells are kept
+/// in a separate list, tested by every query.
+///
+/// The index doesn't know when a drawable moves: call
+/// update() with its new bounds. The index doesn't own the
+/// drawables either, they must outlive their entry.
+///
+/// Drawing the index draws the drawables that are visible in
+/// the current view of the target, in insertion order. When
+/// the view that will be used is not known yet (see
+/// sf::RenderTarget::isViewKnown), all of them are drawn.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::Sprite> trees(100000);
+/// sf::SpatialIndex index(512.f);
+///
+/// std::vector<std::size_t> ids(trees.size());
+/// for (std::size_t i = 0; i < trees.size(); ++i)
+/// {
+///     trees[i].setTexture(texture);
+///     trees[i].setPosition(...);
+///     ids[i] = index.insert(trees[i], trees[i].getGlobalBounds());
+/// }
+///
+/// // A tree moved
+/// trees[42].move(10.f, 0.f);
+/// index.update(ids[42], trees[42].getGlobalBounds());
+///
+/// // Draw only the trees visible in the current view
+/// window.draw(index);
+/// \endcode
+///
+/// \see sf::View, sf::SceneNode
+///
+////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/GraphicsMemory.hpp>
 #include <SFML/Window/GlResource.hpp>
 
 
@@ -86,15 +87,25 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Create the texture
     ///
+    /// The \a format argument selects how the pixels are stored
+    /// in graphics memory. Compact formats such as Image::R8 use
+    /// less video memory and bandwidth than the default RGBA8
+    /// format. If the graphics driver doesn't support the requested
+    /// format, the texture falls back to RGBA8 and the pixels are
+    /// converted when they are uploaded.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param width  Width of the texture
     /// \param height Height of the texture
+    /// \param format Pixel format of the texture
     ///
     /// \return True if creation was successful
     ///
+    /// \see getPixelFormat
+    ///
     ////////////////////////////////////////////////////////////
-    bool create(unsigned int width, unsigned int height);
+    bool create(unsigned int width, unsigned int height, Image::PixelFormat format = Image::RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a file on disk
@@ -199,6 +210,8 @@ public:
     /// If the \a area rectangle crosses the bounds of the image, it
     /// is adjusted to fit the image size.
     ///
+    /// The texture is created with the pixel format of the image.
+    ///
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
@@ -222,6 +235,34 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the pixel format of the texture
+    ///
+    /// This is the format actually used by the texture, which
+    /// is RGBA8 if the format requested in create was not
+    /// supported by the graphics driver.
+    ///
+    /// \return Pixel format of the texture
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    Image::PixelFormat getPixelFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the amount of graphics memory used by the texture
+    ///
+    /// The returned value includes the padding added when the
+    /// graphics card doesn't support non-power-of-two textures,
+    /// and the mipmap levels if they were generated.
+    ///
+    /// \return Estimated memory usage, in bytes
+    ///
+    /// \see GraphicsMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getMemoryUsage() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the texture pixels to an image
     ///
@@ -229,6 +270,7 @@ public:
     /// the texture's pixels from the graphics card and copies
     /// them to a new image, potentially applying transformations
     /// to pixels if necessary (texture may be padded or flipped).
+    /// The returned image is always in RGBA8 format.
     ///
     /// \return Image containing the texture's pixels
     ///
@@ -241,7 +283,8 @@ public:
     /// \brief Update the whole texture from an array of pixels
     ///
     /// The \a pixel array is assumed to have the same size as
-    /// the \a area rectangle, and to contain 32-bits RGBA pixels.
+    /// the \a area rectangle, and to contain pixels in the format
+    /// of the texture (see getPixelFormat).
     ///
     /// No additional check is performed on the size of the pixel
     /// array, passing invalid arguments will lead to an undefined
@@ -259,7 +302,8 @@ public:
     /// \brief Update a part of the texture from an array of pixels
     ///
     /// The size of the \a pixel array must match the \a width and
-    /// \a height arguments, and it must contain 32-bits RGBA pixels.
+    /// \a height arguments, and it must contain pixels in the
+    /// format of the texture (see getPixelFormat).
     ///
     /// No additional check is performed on the size of the pixel
     /// array or the bounds of the area to update, passing invalid
@@ -545,6 +589,10 @@ public:
     /// used when drawing SFML entities. It must be used only if you
     /// mix sf::Texture with OpenGL code.
     ///
+    /// This function always calls OpenGL, even when the texture
+    /// is already bound, so it can be used after changing the
+    /// OpenGL bindings directly.
+    ///
     /// \code
     /// sf::Texture t1, t2;
     /// ...
@@ -586,8 +634,20 @@ public:
 private:
 
     friend class Text;
+    friend class Font;
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class Shader;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a texture for rendering
+    ///
+    /// \param texture        Pointer to the texture to bind, can be null to use no texture
+    /// \param coordinateType Type of texture coordinates to use
+    /// \param force          Call OpenGL even if the state cache knows the binding, as for user code
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const Texture* texture, CoordinateType coordinateType, bool force);
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -613,19 +673,44 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the graphics memory held by the texture
+    ///
+    /// \param bytes   Total number of bytes allocated
+    /// \param padding Part of \a bytes wasted in padding
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMemoryUsage(Uint64 bytes, Uint64 padding);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the matrix applied to the texture coordinates
+    ///
+    /// The matrix converts pixel coordinates to normalized ones if
+    /// requested, and flips the Y axis of render texture contents.
+    ///
+    /// \param coordinateType Type of texture coordinates to use
+    /// \param matrix         Array of 16 floats receiving the matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void getTextureMatrix(CoordinateType coordinateType, float* matrix) const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u     m_size;          ///< Public texture size
-    Vector2u     m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
-    unsigned int m_texture;       ///< Internal texture identifier
-    bool         m_isSmooth;      ///< Status of the smooth filter
-    bool         m_sRgb;          ///< Should the texture source be converted from sRGB?
-    bool         m_isRepeated;    ///< Is the texture in repeat mode?
-    mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
-    bool         m_fboAttachment; ///< Is this texture owned by a framebuffer object?
-    bool         m_hasMipmap;     ///< Has the mipmap been generated?
-    Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    Vector2u                 m_size;           ///< Public texture size
+    Vector2u                 m_actualSize;     ///< Actual texture size (can be greater than public size because of padding)
+    Image::PixelFormat       m_format;         ///< Pixel format of the texture
+    unsigned int             m_texture;        ///< Internal texture identifier
+    bool                     m_isSmooth;       ///< Status of the smooth filter
+    bool                     m_sRgb;           ///< Should the texture source be converted from sRGB?
+    bool                     m_isRepeated;     ///< Is the texture in repeat mode?
+    mutable bool             m_pixelsFlipped;  ///< To work around the inconsistency in Y orientation
+    bool                     m_fboAttachment;  ///< Is this texture owned by a framebuffer object?
+    bool                     m_hasMipmap;      ///< Has the mipmap been generated?
+    Uint64                   m_cacheId;        ///< Unique number that identifies the texture to the render target's cache
+    GraphicsMemory::Category m_memoryCategory; ///< Category in which the memory of the texture is accounted
+    Uint64                   m_memoryUsage;    ///< Number of bytes allocated for the texture
+    Uint64                   m_memoryPadding;  ///< Part of the allocated bytes wasted in padding
 };
 
 } // namespace sf
@@ -668,10 +753,14 @@ private:
 /// store the collision information separately, for example in an array
 /// of booleans.
 ///
-/// Like sf::Image, sf::Texture can handle a unique internal
-/// representation of pixels, which is RGBA 32 bits. This means
-/// that a pixel must be composed of 8 bits red, green, blue and
-/// alpha channels -- just like a sf::Color.
+/// Like sf::Image, sf::Texture stores RGBA 32 bits pixels by
+/// default. This means that a pixel is composed of 8 bits red,
+/// green, blue and alpha channels -- just like a sf::Color.
+/// Textures can also use the compact formats of sf::Image
+/// (see Image::PixelFormat), which is useful to save video
+/// memory for masks, heightmaps or data textures. Missing
+/// channels are read as 0 for green and blue and 1 for alpha
+/// in shaders.
 ///
 /// Usage example:
 /// \code
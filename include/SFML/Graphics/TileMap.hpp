@@ -0,0 +1,320 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TILEMAP_HPP
+#define SFML_TILEMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexFormat.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Grid of tiles taken from a tileset texture, drawn
+///        in chunks
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TileMap : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const Uint32 Empty; ///< Tile value for cells which display nothing
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty map, with no tiles nor tileset.
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the map
+    ///
+    /// All the tiles of the new map are empty. The chunk size
+    /// is the number of tiles along each side of a chunk, it is
+    /// clamped to [1, 128].
+    ///
+    /// \param size      Size of the map, in tiles
+    /// \param tileSize  Size of a tile, in pixels
+    /// \param chunkSize Size of a chunk, in tiles
+    ///
+    /// \return True if the map was created, false if a size is null
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(const Vector2u& size, const Vector2u& tileSize, unsigned int chunkSize = 32);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the tileset texture
+    ///
+    /// The tiles are numbered from left to right, then from top
+    /// to bottom, starting at 0 in the top-left corner of the
+    /// texture. The texture must exist as long as the map uses
+    /// it, the map only keeps a pointer to it.
+    ///
+    /// \param tileset New tileset texture
+    ///
+    /// \see getTileset
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTileset(const Texture& tileset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the tileset texture
+    ///
+    /// \return Pointer to the tileset, or null if no tileset was set
+    ///
+    /// \see setTileset
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTileset() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a tile
+    ///
+    /// Only the chunk containing the tile is rebuilt, the next
+    /// time it is drawn. This function does nothing if the
+    /// coordinates are outside the map.
+    ///
+    /// \param x    X coordinate of the tile
+    /// \param y    Y coordinate of the tile
+    /// \param tile Index of the tile in the tileset, or TileMap::Empty
+    ///
+    /// \see getTile
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTile(unsigned int x, unsigned int y, Uint32 tile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a tile
+    ///
+    /// \param x X coordinate of the tile
+    /// \param y Y coordinate of the tile
+    ///
+    /// \return Index of the tile in the tileset, TileMap::Empty if the tile is empty or outside the map
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getTile(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change all the tiles of the map
+    ///
+    /// \a tiles must contain getSize().x * getSize().y values,
+    /// stored row by row.
+    ///
+    /// \param tiles Indices of the tiles in the tileset, or TileMap::Empty
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTiles(const Uint32* tiles);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the map
+    ///
+    /// \return Size of the map, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2u& getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a tile
+    ///
+    /// \return Size of a tile, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2u& getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the chunks
+    ///
+    /// \return Size of a chunk, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChunkSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the map
+    ///
+    /// The returned rectangle is in local coordinates, which means
+    /// that it ignores the transformations (translation, rotation,
+    /// scale, ...) that are applied to the entity.
+    ///
+    /// \return Local bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the map
+    ///
+    /// The returned rectangle is in global coordinates, which means
+    /// that it takes into account the transformations (translation,
+    /// rotation, scale, ...) that are applied to the entity.
+    ///
+    /// \return Global bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible chunks of the map to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Chunk of tiles, with its geometry
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Chunk
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Chunk();
+
+        std::vector<Uint32> tiles;     ///< Tiles of the chunk, row by row
+        VertexBuffer        buffer;    ///< Quads of the non-empty tiles, in graphics memory
+        std::vector<Vertex> vertices;  ///< Quads of the non-empty tiles, when vertex buffers are not available
+        std::size_t         tileCount; ///< Number of non-empty tiles in the geometry
+        bool                dirty;     ///< Must the geometry be rebuilt?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the geometry of a chunk
+    ///
+    /// The geometry is relative to the top-left corner of the chunk.
+    ///
+    /// \param chunk      Chunk to rebuild
+    /// \param useBuffers Store the geometry in a vertex buffer?
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateChunk(Chunk& chunk, bool useBuffers) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the vertex format of the chunk buffers
+    ///
+    /// \return Most compact format able to store the geometry exactly
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexFormat getChunkFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the geometry of all the chunks as outdated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateChunks() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u                    m_size;        ///< Size of the map, in tiles
+    Vector2u                    m_tileSize;    ///< Size of a tile, in pixels
+    unsigned int                m_chunkSize;   ///< Size of a chunk, in tiles
+    Vector2u                    m_chunkCount;  ///< Number of chunks along each axis
+    const Texture*              m_tileset;     ///< Tileset texture
+    mutable std::vector<Chunk>  m_chunks;      ///< Chunks, row by row, rebuilt when drawn
+    mutable IndexBuffer         m_indices;     ///< Indices of the quads of a full chunk, shared by all the chunks
+    mutable std::vector<Uint16> m_quadIndices; ///< Indices of the quads of a full chunk, when vertex buffers are not available
+    mutable std::vector<Vertex> m_scratch;     ///< Geometry of the chunk being rebuilt
+    mutable Vector2u            m_tilesetSize; ///< Size of the tileset when the chunks were built
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEMAP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TileMap
+/// \ingroup graphics
+///
+/// sf::TileMap displays a grid of tiles, all of the same
+/// size, taken from a single tileset texture.
+///
+/// The map is split into square chunks. The geometry of each
+/// chunk is kept in a static vertex buffer, in a compact
+/// vertex format when the tile and tileset sizes allow it,
+/// and drawn with an index buffer shared by all the chunks.
+/// Changing a tile only marks its chunk as outdated; outdated
+/// chunks are rebuilt and uploaded again the next time they
+/// are visible. Drawing the map only visits the chunks that
+/// intersect the current view of the target: the cost of
+/// drawing a map depends on the size of the view, not on the
+/// size of the map. When the view that will be used is not
+/// known yet (see sf::RenderTarget::isViewKnown), all the
+/// chunks are drawn.
+///
+/// Chunks that were never visible don't use any graphics
+/// memory. A larger chunk size means fewer draw calls, a
+/// smaller one means cheaper updates and tighter culling.
+///
+/// When vertex buffers are not available, or a chunk can't be
+/// uploaded to one, the chunks are kept in system memory and
+/// drawn as vertex arrays.
+///
+/// Usage example:
+/// \code
+/// sf::Texture tileset;
+/// tileset.loadFromFile("tileset.png");
+///
+/// sf::TileMap map;
+/// map.create(sf::Vector2u(4096, 4096), sf::Vector2u(16, 16));
+/// map.setTileset(tileset);
+/// map.setTiles(&level[0]);
+///
+/// // Open a door: only one chunk is rebuilt
+/// map.setTile(10, 20, openDoorTile);
+///
+/// window.draw(map);
+/// \endcode
+///
+/// \see sf::Texture, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
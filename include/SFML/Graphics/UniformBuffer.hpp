@@ -0,0 +1,458 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_UNIFORMBUFFER_HPP
+#define SFML_UNIFORMBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Glsl.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Uniform block storage shared by several shaders
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API UniformBuffer : private GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty uniform buffer.
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformBuffer(const UniformBuffer& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~UniformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the uniform buffer
+    ///
+    /// Creates the uniform buffer and allocates \p size bytes
+    /// of graphics memory, filled with zeros. Any previously
+    /// allocated memory is freed in the process.
+    ///
+    /// The size of a block declared with the std140 layout
+    /// can be computed with sf::Glsl::Std140.
+    ///
+    /// \param size Size of the buffer, in bytes
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the buffer
+    ///
+    /// \return Size of the buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p float member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param x      Value of the float scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec2 member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param vector Value of the vec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, const Glsl::Vec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec3 member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param vector Value of the vec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, const Glsl::Vec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec4 member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param vector Value of the vec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, const Glsl::Vec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p int member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param x      Value of the int scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, int x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec2 member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param vector Value of the ivec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, const Glsl::Ivec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec3 member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param vector Value of the ivec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, const Glsl::Ivec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec4 member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param vector Value of the ivec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, const Glsl::Ivec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bool member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param x      Value of the bool scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, bool x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec2 member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param vector Value of the bvec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, const Glsl::Bvec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec3 member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param vector Value of the bvec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, const Glsl::Bvec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec4 member
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param vector Value of the bvec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, const Glsl::Bvec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat3 matrix
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param matrix Value of the mat3 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, const Glsl::Mat3& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat4 matrix
+    ///
+    /// \param offset Offset of the member in the block, in bytes
+    /// \param matrix Value of the mat4 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(std::size_t offset, const Glsl::Mat4& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p float[] array member
+    ///
+    /// \param offset      Offset of the array in the block, in bytes
+    /// \param scalarArray pointer to array of \p float values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(std::size_t offset, const float* scalarArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec2[] array member
+    ///
+    /// \param offset      Offset of the array in the block, in bytes
+    /// \param vectorArray pointer to array of \p vec2 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(std::size_t offset, const Glsl::Vec2* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec3[] array member
+    ///
+    /// \param offset      Offset of the array in the block, in bytes
+    /// \param vectorArray pointer to array of \p vec3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(std::size_t offset, const Glsl::Vec3* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec4[] array member
+    ///
+    /// \param offset      Offset of the array in the block, in bytes
+    /// \param vectorArray pointer to array of \p vec4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(std::size_t offset, const Glsl::Vec4* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p mat3[] array member
+    ///
+    /// \param offset      Offset of the array in the block, in bytes
+    /// \param matrixArray pointer to array of \p mat3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(std::size_t offset, const Glsl::Mat3* matrixArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p mat4[] array member
+    ///
+    /// \param offset      Offset of the array in the block, in bytes
+    /// \param matrixArray pointer to array of \p mat4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(std::size_t offset, const Glsl::Mat4* matrixArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy raw bytes to the buffer
+    ///
+    /// This function is useful to fill the buffer from a C++
+    /// structure that already follows the layout of the block.
+    ///
+    /// \param data   Bytes to copy
+    /// \param size   Number of bytes to copy
+    /// \param offset Offset in the buffer to copy to, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setData(const void* data, std::size_t size, std::size_t offset = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformBuffer& operator =(const UniformBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this uniform buffer with those of another
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(UniformBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the amount of graphics memory used by the uniform buffer
+    ///
+    /// \return Estimated memory usage, in bytes
+    ///
+    /// \see GraphicsMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getMemoryUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the uniform buffer.
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the uniform buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a uniform buffer to a uniform buffer binding point
+    ///
+    /// The values changed since the last time the buffer was
+    /// bound are uploaded first.
+    ///
+    /// This function is not part of the graphics API, it mustn't be
+    /// used when drawing SFML entities. It must be used only if you
+    /// mix sf::UniformBuffer with OpenGL code.
+    ///
+    /// This function always calls OpenGL, even when the buffer
+    /// is already bound, so it can be used after changing the
+    /// OpenGL bindings directly.
+    ///
+    /// \param uniformBuffer Pointer to the uniform buffer to bind, can be null to use no uniform buffer
+    /// \param binding       Index of the binding point
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const UniformBuffer* uniformBuffer, unsigned int binding);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports uniform buffers
+    ///
+    /// This function should always be called before using
+    /// the uniform buffer features. If it returns false, then
+    /// any attempt to use sf::UniformBuffer will fail.
+    ///
+    /// \return True if uniform buffers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    friend class Shader;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a uniform buffer to a uniform buffer binding point
+    ///
+    /// \param uniformBuffer Pointer to the uniform buffer to bind, can be null to use no uniform buffer
+    /// \param binding       Index of the binding point
+    /// \param force         Call OpenGL even if the state cache knows the binding, as for user code
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const UniformBuffer* uniformBuffer, unsigned int binding, bool force);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy values to the local copy of the buffer
+    ///
+    /// \param offset  Offset in the buffer to copy to, in bytes
+    /// \param data    Values to copy
+    /// \param size    Size of a single element, in bytes
+    /// \param stride  Distance between two elements in the buffer, in bytes
+    /// \param count   Number of elements to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    void write(std::size_t offset, const void* data, std::size_t size, std::size_t stride, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the values that changed to graphics memory
+    ///
+    ////////////////////////////////////////////////////////////
+    void upload() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int        m_buffer;     ///< Internal buffer identifier
+    std::vector<Uint8>  m_data;       ///< Local copy of the contents of the buffer
+    mutable std::size_t m_dirtyBegin; ///< Beginning of the range of bytes that changed since the last upload
+    mutable std::size_t m_dirtyEnd;   ///< End of the range of bytes that changed since the last upload
+};
+
+} // namespace sf
+
+
+#endif // SFML_UNIFORMBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::UniformBuffer
+/// \ingroup graphics
+///
+/// sf::UniformBuffer stores the values of a GLSL uniform block
+/// in graphics memory. The same buffer can be attached to any
+/// number of shaders with sf::Shader::setUniformBlock: values
+/// that are common to many shaders, like a camera or the
+/// lights of a scene, are then set and uploaded once for all
+/// of them, and switching from one shader to another doesn't
+/// upload them again.
+///
+/// Values are written to a local copy of the buffer, at the
+/// offsets of the members of the block. Changes are sent to
+/// graphics memory in one go, the next time a shader using
+/// the buffer is bound. The offsets of the members of a block
+/// declared with the std140 layout are given by sf::Glsl::Std140.
+///
+/// Uniform buffers require OpenGL 3.1 or the
+/// GL_ARB_uniform_buffer_object extension, check isAvailable()
+/// before using them.
+///
+/// Example:
+/// \code
+/// // GLSL: layout(std140) uniform Scene { mat4 view; vec4 ambient; float time; };
+/// sf::Glsl::Std140 layout;
+/// std::size_t view    = layout.add(sf::Glsl::Std140::Mat4);
+/// std::size_t ambient = layout.add(sf::Glsl::Std140::Vec4);
+/// std::size_t time    = layout.add(sf::Glsl::Std140::Float);
+///
+/// sf::UniformBuffer scene;
+/// scene.create(layout.getSize());
+///
+/// for (std::size_t i = 0; i < shaders.size(); ++i)
+///     shaders[i].setUniformBlock("Scene", scene);
+///
+/// // Once per frame, for all the shaders
+/// scene.setUniform(view, sf::Glsl::Mat4(camera.getTransform()));
+/// scene.setUniform(ambient, sf::Glsl::Vec4(sf::Color(40, 40, 60)));
+/// scene.setUniform(time, clock.getElapsedTime().asSeconds());
+/// \endcode
+///
+/// \see sf::Shader, sf::Glsl::Std140
+///
+////////////////////////////////////////////////////////////
@@ -31,6 +31,7 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/VertexFormat.hpp>
 #include <SFML/Window/GlResource.hpp>
 
 
@@ -129,10 +130,16 @@ public:
     /// as \p vertexCount. Don't forget to recreate with a non-zero
     /// value when graphics memory should be allocated again.
     ///
+    /// The size of a vertex is given by the format of the buffer,
+    /// creation fails if the format is not supported by the
+    /// graphics driver.
+    ///
     /// \param vertexCount Number of vertices worth of memory to allocate
     ///
     /// \return True if creation was successful
     ///
+    /// \see setFormat
+    ///
     ////////////////////////////////////////////////////////////
     bool create(std::size_t vertexCount);
 
@@ -188,6 +195,9 @@ public:
     /// array, passing invalid arguments will lead to undefined
     /// behavior.
     ///
+    /// Vertices are converted to the format of the buffer
+    /// before being uploaded.
+    ///
     /// \param vertices    Array of vertices to copy to the buffer
     /// \param vertexCount Number of vertices to copy
     /// \param offset      Offset in the buffer to copy to
@@ -200,6 +210,8 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Copy the contents of another buffer into this buffer
     ///
+    /// Both buffers must have the same format.
+    ///
     /// \param vertexBuffer Vertex buffer whose contents to copy into this vertex buffer
     ///
     /// \return True if the copy was successful
@@ -225,6 +237,16 @@ public:
     ////////////////////////////////////////////////////////////
     void swap(VertexBuffer& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the amount of graphics memory used by the vertex buffer
+    ///
+    /// \return Estimated memory usage, in bytes
+    ///
+    /// \see GraphicsMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getMemoryUsage() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the underlying OpenGL handle of the vertex buffer.
     ///
@@ -283,6 +305,37 @@ public:
     ////////////////////////////////////////////////////////////
     Usage getUsage() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the format in which the vertices are stored
+    ///
+    /// A compact format reduces the graphics memory used by the
+    /// buffer and the bandwidth needed to draw it. Vertices passed
+    /// to update() are converted to this format.
+    ///
+    /// If the buffer was already created, it is reallocated with
+    /// the same vertex count and its contents are lost: it has
+    /// to be updated with new data.
+    ///
+    /// The default format is sf::VertexFormat::Default, the
+    /// layout of sf::Vertex.
+    ///
+    /// \param format New vertex format
+    ///
+    /// \return True if the format is supported by the graphics driver
+    ///
+    /// \see VertexFormat::isSupported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setFormat(const VertexFormat& format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the format in which the vertices are stored
+    ///
+    /// \return Vertex format
+    ///
+    ////////////////////////////////////////////////////////////
+    const VertexFormat& getFormat() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind a vertex buffer for rendering
     ///
@@ -290,6 +343,10 @@ public:
     /// used when drawing SFML entities. It must be used only if you
     /// mix sf::VertexBuffer with OpenGL code.
     ///
+    /// This function always calls OpenGL, even when the buffer
+    /// is already bound, so it can be used after changing the
+    /// OpenGL bindings directly.
+    ///
     /// \code
     /// sf::VertexBuffer vb1, vb2;
     /// ...
@@ -329,6 +386,24 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy a range of vertices back to client memory
+    ///
+    /// Vertices stored in a compact format are converted to
+    /// sf::Vertex. Reading buffers back is not supported on
+    /// OpenGL ES.
+    ///
+    /// \param firstVertex Index of the first vertex to read
+    /// \param vertexCount Number of vertices to read
+    /// \param vertices    Array receiving the vertices
+    ///
+    /// \return True if the vertices were read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readVertices(std::size_t firstVertex, std::size_t vertexCount, Vertex* vertices) const;
+
+    friend class RenderTarget;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -338,6 +413,7 @@ private:
     std::size_t   m_size;          ///< Size in Vertexes of the currently allocated buffer
     PrimitiveType m_primitiveType; ///< Type of primitives to draw
     Usage         m_usage;         ///< How this vertex buffer is to be used
+    VertexFormat  m_format;        ///< Layout of the vertices stored in the buffer
 };
 
 } // namespace sf
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_VERTEXFORMAT_HPP
+#define SFML_VERTEXFORMAT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Memory layout of vertices stored in a compact form
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API VertexFormat
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Storage of the vertex positions
+    ///
+    ////////////////////////////////////////////////////////////
+    enum PositionType
+    {
+        PositionFloat, ///< Two 32-bit floats (8 bytes), as in sf::Vertex
+        PositionHalf,  ///< Two 16-bit half floats (4 bytes)
+        PositionShort  ///< Two 16-bit signed integers (4 bytes), positions are rounded
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Storage of the vertex texture coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    enum TexCoordsType
+    {
+        TexCoordsFloat,     ///< Two 32-bit floats (8 bytes), as in sf::Vertex
+        TexCoordsNormalized ///< Two 16-bit signed integers (4 bytes), relative to the texture coordinates range
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates the format of sf::Vertex, 20 bytes per vertex.
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexFormat();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the format from its components
+    ///
+    /// With TexCoordsNormalized, texture coordinates are stored
+    /// as a fraction of \a texCoordsRange, which is usually the
+    /// size of the texture: coordinates between -range and +range
+    /// can be represented, with a precision of range / 32767.
+    ///
+    /// \param position       Storage of the positions
+    /// \param texCoords      Storage of the texture coordinates
+    /// \param texCoordsRange Range of the normalized texture coordinates, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit VertexFormat(PositionType position, TexCoordsType texCoords = TexCoordsFloat, const Vector2f& texCoordsRange = Vector2f(1.f, 1.f));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the storage of the positions
+    ///
+    /// \return Storage of the positions
+    ///
+    ////////////////////////////////////////////////////////////
+    PositionType getPositionType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the storage of the texture coordinates
+    ///
+    /// \return Storage of the texture coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    TexCoordsType getTexCoordsType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the range of the normalized texture coordinates
+    ///
+    /// \return Range of the texture coordinates, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getTexCoordsRange() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a vertex
+    ///
+    /// \return Number of bytes between two consecutive vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getStride() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the offset of the color in a vertex
+    ///
+    /// The position is always stored first, followed by the
+    /// color (4 bytes, RGBA) and the texture coordinates.
+    ///
+    /// \return Offset of the color, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getColorOffset() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the offset of the texture coordinates in a vertex
+    ///
+    /// \return Offset of the texture coordinates, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getTexCoordsOffset() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert vertices to this format
+    ///
+    /// \a data must have room for vertexCount * getStride() bytes.
+    /// Values that can't be represented are clamped.
+    ///
+    /// \param vertices    Vertices to convert
+    /// \param vertexCount Number of vertices
+    /// \param data        Destination of the converted vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void pack(const Vertex* vertices, std::size_t vertexCount, void* data) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert vertices stored in this format back to sf::Vertex
+    ///
+    /// \param data        Vertices stored in this format
+    /// \param vertexCount Number of vertices
+    /// \param vertices    Destination of the converted vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void unpack(const void* data, std::size_t vertexCount, Vertex* vertices) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the graphics driver can read this format
+    ///
+    /// Half float positions require OpenGL 3.0 or the
+    /// ARB_half_float_vertex extension. Vertices in a format
+    /// which is not supported can't be stored in a sf::VertexBuffer,
+    /// and are converted on the CPU when drawn from client memory.
+    ///
+    /// \return True if the format is supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSupported() const;
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const VertexFormat Default; ///< Format of sf::Vertex
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    PositionType  m_positionType;   ///< Storage of the positions
+    TexCoordsType m_texCoordsType;  ///< Storage of the texture coordinates
+    Vector2f      m_texCoordsRange; ///< Range of the normalized texture coordinates
+};
+
+////////////////////////////////////////////////////////////
+/// \relates VertexFormat
+/// \brief Overload of the == operator
+///
+/// The texture coordinates range is only compared for
+/// formats with normalized texture coordinates.
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if the formats are equal, false if they are different
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator ==(const VertexFormat& left, const VertexFormat& right);
+
+////////////////////////////////////////////////////////////
+/// \relates VertexFormat
+/// \brief Overload of the != operator
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if the formats are different, false if they are equal
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator !=(const VertexFormat& left, const VertexFormat& right);
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXFORMAT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VertexFormat
+/// \ingroup graphics
+///
+/// sf::Vertex stores its position and texture coordinates as
+/// 32-bit floats, 20 bytes per vertex. Large static meshes,
+/// like tile maps or particle clouds, rarely need that much
+/// precision: sf::VertexFormat describes a more compact layout,
+/// which can be used by sf::VertexBuffer or drawn directly by
+/// sf::RenderTarget.
+///
+/// Positions can be stored as half floats, or as integers when
+/// they are whole numbers of pixels. Texture coordinates can be
+/// stored as 16-bit fractions of a range, usually the size of
+/// the texture; the conversion back to pixels is folded into
+/// the texture matrix, at no cost. The color is always stored
+/// as 4 bytes, as in sf::Vertex. With both compact components,
+/// a vertex takes 12 bytes instead of 20.
+///
+/// pack() and unpack() convert vertices from and to sf::Vertex.
+///
+/// Usage example:
+/// \code
+/// sf::VertexFormat format(sf::VertexFormat::PositionShort, sf::VertexFormat::TexCoordsNormalized,
+///                         sf::Vector2f(tileset.getSize()));
+///
+/// sf::VertexBuffer tiles(sf::Quads, sf::VertexBuffer::Static);
+/// tiles.setFormat(format);
+/// tiles.create(vertices.size());
+/// tiles.update(&vertices[0]);
+///
+/// window.draw(tiles, &tileset);
+/// \endcode
+///
+/// \see sf::Vertex, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
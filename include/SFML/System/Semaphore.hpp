@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SEMAPHORE_HPP
+#define SFML_SEMAPHORE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class SemaphoreImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Counter that threads can wait on until another
+///        thread signals it
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Semaphore : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The counter of the semaphore starts at 0.
+    ///
+    ////////////////////////////////////////////////////////////
+    Semaphore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Semaphore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Increase the counter of the semaphore
+    ///
+    /// Up to \a count threads blocked in wait() are released.
+    ///
+    /// \param count Value to add to the counter
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void post(unsigned int count = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decrease the counter of the semaphore
+    ///
+    /// If the counter is 0, this call will block the execution
+    /// until another thread calls post().
+    ///
+    /// \see post
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::SemaphoreImpl* m_semaphoreImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_SEMAPHORE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Semaphore
+/// \ingroup system
+///
+/// A semaphore is a synchronization object holding a counter.
+/// wait() decreases the counter, blocking while it is 0, and
+/// post() increases it, releasing the waiting threads.
+///
+/// Unlike a mutex, a semaphore is not owned by any thread:
+/// one thread can wait for a signal that another thread
+/// posts. This makes it suitable to hand work to a set of
+/// sleeping threads and to wait until they are done.
+///
+/// Usage example:
+/// \code
+/// sf::Semaphore ready;
+///
+/// void producer()
+/// {
+///     queue.push(...); // queue is protected by its own mutex
+///     ready.post(); // one waiting consumer will now be unblocked
+/// }
+///
+/// void consumer()
+/// {
+///     ready.wait(); // this call will block the thread until an item is available
+///     process(queue.pop());
+/// }
+/// \endcode
+///
+/// \see sf::Mutex, sf::Thread
+///
+////////////////////////////////////////////////////////////
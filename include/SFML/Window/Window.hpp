@@ -517,6 +517,17 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called after the window has been displayed
+    ///
+    /// This function is called by display() so that derived
+    /// classes can perform custom actions at the end of each
+    /// frame, whether display() is called through the derived
+    /// class or through sf::Window.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/BlendEquation.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Compute a blending factor, as glBlendFunc does
+    float getFactor(sf::BlendMode::Factor factor, const float* source, const float* destination, int channel)
+    {
+        switch (factor)
+        {
+            default:
+            case sf::BlendMode::Zero:             return 0.f;
+            case sf::BlendMode::One:              return 1.f;
+            case sf::BlendMode::SrcColor:         return source[channel];
+            case sf::BlendMode::OneMinusSrcColor: return 1.f - source[channel];
+            case sf::BlendMode::DstColor:         return destination[channel];
+            case sf::BlendMode::OneMinusDstColor: return 1.f - destination[channel];
+            case sf::BlendMode::SrcAlpha:         return source[3];
+            case sf::BlendMode::OneMinusSrcAlpha: return 1.f - source[3];
+            case sf::BlendMode::DstAlpha:         return destination[3];
+            case sf::BlendMode::OneMinusDstAlpha: return 1.f - destination[3];
+        }
+    }
+
+    // Combine a source and a destination channel, as glBlendEquation does
+    float blend(sf::BlendMode::Equation equation, float source, float sourceFactor, float destination, float destinationFactor)
+    {
+        float result;
+
+        switch (equation)
+        {
+            default:
+            case sf::BlendMode::Add:             result = source * sourceFactor + destination * destinationFactor; break;
+            case sf::BlendMode::Subtract:        result = source * sourceFactor - destination * destinationFactor; break;
+            case sf::BlendMode::ReverseSubtract: result = destination * destinationFactor - source * sourceFactor; break;
+        }
+
+        return std::min(std::max(result, 0.f), 1.f);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void blendColors(const BlendMode& mode, const float* source, const float* destination, float* result)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        result[i] = blend(mode.colorEquation, source[i], getFactor(mode.colorSrcFactor, source, destination, i),
+                          destination[i], getFactor(mode.colorDstFactor, source, destination, i));
+    }
+
+    result[3] = blend(mode.alphaEquation, source[3], getFactor(mode.alphaSrcFactor, source, destination, 3),
+                      destination[3], getFactor(mode.alphaDstFactor, source, destination, 3));
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_BLENDEQUATION_HPP
+#define SFML_BLENDEQUATION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/BlendMode.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Blend a source color with a destination color
+///
+/// The computation is the one OpenGL performs for the
+/// factors and equations of \a mode: components are
+/// normalized to [0, 1] and the result is clamped to
+/// the same range.
+///
+/// \param mode        Blend mode to apply
+/// \param source      RGBA components of the source color
+/// \param destination RGBA components of the destination color
+/// \param result      Array receiving the 4 blended components
+///
+////////////////////////////////////////////////////////////
+void blendColors(const BlendMode& mode, const float* source, const float* destination, float* result);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_BLENDEQUATION_HPP
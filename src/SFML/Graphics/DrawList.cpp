@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DrawList.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+DrawList::DrawList()
+{
+    // A draw list is a render target that records forever and never submits
+    beginQueue();
+
+    // The view of the replay target is unknown until the user provides it
+    m_viewKnown = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawList::clear()
+{
+    clearQueue();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DrawList::getDrawCount() const
+{
+    return m_queue.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawList::setView(const View& view)
+{
+    // The view only serves culling while recording, there's nothing to submit
+    m_view = view;
+    m_viewKnown = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u DrawList::getSize() const
+{
+    return Vector2u(0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool DrawList::setActive(bool /* active */)
+{
+    // Lists are recorded on any thread, without a context
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DrawList::submitQueue()
+{
+    // The draws are replayed by the target the list is drawn to
+    return false;
+}
+
+} // namespace sf
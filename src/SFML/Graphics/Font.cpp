@@ -462,6 +462,17 @@ const Texture& Font::getTexture(unsigned int characterSize) const
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 Font::getMemoryUsage() const
+{
+    Uint64 usage = 0;
+    for (PageTable::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        usage += it->second.texture.getMemoryUsage();
+
+    return usage;
+}
+
+
 ////////////////////////////////////////////////////////////
 Font& Font::operator =(const Font& right)
 {
@@ -726,6 +737,7 @@ IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height)
             {
                 // Make the texture 2 times bigger
                 Texture newTexture;
+                newTexture.m_memoryCategory = GraphicsMemory::FontPages;
                 newTexture.create(textureWidth * 2, textureHeight * 2);
                 newTexture.update(page.texture);
                 page.texture.swap(newTexture);
@@ -803,7 +815,8 @@ nextRow(3)
         for (int y = 0; y < 2; ++y)
             image.setPixel(x, y, Color(255, 255, 255, 255));
 
-    // Create the texture
+    // Create the texture, accounted as a font page
+    texture.m_memoryCategory = GraphicsMemory::FontPages;
     texture.loadFromImage(image);
     texture.setSmooth(true);
 }
@@ -50,6 +50,7 @@
     #define GLEXT_glClientActiveTexture               glClientActiveTexture
     #define GLEXT_glActiveTexture                     glActiveTexture
     #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0
+    #define GLEXT_GL_ACTIVE_TEXTURE                   GL_ACTIVE_TEXTURE
     #define GLEXT_GL_CLAMP                            GL_CLAMP_TO_EDGE
     #define GLEXT_GL_CLAMP_TO_EDGE                    GL_CLAMP_TO_EDGE
 
@@ -57,6 +58,8 @@
     // 1.1 does not support GL_STREAM_DRAW so we just define it to GL_DYNAMIC_DRAW
     #define GLEXT_vertex_buffer_object                true
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER
+    #define GLEXT_GL_ARRAY_BUFFER_BINDING             GL_ARRAY_BUFFER_BINDING
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW
     #define GLEXT_GL_STREAM_DRAW                      GL_DYNAMIC_DRAW
@@ -66,6 +69,13 @@
     #define GLEXT_glDeleteBuffers                     glDeleteBuffers
     #define GLEXT_glGenBuffers                        glGenBuffers
 
+    // Core since 3.0 - OES_element_index_uint
+    #ifdef GL_OES_element_index_uint
+        #define GLEXT_element_index_uint                  GL_OES_element_index_uint
+    #else
+        #define GLEXT_element_index_uint                  false
+    #endif
+
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
     // functions according to the corresponding specification
@@ -133,16 +143,60 @@
     // Core since 3.0
     #define GLEXT_framebuffer_multisample             false
 
+    // Core since 3.0 - ARB_texture_float
+    #define GLEXT_texture_float                       false
+    #define GLEXT_GL_RGBA16F                          0
+
+    // Core since 3.0 - ARB_half_float_pixel
+    #define GLEXT_half_float_pixel                    false
+    #define GLEXT_GL_HALF_FLOAT                       0
+
+    // Core since 3.0 - ARB_texture_rg
+    #define GLEXT_texture_rg                          false
+    #define GLEXT_GL_R8                               0
+    #define GLEXT_GL_RG8                              0
+    #define GLEXT_GL_RED                              0
+    #define GLEXT_GL_RG                               0
+
+    // Core since 3.0 - OES_vertex_array_object
+    #define GLEXT_vertex_array_object                 false
+
     // Core since 3.0 - NV_copy_buffer
     #define GLEXT_copy_buffer                         false
 
+    // Core since 3.0 - EXT_draw_instanced
+    #define GLEXT_draw_instanced                      false
+
+    // Core since 3.0 - EXT_instanced_arrays
+    #define GLEXT_instanced_arrays                    false
+
+    // Core since 3.0 - EXT_occlusion_query_boolean
+    #define GLEXT_occlusion_query                     false
+
+    // EXT_disjoint_timer_query
+    #define GLEXT_timer_query                         false
+
+    // Core since 3.0 - OES_get_program_binary
+    #define GLEXT_get_program_binary                  false
+
+    // KHR_parallel_shader_compile
+    #define GLEXT_parallel_shader_compile             false
+
+    // Core since 3.0
+    #define GLEXT_uniform_buffer_object               false
+
+    // Core since 3.0 - OES_vertex_half_float
+    #define GLEXT_half_float_vertex                   false
+
     // Core since 3.0 - EXT_sRGB
     #ifdef GL_EXT_sRGB
         #define GLEXT_texture_sRGB                        GL_EXT_sRGB
         #define GLEXT_GL_SRGB8_ALPHA8                     GL_SRGB8_ALPHA8_EXT
+        #define GLEXT_GL_SRGB8                            GL_SRGB_EXT
     #else
         #define GLEXT_texture_sRGB                        false
         #define GLEXT_GL_SRGB8_ALPHA8                     0
+        #define GLEXT_GL_SRGB8                            0
     #endif
 
 #else
@@ -185,6 +239,7 @@
     #define GLEXT_glClientActiveTexture               glClientActiveTextureARB
     #define GLEXT_glActiveTexture                     glActiveTextureARB
     #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0_ARB
+    #define GLEXT_GL_ACTIVE_TEXTURE                   GL_ACTIVE_TEXTURE_ARB
 
     // Core since 1.4 - EXT_blend_func_separate
     #define GLEXT_blend_func_separate                 sfogl_ext_EXT_blend_func_separate
@@ -193,6 +248,8 @@
     // Core since 1.5 - ARB_vertex_buffer_object
     #define GLEXT_vertex_buffer_object                sfogl_ext_ARB_vertex_buffer_object
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_ARRAY_BUFFER_BINDING             GL_ARRAY_BUFFER_BINDING_ARB
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW_ARB
     #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW_ARB
@@ -203,9 +260,25 @@
     #define GLEXT_glBufferSubData                     glBufferSubDataARB
     #define GLEXT_glDeleteBuffers                     glDeleteBuffersARB
     #define GLEXT_glGenBuffers                        glGenBuffersARB
+    #define GLEXT_glGetBufferSubData                  glGetBufferSubDataARB
     #define GLEXT_glMapBuffer                         glMapBufferARB
     #define GLEXT_glUnmapBuffer                       glUnmapBufferARB
 
+    // Core since 1.5 - ARB_occlusion_query
+    #define GLEXT_occlusion_query                     sfogl_ext_ARB_occlusion_query
+    #define GLEXT_GL_QUERY_RESULT                     GL_QUERY_RESULT_ARB
+    #define GLEXT_GL_QUERY_RESULT_AVAILABLE           GL_QUERY_RESULT_AVAILABLE_ARB
+    #define GLEXT_GL_SAMPLES_PASSED                   GL_SAMPLES_PASSED_ARB
+    #define GLEXT_glGenQueries                        glGenQueriesARB
+    #define GLEXT_glDeleteQueries                     glDeleteQueriesARB
+    #define GLEXT_glGetQueryObjectiv                  glGetQueryObjectivARB
+    #define GLEXT_glGetQueryObjectuiv                 glGetQueryObjectuivARB
+    #define GLEXT_glBeginQuery                        glBeginQueryARB
+    #define GLEXT_glEndQuery                          glEndQueryARB
+
+    // Core since 1.1 - 32-bit indices
+    #define GLEXT_element_index_uint                  true
+
     // Core since 2.0 - ARB_shading_language_100
     #define GLEXT_shading_language_100                sfogl_ext_ARB_shading_language_100
 
@@ -247,6 +320,11 @@
     #define GLEXT_vertex_shader                       sfogl_ext_ARB_vertex_shader
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
+    #define GLEXT_glBindAttribLocation                glBindAttribLocationARB
+    #define GLEXT_glGetAttribLocation                 glGetAttribLocationARB
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointerARB
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArrayARB
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArrayARB
 
     // Core since 2.0 - ARB_fragment_shader
     #define GLEXT_fragment_shader                     sfogl_ext_ARB_fragment_shader
@@ -262,6 +340,7 @@
     // Core since 2.1 - EXT_texture_sRGB
     #define GLEXT_texture_sRGB                        sfogl_ext_EXT_texture_sRGB
     #define GLEXT_GL_SRGB8_ALPHA8                     GL_SRGB8_ALPHA8_EXT
+    #define GLEXT_GL_SRGB8                            GL_SRGB8_EXT
 
     // Core since 3.0 - EXT_framebuffer_object
     #define GLEXT_framebuffer_object                  sfogl_ext_EXT_framebuffer_object
@@ -302,16 +381,79 @@
     #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT
     #define GLEXT_GL_MAX_SAMPLES                      GL_MAX_SAMPLES_EXT
 
+    // Core since 3.0 - ARB_texture_float
+    #define GLEXT_texture_float                       sfogl_ext_ARB_texture_float
+    #define GLEXT_GL_RGBA16F                          GL_RGBA16F_ARB
+
+    // Core since 3.0 - ARB_half_float_pixel
+    #define GLEXT_half_float_pixel                    sfogl_ext_ARB_half_float_pixel
+    #define GLEXT_GL_HALF_FLOAT                       GL_HALF_FLOAT_ARB
+
+    // Core since 3.0 - ARB_texture_rg
+    #define GLEXT_texture_rg                          sfogl_ext_ARB_texture_rg
+    #define GLEXT_GL_R8                               GL_R8
+    #define GLEXT_GL_RG8                              GL_RG8
+    #define GLEXT_GL_RED                              GL_RED
+    #define GLEXT_GL_RG                               GL_RG
+
+    // Core since 3.0 - ARB_vertex_array_object
+    #define GLEXT_vertex_array_object                 sfogl_ext_ARB_vertex_array_object
+    #define GLEXT_glBindVertexArray                   glBindVertexArray
+    #define GLEXT_glDeleteVertexArrays                glDeleteVertexArrays
+    #define GLEXT_glGenVertexArrays                   glGenVertexArrays
+
     // Core since 3.1 - ARB_copy_buffer
     #define GLEXT_copy_buffer                         sfogl_ext_ARB_copy_buffer
     #define GLEXT_GL_COPY_READ_BUFFER                 GL_COPY_READ_BUFFER
     #define GLEXT_GL_COPY_WRITE_BUFFER                GL_COPY_WRITE_BUFFER
     #define GLEXT_glCopyBufferSubData                 glCopyBufferSubData
 
+    // Core since 3.1 - ARB_draw_instanced
+    #define GLEXT_draw_instanced                      sfogl_ext_ARB_draw_instanced
+    #define GLEXT_glDrawArraysInstanced               glDrawArraysInstancedARB
+    #define GLEXT_glDrawElementsInstanced             glDrawElementsInstancedARB
+
     // Core since 3.2 - ARB_geometry_shader4
     #define GLEXT_geometry_shader4                    sfogl_ext_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+    // Core since 3.3 - ARB_instanced_arrays
+    #define GLEXT_instanced_arrays                    sfogl_ext_ARB_instanced_arrays
+    #define GLEXT_glVertexAttribDivisor               glVertexAttribDivisorARB
+
+    // Core since 3.3 - ARB_timer_query
+    #define GLEXT_timer_query                         sfogl_ext_ARB_timer_query
+    #define GLEXT_GL_TIMESTAMP                        GL_TIMESTAMP
+    #define GLEXT_glQueryCounter                      glQueryCounter
+    #define GLEXT_glGetQueryObjectui64v               glGetQueryObjectui64v
+
+    // Core since 4.1 - ARB_get_program_binary
+    #define GLEXT_get_program_binary                  sfogl_ext_ARB_get_program_binary
+    #define GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            GL_PROGRAM_BINARY_LENGTH
+    #define GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS       GL_NUM_PROGRAM_BINARY_FORMATS
+    #define GLEXT_glGetProgramBinary                  glGetProgramBinary
+    #define GLEXT_glProgramBinary                     glProgramBinary
+    #define GLEXT_glProgramParameteri                 glProgramParameteri
+
+    // KHR_parallel_shader_compile
+    #define GLEXT_parallel_shader_compile             sfogl_ext_KHR_parallel_shader_compile
+    #define GLEXT_GL_MAX_SHADER_COMPILER_THREADS      GL_MAX_SHADER_COMPILER_THREADS_KHR
+    #define GLEXT_GL_COMPLETION_STATUS                GL_COMPLETION_STATUS_KHR
+    #define GLEXT_glMaxShaderCompilerThreads          glMaxShaderCompilerThreadsKHR
+
+    // Core since 3.1 - ARB_uniform_buffer_object
+    #define GLEXT_uniform_buffer_object               sfogl_ext_ARB_uniform_buffer_object
+    #define GLEXT_GL_UNIFORM_BUFFER                   GL_UNIFORM_BUFFER
+    #define GLEXT_GL_UNIFORM_BUFFER_BINDING           GL_UNIFORM_BUFFER_BINDING
+    #define GLEXT_GL_INVALID_INDEX                    GL_INVALID_INDEX
+    #define GLEXT_glBindBufferBase                    glBindBufferBase
+    #define GLEXT_glGetUniformBlockIndex              glGetUniformBlockIndex
+    #define GLEXT_glUniformBlockBinding               glUniformBlockBinding
+
+    // Core since 3.0 - ARB_half_float_vertex
+    #define GLEXT_half_float_vertex                   sfogl_ext_ARB_half_float_vertex
+
 #endif
 
 namespace sf
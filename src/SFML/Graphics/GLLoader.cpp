@@ -53,6 +53,18 @@ int sfogl_ext_EXT_framebuffer_blit = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_copy_buffer = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_float = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_half_float_pixel = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_rg = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_occlusion_query = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_timer_query = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_get_program_binary = sfogl_LOAD_FAILED;
+int sfogl_ext_KHR_parallel_shader_compile = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_uniform_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_half_float_vertex = sfogl_LOAD_FAILED;
 
 void (GL_FUNCPTR *sf_ptrc_glBlendEquationEXT)(GLenum) = NULL;
 
@@ -935,6 +947,175 @@ static int Load_ARB_geometry_shader4()
     return numFailed;
 }
 
+void (GL_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void*, GLsizei) = NULL;
+
+static int Load_ARB_draw_instanced()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glDrawArraysInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLsizei, GLsizei)>(glLoaderGetProcAddress("glDrawArraysInstancedARB"));
+    if (!sf_ptrc_glDrawArraysInstancedARB)
+        numFailed++;
+
+    sf_ptrc_glDrawElementsInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, GLenum, const void*, GLsizei)>(glLoaderGetProcAddress("glDrawElementsInstancedARB"));
+    if (!sf_ptrc_glDrawElementsInstancedARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint) = NULL;
+
+static int Load_ARB_instanced_arrays()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glVertexAttribDivisorARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint)>(glLoaderGetProcAddress("glVertexAttribDivisorARB"));
+    if (!sf_ptrc_glVertexAttribDivisorARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*) = NULL;
+
+static int Load_ARB_vertex_array_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindVertexArray = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glBindVertexArray"));
+    if (!sf_ptrc_glBindVertexArray)
+        numFailed++;
+
+    sf_ptrc_glDeleteVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteVertexArrays"));
+    if (!sf_ptrc_glDeleteVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glGenVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenVertexArrays"));
+    if (!sf_ptrc_glGenVertexArrays)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glGenQueriesARB)(GLsizei, GLuint *) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteQueriesARB)(GLsizei, const GLuint *) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectivARB)(GLuint, GLenum, GLint *) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectuivARB)(GLuint, GLenum, GLuint *) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBeginQueryARB)(GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glEndQueryARB)(GLenum) = NULL;
+
+static int Load_ARB_occlusion_query()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGenQueriesARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint *)>(glLoaderGetProcAddress("glGenQueriesARB"));
+    if (!sf_ptrc_glGenQueriesARB)
+        numFailed++;
+
+    sf_ptrc_glDeleteQueriesARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint *)>(glLoaderGetProcAddress("glDeleteQueriesARB"));
+    if (!sf_ptrc_glDeleteQueriesARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint *)>(glLoaderGetProcAddress("glGetQueryObjectivARB"));
+    if (!sf_ptrc_glGetQueryObjectivARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectuivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLuint *)>(glLoaderGetProcAddress("glGetQueryObjectuivARB"));
+    if (!sf_ptrc_glGetQueryObjectuivARB)
+        numFailed++;
+
+    sf_ptrc_glBeginQueryARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBeginQueryARB"));
+    if (!sf_ptrc_glBeginQueryARB)
+        numFailed++;
+
+    sf_ptrc_glEndQueryARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glEndQueryARB"));
+    if (!sf_ptrc_glEndQueryARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glQueryCounter)(GLuint, GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64 *) = NULL;
+
+static int Load_ARB_timer_query()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glQueryCounter = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum)>(glLoaderGetProcAddress("glQueryCounter"));
+    if (!sf_ptrc_glQueryCounter)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectui64v = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLuint64 *)>(glLoaderGetProcAddress("glGetQueryObjectui64v"));
+    if (!sf_ptrc_glGetQueryObjectui64v)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei *, GLenum *, void *) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void *, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint) = NULL;
+
+static int Load_ARB_get_program_binary()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGetProgramBinary = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, GLsizei *, GLenum *, void *)>(glLoaderGetProcAddress("glGetProgramBinary"));
+    if (!sf_ptrc_glGetProgramBinary)
+        numFailed++;
+
+    sf_ptrc_glProgramBinary = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, const void *, GLsizei)>(glLoaderGetProcAddress("glProgramBinary"));
+    if (!sf_ptrc_glProgramBinary)
+        numFailed++;
+
+    sf_ptrc_glProgramParameteri = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint)>(glLoaderGetProcAddress("glProgramParameteri"));
+    if (!sf_ptrc_glProgramParameteri)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glMaxShaderCompilerThreadsKHR)(GLuint) = NULL;
+
+static int Load_KHR_parallel_shader_compile()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glMaxShaderCompilerThreadsKHR = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+    if (!sf_ptrc_glMaxShaderCompilerThreadsKHR)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glBindBufferBase)(GLenum, GLuint, GLuint) = NULL;
+GLuint (GL_FUNCPTR *sf_ptrc_glGetUniformBlockIndex)(GLuint, const GLchar *) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniformBlockBinding)(GLuint, GLuint, GLuint) = NULL;
+
+static int Load_ARB_uniform_buffer_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindBufferBase = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint, GLuint)>(glLoaderGetProcAddress("glBindBufferBase"));
+    if (!sf_ptrc_glBindBufferBase)
+        numFailed++;
+
+    sf_ptrc_glGetUniformBlockIndex = reinterpret_cast<GLuint (GL_FUNCPTR *)(GLuint, const GLchar *)>(glLoaderGetProcAddress("glGetUniformBlockIndex"));
+    if (!sf_ptrc_glGetUniformBlockIndex)
+        numFailed++;
+
+    sf_ptrc_glUniformBlockBinding = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint, GLuint)>(glLoaderGetProcAddress("glUniformBlockBinding"));
+    if (!sf_ptrc_glUniformBlockBinding)
+        numFailed++;
+
+    return numFailed;
+}
+
 typedef int (*PFN_LOADFUNCPOINTERS)();
 typedef struct sfogl_StrToExtMap_s
 {
@@ -943,7 +1124,7 @@ typedef struct sfogl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfogl_StrToExtMap;
 
-static sfogl_StrToExtMap ExtensionMap[20] = {
+static sfogl_StrToExtMap ExtensionMap[32] = {
     {"GL_SGIS_texture_edge_clamp", &sfogl_ext_SGIS_texture_edge_clamp, NULL},
     {"GL_EXT_texture_edge_clamp", &sfogl_ext_EXT_texture_edge_clamp, NULL},
     {"GL_EXT_blend_minmax", &sfogl_ext_EXT_blend_minmax, Load_EXT_blend_minmax},
@@ -963,10 +1144,22 @@ static sfogl_StrToExtMap ExtensionMap[20] = {
     {"GL_EXT_framebuffer_blit", &sfogl_ext_EXT_framebuffer_blit, Load_EXT_framebuffer_blit},
     {"GL_EXT_framebuffer_multisample", &sfogl_ext_EXT_framebuffer_multisample, Load_EXT_framebuffer_multisample},
     {"GL_ARB_copy_buffer", &sfogl_ext_ARB_copy_buffer, Load_ARB_copy_buffer},
-    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4}
+    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4},
+    {"GL_ARB_texture_float", &sfogl_ext_ARB_texture_float, NULL},
+    {"GL_ARB_half_float_pixel", &sfogl_ext_ARB_half_float_pixel, NULL},
+    {"GL_ARB_texture_rg", &sfogl_ext_ARB_texture_rg, NULL},
+    {"GL_ARB_draw_instanced", &sfogl_ext_ARB_draw_instanced, Load_ARB_draw_instanced},
+    {"GL_ARB_instanced_arrays", &sfogl_ext_ARB_instanced_arrays, Load_ARB_instanced_arrays},
+    {"GL_ARB_vertex_array_object", &sfogl_ext_ARB_vertex_array_object, Load_ARB_vertex_array_object},
+    {"GL_ARB_occlusion_query", &sfogl_ext_ARB_occlusion_query, Load_ARB_occlusion_query},
+    {"GL_ARB_timer_query", &sfogl_ext_ARB_timer_query, Load_ARB_timer_query},
+    {"GL_ARB_get_program_binary", &sfogl_ext_ARB_get_program_binary, Load_ARB_get_program_binary},
+    {"GL_KHR_parallel_shader_compile", &sfogl_ext_KHR_parallel_shader_compile, Load_KHR_parallel_shader_compile},
+    {"GL_ARB_uniform_buffer_object", &sfogl_ext_ARB_uniform_buffer_object, Load_ARB_uniform_buffer_object},
+    {"GL_ARB_half_float_vertex", &sfogl_ext_ARB_half_float_vertex, NULL}
 };
 
-static int g_extensionMapSize = 20;
+static int g_extensionMapSize = 32;
 
 
 static void ClearExtensionVars()
@@ -991,6 +1184,18 @@ static void ClearExtensionVars()
     sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
     sfogl_ext_ARB_copy_buffer = sfogl_LOAD_FAILED;
     sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_texture_float = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_half_float_pixel = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_texture_rg = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_occlusion_query = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_timer_query = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_get_program_binary = sfogl_LOAD_FAILED;
+    sfogl_ext_KHR_parallel_shader_compile = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_uniform_buffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_half_float_vertex = sfogl_LOAD_FAILED;
 }
 
 
@@ -190,6 +190,18 @@ extern int sfogl_ext_EXT_framebuffer_blit;
 extern int sfogl_ext_EXT_framebuffer_multisample;
 extern int sfogl_ext_ARB_copy_buffer;
 extern int sfogl_ext_ARB_geometry_shader4;
+extern int sfogl_ext_ARB_texture_float;
+extern int sfogl_ext_ARB_half_float_pixel;
+extern int sfogl_ext_ARB_texture_rg;
+extern int sfogl_ext_ARB_draw_instanced;
+extern int sfogl_ext_ARB_instanced_arrays;
+extern int sfogl_ext_ARB_vertex_array_object;
+extern int sfogl_ext_ARB_occlusion_query;
+extern int sfogl_ext_ARB_timer_query;
+extern int sfogl_ext_ARB_get_program_binary;
+extern int sfogl_ext_KHR_parallel_shader_compile;
+extern int sfogl_ext_ARB_uniform_buffer_object;
+extern int sfogl_ext_ARB_half_float_vertex;
 
 #define GL_CLAMP_TO_EDGE_SGIS 0x812F
 
@@ -454,6 +466,41 @@ extern int sfogl_ext_ARB_geometry_shader4;
 #define GL_TRIANGLES_ADJACENCY_ARB 0x000C
 #define GL_TRIANGLE_STRIP_ADJACENCY_ARB 0x000D
 
+#define GL_RGB16F_ARB 0x881B
+#define GL_RGB32F_ARB 0x8815
+#define GL_RGBA16F_ARB 0x881A
+#define GL_RGBA32F_ARB 0x8814
+
+#define GL_HALF_FLOAT_ARB 0x140B
+
+#define GL_R16F 0x822D
+#define GL_R8 0x8229
+#define GL_RG 0x8227
+#define GL_RG16F 0x822F
+#define GL_RG8 0x822B
+
+#define GL_VERTEX_ATTRIB_ARRAY_DIVISOR_ARB 0x88FE
+
+#define GL_VERTEX_ARRAY_BINDING 0x85B5
+
+#define GL_QUERY_RESULT_ARB 0x8866
+#define GL_QUERY_RESULT_AVAILABLE_ARB 0x8867
+#define GL_SAMPLES_PASSED_ARB 0x8914
+
+#define GL_TIMESTAMP 0x8E28
+#define GL_TIME_ELAPSED 0x88BF
+
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
+#define GL_UNIFORM_BUFFER 0x8A11
+#define GL_UNIFORM_BUFFER_BINDING 0x8A28
+#define GL_INVALID_INDEX 0xFFFFFFFFu
+
 #define GL_2D 0x0600
 #define GL_2_BYTES 0x1407
 #define GL_3D 0x0601
@@ -1353,6 +1400,80 @@ extern void (GL_FUNCPTR *sf_ptrc_glProgramParameteriARB)(GLuint, GLenum, GLint);
 #define glProgramParameteriARB sf_ptrc_glProgramParameteriARB
 #endif // GL_ARB_geometry_shader4
 
+#ifndef GL_ARB_draw_instanced
+#define GL_ARB_draw_instanced 1
+extern void (GL_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei);
+#define glDrawArraysInstancedARB sf_ptrc_glDrawArraysInstancedARB
+extern void (GL_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void*, GLsizei);
+#define glDrawElementsInstancedARB sf_ptrc_glDrawElementsInstancedARB
+#endif // GL_ARB_draw_instanced
+
+#ifndef GL_ARB_instanced_arrays
+#define GL_ARB_instanced_arrays 1
+extern void (GL_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint);
+#define glVertexAttribDivisorARB sf_ptrc_glVertexAttribDivisorARB
+#endif // GL_ARB_instanced_arrays
+
+#ifndef GL_ARB_vertex_array_object
+#define GL_ARB_vertex_array_object 1
+extern void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint);
+#define glBindVertexArray sf_ptrc_glBindVertexArray
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*);
+#define glDeleteVertexArrays sf_ptrc_glDeleteVertexArrays
+extern void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*);
+#define glGenVertexArrays sf_ptrc_glGenVertexArrays
+#endif // GL_ARB_vertex_array_object
+
+#ifndef GL_ARB_occlusion_query
+#define GL_ARB_occlusion_query 1
+extern void (GL_FUNCPTR *sf_ptrc_glGenQueriesARB)(GLsizei, GLuint *);
+#define glGenQueriesARB sf_ptrc_glGenQueriesARB
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteQueriesARB)(GLsizei, const GLuint *);
+#define glDeleteQueriesARB sf_ptrc_glDeleteQueriesARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectivARB)(GLuint, GLenum, GLint *);
+#define glGetQueryObjectivARB sf_ptrc_glGetQueryObjectivARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectuivARB)(GLuint, GLenum, GLuint *);
+#define glGetQueryObjectuivARB sf_ptrc_glGetQueryObjectuivARB
+extern void (GL_FUNCPTR *sf_ptrc_glBeginQueryARB)(GLenum, GLuint);
+#define glBeginQueryARB sf_ptrc_glBeginQueryARB
+extern void (GL_FUNCPTR *sf_ptrc_glEndQueryARB)(GLenum);
+#define glEndQueryARB sf_ptrc_glEndQueryARB
+#endif // GL_ARB_occlusion_query
+
+#ifndef GL_ARB_timer_query
+#define GL_ARB_timer_query 1
+extern void (GL_FUNCPTR *sf_ptrc_glQueryCounter)(GLuint, GLenum);
+#define glQueryCounter sf_ptrc_glQueryCounter
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64 *);
+#define glGetQueryObjectui64v sf_ptrc_glGetQueryObjectui64v
+#endif // GL_ARB_timer_query
+
+#ifndef GL_ARB_get_program_binary
+#define GL_ARB_get_program_binary 1
+extern void (GL_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei *, GLenum *, void *);
+#define glGetProgramBinary sf_ptrc_glGetProgramBinary
+extern void (GL_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void *, GLsizei);
+#define glProgramBinary sf_ptrc_glProgramBinary
+extern void (GL_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint);
+#define glProgramParameteri sf_ptrc_glProgramParameteri
+#endif // GL_ARB_get_program_binary
+
+#ifndef GL_KHR_parallel_shader_compile
+#define GL_KHR_parallel_shader_compile 1
+extern void (GL_FUNCPTR *sf_ptrc_glMaxShaderCompilerThreadsKHR)(GLuint);
+#define glMaxShaderCompilerThreadsKHR sf_ptrc_glMaxShaderCompilerThreadsKHR
+#endif // GL_KHR_parallel_shader_compile
+
+#ifndef GL_ARB_uniform_buffer_object
+#define GL_ARB_uniform_buffer_object 1
+extern void (GL_FUNCPTR *sf_ptrc_glBindBufferBase)(GLenum, GLuint, GLuint);
+#define glBindBufferBase sf_ptrc_glBindBufferBase
+extern GLuint (GL_FUNCPTR *sf_ptrc_glGetUniformBlockIndex)(GLuint, const GLchar *);
+#define glGetUniformBlockIndex sf_ptrc_glGetUniformBlockIndex
+extern void (GL_FUNCPTR *sf_ptrc_glUniformBlockBinding)(GLuint, GLuint, GLuint);
+#define glUniformBlockBinding sf_ptrc_glUniformBlockBinding
+#endif // GL_ARB_uniform_buffer_object
+
 GLAPI void APIENTRY glAccum(GLenum, GLfloat);
 GLAPI void APIENTRY glAlphaFunc(GLenum, GLfloat);
 GLAPI void APIENTRY glBegin(GLenum);
@@ -0,0 +1,668 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/ProgrammablePipeline.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <list>
+#include <vector>
+
+#ifndef SFML_OPENGL_ES
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+    #define castFromGlHandle(x) static_cast<unsigned int>(reinterpret_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+    #define castFromGlHandle(x) (x)
+
+#endif
+
+#endif // SFML_OPENGL_ES
+
+
+namespace
+{
+    // Value of the bindings which are not known
+    const unsigned int unknown = 0xFFFFFFFF;
+
+    // Number of texture units whose bindings are tracked
+    const unsigned int trackedTextureUnits = 32;
+
+    // Number of indexed uniform buffer binding points which are tracked
+    const unsigned int trackedUniformBufferBases = 36;
+
+    const float identityMatrix[16] = {1.f, 0.f, 0.f, 0.f,
+                                      0.f, 1.f, 0.f, 0.f,
+                                      0.f, 0.f, 1.f, 0.f,
+                                      0.f, 0.f, 0.f, 1.f};
+
+    // Shadow of the bindings of a single context
+    struct ContextState
+    {
+        ContextState() :
+        contextId      (0),
+        forgetRequests (0),
+        forgetsApplied (0)
+        {
+            reset();
+        }
+
+        // Forget all the bindings
+        void reset()
+        {
+            program = unknown;
+            activeUnit = unknown;
+            arrayBuffer = unknown;
+            uniformBuffer = unknown;
+            coreProfile = unknown;
+            textureMatrixKnown = false;
+
+            std::fill(textures, textures + trackedTextureUnits, unknown);
+            std::fill(uniformBufferBases, uniformBufferBases + trackedUniformBufferBases, unknown);
+        }
+
+        // Get the active texture unit, OpenGL is queried if it isn't known
+        unsigned int getActiveUnit()
+        {
+            if (activeUnit == unknown)
+            {
+                GLint unit = GLEXT_GL_TEXTURE0;
+
+                if (GLEXT_multitexture)
+                    glCheck(glGetIntegerv(GLEXT_GL_ACTIVE_TEXTURE, &unit));
+
+                activeUnit = static_cast<unsigned int>(unit - GLEXT_GL_TEXTURE0);
+            }
+
+            return activeUnit;
+        }
+
+        // Tell whether the context has a core profile, which has no texture matrices
+        bool isCoreProfile()
+        {
+            if (coreProfile == unknown)
+                coreProfile = sf::priv::ProgrammablePipeline::isCoreProfileActive() ? 1 : 0;
+
+            return coreProfile == 1;
+        }
+
+        // Get the texture binding of the active unit, null if it isn't tracked
+        unsigned int* getTextureBinding()
+        {
+            unsigned int unit = getActiveUnit();
+
+            return (unit < trackedTextureUnits) ? &textures[unit] : NULL;
+        }
+
+        sf::Uint64   contextId;                                     // Context whose bindings are shadowed, 0 if the state is free
+        unsigned int program;                                       // Current program
+        unsigned int activeUnit;                                    // Active texture unit
+        unsigned int textures[trackedTextureUnits];                 // 2D texture bound to each unit
+        unsigned int arrayBuffer;                                   // GL_ARRAY_BUFFER binding
+        unsigned int uniformBuffer;                                 // Generic GL_UNIFORM_BUFFER binding
+        unsigned int uniformBufferBases[trackedUniformBufferBases]; // Indexed GL_UNIFORM_BUFFER bindings
+        unsigned int coreProfile;                                   // 1 for a core profile context, 0 otherwise
+        bool         textureMatrixKnown;                            // Is the texture matrix of unit 0 known?
+        float        textureMatrix[16];                             // Texture matrix of unit 0
+
+        // Objects deleted by other threads are forgotten by the thread which owns the
+        // state, the next time it uses it: the requests are written under the mutex,
+        // and the owner only reads the counter without locking to know if there are any
+        unsigned int              forgetRequests;  // Number of requests made by other threads, written under the mutex
+        unsigned int              forgetsApplied;  // Number of requests applied by the owner
+        std::vector<unsigned int> pendingTextures; // Textures to forget, under the mutex
+        std::vector<unsigned int> pendingBuffers;  // Buffers to forget, under the mutex
+        std::vector<unsigned int> pendingPrograms; // Programs to forget, under the mutex
+    };
+
+    // The states of all the contexts. They are never freed, only recycled
+    // when their context is destroyed, so that the threads can keep a
+    // pointer to the state of their active context without locking
+    typedef std::list<ContextState> ContextStateList;
+    ContextStateList contextStates;
+    sf::Mutex mutex;
+
+    // State of the context that was last active in each thread
+    sf::ThreadLocalPtr<ContextState> currentState(NULL);
+
+    // Remove a texture from the bindings of a state
+    void removeTexture(ContextState& state, unsigned int texture)
+    {
+        std::replace(state.textures, state.textures + trackedTextureUnits, texture, unknown);
+    }
+
+    // Remove a buffer from the bindings of a state
+    void removeBuffer(ContextState& state, unsigned int buffer)
+    {
+        if (state.arrayBuffer == buffer)
+            state.arrayBuffer = unknown;
+
+        if (state.uniformBuffer == buffer)
+            state.uniformBuffer = unknown;
+
+        std::replace(state.uniformBufferBases, state.uniformBufferBases + trackedUniformBufferBases, buffer, unknown);
+    }
+
+    // Remove a program from the bindings of a state
+    void removeProgram(ContextState& state, unsigned int program)
+    {
+        if (state.program == program)
+            state.program = unknown;
+    }
+
+    // Apply the requests of other threads to forget deleted objects, the mutex must be locked
+    void applyForgets(ContextState& state)
+    {
+        for (std::size_t i = 0; i < state.pendingTextures.size(); ++i)
+            removeTexture(state, state.pendingTextures[i]);
+
+        for (std::size_t i = 0; i < state.pendingBuffers.size(); ++i)
+            removeBuffer(state, state.pendingBuffers[i]);
+
+        for (std::size_t i = 0; i < state.pendingPrograms.size(); ++i)
+            removeProgram(state, state.pendingPrograms[i]);
+
+        state.pendingTextures.clear();
+        state.pendingBuffers.clear();
+        state.pendingPrograms.clear();
+        state.forgetsApplied = state.forgetRequests;
+    }
+
+    // Callback that is called every time a context is destroyed
+    void contextDestroyCallback(void* /* arg */)
+    {
+        sf::Lock lock(mutex);
+
+        sf::Uint64 contextId = sf::Context::getActiveContextId();
+
+        for (ContextStateList::iterator it = contextStates.begin(); it != contextStates.end(); ++it)
+        {
+            if (it->contextId == contextId)
+            {
+                it->contextId = 0;
+                it->reset();
+
+                it->pendingTextures.clear();
+                it->pendingBuffers.clear();
+                it->pendingPrograms.clear();
+                it->forgetsApplied = it->forgetRequests;
+            }
+        }
+    }
+
+    // Registering a context destruction callback is reserved to OpenGL resources
+    struct ContextStateResource : sf::GlResource
+    {
+        static void registerCallback()
+        {
+            registerContextDestroyCallback(contextDestroyCallback, 0);
+        }
+    };
+
+    // Get the state of the active context. The state is only looked up
+    // when another context was activated since the last call in this
+    // thread; a recycled state can't match, as context ids are unique
+    ContextState* getContextState()
+    {
+        sf::Uint64 contextId = sf::Context::getActiveContextId();
+
+        if (!contextId)
+            return NULL;
+
+        ContextState* state = currentState;
+
+        if (state && (state->contextId == contextId))
+        {
+            // An object deleted by another thread may have been bound in this context;
+            // its name must be forgotten before it gets reused for another object
+            if (state->forgetRequests != state->forgetsApplied)
+            {
+                sf::Lock lock(mutex);
+                applyForgets(*state);
+            }
+
+            return state;
+        }
+
+        sf::Lock lock(mutex);
+
+        static bool callbackRegistered = false;
+
+        if (!callbackRegistered)
+        {
+            ContextStateResource::registerCallback();
+            callbackRegistered = true;
+        }
+
+        ContextState* freeState = NULL;
+        state = NULL;
+
+        for (ContextStateList::iterator it = contextStates.begin(); it != contextStates.end(); ++it)
+        {
+            if (it->contextId == contextId)
+                state = &*it;
+            else if (!it->contextId && !freeState)
+                freeState = &*it;
+        }
+
+        if (!state)
+        {
+            if (!freeState)
+            {
+                contextStates.push_back(ContextState());
+                freeState = &contextStates.back();
+            }
+
+            state = freeState;
+            state->contextId = contextId;
+        }
+
+        applyForgets(*state);
+        currentState = state;
+
+        return state;
+    }
+
+#ifdef SFML_DEBUG
+
+    // Check that a binding that is about to be skipped is really the
+    // one of the context, it isn't when OpenGL states were changed
+    // without calling resetGLStates()
+    bool checkBinding(unsigned int actual, unsigned int cached, const char* name)
+    {
+        if (actual == cached)
+            return true;
+
+        static bool warned = false;
+
+        if (!warned)
+        {
+            sf::err() << "The cached OpenGL " << name << " binding (" << cached << ") differs from the actual one ("
+                      << actual << "), call resetGLStates() after changing OpenGL states directly" << std::endl;
+
+            warned = true;
+        }
+
+        return false;
+    }
+
+    // Validate a binding which is about to be skipped against the context
+    bool isInSync(GLenum binding, unsigned int cached, const char* name)
+    {
+        GLint actual = 0;
+        glCheck(glGetIntegerv(binding, &actual));
+
+        return checkBinding(static_cast<unsigned int>(actual), cached, name);
+    }
+
+    // Validate a texture matrix load which is about to be skipped against the context
+    bool isTextureMatrixInSync(const float* cached)
+    {
+        float actual[16];
+        glCheck(glGetFloatv(GL_TEXTURE_MATRIX, actual));
+
+        if (std::equal(actual, actual + 16, cached))
+            return true;
+
+        static bool warned = false;
+
+        if (!warned)
+        {
+            sf::err() << "The cached OpenGL texture matrix differs from the actual one, "
+                      << "call resetGLStates() after changing OpenGL states directly" << std::endl;
+
+            warned = true;
+        }
+
+        return false;
+    }
+
+#else
+
+    // Skipped bindings are only validated in debug builds
+    bool isInSync(GLenum /* binding */, unsigned int /* cached */, const char* /* name */)
+    {
+        return true;
+    }
+
+    bool isTextureMatrixInSync(const float* /* cached */)
+    {
+        return true;
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void GLStateCache::bindTexture(unsigned int texture, bool force)
+{
+    ContextState* state = getContextState();
+    unsigned int* binding = state ? state->getTextureBinding() : NULL;
+
+    if (!force && binding && (*binding == texture) && isInSync(GL_TEXTURE_BINDING_2D, texture, "texture"))
+        return;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, texture));
+
+    if (binding)
+        *binding = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GLStateCache::getTexture()
+{
+    ContextState* state = getContextState();
+    unsigned int* binding = state ? state->getTextureBinding() : NULL;
+
+    if (binding && (*binding != unknown))
+        return *binding;
+
+    GLint texture = 0;
+    glCheck(glGetIntegerv(GL_TEXTURE_BINDING_2D, &texture));
+
+    if (binding)
+        *binding = static_cast<unsigned int>(texture);
+
+    return static_cast<unsigned int>(texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::activeTexture(unsigned int unit, bool force)
+{
+    ContextState* state = getContextState();
+
+    if (!force && state && (state->activeUnit == unit) && isInSync(GLEXT_GL_ACTIVE_TEXTURE, GLEXT_GL_TEXTURE0 + unit, "texture unit"))
+        return;
+
+    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + unit));
+
+    if (state)
+        state->activeUnit = unit;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::loadTextureMatrix(const float* matrix, bool force)
+{
+    ContextState* state = getContextState();
+    const float* values = matrix ? matrix : identityMatrix;
+
+    // Core profiles have no fixed-function matrices, shaders get theirs as uniforms
+    if (state ? state->isCoreProfile() : ProgrammablePipeline::isCoreProfileActive())
+        return;
+
+    // Only the matrix of the first unit is tracked, the one used by sf::RenderTarget
+    bool tracked = state && (state->getActiveUnit() == 0);
+
+    if (!force && tracked && state->textureMatrixKnown && std::equal(values, values + 16, state->textureMatrix) &&
+        isTextureMatrixInSync(state->textureMatrix))
+        return;
+
+    glCheck(glMatrixMode(GL_TEXTURE));
+
+    if (matrix)
+        glCheck(glLoadMatrixf(matrix));
+    else
+        glCheck(glLoadIdentity());
+
+    // Go back to model-view mode (sf::RenderTarget relies on it)
+    glCheck(glMatrixMode(GL_MODELVIEW));
+
+    if (tracked)
+    {
+        std::copy(values, values + 16, state->textureMatrix);
+        state->textureMatrixKnown = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::bindBuffer(unsigned int target, unsigned int buffer, bool force)
+{
+    ContextState* state = getContextState();
+    unsigned int* binding = NULL;
+    GLenum bindingName = 0;
+
+    if (state && (target == GLEXT_GL_ARRAY_BUFFER))
+    {
+        binding = &state->arrayBuffer;
+        bindingName = GLEXT_GL_ARRAY_BUFFER_BINDING;
+    }
+#ifndef SFML_OPENGL_ES
+    else if (state && (target == GLEXT_GL_UNIFORM_BUFFER))
+    {
+        binding = &state->uniformBuffer;
+        bindingName = GLEXT_GL_UNIFORM_BUFFER_BINDING;
+    }
+#endif
+
+    if (!force && binding && (*binding == buffer) && isInSync(bindingName, buffer, "buffer"))
+        return;
+
+    glCheck(GLEXT_glBindBuffer(target, buffer));
+
+    if (binding)
+        *binding = buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::bindBufferBase(unsigned int target, unsigned int index, unsigned int buffer, bool force)
+{
+#ifndef SFML_OPENGL_ES
+
+    ContextState* state = getContextState();
+
+    if (state && (target == GLEXT_GL_UNIFORM_BUFFER) && (index < trackedUniformBufferBases))
+    {
+        // Indexed bindings can't be cross-checked, glGetIntegeri_v is not loaded
+        if (!force && (state->uniformBufferBases[index] == buffer))
+            return;
+
+        glCheck(GLEXT_glBindBufferBase(target, index, buffer));
+
+        // The generic binding point is changed as well
+        state->uniformBufferBases[index] = buffer;
+        state->uniformBuffer = buffer;
+    }
+    else
+    {
+        glCheck(GLEXT_glBindBufferBase(target, index, buffer));
+    }
+
+#else
+
+    // Indexed binding points are not available in OpenGL ES 1
+    (void)target;
+    (void)index;
+    (void)buffer;
+    (void)force;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::useProgram(unsigned int program, bool force)
+{
+#ifndef SFML_OPENGL_ES
+
+    ContextState* state = getContextState();
+
+    if (!force && state && (state->program == program))
+    {
+    #ifdef SFML_DEBUG
+        GLEXT_GLhandle actual = 0;
+        glCheck(actual = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+
+        if (checkBinding(castFromGlHandle(actual), program, "program"))
+            return;
+    #else
+        return;
+    #endif
+    }
+
+    glCheck(GLEXT_glUseProgramObject(castToGlHandle(program)));
+
+    if (state)
+        state->program = program;
+
+#else
+
+    // Shaders are not available in OpenGL ES 1
+    (void)program;
+    (void)force;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GLStateCache::getProgram()
+{
+#ifndef SFML_OPENGL_ES
+
+    ContextState* state = getContextState();
+
+    if (state && (state->program != unknown))
+        return state->program;
+
+    GLEXT_GLhandle program = 0;
+    glCheck(program = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+
+    if (state)
+        state->program = castFromGlHandle(program);
+
+    return castFromGlHandle(program);
+
+#else
+
+    return 0;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::invalidate()
+{
+    ContextState* state = getContextState();
+
+    if (state)
+        state->reset();
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::forgetTexture(unsigned int texture)
+{
+    // The state of the active context is updated directly, the states of
+    // the other contexts belong to other threads which will update them
+    ContextState* current = getContextState();
+
+    Lock lock(mutex);
+
+    for (ContextStateList::iterator it = contextStates.begin(); it != contextStates.end(); ++it)
+    {
+        if (&*it == current)
+        {
+            removeTexture(*it, texture);
+        }
+        else if (it->contextId)
+        {
+            it->pendingTextures.push_back(texture);
+            ++it->forgetRequests;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::forgetBuffer(unsigned int buffer)
+{
+    ContextState* current = getContextState();
+
+    Lock lock(mutex);
+
+    for (ContextStateList::iterator it = contextStates.begin(); it != contextStates.end(); ++it)
+    {
+        if (&*it == current)
+        {
+            removeBuffer(*it, buffer);
+        }
+        else if (it->contextId)
+        {
+            it->pendingBuffers.push_back(buffer);
+            ++it->forgetRequests;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::forgetProgram(unsigned int program)
+{
+    ContextState* current = getContextState();
+
+    Lock lock(mutex);
+
+    for (ContextStateList::iterator it = contextStates.begin(); it != contextStates.end(); ++it)
+    {
+        if (&*it == current)
+        {
+            removeProgram(*it, program);
+        }
+        else if (it->contextId)
+        {
+            it->pendingPrograms.push_back(program);
+            ++it->forgetRequests;
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GLSTATECACHE_HPP
+#define SFML_GLSTATECACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Per-context shadow of the OpenGL bindings used by SFML
+///
+/// Textures, shaders and buffers bind their objects through
+/// this class, which remembers what is bound in each context
+/// and skips the calls that would not change anything.
+/// Each thread remembers the state of its active context,
+/// which is only looked up again when another context gets
+/// activated: binding through the cache doesn't lock.
+///
+/// Bindings that were changed behind SFML's back are only
+/// known again after invalidate() has been called, which
+/// RenderTarget::resetGLStates() and popGLStates() do. In
+/// debug builds, every skipped call is cross-checked against
+/// the actual OpenGL state, and a mismatch is reported.
+///
+/// The public bind functions of SFML (Texture::bind,
+/// Shader::bind, ...) can be mixed with direct OpenGL calls,
+/// so they force the calls, which only refresh the shadow.
+/// The internal rendering paths let the cache skip them.
+///
+/// The objects deleted by a thread are forgotten by the
+/// other contexts the next time their own thread uses them,
+/// so that the state of a context is only ever written by
+/// the thread where it is active.
+///
+////////////////////////////////////////////////////////////
+class GLStateCache
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a 2D texture to the active texture unit
+    ///
+    /// \param texture OpenGL name of the texture, 0 to unbind
+    /// \param force   Call OpenGL even if the texture is known to be bound
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bindTexture(unsigned int texture, bool force = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the 2D texture bound to the active texture unit
+    ///
+    /// OpenGL is only queried if the binding is not known.
+    ///
+    /// \return OpenGL name of the bound texture
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the active texture unit
+    ///
+    /// \param unit  Index of the texture unit, starting at 0
+    /// \param force Call OpenGL even if the unit is known to be active
+    ///
+    ////////////////////////////////////////////////////////////
+    static void activeTexture(unsigned int unit, bool force = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the fixed-function texture matrix
+    ///
+    /// The matrix mode is left to GL_MODELVIEW, which
+    /// sf::RenderTarget relies on.
+    ///
+    /// \param matrix Column-major 4x4 matrix, null for identity
+    /// \param force  Call OpenGL even if the matrix is known to be loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    static void loadTextureMatrix(const float* matrix, bool force = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a buffer object
+    ///
+    /// Only the GL_ARRAY_BUFFER and GL_UNIFORM_BUFFER targets
+    /// are tracked, the others are always bound. The element
+    /// array binding is part of the vertex array object state
+    /// and is not tracked either.
+    ///
+    /// \param target Target to bind the buffer to
+    /// \param buffer OpenGL name of the buffer, 0 to unbind
+    /// \param force  Call OpenGL even if the buffer is known to be bound
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bindBuffer(unsigned int target, unsigned int buffer, bool force = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a buffer object to an indexed binding point
+    ///
+    /// \param target Indexed target, like GL_UNIFORM_BUFFER
+    /// \param index  Index of the binding point
+    /// \param buffer OpenGL name of the buffer, 0 to unbind
+    /// \param force  Call OpenGL even if the buffer is known to be bound
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bindBufferBase(unsigned int target, unsigned int index, unsigned int buffer, bool force = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a program object current
+    ///
+    /// \param program OpenGL name of the program, 0 to unbind
+    /// \param force   Call OpenGL even if the program is known to be current
+    ///
+    ////////////////////////////////////////////////////////////
+    static void useProgram(unsigned int program, bool force = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current program object
+    ///
+    /// OpenGL is only queried if the binding is not known.
+    ///
+    /// \return OpenGL name of the current program
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getProgram();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the bindings of the active context
+    ///
+    /// This must be called whenever the bindings may have been
+    /// changed without going through this class.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void invalidate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget a texture which is about to be deleted
+    ///
+    /// Texture names are shared between contexts, so the
+    /// texture is forgotten in all of them: immediately in the
+    /// active context, and by the other contexts the next time
+    /// their thread uses the cache.
+    ///
+    /// \param texture OpenGL name of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    static void forgetTexture(unsigned int texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget a buffer which is about to be deleted
+    ///
+    /// \param buffer OpenGL name of the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    static void forgetBuffer(unsigned int buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget a program which is about to be deleted
+    ///
+    /// \param program OpenGL name of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    static void forgetProgram(unsigned int program);
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLSTATECACHE_HPP
@@ -83,4 +83,110 @@ namespace priv
     }
 
 } // namespace priv
+
+
+namespace Glsl
+{
+////////////////////////////////////////////////////////////
+Std140::Std140() :
+m_size(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Std140::add(Type type, std::size_t arrayLength)
+{
+    // Align the member, then make room for it
+    std::size_t alignment = getAlignment(type, arrayLength > 0);
+    std::size_t offset = (m_size + alignment - 1) / alignment * alignment;
+
+    if (arrayLength > 0)
+        m_size = offset + getArrayStride(type) * arrayLength;
+    else
+        m_size = offset + getTypeSize(type);
+
+    return offset;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Std140::getSize() const
+{
+    // Blocks are padded to a multiple of the size of a vec4
+    return (m_size + 15) / 16 * 16;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Std140::getAlignment(Type type, bool array)
+{
+    // Arrays and matrices are aligned like vec4
+    if (array)
+        return 16;
+
+    switch (type)
+    {
+        case Vec2:
+        case Ivec2:
+        case Bvec2:
+            return 8;
+
+        case Vec3:
+        case Vec4:
+        case Ivec3:
+        case Ivec4:
+        case Bvec3:
+        case Bvec4:
+        case Mat3:
+        case Mat4:
+            return 16;
+
+        default:
+            return 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Std140::getArrayStride(Type type)
+{
+    // Elements of arrays are padded to the size of a vec4
+    return (getTypeSize(type) + 15) / 16 * 16;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Std140::getTypeSize(Type type)
+{
+    switch (type)
+    {
+        case Vec2:
+        case Ivec2:
+        case Bvec2:
+            return 8;
+
+        case Vec3:
+        case Ivec3:
+        case Bvec3:
+            return 12;
+
+        case Vec4:
+        case Ivec4:
+        case Bvec4:
+            return 16;
+
+        // Matrices are stored as arrays of columns
+        case Mat3:
+            return 3 * 16;
+
+        case Mat4:
+            return 4 * 16;
+
+        default:
+            return 4;
+    }
+}
+
+} // namespace Glsl
 } // namespace sf
@@ -0,0 +1,313 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuProfiler.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+
+    // Statistics returned for unknown zones
+    const sf::GpuProfiler::ZoneStatistics noStatistics;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GpuProfiler::ZoneStatistics::ZoneStatistics() :
+lastTime   (Time::Zero),
+totalTime  (Time::Zero),
+minTime    (Time::Zero),
+maxTime    (Time::Zero),
+sampleCount(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfiler::Scope::Scope(GpuProfiler& profiler, RenderTarget& target, const std::string& name) :
+m_profiler(profiler),
+m_target  (target)
+{
+    m_profiler.beginZone(m_target, name);
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfiler::Scope::~Scope()
+{
+    m_profiler.endZone(m_target);
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfiler::GpuProfiler(std::size_t queryCount) :
+m_queryCount(std::max(queryCount, static_cast<std::size_t>(1))),
+m_zones     (),
+m_rings     (),
+m_openZones ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfiler::~GpuProfiler()
+{
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock contextLock;
+
+    // Query objects are not shared between contexts, we can only
+    // delete the ones of the active context; the others die with their context
+    RingMap::iterator iter = m_rings.find(Context::getActiveContextId());
+
+    if (iter != m_rings.end())
+    {
+        std::vector<Query>& queries = iter->second.queries;
+
+        for (std::vector<Query>::iterator it = queries.begin(); it != queries.end(); ++it)
+        {
+            glCheck(GLEXT_glDeleteQueries(1, &it->begin));
+            glCheck(GLEXT_glDeleteQueries(1, &it->end));
+        }
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::beginZone(RenderTarget& target, const std::string& name)
+{
+    ZoneStatistics& zone = m_zones[name];
+    Query* query = NULL;
+
+    QueryRing* ring = getRing(target);
+
+    if (ring)
+    {
+        collect(*ring);
+
+        // Take the oldest query; if its result is still in flight, the zone is not timed
+        Query& candidate = ring->queries[ring->next];
+
+        if (candidate.state == Free)
+        {
+        #ifndef SFML_OPENGL_ES
+            glCheck(GLEXT_glQueryCounter(candidate.begin, GLEXT_GL_TIMESTAMP));
+        #endif
+
+            candidate.zone = &zone;
+            candidate.state = Open;
+            ring->next = (ring->next + 1) % ring->queries.size();
+
+            query = &candidate;
+        }
+    }
+
+    m_openZones.push_back(query);
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::endZone(RenderTarget& target)
+{
+    if (m_openZones.empty())
+        return;
+
+    Query* query = m_openZones.back();
+    m_openZones.pop_back();
+
+    if (query && getRing(target))
+    {
+    #ifndef SFML_OPENGL_ES
+        glCheck(GLEXT_glQueryCounter(query->end, GLEXT_GL_TIMESTAMP));
+    #endif
+
+        query->state = Pending;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::update(RenderTarget& target)
+{
+    QueryRing* ring = getRing(target);
+
+    if (ring)
+        collect(*ring);
+}
+
+
+////////////////////////////////////////////////////////////
+const GpuProfiler::ZoneStatistics& GpuProfiler::getZoneStatistics(const std::string& name) const
+{
+    ZoneMap::const_iterator iter = m_zones.find(name);
+
+    return (iter != m_zones.end()) ? iter->second : noStatistics;
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<std::string> GpuProfiler::getZoneNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(m_zones.size());
+
+    for (ZoneMap::const_iterator it = m_zones.begin(); it != m_zones.end(); ++it)
+        names.push_back(it->first);
+
+    return names;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::reset()
+{
+    // Queries in flight keep running, but their results are dropped
+    for (RingMap::iterator ring = m_rings.begin(); ring != m_rings.end(); ++ring)
+    {
+        std::vector<Query>& queries = ring->second.queries;
+
+        for (std::vector<Query>::iterator it = queries.begin(); it != queries.end(); ++it)
+            it->zone = NULL;
+    }
+
+    m_zones.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuProfiler::isAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_occlusion_query && GLEXT_timer_query;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfiler::QueryRing* GpuProfiler::getRing(RenderTarget& target)
+{
+    if (!isAvailable() || !target.setActive(true))
+        return NULL;
+
+    Uint64 contextId = Context::getActiveContextId();
+    RingMap::iterator iter = m_rings.find(contextId);
+
+    if (iter != m_rings.end())
+        return &iter->second;
+
+    // Query objects are not shared, each context gets its own ring
+    QueryRing& ring = m_rings[contextId];
+    ring.queries.resize(m_queryCount);
+    ring.next = 0;
+
+    for (std::vector<Query>::iterator it = ring.queries.begin(); it != ring.queries.end(); ++it)
+    {
+        GLuint queries[2] = {0, 0};
+
+    #ifndef SFML_OPENGL_ES
+        glCheck(GLEXT_glGenQueries(2, queries));
+    #endif
+
+        it->begin = queries[0];
+        it->end   = queries[1];
+        it->zone  = NULL;
+        it->state = Free;
+    }
+
+    return &ring;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::collect(QueryRing& ring)
+{
+#ifndef SFML_OPENGL_ES
+
+    for (std::vector<Query>::iterator it = ring.queries.begin(); it != ring.queries.end(); ++it)
+    {
+        if (it->state != Pending)
+            continue;
+
+        // Never wait for the GPU: skip the results that are not ready yet
+        GLint available = GL_FALSE;
+        glCheck(GLEXT_glGetQueryObjectiv(it->end, GLEXT_GL_QUERY_RESULT_AVAILABLE, &available));
+
+        if (!available)
+            continue;
+
+        it->state = Free;
+
+        if (!it->zone)
+            continue;
+
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        glCheck(GLEXT_glGetQueryObjectui64v(it->begin, GLEXT_GL_QUERY_RESULT, &begin));
+        glCheck(GLEXT_glGetQueryObjectui64v(it->end, GLEXT_GL_QUERY_RESULT, &end));
+
+        // Timestamps are in nanoseconds
+        Time time = microseconds(static_cast<Int64>((end > begin ? end - begin : 0) / 1000));
+
+        ZoneStatistics& zone = *it->zone;
+        zone.lastTime = time;
+        zone.totalTime += time;
+        zone.minTime = (zone.sampleCount == 0) ? time : std::min(zone.minTime, time);
+        zone.maxTime = std::max(zone.maxTime, time);
+        zone.sampleCount++;
+    }
+
+#endif
+}
+
+} // namespace sf
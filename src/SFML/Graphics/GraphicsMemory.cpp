@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GraphicsMemory.hpp>
+#include <SFML/Graphics/GraphicsMemoryTracker.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Resources can be created and destroyed from any thread
+    sf::Mutex mutex;
+
+    sf::GraphicsMemory::Statistics categories[sf::GraphicsMemory::CategoryCount];
+    sf::Uint64 totalPeak = 0;
+
+    // Compute the current total of all the categories
+    sf::Uint64 getTotalBytes()
+    {
+        sf::Uint64 total = 0;
+        for (int i = 0; i < sf::GraphicsMemory::CategoryCount; ++i)
+            total += categories[i].bytes;
+
+        return total;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GraphicsMemory::Statistics::Statistics() :
+bytes       (0),
+paddingBytes(0),
+peakBytes   (0),
+count       (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+GraphicsMemory::Statistics GraphicsMemory::getStatistics(Category category)
+{
+    Lock lock(mutex);
+
+    return categories[category];
+}
+
+
+////////////////////////////////////////////////////////////
+GraphicsMemory::Statistics GraphicsMemory::getTotalStatistics()
+{
+    Lock lock(mutex);
+
+    Statistics total;
+    for (int i = 0; i < CategoryCount; ++i)
+    {
+        total.bytes        += categories[i].bytes;
+        total.paddingBytes += categories[i].paddingBytes;
+        total.count        += categories[i].count;
+    }
+    total.peakBytes = totalPeak;
+
+    return total;
+}
+
+
+////////////////////////////////////////////////////////////
+void GraphicsMemory::resetPeaks()
+{
+    Lock lock(mutex);
+
+    for (int i = 0; i < CategoryCount; ++i)
+        categories[i].peakBytes = categories[i].bytes;
+
+    totalPeak = getTotalBytes();
+}
+
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void updateGraphicsMemory(GraphicsMemory::Category category, Uint64 oldBytes, Uint64 oldPadding, Uint64 newBytes, Uint64 newPadding)
+{
+    if ((oldBytes == newBytes) && (oldPadding == newPadding))
+        return;
+
+    Lock lock(mutex);
+
+    GraphicsMemory::Statistics& statistics = categories[category];
+
+    statistics.bytes = statistics.bytes - oldBytes + newBytes;
+    statistics.paddingBytes = statistics.paddingBytes - oldPadding + newPadding;
+
+    if (oldBytes && !newBytes)
+        statistics.count--;
+    else if (!oldBytes && newBytes)
+        statistics.count++;
+
+    statistics.peakBytes = std::max(statistics.peakBytes, statistics.bytes);
+    totalPeak = std::max(totalPeak, getTotalBytes());
+}
+
+
+////////////////////////////////////////////////////////////
+void moveGraphicsMemory(GraphicsMemory::Category from, GraphicsMemory::Category to, Uint64 bytes, Uint64 padding)
+{
+    if ((from == to) || !bytes)
+        return;
+
+    Lock lock(mutex);
+
+    categories[from].bytes -= bytes;
+    categories[from].paddingBytes -= padding;
+    categories[from].count--;
+
+    categories[to].bytes += bytes;
+    categories[to].paddingBytes += padding;
+    categories[to].count++;
+    categories[to].peakBytes = std::max(categories[to].peakBytes, categories[to].bytes);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GRAPHICSMEMORYTRACKER_HPP
+#define SFML_GRAPHICSMEMORYTRACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GraphicsMemory.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Record a change in the memory held by a graphics resource
+///
+/// Pass zero as the old size when the resource is allocated,
+/// and zero as the new size when it is released.
+///
+/// \param category   Category of the resource
+/// \param oldBytes   Bytes previously held by the resource
+/// \param oldPadding Padding part of \a oldBytes
+/// \param newBytes   Bytes now held by the resource
+/// \param newPadding Padding part of \a newBytes
+///
+////////////////////////////////////////////////////////////
+void updateGraphicsMemory(GraphicsMemory::Category category, Uint64 oldBytes, Uint64 oldPadding, Uint64 newBytes, Uint64 newPadding);
+
+////////////////////////////////////////////////////////////
+/// \brief Move the memory held by a resource to another category
+///
+/// \param from    Previous category of the memory
+/// \param to      New category of the memory
+/// \param bytes   Bytes held by the resource
+/// \param padding Padding part of \a bytes
+///
+////////////////////////////////////////////////////////////
+void moveGraphicsMemory(GraphicsMemory::Category from, GraphicsMemory::Category to, Uint64 bytes, Uint64 padding);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GRAPHICSMEMORYTRACKER_HPP
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/HalfFloat.hpp>
+#include <cstring>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+Uint16 floatToHalf(float value)
+{
+    Uint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    Uint16 sign     = static_cast<Uint16>((bits >> 16) & 0x8000);
+    Int32  exponent = static_cast<Int32>((bits >> 23) & 0xFF) - 127 + 15;
+    Uint32 mantissa = bits & 0x007FFFFF;
+
+    // NaN and infinity
+    if (((bits >> 23) & 0xFF) == 0xFF)
+        return static_cast<Uint16>(sign | 0x7C00 | (mantissa ? 0x0200 : 0));
+
+    // Overflow, clamp to infinity
+    if (exponent >= 0x1F)
+        return static_cast<Uint16>(sign | 0x7C00);
+
+    // Underflow, produce a denormalized half or zero
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+            return sign;
+
+        mantissa |= 0x00800000;
+        Uint32 shift = static_cast<Uint32>(14 - exponent);
+        Uint32 half = mantissa >> shift;
+
+        // Round to nearest
+        if ((mantissa >> (shift - 1)) & 1)
+            ++half;
+
+        return static_cast<Uint16>(sign | half);
+    }
+
+    // Normalized value, round the mantissa to nearest
+    Uint32 half = (static_cast<Uint32>(exponent) << 10) | (mantissa >> 13);
+    if (mantissa & 0x00001000)
+        ++half;
+
+    return static_cast<Uint16>(sign | half);
+}
+
+
+////////////////////////////////////////////////////////////
+float halfToFloat(Uint16 value)
+{
+    Uint32 sign     = static_cast<Uint32>(value & 0x8000) << 16;
+    Uint32 exponent = (value >> 10) & 0x1F;
+    Uint32 mantissa = value & 0x03FF;
+    Uint32 bits;
+
+    if (exponent == 0)
+    {
+        if (mantissa == 0)
+        {
+            // Zero
+            bits = sign;
+        }
+        else
+        {
+            // Denormalized value, renormalize it
+            exponent = 127 - 15 + 1;
+            while (!(mantissa & 0x0400))
+            {
+                mantissa <<= 1;
+                --exponent;
+            }
+            mantissa &= 0x03FF;
+            bits = sign | (exponent << 23) | (mantissa << 13);
+        }
+    }
+    else if (exponent == 0x1F)
+    {
+        // Infinity or NaN
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    }
+    else
+    {
+        // Normalized value
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+} // namespace priv
+
+} // namespace sf
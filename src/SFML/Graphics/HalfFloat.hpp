@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_HALFFLOAT_HPP
+#define SFML_HALFFLOAT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Convert a 32-bit float to a 16-bit IEEE 754 half float
+///
+/// Values that are too large are converted to infinity,
+/// values that are too small are flushed to zero.
+///
+/// \param value Value to convert
+///
+/// \return Bits of the corresponding half float
+///
+////////////////////////////////////////////////////////////
+Uint16 floatToHalf(float value);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert a 16-bit IEEE 754 half float to a 32-bit float
+///
+/// \param value Bits of the half float to convert
+///
+/// \return Corresponding float value
+///
+////////////////////////////////////////////////////////////
+float halfToFloat(Uint16 value);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_HALFFLOAT_HPP
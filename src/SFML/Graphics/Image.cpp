@@ -27,19 +27,220 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/BlendEquation.hpp>
+#include <SFML/Graphics/HalfFloat.hpp>
+#include <SFML/Graphics/Transform.hpp>
 #include <SFML/System/Err.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 
 
+namespace
+{
+    // Convert a normalized half float component to an 8 bits component
+    sf::Uint8 halfToComponent(const sf::Uint8* half)
+    {
+        sf::Uint16 bits;
+        std::memcpy(&bits, half, sizeof(bits));
+        float value = sf::priv::halfToFloat(bits);
+
+        // Also rejects NaN
+        if (!(value > 0.f))
+            return 0;
+        if (value >= 1.f)
+            return 255;
+        return static_cast<sf::Uint8>(value * 255.f + 0.5f);
+    }
+
+    // Convert an 8 bits component to a normalized half float component
+    void componentToHalf(sf::Uint8 component, sf::Uint8* half)
+    {
+        sf::Uint16 bits = sf::priv::floatToHalf(component / 255.f);
+        std::memcpy(half, &bits, sizeof(bits));
+    }
+
+    // Read a pixel stored in the given format
+    sf::Color readPixel(const sf::Uint8* pixel, sf::Image::PixelFormat format)
+    {
+        switch (format)
+        {
+            case sf::Image::RGB8:    return sf::Color(pixel[0], pixel[1], pixel[2]);
+            case sf::Image::RG8:     return sf::Color(pixel[0], pixel[1], 0);
+            case sf::Image::R8:      return sf::Color(pixel[0], 0, 0);
+            case sf::Image::RGBA16F: return sf::Color(halfToComponent(pixel),
+                                                      halfToComponent(pixel + 2),
+                                                      halfToComponent(pixel + 4),
+                                                      halfToComponent(pixel + 6));
+            default:                 return sf::Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+        }
+    }
+
+    // Write a pixel in the given format
+    void writePixel(sf::Uint8* pixel, sf::Image::PixelFormat format, const sf::Color& color)
+    {
+        switch (format)
+        {
+            case sf::Image::RGBA16F:
+                componentToHalf(color.r, pixel);
+                componentToHalf(color.g, pixel + 2);
+                componentToHalf(color.b, pixel + 4);
+                componentToHalf(color.a, pixel + 6);
+                break;
+
+            case sf::Image::RGBA8:
+                pixel[3] = color.a;
+                // fallthrough
+            case sf::Image::RGB8:
+                pixel[2] = color.b;
+                // fallthrough
+            case sf::Image::RG8:
+                pixel[1] = color.g;
+                // fallthrough
+            case sf::Image::R8:
+                pixel[0] = color.r;
+                break;
+        }
+    }
+
+    const float inverse255 = 1.f / 255.f;
+
+    // Read contiguous pixels as normalized RGBA components
+    void loadPixels(const sf::Uint8* pixels, sf::Image::PixelFormat format, std::size_t count, float* components)
+    {
+        if (format == sf::Image::RGBA8)
+        {
+            for (std::size_t i = 0; i < count * 4; ++i)
+                components[i] = pixels[i] * inverse255;
+        }
+        else if (format == sf::Image::RGBA16F)
+        {
+            for (std::size_t i = 0; i < count * 4; ++i)
+            {
+                sf::Uint16 bits;
+                std::memcpy(&bits, pixels + i * 2, sizeof(bits));
+                float value = sf::priv::halfToFloat(bits);
+
+                // Also rejects NaN
+                components[i] = (value > 0.f) ? std::min(value, 1.f) : 0.f;
+            }
+        }
+        else
+        {
+            std::size_t size = sf::Image::getBytesPerPixel(format);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                sf::Color color = readPixel(pixels + i * size, format);
+                components[i * 4 + 0] = color.r * inverse255;
+                components[i * 4 + 1] = color.g * inverse255;
+                components[i * 4 + 2] = color.b * inverse255;
+                components[i * 4 + 3] = color.a * inverse255;
+            }
+        }
+    }
+
+    // Write normalized RGBA components to contiguous pixels
+    void storePixels(sf::Uint8* pixels, sf::Image::PixelFormat format, std::size_t count, const float* components)
+    {
+        if (format == sf::Image::RGBA8)
+        {
+            for (std::size_t i = 0; i < count * 4; ++i)
+                pixels[i] = static_cast<sf::Uint8>(components[i] * 255.f + 0.5f);
+        }
+        else if (format == sf::Image::RGBA16F)
+        {
+            for (std::size_t i = 0; i < count * 4; ++i)
+            {
+                sf::Uint16 bits = sf::priv::floatToHalf(components[i]);
+                std::memcpy(pixels + i * 2, &bits, sizeof(bits));
+            }
+        }
+        else
+        {
+            std::size_t size = sf::Image::getBytesPerPixel(format);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const float* color = components + i * 4;
+                writePixel(pixels + i * size, format, sf::Color(static_cast<sf::Uint8>(color[0] * 255.f + 0.5f),
+                                                                static_cast<sf::Uint8>(color[1] * 255.f + 0.5f),
+                                                                static_cast<sf::Uint8>(color[2] * 255.f + 0.5f),
+                                                                static_cast<sf::Uint8>(color[3] * 255.f + 0.5f)));
+            }
+        }
+    }
+
+    // Modulate normalized RGBA components by a color
+    void modulate(float* components, std::size_t count, const sf::Color& color)
+    {
+        if (color == sf::Color::White)
+            return;
+
+        float factors[4] = {color.r * inverse255, color.g * inverse255, color.b * inverse255, color.a * inverse255};
+        for (std::size_t i = 0; i < count * 4; ++i)
+            components[i] *= factors[i % 4];
+    }
+
+    // Blend a span of source components into a span of destination components;
+    // the common modes get branch-free loops that the compiler can vectorize
+    void blendSpan(const sf::BlendMode& mode, const float* source, float* destination, std::size_t count)
+    {
+        if (mode == sf::BlendNone)
+        {
+            std::copy(source, source + count * 4, destination);
+        }
+        else if (mode == sf::BlendAlpha)
+        {
+            for (std::size_t i = 0; i < count * 4; i += 4)
+            {
+                float alpha = source[i + 3];
+                float inverseAlpha = 1.f - alpha;
+                destination[i + 0] = source[i + 0] * alpha + destination[i + 0] * inverseAlpha;
+                destination[i + 1] = source[i + 1] * alpha + destination[i + 1] * inverseAlpha;
+                destination[i + 2] = source[i + 2] * alpha + destination[i + 2] * inverseAlpha;
+                destination[i + 3] = alpha + destination[i + 3] * inverseAlpha;
+            }
+        }
+        else if (mode == sf::BlendMultiply)
+        {
+            for (std::size_t i = 0; i < count * 4; ++i)
+                destination[i] *= source[i];
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count * 4; i += 4)
+            {
+                float result[4];
+                sf::priv::blendColors(mode, source + i, destination + i, result);
+                std::copy(result, result + 4, destination + i);
+            }
+        }
+    }
+
+    // Resolve the source rectangle of a blend: empty means the whole image, and it must lie inside the image
+    bool getBlendSourceRect(const sf::Image& source, const sf::IntRect& sourceRect, sf::IntRect& result)
+    {
+        sf::IntRect bounds(0, 0, static_cast<int>(source.getSize().x), static_cast<int>(source.getSize().y));
+
+        if ((sourceRect.width == 0) || (sourceRect.height == 0))
+        {
+            result = bounds;
+            return (bounds.width > 0) && (bounds.height > 0);
+        }
+
+        return bounds.intersects(sourceRect, result);
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Image::Image() :
-m_size(0, 0)
+m_size  (0, 0),
+m_format(RGBA8)
 {
 
 }
@@ -53,104 +254,137 @@ Image::~Image()
 
 
 ////////////////////////////////////////////////////////////
-void Image::create(unsigned int width, unsigned int height, const Color& color)
+void Image::create(unsigned int width, unsigned int height, const Color& color, PixelFormat format)
 {
     if (width && height)
     {
         // Create a new pixel buffer first for exception safety's sake
-        std::vector<Uint8> newPixels(width * height * 4);
-    
-        // Fill it with the specified color
+        std::size_t pixelSize = getBytesPerPixel(format);
+        std::vector<Uint8> newPixels(width * height * pixelSize);
+
+        // Encode the specified color once
+        Uint8 pixel[8];
+        writePixel(pixel, format, color);
+
+        // Fill the buffer with it
         Uint8* ptr = &newPixels[0];
         Uint8* end = ptr + newPixels.size();
         while (ptr < end)
         {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
+            std::memcpy(ptr, pixel, pixelSize);
+            ptr += pixelSize;
         }
-    
+
         // Commit the new pixel buffer
         m_pixels.swap(newPixels);
-        
-        // Assign the new size
+
+        // Assign the new size and format
         m_size.x = width;
         m_size.y = height;
+        m_format = format;
     }
     else
     {
         // Dump the pixel buffer
         std::vector<Uint8>().swap(m_pixels);
-        
-        // Assign the new size
+
+        // Assign the new size and format
         m_size.x = 0;
         m_size.y = 0;
+        m_format = format;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
+void Image::create(unsigned int width, unsigned int height, const Uint8* pixels, PixelFormat format)
 {
     if (pixels && width && height)
     {
         // Create a new pixel buffer first for exception safety's sake
-        std::vector<Uint8> newPixels(pixels, pixels + width * height * 4);
-        
+        std::vector<Uint8> newPixels(pixels, pixels + width * height * getBytesPerPixel(format));
+
         // Commit the new pixel buffer
         m_pixels.swap(newPixels);
-        
-        // Assign the new size
+
+        // Assign the new size and format
         m_size.x = width;
         m_size.y = height;
+        m_format = format;
     }
     else
     {
         // Dump the pixel buffer
         std::vector<Uint8>().swap(m_pixels);
-        
-        // Assign the new size
+
+        // Assign the new size and format
         m_size.x = 0;
         m_size.y = 0;
+        m_format = format;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::loadFromFile(const std::string& filename)
+bool Image::loadFromFile(const std::string& filename, PixelFormat format)
 {
     #ifndef SFML_SYSTEM_ANDROID
 
-        return priv::ImageLoader::getInstance().loadImageFromFile(filename, m_pixels, m_size);
+        if (priv::ImageLoader::getInstance().loadImageFromFile(filename, m_pixels, m_size, format))
+        {
+            m_format = format;
+            return true;
+        }
+
+        return false;
 
     #else
 
         priv::ResourceStream stream(filename);
-        return loadFromStream(stream);
+        return loadFromStream(stream, format);
 
     #endif
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::loadFromMemory(const void* data, std::size_t size)
+bool Image::loadFromMemory(const void* data, std::size_t size, PixelFormat format)
 {
-    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size);
+    if (priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size, format))
+    {
+        m_format = format;
+        return true;
+    }
+
+    return false;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::loadFromStream(InputStream& stream)
+bool Image::loadFromStream(InputStream& stream, PixelFormat format)
 {
-    return priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size);
+    if (priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size, format))
+    {
+        m_format = format;
+        return true;
+    }
+
+    return false;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::saveToFile(const std::string& filename) const
 {
-    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size);
+    if (m_format != RGBA16F)
+        return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size, static_cast<int>(getBytesPerPixel(m_format)));
+
+    // Image writers only support 8 bits channels, convert the pixels first
+    std::vector<Uint8> pixels(m_size.x * m_size.y * 4);
+    for (std::size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = halfToComponent(&m_pixels[i * 2]);
+
+    return priv::ImageLoader::getInstance().saveImageToFile(filename, pixels, m_size, 4);
 }
 
 
@@ -161,9 +395,51 @@ Vector2u Image::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+Image::PixelFormat Image::getPixelFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Image::getBytesPerPixel(PixelFormat format)
+{
+    switch (format)
+    {
+        case RGB8:    return 3;
+        case RG8:     return 2;
+        case R8:      return 1;
+        case RGBA16F: return 8;
+        default:      return 4;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::createMaskFromColor(const Color& color, Uint8 alpha)
 {
+    // Formats without alpha channel can't be made transparent
+    if ((m_format != RGBA8) && (m_format != RGBA16F))
+        return;
+
+    // Pixels of other formats have to be decoded one by one
+    if ((m_format != RGBA8) && !m_pixels.empty())
+    {
+        std::size_t pixelSize = getBytesPerPixel(m_format);
+        for (Uint8* ptr = &m_pixels[0]; ptr < &m_pixels[0] + m_pixels.size(); ptr += pixelSize)
+        {
+            Color pixel = readPixel(ptr, m_format);
+            if (pixel == color)
+            {
+                pixel.a = alpha;
+                writePixel(ptr, m_format, pixel);
+            }
+        }
+
+        return;
+    }
+
     // Make sure that the image is not empty
     if (!m_pixels.empty())
     {
@@ -215,15 +491,49 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
         return;
 
     // Precompute as much as possible
-    int          pitch     = width * 4;
+    int          srcSize   = static_cast<int>(getBytesPerPixel(source.m_format));
+    int          dstSize   = static_cast<int>(getBytesPerPixel(m_format));
+    int          pitch     = width * dstSize;
     int          rows      = height;
-    int          srcStride = source.m_size.x * 4;
-    int          dstStride = m_size.x * 4;
-    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * 4;
-    Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * 4;
+    int          srcStride = source.m_size.x * srcSize;
+    int          dstStride = m_size.x * dstSize;
+    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * srcSize;
+    Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * dstSize;
+
+    // Source pixels without alpha channel are opaque
+    if ((source.m_format != RGBA8) && (source.m_format != RGBA16F))
+        applyAlpha = false;
 
     // Copy the pixels
-    if (applyAlpha)
+    if ((source.m_format != m_format) || (applyAlpha && (m_format != RGBA8)))
+    {
+        // Conversion between formats, pixel by pixel (slowest)
+        for (int i = 0; i < rows; ++i)
+        {
+            for (int j = 0; j < width; ++j)
+            {
+                Color src = readPixel(srcPixels + j * srcSize, source.m_format);
+                Uint8* dst = dstPixels + j * dstSize;
+
+                if (applyAlpha)
+                {
+                    // Interpolate RGBA components using the alpha value of the source pixel
+                    Color color = readPixel(dst, m_format);
+                    Uint8 alpha = src.a;
+                    src.r = static_cast<Uint8>((src.r * alpha + color.r * (255 - alpha)) / 255);
+                    src.g = static_cast<Uint8>((src.g * alpha + color.g * (255 - alpha)) / 255);
+                    src.b = static_cast<Uint8>((src.b * alpha + color.b * (255 - alpha)) / 255);
+                    src.a = static_cast<Uint8>(alpha + color.a * (255 - alpha) / 255);
+                }
+
+                writePixel(dst, m_format, src);
+            }
+
+            srcPixels += srcStride;
+            dstPixels += dstStride;
+        }
+    }
+    else if (applyAlpha)
     {
         // Interpolation using alpha values, pixel by pixel (slower)
         for (int i = 0; i < rows; ++i)
@@ -259,22 +569,142 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
 }
 
 
+////////////////////////////////////////////////////////////
+void Image::blend(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect, const BlendMode& mode, const Color& tint)
+{
+    // Make sure that both images are valid and overlap
+    IntRect srcRect;
+    if (!getBlendSourceRect(source, sourceRect, srcRect) || (destX >= m_size.x) || (destY >= m_size.y))
+        return;
+
+    std::size_t width  = std::min(static_cast<std::size_t>(srcRect.width),  static_cast<std::size_t>(m_size.x - destX));
+    std::size_t height = std::min(static_cast<std::size_t>(srcRect.height), static_cast<std::size_t>(m_size.y - destY));
+
+    std::size_t srcSize = getBytesPerPixel(source.m_format);
+    std::size_t dstSize = getBytesPerPixel(m_format);
+
+    // Blend row by row, through normalized components
+    std::vector<float> sourceRow(width * 4);
+    std::vector<float> destinationRow(width * 4);
+
+    for (std::size_t i = 0; i < height; ++i)
+    {
+        const Uint8* srcPixels = &source.m_pixels[((srcRect.top + i) * source.m_size.x + srcRect.left) * srcSize];
+        Uint8*       dstPixels = &m_pixels[((destY + i) * m_size.x + destX) * dstSize];
+
+        loadPixels(srcPixels, source.m_format, width, &sourceRow[0]);
+        modulate(&sourceRow[0], width, tint);
+        loadPixels(dstPixels, m_format, width, &destinationRow[0]);
+        blendSpan(mode, &sourceRow[0], &destinationRow[0], width);
+        storePixels(dstPixels, m_format, width, &destinationRow[0]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::blend(const Image& source, const Transform& transform, const IntRect& sourceRect, const BlendMode& mode, const Color& tint)
+{
+    // Make sure that both images are valid
+    IntRect srcRect;
+    if (!getBlendSourceRect(source, sourceRect, srcRect) || (m_size.x == 0) || (m_size.y == 0))
+        return;
+
+    // A degenerate transform covers no pixel
+    const float* matrix = transform.getMatrix();
+    if (matrix[0] * matrix[5] - matrix[1] * matrix[4] == 0.f)
+        return;
+
+    // Find the pixels that the transformed rectangle may cover
+    FloatRect bounds = transform.transformRect(FloatRect(0, 0, static_cast<float>(srcRect.width), static_cast<float>(srcRect.height)));
+    int left   = std::max(static_cast<int>(std::floor(bounds.left)), 0);
+    int top    = std::max(static_cast<int>(std::floor(bounds.top)), 0);
+    int right  = std::min(static_cast<int>(std::ceil(bounds.left + bounds.width)), static_cast<int>(m_size.x));
+    int bottom = std::min(static_cast<int>(std::ceil(bounds.top + bounds.height)), static_cast<int>(m_size.y));
+
+    if ((left >= right) || (top >= bottom))
+        return;
+
+    const float* inverse = transform.getInverse().getMatrix();
+    float width  = static_cast<float>(srcRect.width);
+    float height = static_cast<float>(srcRect.height);
+
+    std::size_t srcSize = getBytesPerPixel(source.m_format);
+    std::size_t dstSize = getBytesPerPixel(m_format);
+
+    std::vector<float> sourceRow((right - left) * 4);
+    std::vector<float> destinationRow((right - left) * 4);
+
+    for (int y = top; y < bottom; ++y)
+    {
+        // The rectangle is convex: the covered pixel centers of a row are contiguous
+        int first = right;
+        std::size_t count = 0;
+
+        for (int x = left; x < right; ++x)
+        {
+            float centerX = x + 0.5f;
+            float centerY = y + 0.5f;
+            float localX = inverse[0] * centerX + inverse[4] * centerY + inverse[12];
+            float localY = inverse[1] * centerX + inverse[5] * centerY + inverse[13];
+
+            if ((localX >= 0.f) && (localX < width) && (localY >= 0.f) && (localY < height))
+            {
+                first = std::min(first, x);
+
+                std::size_t sourceX = srcRect.left + static_cast<std::size_t>(localX);
+                std::size_t sourceY = srcRect.top + static_cast<std::size_t>(localY);
+                loadPixels(&source.m_pixels[(sourceY * source.m_size.x + sourceX) * srcSize], source.m_format, 1, &sourceRow[count * 4]);
+                ++count;
+            }
+            else if (count > 0)
+            {
+                break;
+            }
+        }
+
+        if (count == 0)
+            continue;
+
+        Uint8* dstPixels = &m_pixels[(static_cast<std::size_t>(y) * m_size.x + first) * dstSize];
+
+        modulate(&sourceRow[0], count, tint);
+        loadPixels(dstPixels, m_format, count, &destinationRow[0]);
+        blendSpan(mode, &sourceRow[0], &destinationRow[0], count);
+        storePixels(dstPixels, m_format, count, &destinationRow[0]);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 {
-    Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
-    *pixel++ = color.r;
-    *pixel++ = color.g;
-    *pixel++ = color.b;
-    *pixel++ = color.a;
+    if (m_format == RGBA8)
+    {
+        Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
+        *pixel++ = color.r;
+        *pixel++ = color.g;
+        *pixel++ = color.b;
+        *pixel++ = color.a;
+    }
+    else
+    {
+        writePixel(&m_pixels[(x + y * m_size.x) * getBytesPerPixel(m_format)], m_format, color);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 Color Image::getPixel(unsigned int x, unsigned int y) const
 {
-    const Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
-    return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+    if (m_format == RGBA8)
+    {
+        const Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
+        return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+    }
+    else
+    {
+        return readPixel(&m_pixels[(x + y * m_size.x) * getBytesPerPixel(m_format)], m_format);
+    }
 }
 
 
@@ -298,19 +728,20 @@ void Image::flipHorizontally()
 {
     if (!m_pixels.empty())
     {
-        std::size_t rowSize = m_size.x * 4;
+        std::size_t pixelSize = getBytesPerPixel(m_format);
+        std::size_t rowSize = m_size.x * pixelSize;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
         {
             std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
+            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - pixelSize;
 
             for (std::size_t x = 0; x < m_size.x / 2; ++x)
             {
-                std::swap_ranges(left, left + 4, right);
+                std::swap_ranges(left, left + pixelSize, right);
 
-                left += 4;
-                right -= 4;
+                left += pixelSize;
+                right -= pixelSize;
             }
         }
     }
@@ -322,7 +753,7 @@ void Image::flipVertically()
 {
     if (!m_pixels.empty())
     {
-        std::size_t rowSize = m_size.x * 4;
+        std::size_t rowSize = m_size.x * getBytesPerPixel(m_format);
 
         std::vector<Uint8>::iterator top = m_pixels.begin();
         std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
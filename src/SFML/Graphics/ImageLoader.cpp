@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/HalfFloat.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
 #define STB_IMAGE_IMPLEMENTATION
@@ -33,6 +34,7 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 #include <cctype>
+#include <cstring>
 
 
 namespace
@@ -61,6 +63,60 @@ namespace
         sf::InputStream* stream = static_cast<sf::InputStream*>(user);
         return stream->tell() >= stream->getSize();
     }
+
+    // Number of channels to request from stb_image for a pixel format
+    int getChannelCount(sf::Image::PixelFormat format)
+    {
+        switch (format)
+        {
+            case sf::Image::R8:   return STBI_grey;
+            case sf::Image::RG8:  return STBI_grey_alpha;
+            case sf::Image::RGB8: return STBI_rgb;
+            default:              return STBI_rgb_alpha;
+        }
+    }
+
+    // Conversion of the components decoded by stb_image to half floats
+    sf::Uint16 toHalf(unsigned char value) {return sf::priv::floatToHalf(value / 255.f);}
+    sf::Uint16 toHalf(float value)         {return sf::priv::floatToHalf(value);}
+
+    // Copy the pixels decoded by stb_image to the pixel buffer, and free them
+    template <typename T>
+    bool storePixels(T* ptr, int width, int height, sf::Image::PixelFormat format, std::vector<sf::Uint8>& pixels, sf::Vector2u& size)
+    {
+        if (!ptr)
+            return false;
+
+        // Assign the image properties
+        size.x = width;
+        size.y = height;
+
+        if (width && height)
+        {
+            if (format == sf::Image::RGBA16F)
+            {
+                // Convert the loaded components to half floats
+                std::size_t count = width * height * 4;
+                pixels.resize(count * sizeof(sf::Uint16));
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    sf::Uint16 half = toHalf(ptr[i]);
+                    std::memcpy(&pixels[i * sizeof(sf::Uint16)], &half, sizeof(sf::Uint16));
+                }
+            }
+            else
+            {
+                // Copy the loaded pixels to the pixel buffer
+                pixels.resize(width * height * sf::Image::getBytesPerPixel(format));
+                std::memcpy(&pixels[0], ptr, pixels.size());
+            }
+        }
+
+        // Free the loaded pixels (they are now in our own pixel buffer)
+        stbi_image_free(ptr);
+
+        return true;
+    }
 }
 
 
@@ -92,33 +148,29 @@ ImageLoader::~ImageLoader()
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size, Image::PixelFormat format)
 {
     // Clear the array (just in case)
     pixels.clear();
 
-    // Load the image and get a pointer to the pixels in memory
+    // Load the image and copy the decoded pixels, keeping the full range of HDR images for float formats
     int width = 0;
     int height = 0;
     int channels = 0;
-    unsigned char* ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
-
-    if (ptr)
+    bool loaded;
+    if ((format == Image::RGBA16F) && stbi_is_hdr(filename.c_str()))
     {
-        // Assign the image properties
-        size.x = width;
-        size.y = height;
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+        float* ptr = stbi_loadf(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+        loaded = storePixels(ptr, width, height, format, pixels, size);
+    }
+    else
+    {
+        unsigned char* ptr = stbi_load(filename.c_str(), &width, &height, &channels, getChannelCount(format));
+        loaded = storePixels(ptr, width, height, format, pixels, size);
+    }
 
+    if (loaded)
+    {
         return true;
     }
     else
@@ -132,7 +184,7 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size, Image::PixelFormat format)
 {
     // Check input parameters
     if (data && dataSize)
@@ -140,29 +192,26 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
         // Clear the array (just in case)
         pixels.clear();
 
-        // Load the image and get a pointer to the pixels in memory
+        // Load the image and copy the decoded pixels, keeping the full range of HDR images for float formats
         int width = 0;
         int height = 0;
         int channels = 0;
         const unsigned char* buffer = static_cast<const unsigned char*>(data);
-        unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, STBI_rgb_alpha);
-
-        if (ptr)
+        int length = static_cast<int>(dataSize);
+        bool loaded;
+        if ((format == Image::RGBA16F) && stbi_is_hdr_from_memory(buffer, length))
         {
-            // Assign the image properties
-            size.x = width;
-            size.y = height;
-
-            if (width && height)
-            {
-                // Copy the loaded pixels to the pixel buffer
-                pixels.resize(width * height * 4);
-                memcpy(&pixels[0], ptr, pixels.size());
-            }
-
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
+            float* ptr = stbi_loadf_from_memory(buffer, length, &width, &height, &channels, STBI_rgb_alpha);
+            loaded = storePixels(ptr, width, height, format, pixels, size);
+        }
+        else
+        {
+            unsigned char* ptr = stbi_load_from_memory(buffer, length, &width, &height, &channels, getChannelCount(format));
+            loaded = storePixels(ptr, width, height, format, pixels, size);
+        }
 
+        if (loaded)
+        {
             return true;
         }
         else
@@ -182,7 +231,7 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size, Image::PixelFormat format)
 {
     // Clear the array (just in case)
     pixels.clear();
@@ -196,28 +245,28 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
     callbacks.skip = &skip;
     callbacks.eof  = &eof;
 
-    // Load the image and get a pointer to the pixels in memory
+    // Check whether the full range of a HDR image must be kept (this consumes the beginning of the stream)
+    bool hdr = (format == Image::RGBA16F) && stbi_is_hdr_from_callbacks(&callbacks, &stream);
+    stream.seek(0);
+
+    // Load the image and copy the decoded pixels
     int width = 0;
     int height = 0;
     int channels = 0;
-    unsigned char* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &channels, STBI_rgb_alpha);
-
-    if (ptr)
+    bool loaded;
+    if (hdr)
     {
-        // Assign the image properties
-        size.x = width;
-        size.y = height;
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+        float* ptr = stbi_loadf_from_callbacks(&callbacks, &stream, &width, &height, &channels, STBI_rgb_alpha);
+        loaded = storePixels(ptr, width, height, format, pixels, size);
+    }
+    else
+    {
+        unsigned char* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &channels, getChannelCount(format));
+        loaded = storePixels(ptr, width, height, format, pixels, size);
+    }
 
+    if (loaded)
+    {
         return true;
     }
     else
@@ -231,7 +280,7 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size, int channels)
 {
     // Make sure the image is not empty
     if (!pixels.empty() && (size.x > 0) && (size.y > 0))
@@ -245,25 +294,25 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
         if (extension == "bmp")
         {
             // BMP format
-            if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+            if (stbi_write_bmp(filename.c_str(), size.x, size.y, channels, &pixels[0]))
                 return true;
         }
         else if (extension == "tga")
         {
             // TGA format
-            if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+            if (stbi_write_tga(filename.c_str(), size.x, size.y, channels, &pixels[0]))
                 return true;
         }
         else if (extension == "png")
         {
             // PNG format
-            if (stbi_write_png(filename.c_str(), size.x, size.y, 4, &pixels[0], 0))
+            if (stbi_write_png(filename.c_str(), size.x, size.y, channels, &pixels[0], 0))
                 return true;
         }
         else if (extension == "jpg" || extension == "jpeg")
         {
             // JPG format
-            if (stbi_write_jpg(filename.c_str(), size.x, size.y, 4, &pixels[0], 90))
+            if (stbi_write_jpg(filename.c_str(), size.x, size.y, channels, &pixels[0], 90))
                 return true;
         }
     }
@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <string>
@@ -62,11 +63,12 @@ public:
     /// \param filename Path of image file to load
     /// \param pixels   Array of pixels to fill with loaded image
     /// \param size     Size of loaded image, in pixels
+    /// \param format   Pixel format to decode the image to
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size, Image::PixelFormat format);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file in memory
@@ -75,11 +77,12 @@ public:
     /// \param dataSize Size of the data to load, in bytes
     /// \param pixels   Array of pixels to fill with loaded image
     /// \param size     Size of loaded image, in pixels
+    /// \param format   Pixel format to decode the image to
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size, Image::PixelFormat format);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a custom stream
@@ -87,11 +90,12 @@ public:
     /// \param stream Source stream to read from
     /// \param pixels Array of pixels to fill with loaded image
     /// \param size   Size of loaded image, in pixels
+    /// \param format Pixel format to decode the image to
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size, Image::PixelFormat format);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
@@ -99,11 +103,12 @@ public:
     /// \param filename Path of image file to save
     /// \param pixels   Array of pixels to save to image
     /// \param size     Size of image to save, in pixels
+    /// \param channels Number of 8 bits channels per pixel (1 to 4)
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size, int channels);
 
 private:
 
@@ -0,0 +1,425 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GraphicsMemoryTracker.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    GLenum usageToGlEnum(sf::IndexBuffer::Usage usage)
+    {
+        switch (usage)
+        {
+            case sf::IndexBuffer::Static:  return GLEXT_GL_STATIC_DRAW;
+            case sf::IndexBuffer::Dynamic: return GLEXT_GL_DYNAMIC_DRAW;
+            default:                       return GLEXT_GL_STREAM_DRAW;
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer() :
+m_buffer(0),
+m_size  (0),
+m_type  (Index16),
+m_usage (Stream)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer(IndexBuffer::IndexType type) :
+m_buffer(0),
+m_size  (0),
+m_type  (type),
+m_usage (Stream)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer(IndexBuffer::Usage usage) :
+m_buffer(0),
+m_size  (0),
+m_type  (Index16),
+m_usage (usage)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer(IndexBuffer::IndexType type, IndexBuffer::Usage usage) :
+m_buffer(0),
+m_size  (0),
+m_type  (type),
+m_usage (usage)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer(const IndexBuffer& copy) :
+m_buffer(0),
+m_size  (0),
+m_type  (copy.m_type),
+m_usage (copy.m_usage)
+{
+    if (copy.m_buffer && copy.m_size)
+    {
+        if (!create(copy.m_size))
+        {
+            err() << "Could not create index buffer for copying" << std::endl;
+            return;
+        }
+
+        if (!update(copy))
+            err() << "Could not copy index buffer" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::~IndexBuffer()
+{
+    if (m_buffer)
+    {
+        TransientContextLock contextLock;
+
+        glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+
+        priv::updateGraphicsMemory(GraphicsMemory::IndexBuffers, getMemoryUsage(), 0, 0, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::create(std::size_t indexCount)
+{
+    if (!isAvailable())
+        return false;
+
+    TransientContextLock contextLock;
+
+    if (!m_buffer)
+        glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+
+    if (!m_buffer)
+    {
+        err() << "Could not create index buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ELEMENT_ARRAY_BUFFER, getIndexSize(m_type) * indexCount, 0, usageToGlEnum(m_usage)));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, 0));
+
+    priv::updateGraphicsMemory(GraphicsMemory::IndexBuffers, getMemoryUsage(), 0, getIndexSize(m_type) * indexCount, 0);
+
+    m_size = indexCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t IndexBuffer::getIndexCount() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::update(const Uint16* indices)
+{
+    return update(indices, m_size, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::update(const Uint16* indices, std::size_t indexCount, unsigned int offset)
+{
+    if (m_type != Index16)
+    {
+        err() << "Could not update index buffer, it doesn't store 16-bit indices" << std::endl;
+        return false;
+    }
+
+    return updateData(indices, indexCount, offset);
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::update(const Uint32* indices)
+{
+    return update(indices, m_size, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::update(const Uint32* indices, std::size_t indexCount, unsigned int offset)
+{
+    if (m_type != Index32)
+    {
+        err() << "Could not update index buffer, it doesn't store 32-bit indices" << std::endl;
+        return false;
+    }
+
+    return updateData(indices, indexCount, offset);
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::update(const IndexBuffer& indexBuffer)
+{
+#ifdef SFML_OPENGL_ES
+
+    return false;
+
+#else
+
+    if (!m_buffer || !indexBuffer.m_buffer)
+        return false;
+
+    if (m_type != indexBuffer.m_type)
+    {
+        err() << "Could not copy index buffer, index types don't match" << std::endl;
+        return false;
+    }
+
+    TransientContextLock contextLock;
+
+    // Make sure that extensions are initialized
+    sf::priv::ensureExtensionsInit();
+
+    std::size_t size = getIndexSize(m_type) * indexBuffer.m_size;
+
+    if (GLEXT_copy_buffer)
+    {
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, indexBuffer.m_buffer));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, m_buffer));
+
+        glCheck(GLEXT_glCopyBufferSubData(GLEXT_GL_COPY_READ_BUFFER, GLEXT_GL_COPY_WRITE_BUFFER, 0, 0, size));
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, 0));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, 0));
+
+        return true;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ELEMENT_ARRAY_BUFFER, size, 0, usageToGlEnum(m_usage)));
+
+    // The buffer was reallocated to the size of the source
+    priv::updateGraphicsMemory(GraphicsMemory::IndexBuffers, getMemoryUsage(), 0, size, 0);
+    m_size = indexBuffer.m_size;
+
+    void* destination = 0;
+    glCheck(destination = GLEXT_glMapBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, GLEXT_GL_WRITE_ONLY));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, indexBuffer.m_buffer));
+
+    void* source = 0;
+    glCheck(source = GLEXT_glMapBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, GLEXT_GL_READ_ONLY));
+
+    std::memcpy(destination, source, size);
+
+    GLboolean sourceResult = GL_FALSE;
+    glCheck(sourceResult = GLEXT_glUnmapBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, m_buffer));
+
+    GLboolean destinationResult = GL_FALSE;
+    glCheck(destinationResult = GLEXT_glUnmapBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, 0));
+
+    if ((sourceResult == GL_FALSE) || (destinationResult == GL_FALSE))
+        return false;
+
+    return true;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer& IndexBuffer::operator =(const IndexBuffer& right)
+{
+    IndexBuffer temp(right);
+
+    swap(temp);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexBuffer::swap(IndexBuffer& right)
+{
+    std::swap(m_size,   right.m_size);
+    std::swap(m_buffer, right.m_buffer);
+    std::swap(m_type,   right.m_type);
+    std::swap(m_usage,  right.m_usage);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 IndexBuffer::getMemoryUsage() const
+{
+    return m_buffer ? getIndexSize(m_type) * m_size : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int IndexBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexType IndexBuffer::getIndexType() const
+{
+    return m_type;
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexBuffer::setUsage(IndexBuffer::Usage usage)
+{
+    m_usage = usage;
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::Usage IndexBuffer::getUsage() const
+{
+    return m_usage;
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexBuffer::bind(const IndexBuffer* indexBuffer)
+{
+    if (!isAvailable())
+        return;
+
+    TransientContextLock lock;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, indexBuffer ? indexBuffer->m_buffer : 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::isAvailable()
+{
+    // Index buffers rely on the same extension as vertex buffers
+    return VertexBuffer::isAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t IndexBuffer::getIndexSize(IndexType type)
+{
+    return (type == Index32) ? sizeof(Uint32) : sizeof(Uint16);
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::updateData(const void* indices, std::size_t indexCount, unsigned int offset)
+{
+    // Sanity checks
+    if (!m_buffer)
+        return false;
+
+    if (!indices)
+        return false;
+
+    if (offset && (offset + indexCount > m_size))
+        return false;
+
+    TransientContextLock contextLock;
+
+    std::size_t indexSize = getIndexSize(m_type);
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, m_buffer));
+
+    // Check if we need to resize or orphan the buffer
+    if (indexCount >= m_size)
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ELEMENT_ARRAY_BUFFER, indexSize * indexCount, 0, usageToGlEnum(m_usage)));
+
+        priv::updateGraphicsMemory(GraphicsMemory::IndexBuffers, getMemoryUsage(), 0, indexSize * indexCount, 0);
+
+        m_size = indexCount;
+    }
+
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ELEMENT_ARRAY_BUFFER, indexSize * offset, indexSize * indexCount, indices));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, 0));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::readIndices(std::size_t firstIndex, std::size_t indexCount, void* indices) const
+{
+#ifdef SFML_OPENGL_ES
+
+    return false;
+
+#else
+
+    if (!m_buffer || (firstIndex + indexCount > m_size))
+        return false;
+
+    if (!indexCount)
+        return true;
+
+    const std::size_t indexSize = getIndexSize(m_type);
+
+    TransientContextLock contextLock;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, m_buffer));
+    glCheck(GLEXT_glGetBufferSubData(GLEXT_GL_ELEMENT_ARRAY_BUFFER, indexSize * firstIndex, indexSize * indexCount, indices));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, 0));
+
+    return true;
+
+#endif // SFML_OPENGL_ES
+}
+
+} // namespace sf
@@ -0,0 +1,336 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/InstancedRenderer.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GraphicsMemoryTracker.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+#ifndef SFML_OPENGL_ES
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+
+#endif
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+
+    // Layout of the per-instance attributes, in floats:
+    // two transform rows (3 + 3), color (4), texture rectangle (4)
+    const std::size_t floatsPerInstance = 14;
+    const int         attributeSizes[4]   = {3, 3, 4, 4};
+    const std::size_t attributeOffsets[4] = {0, 3, 6, 10};
+    const char* const attributeNames[4]   = {"sf_instanceRow0", "sf_instanceRow1", "sf_instanceColor", "sf_instanceTexRect"};
+
+    // The instance transform is applied in the vertex shader, the render states
+    // transform and the view are provided by the fixed-function matrices
+    const char vertexShaderSource[] =
+        "attribute vec3 sf_instanceRow0;\n"
+        "attribute vec3 sf_instanceRow1;\n"
+        "attribute vec4 sf_instanceColor;\n"
+        "attribute vec4 sf_instanceTexRect;\n"
+        "varying vec4 sf_color;\n"
+        "varying vec2 sf_texCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    vec3 position = vec3(gl_Vertex.xy, 1.0);\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * vec4(dot(sf_instanceRow0, position), dot(sf_instanceRow1, position), 0.0, 1.0);\n"
+        "    vec2 texCoords = sf_instanceTexRect.xy + gl_MultiTexCoord0.xy * sf_instanceTexRect.zw;\n"
+        "    sf_texCoords = (gl_TextureMatrix[0] * vec4(texCoords, 0.0, 1.0)).xy;\n"
+        "    sf_color = gl_Color * sf_instanceColor;\n"
+        "}\n";
+
+    const char fragmentShaderSource[] =
+        "uniform sampler2D sf_texture;\n"
+        "uniform float sf_textured;\n"
+        "varying vec4 sf_color;\n"
+        "varying vec2 sf_texCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = sf_color * mix(vec4(1.0), texture2D(sf_texture, sf_texCoords), sf_textured);\n"
+        "}\n";
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+InstancedRenderer::InstancedRenderer() :
+m_shader       (),
+m_buffer       (0),
+m_bufferSize   (0),
+m_initialized  (false),
+m_valid        (false),
+m_textured     (false),
+m_instanceData ()
+{
+    std::fill(m_locations, m_locations + 4, -1);
+}
+
+
+////////////////////////////////////////////////////////////
+InstancedRenderer::~InstancedRenderer()
+{
+    if (m_buffer)
+    {
+        TransientContextLock contextLock;
+
+        GLStateCache::forgetBuffer(m_buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+        priv::updateGraphicsMemory(GraphicsMemory::VertexBuffers, m_bufferSize, 0, 0, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstancedRenderer::bind(const InstanceData* instances, std::size_t instanceCount, bool textured)
+{
+    if (!m_initialized)
+    {
+        m_initialized = true;
+        m_valid = initialize();
+    }
+
+    if (!m_valid)
+        return false;
+
+    // Convert the instances to the attribute layout expected by the shader
+    m_instanceData.resize(instanceCount * floatsPerInstance);
+    float* data = &m_instanceData[0];
+
+    for (std::size_t i = 0; i < instanceCount; ++i)
+    {
+        const float* matrix = instances[i].transform.getMatrix();
+        const Color& color = instances[i].color;
+        const FloatRect& rect = instances[i].textureRect;
+
+        data[0]  = matrix[0];
+        data[1]  = matrix[4];
+        data[2]  = matrix[12];
+        data[3]  = matrix[1];
+        data[4]  = matrix[5];
+        data[5]  = matrix[13];
+        data[6]  = color.r / 255.f;
+        data[7]  = color.g / 255.f;
+        data[8]  = color.b / 255.f;
+        data[9]  = color.a / 255.f;
+        data[10] = rect.left;
+        data[11] = rect.top;
+        data[12] = rect.width;
+        data[13] = rect.height;
+
+        data += floatsPerInstance;
+    }
+
+    std::size_t size = m_instanceData.size() * sizeof(float);
+
+    GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer);
+
+    // Orphan the previous contents (growing the buffer if needed) so
+    // that the upload doesn't wait for pending draws to complete
+    std::size_t bufferSize = std::max(size, m_bufferSize);
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, bufferSize, NULL, GLEXT_GL_STREAM_DRAW));
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, 0, size, &m_instanceData[0]));
+
+    if (bufferSize != m_bufferSize)
+    {
+        priv::updateGraphicsMemory(GraphicsMemory::VertexBuffers, m_bufferSize, 0, bufferSize, 0);
+        m_bufferSize = bufferSize;
+    }
+
+    // Attributes advance once per instance instead of once per vertex
+    for (int i = 0; i < 4; ++i)
+    {
+        GLuint location = static_cast<GLuint>(m_locations[i]);
+        const void* offset = reinterpret_cast<const void*>(attributeOffsets[i] * sizeof(float));
+
+        glCheck(GLEXT_glEnableVertexAttribArray(location));
+        glCheck(GLEXT_glVertexAttribPointer(location, attributeSizes[i], GL_FLOAT, GL_FALSE, static_cast<GLsizei>(floatsPerInstance * sizeof(float)), offset));
+        glCheck(GLEXT_glVertexAttribDivisor(location, 1));
+    }
+
+    GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, 0);
+
+    if (textured != m_textured)
+    {
+        m_shader.setUniform("sf_textured", textured ? 1.f : 0.f);
+        m_textured = textured;
+    }
+
+    Shader::bind(&m_shader, false, true);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancedRenderer::unbind()
+{
+    Shader::bind(NULL, false, true);
+
+    // Restore the default divisor, other shaders may reuse these locations
+    for (int i = 0; i < 4; ++i)
+    {
+        GLuint location = static_cast<GLuint>(m_locations[i]);
+
+        glCheck(GLEXT_glVertexAttribDivisor(location, 0));
+        glCheck(GLEXT_glDisableVertexAttribArray(location));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstancedRenderer::isAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        if (!Shader::isAvailable() || !VertexBuffer::isAvailable())
+            return false;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_draw_instanced && GLEXT_instanced_arrays;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstancedRenderer::initialize()
+{
+    if (!m_shader.loadFromMemory(vertexShaderSource, fragmentShaderSource))
+    {
+        err() << "Failed to compile the instancing shader, instances will be expanded on the CPU" << std::endl;
+        return false;
+    }
+
+    m_shader.setUniform("sf_textured", m_textured ? 1.f : 0.f);
+
+    GLEXT_GLhandle program = castToGlHandle(m_shader.getNativeHandle());
+
+    for (int i = 0; i < 4; ++i)
+    {
+        glCheck(m_locations[i] = GLEXT_glGetAttribLocation(program, attributeNames[i]));
+
+        if (m_locations[i] < 0)
+        {
+            err() << "Instancing shader attribute \"" << attributeNames[i] << "\" not found, instances will be expanded on the CPU" << std::endl;
+            return false;
+        }
+    }
+
+    glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+
+    if (!m_buffer)
+    {
+        err() << "Failed to create the instance buffer, instances will be expanded on the CPU" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+InstancedRenderer::InstancedRenderer() :
+m_shader       (),
+m_buffer       (0),
+m_bufferSize   (0),
+m_initialized  (false),
+m_valid        (false),
+m_textured     (false),
+m_instanceData ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstancedRenderer::~InstancedRenderer()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstancedRenderer::bind(const InstanceData* /* instances */, std::size_t /* instanceCount */, bool /* textured */)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancedRenderer::unbind()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstancedRenderer::isAvailable()
+{
+    return false;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_INSTANCEDRENDERER_HPP
+#define SFML_INSTANCEDRENDERER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/InstanceData.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Hardware instancing support for RenderTarget::drawInstanced
+///
+/// Owns the built-in instancing shader and the streaming
+/// buffer that per-instance attributes are uploaded to.
+///
+////////////////////////////////////////////////////////////
+class InstancedRenderer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    InstancedRenderer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~InstancedRenderer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the instances and bind the instancing shader
+    ///
+    /// The mesh vertex arrays must already be set up. On success
+    /// the caller issues the instanced draw call, then calls unbind().
+    ///
+    /// \param instances     Pointer to the instances
+    /// \param instanceCount Number of instances
+    /// \param textured      Whether a texture is bound for the draw
+    ///
+    /// \return True if the instancing state was set up, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool bind(const InstanceData* instances, std::size_t instanceCount, bool textured);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unbind the instancing shader and attributes
+    ///
+    ////////////////////////////////////////////////////////////
+    void unbind();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports hardware instancing
+    ///
+    /// This requires shaders, vertex buffers, ARB_draw_instanced
+    /// and ARB_instanced_arrays.
+    ///
+    /// \return True if hardware instancing is supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the shader and the instance buffer
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool initialize();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Shader             m_shader;        ///< Built-in instancing shader
+    unsigned int       m_buffer;        ///< OpenGL identifier of the instance buffer
+    std::size_t        m_bufferSize;    ///< Size of the instance buffer, in bytes
+    int                m_locations[4];  ///< Locations of the per-instance attributes
+    bool               m_initialized;   ///< Has initialization been attempted?
+    bool               m_valid;         ///< Did initialization succeed?
+    bool               m_textured;      ///< Current value of the shader's texturing flag
+    std::vector<float> m_instanceData;  ///< Staging copy of the per-instance attributes
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_INSTANCEDRENDERER_HPP
@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/OverdrawAnalyzer.hpp>
+#include <SFML/Graphics/ProgrammablePipeline.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Every fragment adds 1 to the 8-bit color channels of the target
+    const char fixedFragmentSource[] =
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(1.0 / 255.0);\n"
+        "}\n";
+
+    // Same thing, against the built-in vertex shader of the programmable pipeline
+    const char pipelineFragmentSource[] =
+        "void main()\n"
+        "{\n"
+        "    sf_fragColor = vec4(1.0 / 255.0);\n"
+        "}\n";
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+OverdrawAnalyzer::OverdrawAnalyzer() :
+m_fixedShader   (),
+m_fixedStatus   (NotLoaded),
+m_pipelineShader(),
+m_pipelineStatus(NotLoaded),
+m_pipelineCore  (false),
+m_states        (),
+m_records       (),
+m_queries       (),
+m_queryActive   (false)
+{
+    m_states.blendMode = BlendMode(BlendMode::One, BlendMode::One, BlendMode::Add);
+}
+
+
+////////////////////////////////////////////////////////////
+OverdrawAnalyzer::~OverdrawAnalyzer()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_queries.empty())
+    {
+        TransientContextLock contextLock;
+
+        glCheck(GLEXT_glDeleteQueries(static_cast<GLsizei>(m_queries.size()), &m_queries[0]));
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderStates& OverdrawAnalyzer::beginDraw(const RenderStates& states, bool programmable, bool coreProfile)
+{
+    Record record;
+    record.draw.texture   = states.texture;
+    record.draw.shader    = states.shader;
+    record.draw.blendMode = states.blendMode;
+    record.query          = 0;
+
+#ifndef SFML_OPENGL_ES
+
+    if (GLEXT_occlusion_query)
+    {
+        // Reuse the queries of the previous frames, create new ones as needed
+        if (m_records.size() == m_queries.size())
+        {
+            GLuint query = 0;
+            glCheck(GLEXT_glGenQueries(1, &query));
+            m_queries.push_back(query);
+        }
+
+        record.query = m_queries[m_records.size()];
+
+        glCheck(GLEXT_glBeginQuery(GLEXT_GL_SAMPLES_PASSED, record.query));
+        m_queryActive = true;
+    }
+
+#endif // SFML_OPENGL_ES
+
+    m_records.push_back(record);
+
+    // Keep the geometry, drop everything that would change the written color
+    m_states.transform = states.transform;
+    m_states.texture   = NULL;
+    m_states.shader    = getShader(programmable, coreProfile);
+
+    return m_states;
+}
+
+
+////////////////////////////////////////////////////////////
+void OverdrawAnalyzer::endDraw()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_queryActive)
+    {
+        glCheck(GLEXT_glEndQuery(GLEXT_GL_SAMPLES_PASSED));
+        m_queryActive = false;
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void OverdrawAnalyzer::reset()
+{
+    m_records.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void OverdrawAnalyzer::fillReport(const Vector2u& size, OverdrawReport& report)
+{
+    report = OverdrawReport();
+    report.histogram.resize(256, 0);
+
+    // Read the overdraw counts from the red channel of the target
+    std::vector<Uint8> pixels(size.x * size.y * 4);
+    if (!pixels.empty())
+    {
+        glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+        glCheck(glReadPixels(0, 0, static_cast<GLsizei>(size.x), static_cast<GLsizei>(size.y), GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
+    }
+
+    // Build the heat map, flipping the rows since OpenGL reads them bottom to top
+    std::vector<Uint8> heatMap(pixels.size());
+    for (unsigned int y = 0; y < size.y; ++y)
+    {
+        const Uint8* source = &pixels[(size.y - 1 - y) * size.x * 4];
+        Uint8* destination = &heatMap[y * size.x * 4];
+
+        for (unsigned int x = 0; x < size.x; ++x)
+        {
+            unsigned int overdraw = source[x * 4];
+
+            ++report.histogram[overdraw];
+            report.fragmentCount += overdraw;
+            report.maxOverdraw = std::max(report.maxOverdraw, overdraw);
+
+            Color color = OverdrawReport::getHeatMapColor(overdraw);
+            destination[x * 4 + 0] = color.r;
+            destination[x * 4 + 1] = color.g;
+            destination[x * 4 + 2] = color.b;
+            destination[x * 4 + 3] = color.a;
+        }
+    }
+
+    if (!heatMap.empty())
+    {
+        report.heatMap.create(size.x, size.y, &heatMap[0]);
+        report.averageOverdraw = static_cast<float>(report.fragmentCount) / (size.x * size.y);
+    }
+
+    // Collect the pixel counts of the draw calls; the GPU is done with them after the read back
+    report.hasSampleCounts = GLEXT_occlusion_query;
+    report.draws.reserve(m_records.size());
+
+    for (std::vector<Record>::iterator it = m_records.begin(); it != m_records.end(); ++it)
+    {
+    #ifndef SFML_OPENGL_ES
+
+        if (it->query)
+        {
+            GLuint samples = 0;
+            glCheck(GLEXT_glGetQueryObjectuiv(it->query, GLEXT_GL_QUERY_RESULT, &samples));
+            it->draw.sampleCount = samples;
+        }
+
+    #endif // SFML_OPENGL_ES
+
+        report.draws.push_back(it->draw);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader* OverdrawAnalyzer::getShader(bool programmable, bool coreProfile)
+{
+    if (programmable)
+    {
+        // The target may have moved to a context of a different profile
+        if ((m_pipelineStatus == Loaded) && (m_pipelineCore != coreProfile))
+            m_pipelineStatus = NotLoaded;
+
+        if (m_pipelineStatus == NotLoaded)
+        {
+            m_pipelineCore = coreProfile;
+            m_pipelineStatus = ProgrammablePipeline::loadShader(m_pipelineShader, pipelineFragmentSource, coreProfile) ? Loaded : Failed;
+
+            if (m_pipelineStatus == Failed)
+                err() << "Failed to compile the overdraw shader, overdraw counts will be wrong" << std::endl;
+        }
+
+        return (m_pipelineStatus == Loaded) ? &m_pipelineShader : NULL;
+    }
+
+    if (m_fixedStatus == NotLoaded)
+    {
+        m_fixedStatus = (Shader::isAvailable() && m_fixedShader.loadFromMemory(fixedFragmentSource, Shader::Fragment)) ? Loaded : Failed;
+
+        if (m_fixedStatus == Failed)
+            err() << "Failed to compile the overdraw shader, overdraw counts will be wrong" << std::endl;
+    }
+
+    return (m_fixedStatus == Loaded) ? &m_fixedShader : NULL;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_OVERDRAWANALYZER_HPP
+#define SFML_OVERDRAWANALYZER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/OverdrawReport.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Overdraw counting resources of a render target
+///
+/// Replaces the render states of each draw call so that it
+/// adds 1 to the color channels of every pixel it covers,
+/// and measures the pixels written by each draw call with
+/// occlusion queries.
+///
+////////////////////////////////////////////////////////////
+class OverdrawAnalyzer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    OverdrawAnalyzer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~OverdrawAnalyzer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a draw call and start counting its pixels
+    ///
+    /// Must be called with the render target's context active.
+    ///
+    /// \param states       Render states of the draw call
+    /// \param programmable True if the target uses the programmable pipeline
+    /// \param coreProfile  True if the target's context is a core profile context
+    ///
+    /// \return Render states that count the overdraw instead
+    ///
+    ////////////////////////////////////////////////////////////
+    const RenderStates& beginDraw(const RenderStates& states, bool programmable, bool coreProfile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop counting the pixels of the current draw call
+    ///
+    ////////////////////////////////////////////////////////////
+    void endDraw();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the recorded draw calls
+    ///
+    /// Called when the render target is cleared.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the overdraw counts back and fill a report
+    ///
+    /// Must be called with the render target's context active.
+    /// Waits for the GPU to finish the recorded draw calls.
+    ///
+    /// \param size   Size of the render target, in pixels
+    /// \param report Report to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    void fillReport(const Vector2u& size, OverdrawReport& report);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load state of a counting shader
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ShaderStatus
+    {
+        NotLoaded, ///< The shader was not compiled yet
+        Loaded,    ///< The shader is ready to be used
+        Failed     ///< The shader could not be compiled
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counting shader of a pipeline
+    ///
+    /// \param programmable True for the programmable pipeline
+    /// \param coreProfile  True for a core profile context
+    ///
+    /// \return Counting shader, or null if it is not available
+    ///
+    ////////////////////////////////////////////////////////////
+    const Shader* getShader(bool programmable, bool coreProfile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw call recorded during the analysis
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Record
+    {
+        OverdrawReport::Draw draw;  ///< Public part of the record
+        unsigned int         query; ///< Occlusion query of the draw call, 0 if none
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Shader                    m_fixedShader;        ///< Fragment-only counting shader for the fixed-function pipeline
+    ShaderStatus              m_fixedStatus;        ///< Load state of m_fixedShader
+    Shader                    m_pipelineShader;     ///< Counting shader for the programmable pipeline
+    ShaderStatus              m_pipelineStatus;     ///< Load state of m_pipelineShader
+    bool                      m_pipelineCore;       ///< Was m_pipelineShader compiled for a core profile context?
+    RenderStates              m_states;             ///< Counting render states of the current draw call
+    std::vector<Record>       m_records;            ///< Draw calls since the last reset
+    std::vector<unsigned int> m_queries;            ///< Occlusion queries, reused from one frame to the next
+    bool                      m_queryActive;        ///< Is an occlusion query running?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_OVERDRAWANALYZER_HPP
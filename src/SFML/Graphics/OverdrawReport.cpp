@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/OverdrawReport.hpp>
+
+
+namespace
+{
+    // Heat map colors of the overdraw counts 0 to 8
+    const sf::Color heatMapColors[] =
+    {
+        sf::Color(0, 0, 0),
+        sf::Color(0, 0, 160),
+        sf::Color(0, 160, 255),
+        sf::Color(0, 200, 0),
+        sf::Color(255, 255, 0),
+        sf::Color(255, 128, 0),
+        sf::Color(255, 0, 0),
+        sf::Color(255, 0, 255),
+        sf::Color(255, 255, 255)
+    };
+
+    const unsigned int heatMapColorCount = sizeof(heatMapColors) / sizeof(*heatMapColors);
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+OverdrawReport::Draw::Draw() :
+texture    (NULL),
+shader     (NULL),
+blendMode  (),
+sampleCount(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+OverdrawReport::OverdrawReport() :
+heatMap        (),
+histogram      (),
+draws          (),
+hasSampleCounts(false),
+fragmentCount  (0),
+maxOverdraw    (0),
+averageOverdraw(0.f)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Color OverdrawReport::getHeatMapColor(unsigned int overdraw)
+{
+    if (overdraw >= heatMapColorCount)
+        overdraw = heatMapColorCount - 1;
+
+    return heatMapColors[overdraw];
+}
+
+} // namespace sf
@@ -0,0 +1,484 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/WorkerPool.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Number of particles drawn by a single batch, so that its quads can be indexed with 16-bit indices
+    const std::size_t batchSize = 65536 / 4;
+
+    // Number of particles handed to a thread at once; small enough for the attributes of a block to stay in cache
+    const std::size_t blockSize = 4096;
+
+    // Convert a color component to its 8-bit value
+    sf::Uint8 toComponent(float value)
+    {
+        return static_cast<sf::Uint8>(std::min(std::max(value, 0.f), 255.f));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem() :
+m_capacity    (0),
+m_count       (0),
+m_acceleration(0, 0),
+m_particleSize(1, 1),
+m_texture     (NULL),
+m_textureRect (),
+m_threadCount (1),
+m_elapsed     (0),
+m_nextBlock   (0),
+m_blockMutex  (),
+m_workers     (new priv::WorkerPool),
+m_vertices    (),
+m_batches     (),
+m_indices     (IndexBuffer::Index16, IndexBuffer::Static),
+m_quadIndices (),
+m_needUpload  (false)
+{
+    setCapacity(1000);
+}
+
+
+////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem(std::size_t capacity) :
+m_capacity    (0),
+m_count       (0),
+m_acceleration(0, 0),
+m_particleSize(1, 1),
+m_texture     (NULL),
+m_textureRect (),
+m_threadCount (1),
+m_elapsed     (0),
+m_nextBlock   (0),
+m_blockMutex  (),
+m_workers     (new priv::WorkerPool),
+m_vertices    (),
+m_batches     (),
+m_indices     (IndexBuffer::Index16, IndexBuffer::Static),
+m_quadIndices (),
+m_needUpload  (false)
+{
+    setCapacity(capacity);
+}
+
+
+////////////////////////////////////////////////////////////
+ParticleSystem::~ParticleSystem()
+{
+    delete m_workers;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setCapacity(std::size_t capacity)
+{
+    for (int i = 0; i < AttributeCount; ++i)
+        m_attributes[i].resize(capacity);
+
+    m_vertices.resize(capacity * 4);
+
+    m_capacity = capacity;
+    m_count = std::min(m_count, capacity);
+    m_needUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getCapacity() const
+{
+    return m_capacity;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getParticleCount() const
+{
+    return m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ParticleSystem::emit(const Vector2f& position, const Vector2f& velocity, const Color& color, Time lifetime)
+{
+    return emit(position, velocity, color, color, lifetime);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ParticleSystem::emit(const Vector2f& position, const Vector2f& velocity, const Color& startColor, const Color& endColor, Time lifetime)
+{
+    if ((m_count == m_capacity) || (lifetime <= Time::Zero))
+        return false;
+
+    // Store the change of color as a rate, so that the update is a plain integration like the motion
+    float seconds = lifetime.asSeconds();
+    std::size_t index = m_count++;
+
+    m_attributes[PositionX][index]  = position.x;
+    m_attributes[PositionY][index]  = position.y;
+    m_attributes[VelocityX][index]  = velocity.x;
+    m_attributes[VelocityY][index]  = velocity.y;
+    m_attributes[Red][index]        = startColor.r;
+    m_attributes[Green][index]      = startColor.g;
+    m_attributes[Blue][index]       = startColor.b;
+    m_attributes[Alpha][index]      = startColor.a;
+    m_attributes[RedSpeed][index]   = (endColor.r - startColor.r) / seconds;
+    m_attributes[GreenSpeed][index] = (endColor.g - startColor.g) / seconds;
+    m_attributes[BlueSpeed][index]  = (endColor.b - startColor.b) / seconds;
+    m_attributes[AlphaSpeed][index] = (endColor.a - startColor.a) / seconds;
+    m_attributes[Lifetime][index]   = seconds;
+
+    // The quad of the new particle is written by the next update
+    Vertex* quad = &m_vertices[index * 4];
+    for (int i = 0; i < 4; ++i)
+        quad[i] = Vertex(position, Color::Transparent);
+
+    m_needUpload = true;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::clear()
+{
+    m_count = 0;
+    m_needUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::update(Time elapsed)
+{
+    if (!m_count)
+        return;
+
+    m_elapsed = elapsed.asSeconds();
+
+    // Update the blocks of particles on the worker threads and on this one
+    m_nextBlock = 0;
+
+    std::size_t blockCount = (m_count + blockSize - 1) / blockSize;
+
+    unsigned int threadCount = std::min(m_threadCount, static_cast<unsigned int>(blockCount));
+    m_workers->run(&ParticleSystem::updateBlocksTask, this, threadCount - 1);
+
+    removeDeadParticles();
+
+    m_needUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setAcceleration(const Vector2f& acceleration)
+{
+    m_acceleration = acceleration;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getAcceleration() const
+{
+    return m_acceleration;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setParticleSize(const Vector2f& size)
+{
+    m_particleSize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getParticleSize() const
+{
+    return m_particleSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTexture(const Texture* texture, bool resetRect)
+{
+    if (texture && resetRect)
+        m_textureRect = IntRect(0, 0, texture->getSize().x, texture->getSize().y);
+
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* ParticleSystem::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTextureRect(const IntRect& rectangle)
+{
+    m_textureRect = rectangle;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& ParticleSystem::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setThreadCount(unsigned int count)
+{
+    m_threadCount = std::max(count, 1u);
+
+    // The calling thread takes part in the updates
+    m_workers->setThreadCount(m_threadCount - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ParticleSystem::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_count)
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    bool useBuffers = VertexBuffer::isAvailable() && IndexBuffer::isAvailable();
+
+    // Two triangles per quad, the same indices serve all the batches
+    if (m_quadIndices.empty())
+    {
+        m_quadIndices.resize(batchSize * 6);
+        for (std::size_t i = 0; i < batchSize; ++i)
+        {
+            Uint16 first = static_cast<Uint16>(i * 4);
+            m_quadIndices[i * 6 + 0] = first;
+            m_quadIndices[i * 6 + 1] = static_cast<Uint16>(first + 1);
+            m_quadIndices[i * 6 + 2] = static_cast<Uint16>(first + 2);
+            m_quadIndices[i * 6 + 3] = first;
+            m_quadIndices[i * 6 + 4] = static_cast<Uint16>(first + 2);
+            m_quadIndices[i * 6 + 5] = static_cast<Uint16>(first + 3);
+        }
+    }
+
+    if (useBuffers && (m_indices.getIndexCount() != m_quadIndices.size()))
+    {
+        if (!m_indices.create(m_quadIndices.size()) || !m_indices.update(&m_quadIndices[0]))
+            useBuffers = false;
+    }
+
+    std::size_t batchCount = (m_count + batchSize - 1) / batchSize;
+
+    if (useBuffers && (m_batches.size() < batchCount))
+        m_batches.resize(batchCount, VertexBuffer(Triangles, VertexBuffer::Stream));
+
+    for (std::size_t i = 0; i < batchCount; ++i)
+    {
+        std::size_t first = i * batchSize;
+        std::size_t count = std::min(m_count - first, batchSize);
+
+        if (useBuffers)
+        {
+            VertexBuffer& batch = m_batches[i];
+
+            // Allocate full batches, so that later uploads only orphan the storage
+            if (!batch.getVertexCount() && !batch.create(batchSize * 4))
+                useBuffers = false;
+            else if (m_needUpload && !batch.update(&m_vertices[first * 4], count * 4, 0))
+                useBuffers = false;
+        }
+
+        if (useBuffers)
+            target.draw(m_batches[i], m_indices, 0, count * 6, states);
+        else
+            target.draw(&m_vertices[first * 4], count * 4, &m_quadIndices[0], count * 6, Triangles, states);
+    }
+
+    m_needUpload = !useBuffers;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::updateBlocks()
+{
+    for (;;)
+    {
+        std::size_t begin;
+
+        {
+            Lock lock(m_blockMutex);
+
+            if (m_nextBlock * blockSize >= m_count)
+                return;
+
+            begin = m_nextBlock++ * blockSize;
+        }
+
+        // Blocks don't overlap, so no lock is needed to update their particles
+        updateRange(begin, std::min(begin + blockSize, m_count));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::updateBlocksTask(void* system)
+{
+    static_cast<ParticleSystem*>(system)->updateBlocks();
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::updateRange(std::size_t begin, std::size_t end)
+{
+    const float dt = m_elapsed;
+    const float ax = m_acceleration.x * dt;
+    const float ay = m_acceleration.y * dt;
+
+    float* positionX  = &m_attributes[PositionX][0];
+    float* positionY  = &m_attributes[PositionY][0];
+    float* velocityX  = &m_attributes[VelocityX][0];
+    float* velocityY  = &m_attributes[VelocityY][0];
+    float* lifetime   = &m_attributes[Lifetime][0];
+
+    // Each loop streams through one or two arrays without branches,
+    // so that the compiler can turn it into vector instructions
+    for (std::size_t i = begin; i < end; ++i)
+        velocityX[i] += ax;
+
+    for (std::size_t i = begin; i < end; ++i)
+        velocityY[i] += ay;
+
+    for (std::size_t i = begin; i < end; ++i)
+        positionX[i] += velocityX[i] * dt;
+
+    for (std::size_t i = begin; i < end; ++i)
+        positionY[i] += velocityY[i] * dt;
+
+    for (int channel = 0; channel < 4; ++channel)
+    {
+        float* color = &m_attributes[Red + channel][0];
+        const float* speed = &m_attributes[RedSpeed + channel][0];
+
+        for (std::size_t i = begin; i < end; ++i)
+            color[i] += speed[i] * dt;
+    }
+
+    for (std::size_t i = begin; i < end; ++i)
+        lifetime[i] -= dt;
+
+    // Write the quads, centered on the particles
+    const float halfWidth  = m_particleSize.x / 2.f;
+    const float halfHeight = m_particleSize.y / 2.f;
+
+    const float left   = static_cast<float>(m_textureRect.left);
+    const float top    = static_cast<float>(m_textureRect.top);
+    const float right  = static_cast<float>(m_textureRect.left + m_textureRect.width);
+    const float bottom = static_cast<float>(m_textureRect.top + m_textureRect.height);
+
+    const float* red   = &m_attributes[Red][0];
+    const float* green = &m_attributes[Green][0];
+    const float* blue  = &m_attributes[Blue][0];
+    const float* alpha = &m_attributes[Alpha][0];
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        Vertex* quad = &m_vertices[i * 4];
+        Color color(toComponent(red[i]), toComponent(green[i]), toComponent(blue[i]), toComponent(alpha[i]));
+
+        float x = positionX[i];
+        float y = positionY[i];
+
+        quad[0].position = Vector2f(x - halfWidth, y - halfHeight);
+        quad[1].position = Vector2f(x + halfWidth, y - halfHeight);
+        quad[2].position = Vector2f(x + halfWidth, y + halfHeight);
+        quad[3].position = Vector2f(x - halfWidth, y + halfHeight);
+
+        quad[0].texCoords = Vector2f(left, top);
+        quad[1].texCoords = Vector2f(right, top);
+        quad[2].texCoords = Vector2f(right, bottom);
+        quad[3].texCoords = Vector2f(left, bottom);
+
+        quad[0].color = color;
+        quad[1].color = color;
+        quad[2].color = color;
+        quad[3].color = color;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::removeDeadParticles()
+{
+    const float* lifetime = &m_attributes[Lifetime][0];
+
+    // Replace each dead particle, and its quad, with the last living one;
+    // the index is not advanced, since the moved particle may be dead too
+    std::size_t i = 0;
+    while (i < m_count)
+    {
+        if (lifetime[i] > 0.f)
+        {
+            ++i;
+            continue;
+        }
+
+        std::size_t last = --m_count;
+
+        if (i != last)
+        {
+            for (int j = 0; j < AttributeCount; ++j)
+                m_attributes[j][i] = m_attributes[j][last];
+
+            std::copy(&m_vertices[last * 4], &m_vertices[last * 4] + 4, &m_vertices[i * 4]);
+        }
+    }
+}
+
+} // namespace sf
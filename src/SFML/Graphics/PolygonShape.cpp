@@ -0,0 +1,430 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PolygonShape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Triangulation.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Compute the normal of a segment
+    sf::Vector2f computeNormal(const sf::Vector2f& p1, const sf::Vector2f& p2)
+    {
+        sf::Vector2f normal(p1.y - p2.y, p2.x - p1.x);
+        float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+        if (length != 0.f)
+            normal /= length;
+        return normal;
+    }
+
+    // Compute the dot product of two vectors
+    float dotProduct(const sf::Vector2f& p1, const sf::Vector2f& p2)
+    {
+        return p1.x * p2.x + p1.y * p2.y;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PolygonShape::PolygonShape(std::size_t pointCount) :
+m_contours         (1, std::vector<Vector2f>(pointCount)),
+m_texture          (NULL),
+m_textureRect      (),
+m_fillColor        (255, 255, 255),
+m_outlineColor     (255, 255, 255),
+m_outlineThickness (0),
+m_vertices         (),
+m_indices          (),
+m_wideIndices      (),
+m_outlineVertices  (Triangles),
+m_insideBounds     (),
+m_bounds           (),
+m_needTriangulation(true),
+m_needOutlineUpdate(true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setPointCount(std::size_t count)
+{
+    m_contours[0].resize(count);
+    m_needTriangulation = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PolygonShape::getPointCount() const
+{
+    return m_contours[0].size();
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setPoint(std::size_t index, const Vector2f& point)
+{
+    m_contours[0][index] = point;
+    m_needTriangulation = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f PolygonShape::getPoint(std::size_t index) const
+{
+    return m_contours[0][index];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PolygonShape::addHole(std::size_t pointCount)
+{
+    m_contours.push_back(std::vector<Vector2f>(pointCount));
+    m_needTriangulation = true;
+
+    return m_contours.size() - 2;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::removeHoles()
+{
+    m_contours.resize(1);
+    m_needTriangulation = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PolygonShape::getHoleCount() const
+{
+    return m_contours.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PolygonShape::getHolePointCount(std::size_t hole) const
+{
+    return m_contours[hole + 1].size();
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setHolePoint(std::size_t hole, std::size_t index, const Vector2f& point)
+{
+    m_contours[hole + 1][index] = point;
+    m_needTriangulation = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f PolygonShape::getHolePoint(std::size_t hole, std::size_t index) const
+{
+    return m_contours[hole + 1][index];
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setTexture(const Texture* texture, bool resetRect)
+{
+    if (texture)
+    {
+        // Recompute the texture area if requested, or if there was no texture & rect before
+        if (resetRect || (!m_texture && (m_textureRect == IntRect())))
+            setTextureRect(IntRect(0, 0, texture->getSize().x, texture->getSize().y));
+    }
+
+    // Assign the new texture
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setTextureRect(const IntRect& rect)
+{
+    m_textureRect = rect;
+    updateTexCoords();
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setFillColor(const Color& color)
+{
+    m_fillColor = color;
+
+    for (std::size_t i = 0; i < m_vertices.size(); ++i)
+        m_vertices[i].color = m_fillColor;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setOutlineColor(const Color& color)
+{
+    m_outlineColor = color;
+
+    for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
+        m_outlineVertices[i].color = m_outlineColor;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setOutlineThickness(float thickness)
+{
+    m_outlineThickness = thickness;
+    m_needOutlineUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* PolygonShape::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& PolygonShape::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& PolygonShape::getFillColor() const
+{
+    return m_fillColor;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& PolygonShape::getOutlineColor() const
+{
+    return m_outlineColor;
+}
+
+
+////////////////////////////////////////////////////////////
+float PolygonShape::getOutlineThickness() const
+{
+    return m_outlineThickness;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect PolygonShape::getLocalBounds() const
+{
+    update();
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect PolygonShape::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::draw(RenderTarget& target, RenderStates states) const
+{
+    update();
+
+    states.transform *= getTransform();
+
+    // Render the inside
+    states.texture = m_texture;
+
+    if (!m_indices.empty())
+        target.draw(&m_vertices[0], m_vertices.size(), &m_indices[0], m_indices.size(), Triangles, states);
+    else if (!m_wideIndices.empty())
+        target.draw(&m_vertices[0], m_vertices.size(), &m_wideIndices[0], m_wideIndices.size(), Triangles, states);
+
+    // Render the outline
+    if (m_outlineThickness != 0)
+    {
+        states.texture = NULL;
+        target.draw(m_outlineVertices, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::update() const
+{
+    if (m_needTriangulation)
+    {
+        m_needTriangulation = false;
+
+        // Gather the points of all the contours
+        std::vector<Vector2f> points;
+        std::vector<std::size_t> counts;
+
+        for (std::size_t i = 0; i < m_contours.size(); ++i)
+        {
+            points.insert(points.end(), m_contours[i].begin(), m_contours[i].end());
+            counts.push_back(m_contours[i].size());
+        }
+
+        priv::triangulatePolygon(points, counts, m_wideIndices);
+
+        // Use 16-bit indices whenever possible, they are supported everywhere
+        m_indices.clear();
+        if (points.size() <= 65536)
+        {
+            m_indices.resize(m_wideIndices.size());
+            for (std::size_t i = 0; i < m_wideIndices.size(); ++i)
+                m_indices[i] = static_cast<Uint16>(m_wideIndices[i]);
+
+            m_wideIndices.clear();
+        }
+
+        m_vertices.resize(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+            m_vertices[i] = Vertex(points[i], m_fillColor);
+
+        // The holes are inside the outer boundary, which alone defines the bounds
+        const std::vector<Vector2f>& boundary = m_contours[0];
+        if (!boundary.empty())
+        {
+            Vector2f min = boundary[0];
+            Vector2f max = boundary[0];
+
+            for (std::size_t i = 1; i < boundary.size(); ++i)
+            {
+                min.x = std::min(min.x, boundary[i].x);
+                min.y = std::min(min.y, boundary[i].y);
+                max.x = std::max(max.x, boundary[i].x);
+                max.y = std::max(max.y, boundary[i].y);
+            }
+
+            m_insideBounds = FloatRect(min, max - min);
+        }
+        else
+        {
+            m_insideBounds = FloatRect();
+        }
+
+        updateTexCoords();
+
+        m_needOutlineUpdate = true;
+    }
+
+    if (m_needOutlineUpdate)
+    {
+        m_needOutlineUpdate = false;
+        updateOutline();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::updateTexCoords() const
+{
+    for (std::size_t i = 0; i < m_vertices.size(); ++i)
+    {
+        float xratio = m_insideBounds.width > 0 ? (m_vertices[i].position.x - m_insideBounds.left) / m_insideBounds.width : 0;
+        float yratio = m_insideBounds.height > 0 ? (m_vertices[i].position.y - m_insideBounds.top) / m_insideBounds.height : 0;
+        m_vertices[i].texCoords.x = m_textureRect.left + m_textureRect.width * xratio;
+        m_vertices[i].texCoords.y = m_textureRect.top + m_textureRect.height * yratio;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::updateOutline() const
+{
+    m_outlineVertices.clear();
+
+    // Return if there is no outline
+    if (m_outlineThickness == 0.f)
+    {
+        m_bounds = m_insideBounds;
+        return;
+    }
+
+    std::vector<Vector2f> extruded;
+
+    for (std::size_t i = 0; i < m_contours.size(); ++i)
+    {
+        const std::vector<Vector2f>& contour = m_contours[i];
+        std::size_t count = contour.size();
+        if (count < 3)
+            continue;
+
+        // The normals must point away from the filled area: outwards for the
+        // outer boundary, inwards for the holes, whatever the winding order
+        float area = 0.f;
+        for (std::size_t j = 0; j < count; ++j)
+            area += contour[j].x * contour[(j + 1) % count].y - contour[j].y * contour[(j + 1) % count].x;
+
+        float side = ((i == 0) == (area > 0.f)) ? -1.f : 1.f;
+
+        extruded.resize(count);
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            // Get the two segments shared by the current point
+            const Vector2f& p0 = contour[(j + count - 1) % count];
+            const Vector2f& p1 = contour[j];
+            const Vector2f& p2 = contour[(j + 1) % count];
+
+            // Compute their normal
+            Vector2f n1 = computeNormal(p0, p1) * side;
+            Vector2f n2 = computeNormal(p1, p2) * side;
+
+            // Combine them to get the extrusion direction
+            float factor = 1.f + dotProduct(n1, n2);
+            Vector2f normal = (n1 + n2) / factor;
+
+            extruded[j] = p1 + normal * m_outlineThickness;
+        }
+
+        // Two triangles between each edge of the contour and its extruded copy
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            std::size_t next = (j + 1) % count;
+
+            m_outlineVertices.append(Vertex(contour[j], m_outlineColor));
+            m_outlineVertices.append(Vertex(extruded[j], m_outlineColor));
+            m_outlineVertices.append(Vertex(extruded[next], m_outlineColor));
+            m_outlineVertices.append(Vertex(contour[j], m_outlineColor));
+            m_outlineVertices.append(Vertex(extruded[next], m_outlineColor));
+            m_outlineVertices.append(Vertex(contour[next], m_outlineColor));
+        }
+    }
+
+    // Update the shape's bounds
+    m_bounds = m_outlineVertices.getVertexCount() ? m_outlineVertices.getBounds() : m_insideBounds;
+}
+
+} // namespace sf
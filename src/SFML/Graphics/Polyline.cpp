@@ -0,0 +1,475 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Polyline.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+namespace
+{
+    const float pi = 3.141592654f;
+
+    // Largest distance between a round join or cap and the polygon approximating it, in pixels
+    const float arcTolerance = 0.25f;
+
+    // Grow a rectangle to contain the vertices from the given index onwards;
+    // when the index is 0, the rectangle is replaced by their bounds
+    sf::FloatRect extendBounds(const sf::FloatRect& bounds, const std::vector<sf::Vertex>& vertices, std::size_t first)
+    {
+        if (first >= vertices.size())
+            return bounds;
+
+        float left   = first ? bounds.left : vertices[0].position.x;
+        float top    = first ? bounds.top : vertices[0].position.y;
+        float right  = first ? bounds.left + bounds.width : left;
+        float bottom = first ? bounds.top + bounds.height : top;
+
+        for (std::size_t i = first; i < vertices.size(); ++i)
+        {
+            const sf::Vector2f& position = vertices[i].position;
+
+            left   = std::min(left, position.x);
+            top    = std::min(top, position.y);
+            right  = std::max(right, position.x);
+            bottom = std::max(bottom, position.y);
+        }
+
+        return sf::FloatRect(left, top, right - left, bottom - top);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Polyline::Polyline(float thickness) :
+m_points    (),
+m_thickness (thickness),
+m_color     (Color::White),
+m_joinStyle (MiterJoin),
+m_capStyle  (ButtCap),
+m_miterLimit(4.f),
+m_vertices  (),
+m_segments  (),
+m_directions(),
+m_bodySize  (0),
+m_bodyBounds(),
+m_bounds    (),
+m_needUpdate(false),
+m_buffer    (Triangles, VertexBuffer::Dynamic),
+m_uploaded  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::addPoint(const Vector2f& point)
+{
+    m_points.push_back(point);
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::setPoint(std::size_t index, const Vector2f& point)
+{
+    assert(index < m_points.size());
+
+    m_points[index] = point;
+
+    // The point is shared by two segments, and the corner before the first one depends on it too
+    invalidateFrom(index > 0 ? index - 1 : 0);
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& Polyline::getPoint(std::size_t index) const
+{
+    assert(index < m_points.size());
+
+    return m_points[index];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Polyline::getPointCount() const
+{
+    return m_points.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::clear()
+{
+    m_points.clear();
+    invalidateFrom(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::setThickness(float thickness)
+{
+    if (thickness != m_thickness)
+    {
+        m_thickness = thickness;
+        invalidateFrom(0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float Polyline::getThickness() const
+{
+    return m_thickness;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::setColor(const Color& color)
+{
+    if (color != m_color)
+    {
+        m_color = color;
+
+        // The shape of the geometry doesn't change, only its vertices must be uploaded again
+        for (std::size_t i = 0; i < m_vertices.size(); ++i)
+            m_vertices[i].color = color;
+
+        m_uploaded = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& Polyline::getColor() const
+{
+    return m_color;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::setJoinStyle(JoinStyle style)
+{
+    if (style != m_joinStyle)
+    {
+        m_joinStyle = style;
+        invalidateFrom(0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Polyline::JoinStyle Polyline::getJoinStyle() const
+{
+    return m_joinStyle;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::setCapStyle(CapStyle style)
+{
+    if (style != m_capStyle)
+    {
+        m_capStyle = style;
+        m_needUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Polyline::CapStyle Polyline::getCapStyle() const
+{
+    return m_capStyle;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::setMiterLimit(float limit)
+{
+    limit = std::max(limit, 1.f);
+
+    if (limit != m_miterLimit)
+    {
+        m_miterLimit = limit;
+
+        if (m_joinStyle == MiterJoin)
+            invalidateFrom(0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float Polyline::getMiterLimit() const
+{
+    return m_miterLimit;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect Polyline::getLocalBounds() const
+{
+    updateGeometry();
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect Polyline::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::draw(RenderTarget& target, RenderStates states) const
+{
+    updateGeometry();
+
+    if (m_vertices.empty())
+        return;
+
+    states.transform *= getTransform();
+    states.texture = NULL;
+
+    if (VertexBuffer::isAvailable())
+    {
+        // Grow the buffer geometrically, so that appending points doesn't reallocate it every time
+        if (m_buffer.getVertexCount() < m_vertices.size())
+        {
+            if (m_buffer.create(std::max(m_vertices.size(), m_buffer.getVertexCount() * 2)))
+                m_uploaded = 0;
+        }
+
+        // Only the vertices which changed since the last draw are uploaded
+        if (m_buffer.getVertexCount() >= m_vertices.size())
+        {
+            std::size_t count = m_vertices.size() - m_uploaded;
+
+            if (!count || m_buffer.update(&m_vertices[m_uploaded], count, static_cast<unsigned int>(m_uploaded)))
+            {
+                m_uploaded = m_vertices.size();
+                target.draw(m_buffer, 0, m_vertices.size(), states);
+                return;
+            }
+        }
+    }
+
+    target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::updateGeometry() const
+{
+    if (!m_needUpdate)
+        return;
+
+    m_needUpdate = false;
+
+    // The caps depend on the last segment, they are always rebuilt
+    m_vertices.resize(m_bodySize);
+    m_uploaded = std::min(m_uploaded, m_bodySize);
+
+    std::size_t segmentCount = m_points.size() > 1 ? m_points.size() - 1 : 0;
+    float halfThickness = m_thickness / 2.f;
+
+    for (std::size_t i = m_segments.size(); i < segmentCount; ++i)
+    {
+        const Vector2f& start = m_points[i];
+        const Vector2f& end = m_points[i + 1];
+
+        Vector2f offset = end - start;
+        float length = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+
+        // An empty segment takes the direction of the previous one, so that the
+        // corner with the next segment is computed as if it didn't exist
+        Vector2f previous = i > 0 ? m_directions[i - 1] : Vector2f(0, 0);
+        Vector2f direction = length > 0.f ? offset / length : previous;
+
+        m_segments.push_back(m_vertices.size());
+        m_directions.push_back(direction);
+
+        if (length <= 0.f)
+            continue;
+
+        if ((previous.x != 0.f) || (previous.y != 0.f))
+            addJoin(start, previous, direction);
+
+        Vector2f normal(-direction.y * halfThickness, direction.x * halfThickness);
+
+        addTriangle(start + normal, end + normal, end - normal);
+        addTriangle(start + normal, end - normal, start - normal);
+    }
+
+    m_bodyBounds = extendBounds(m_bodyBounds, m_vertices, m_bodySize);
+    m_bodySize = m_vertices.size();
+
+    if (!m_bodySize)
+    {
+        m_bounds = FloatRect();
+        return;
+    }
+
+    if (m_capStyle != ButtCap)
+    {
+        // Leading empty segments have no direction, the first cap uses the first non-empty one
+        std::size_t first = 0;
+        while ((m_directions[first].x == 0.f) && (m_directions[first].y == 0.f))
+            ++first;
+
+        addCap(m_points.front(), -m_directions[first]);
+        addCap(m_points.back(), m_directions.back());
+    }
+
+    m_bounds = extendBounds(m_bodyBounds, m_vertices, m_bodySize);
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::invalidateFrom(std::size_t segment)
+{
+    if (segment < m_segments.size())
+    {
+        m_bodySize = m_segments[segment];
+        m_segments.resize(segment);
+        m_directions.resize(segment);
+        m_vertices.resize(m_bodySize);
+        m_bodyBounds = extendBounds(FloatRect(), m_vertices, 0);
+    }
+
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::addJoin(const Vector2f& point, const Vector2f& incoming, const Vector2f& outgoing) const
+{
+    float cross = incoming.x * outgoing.y - incoming.y * outgoing.x;
+    float dot = incoming.x * outgoing.x + incoming.y * outgoing.y;
+
+    // Segments which continue in the same direction need no corner
+    if ((std::fabs(cross) < 1e-6f) && (dot > 0.f))
+        return;
+
+    // Offsets of the edges of the two segments on the outer side of the corner
+    float side = cross > 0.f ? -m_thickness / 2.f : m_thickness / 2.f;
+    Vector2f from(-incoming.y * side, incoming.x * side);
+    Vector2f to(-outgoing.y * side, outgoing.x * side);
+
+    switch (m_joinStyle)
+    {
+        case RoundJoin:
+        {
+            addArc(point, from, std::atan2(cross, dot));
+            return;
+        }
+
+        case MiterJoin:
+        {
+            // The length of the miter, relative to half the thickness, is 1 / cos(angle / 2)
+            float cosHalfAngle = std::sqrt(std::max((1.f + dot) / 2.f, 0.f));
+
+            if (cosHalfAngle * m_miterLimit >= 1.f)
+            {
+                Vector2f tip = point + (from + to) / (1.f + dot);
+
+                addTriangle(point, point + from, tip);
+                addTriangle(point, tip, point + to);
+                return;
+            }
+
+            // Too sharp: bevel the corner
+            addTriangle(point, point + from, point + to);
+            return;
+        }
+
+        default:
+        case BevelJoin:
+        {
+            addTriangle(point, point + from, point + to);
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::addCap(const Vector2f& point, const Vector2f& direction) const
+{
+    float halfThickness = m_thickness / 2.f;
+    Vector2f normal(-direction.y * halfThickness, direction.x * halfThickness);
+    Vector2f extension = direction * halfThickness;
+
+    if (m_capStyle == SquareCap)
+    {
+        addTriangle(point + normal, point + normal + extension, point - normal + extension);
+        addTriangle(point + normal, point - normal + extension, point - normal);
+    }
+    else if (m_capStyle == RoundCap)
+    {
+        // Half turn from one edge to the other, through the tip of the cap
+        addArc(point, normal, -pi);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::addArc(const Vector2f& center, const Vector2f& from, float angle) const
+{
+    float radius = m_thickness / 2.f;
+
+    // Angle between two points of the arc, such that the chords stay close enough to it
+    float step = radius > arcTolerance ? 2.f * std::acos(1.f - arcTolerance / radius) : pi / 2.f;
+    int count = std::max(static_cast<int>(std::ceil(std::fabs(angle) / step)), 1);
+
+    float cosine = std::cos(angle / count);
+    float sine = std::sin(angle / count);
+
+    Vector2f current = from;
+    for (int i = 0; i < count; ++i)
+    {
+        Vector2f next(current.x * cosine - current.y * sine, current.x * sine + current.y * cosine);
+        addTriangle(center, center + current, center + next);
+        current = next;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::addTriangle(const Vector2f& a, const Vector2f& b, const Vector2f& c) const
+{
+    m_vertices.push_back(Vertex(a, m_color));
+    m_vertices.push_back(Vertex(b, m_color));
+    m_vertices.push_back(Vertex(c, m_color));
+}
+
+} // namespace sf
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PostProcessChain.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PostProcessChain::PostProcessChain() :
+m_ownPool   (),
+m_pool      (m_ownPool),
+m_passes    (),
+m_targetSize(0, 0)
+{
+    m_targets[0] = NULL;
+    m_targets[1] = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+PostProcessChain::PostProcessChain(RenderTexturePool& pool) :
+m_ownPool   (),
+m_pool      (pool),
+m_passes    (),
+m_targetSize(0, 0)
+{
+    m_targets[0] = NULL;
+    m_targets[1] = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+PostProcessChain::~PostProcessChain()
+{
+    releaseTargets();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PostProcessChain::addPass(const Shader& shader)
+{
+    Pass pass;
+    pass.shader  = &shader;
+    pass.enabled = true;
+    m_passes.push_back(pass);
+
+    return m_passes.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::setPassEnabled(std::size_t index, bool enabled)
+{
+    if (index < m_passes.size())
+        m_passes[index].enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PostProcessChain::isPassEnabled(std::size_t index) const
+{
+    return (index < m_passes.size()) && m_passes[index].enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PostProcessChain::getPassCount() const
+{
+    return m_passes.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::clear()
+{
+    m_passes.clear();
+    releaseTargets();
+}
+
+
+////////////////////////////////////////////////////////////
+bool PostProcessChain::apply(const Texture& input, RenderTarget& output, const RenderStates& states)
+{
+    std::size_t remaining = 0;
+    for (std::vector<Pass>::const_iterator it = m_passes.begin(); it != m_passes.end(); ++it)
+    {
+        if (it->enabled)
+            ++remaining;
+    }
+
+    // Intermediate results have the size of the input
+    if (input.getSize() != m_targetSize)
+    {
+        releaseTargets();
+        m_targetSize = input.getSize();
+    }
+
+    const Texture* source = &input;
+    std::size_t current = 0;
+
+    for (std::vector<Pass>::const_iterator it = m_passes.begin(); (it != m_passes.end()) && (remaining > 1); ++it)
+    {
+        if (!it->enabled)
+            continue;
+
+        if (!m_targets[current])
+        {
+            m_targets[current] = m_pool.acquire(m_targetSize.x, m_targetSize.y);
+            if (!m_targets[current])
+            {
+                err() << "Failed to apply post-processing chain: could not create an intermediate render texture" << std::endl;
+                return false;
+            }
+        }
+
+        // The sprite covers the whole target and replaces its contents
+        RenderTexture& target = *m_targets[current];
+        target.setSmooth(input.isSmooth());
+        target.draw(Sprite(*source), RenderStates(BlendNone, Transform::Identity, NULL, it->shader));
+        target.display();
+
+        source = &target.getTexture();
+        current = 1 - current;
+        --remaining;
+    }
+
+    // The last enabled pass, if any, draws to the output
+    RenderStates finalStates(states);
+    finalStates.shader = NULL;
+    finalStates.texture = NULL;
+    for (std::vector<Pass>::const_reverse_iterator it = m_passes.rbegin(); (it != m_passes.rend()) && remaining; ++it)
+    {
+        if (it->enabled)
+        {
+            finalStates.shader = it->shader;
+            break;
+        }
+    }
+
+    output.draw(Sprite(*source), finalStates);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::releaseTargets()
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        m_pool.release(m_targets[i]);
+        m_targets[i] = NULL;
+    }
+}
+
+} // namespace sf
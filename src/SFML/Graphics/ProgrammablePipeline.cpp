@@ -0,0 +1,752 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ProgrammablePipeline.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GraphicsMemoryTracker.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+#ifndef SFML_OPENGL_ES
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+
+#endif
+
+#if !defined(GL_MAJOR_VERSION)
+    #define GL_MAJOR_VERSION 0x821B
+#endif
+
+#if !defined(GL_MINOR_VERSION)
+    #define GL_MINOR_VERSION 0x821C
+#endif
+
+#if !defined(GL_CONTEXT_PROFILE_MASK)
+    #define GL_CONTEXT_PROFILE_MASK 0x9126
+#endif
+
+#if !defined(GL_CONTEXT_CORE_PROFILE_BIT)
+    #define GL_CONTEXT_CORE_PROFILE_BIT 0x00000001
+#endif
+
+
+namespace
+{
+    // Streaming buffers never shrink below this size, so that small draws don't orphan all the time
+    const std::size_t minimumStreamSize = 64 * 1024;
+
+    const float identityMatrix[16] = {1.f, 0.f, 0.f, 0.f,
+                                      0.f, 1.f, 0.f, 0.f,
+                                      0.f, 0.f, 1.f, 0.f,
+                                      0.f, 0.f, 0.f, 1.f};
+
+    // The default shader is written once in GLSL 1.10 syntax;
+    // these headers adapt it to GLSL 1.50 for core profile contexts
+    const char coreVertexHeader[] =
+        "#version 150\n"
+        "#define attribute in\n"
+        "#define varying out\n";
+
+    const char coreFragmentHeader[] =
+        "#version 150\n"
+        "#define varying in\n"
+        "#define texture2D texture\n"
+        "out vec4 sf_fragColor;\n";
+
+    const char compatibilityVertexHeader[] =
+        "#version 110\n";
+
+    const char compatibilityFragmentHeader[] =
+        "#version 110\n"
+        "#define sf_fragColor gl_FragColor\n";
+
+    const char vertexShaderSource[] =
+        "attribute vec2 sf_position;\n"
+        "attribute vec4 sf_color;\n"
+        "attribute vec2 sf_texCoords;\n"
+        "uniform mat4 sf_viewProjectionMatrix;\n"
+        "uniform mat4 sf_modelMatrix;\n"
+        "uniform mat4 sf_textureMatrix;\n"
+        "varying vec4 sf_vertexColor;\n"
+        "varying vec2 sf_vertexTexCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = sf_viewProjectionMatrix * (sf_modelMatrix * vec4(sf_position, 0.0, 1.0));\n"
+        "    sf_vertexColor = sf_color;\n"
+        "    sf_vertexTexCoords = (sf_textureMatrix * vec4(sf_texCoords, 0.0, 1.0)).xy;\n"
+        "}\n";
+
+    const char fragmentShaderSource[] =
+        "uniform sampler2D sf_texture;\n"
+        "uniform float sf_textured;\n"
+        "varying vec4 sf_vertexColor;\n"
+        "varying vec2 sf_vertexTexCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    sf_fragColor = sf_vertexColor * mix(vec4(1.0), texture2D(sf_texture, sf_vertexTexCoords), sf_textured);\n"
+        "}\n";
+
+    // Convert a byte offset in the bound buffer to an attribute pointer
+    const void* bufferOffset(std::size_t offset)
+    {
+        return reinterpret_cast<const void*>(offset);
+    }
+
+    // Get the OpenGL type of the positions of a vertex format
+    GLenum getPositionType(const sf::VertexFormat& format)
+    {
+        switch (format.getPositionType())
+        {
+            case sf::VertexFormat::PositionHalf:  return GLEXT_GL_HALF_FLOAT;
+            case sf::VertexFormat::PositionShort: return GL_SHORT;
+            default:                              return GL_FLOAT;
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ProgrammablePipeline::ProgrammablePipeline() :
+m_defaultShader     (),
+m_defaultLocations  (),
+m_defaultBound      (false),
+m_dirty             (AllDirty),
+m_textured          (false),
+m_vertexStream      (),
+m_indexStream       (),
+m_quadBuffer        (0),
+m_quadCount         (0),
+m_vertexArrays      (),
+m_vertexArrayContext(0),
+m_coreProfile       (false)
+{
+    std::copy(identityMatrix, identityMatrix + 16, m_viewProjection);
+    std::copy(identityMatrix, identityMatrix + 16, m_model);
+    std::copy(identityMatrix, identityMatrix + 16, m_texture);
+}
+
+
+////////////////////////////////////////////////////////////
+ProgrammablePipeline::~ProgrammablePipeline()
+{
+    TransientContextLock contextLock;
+
+    if (m_vertexStream.buffer)
+    {
+        GLStateCache::forgetBuffer(m_vertexStream.buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &m_vertexStream.buffer));
+        priv::updateGraphicsMemory(GraphicsMemory::VertexBuffers, m_vertexStream.size, 0, 0, 0);
+    }
+
+    if (m_indexStream.buffer)
+    {
+        glCheck(GLEXT_glDeleteBuffers(1, &m_indexStream.buffer));
+        priv::updateGraphicsMemory(GraphicsMemory::IndexBuffers, m_indexStream.size, 0, 0, 0);
+    }
+
+    if (m_quadBuffer)
+    {
+        glCheck(GLEXT_glDeleteBuffers(1, &m_quadBuffer));
+        priv::updateGraphicsMemory(GraphicsMemory::IndexBuffers, m_quadCount * 6 * sizeof(Uint32), 0, 0, 0);
+    }
+
+    // Vertex array objects are not shared between contexts, we can only
+    // delete the one of the active context; the others die with their context
+    VertexArrayMap::iterator iter = m_vertexArrays.find(Context::getActiveContextId());
+
+    if (iter != m_vertexArrays.end())
+        glCheck(GLEXT_glDeleteVertexArrays(1, &iter->second));
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammablePipeline::create(bool coreProfile)
+{
+    m_coreProfile = coreProfile;
+
+    if (coreProfile && !GLEXT_vertex_array_object)
+    {
+        err() << "Core profile rendering requires vertex array objects, which are not available" << std::endl;
+        return false;
+    }
+
+    if (!loadShader(m_defaultShader, fragmentShaderSource, coreProfile))
+    {
+        err() << "Failed to compile the default shader of the programmable pipeline" << std::endl;
+        return false;
+    }
+
+    getUniformLocations(m_defaultShader.getNativeHandle(), m_defaultLocations);
+
+    glCheck(GLEXT_glGenBuffers(1, &m_vertexStream.buffer));
+    glCheck(GLEXT_glGenBuffers(1, &m_indexStream.buffer));
+    glCheck(GLEXT_glGenBuffers(1, &m_quadBuffer));
+
+    if (!m_vertexStream.buffer || !m_indexStream.buffer || !m_quadBuffer)
+    {
+        err() << "Failed to create the streaming buffers of the programmable pipeline" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammablePipeline::isCoreProfile() const
+{
+    return m_coreProfile;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::reset()
+{
+    m_vertexArrayContext = 0;
+    bindVertexArray();
+
+    glCheck(GLEXT_glEnableVertexAttribArray(PositionAttribute));
+    glCheck(GLEXT_glEnableVertexAttribArray(ColorAttribute));
+    glCheck(GLEXT_glEnableVertexAttribArray(TexCoordsAttribute));
+
+    invalidateShader();
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::release()
+{
+    Shader::bind(NULL, false, false);
+    invalidateShader();
+
+    GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, 0);
+
+    if (GLEXT_vertex_array_object)
+    {
+        glCheck(GLEXT_glBindVertexArray(0));
+        m_vertexArrayContext = 0;
+    }
+    else
+    {
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, 0));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::setViewProjection(const Transform& transform)
+{
+    std::copy(transform.getMatrix(), transform.getMatrix() + 16, m_viewProjection);
+    m_dirty |= ViewProjectionDirty;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::setModel(const Transform& transform)
+{
+    std::copy(transform.getMatrix(), transform.getMatrix() + 16, m_model);
+    m_dirty |= ModelDirty;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::setTextureMatrix(const float* matrix)
+{
+    m_textured = (matrix != NULL);
+    if (!matrix)
+        matrix = identityMatrix;
+
+    std::copy(matrix, matrix + 16, m_texture);
+    m_dirty |= TextureDirty;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::applyShader(const Shader* shader)
+{
+    // A shader which is not ready yet is replaced with its fallback, or the default shader
+    if (shader)
+        shader = shader->getReadyShader();
+
+    if (shader)
+    {
+        // User shaders may be used by other targets in between, so all
+        // the uniforms are uploaded every time; their locations are
+        // cached by the shader, which forgets them when it is reloaded
+        Shader::bind(shader, false, false);
+        m_defaultBound = false;
+
+        UniformLocations locations;
+        getUniformLocations(*shader, locations);
+        uploadUniforms(locations, AllDirty);
+    }
+    else
+    {
+        if (!m_defaultBound)
+        {
+            Shader::bind(&m_defaultShader, false, false);
+            m_defaultBound = true;
+        }
+
+        // The default shader keeps its uniform values, only upload what changed
+        if (m_dirty)
+        {
+            uploadUniforms(m_defaultLocations, m_dirty);
+            m_dirty = 0;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::invalidateShader()
+{
+    m_defaultBound = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::setVertexPointers(std::size_t offset, const VertexFormat& format)
+{
+    bindVertexArray();
+
+    // Normalized texture coordinates are read as integers, the texture matrix scales them back to pixels
+    GLsizei stride = static_cast<GLsizei>(format.getStride());
+    GLenum texCoordsType = (format.getTexCoordsType() == VertexFormat::TexCoordsFloat) ? GL_FLOAT : GL_SHORT;
+
+    glCheck(GLEXT_glVertexAttribPointer(PositionAttribute, 2, getPositionType(format), GL_FALSE, stride, bufferOffset(offset)));
+    glCheck(GLEXT_glVertexAttribPointer(ColorAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, bufferOffset(offset + format.getColorOffset())));
+    glCheck(GLEXT_glVertexAttribPointer(TexCoordsAttribute, 2, texCoordsType, GL_FALSE, stride, bufferOffset(offset + format.getTexCoordsOffset())));
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::streamVertices(const Vertex* vertices, std::size_t vertexCount)
+{
+    streamVertices(vertices, vertexCount, VertexFormat::Default);
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::streamVertices(const void* data, std::size_t vertexCount, const VertexFormat& format)
+{
+    bindVertexArray();
+
+    std::size_t offset = uploadStream(GLEXT_GL_ARRAY_BUFFER, m_vertexStream, GraphicsMemory::VertexBuffers, data, vertexCount * format.getStride());
+    setVertexPointers(offset, format);
+
+    GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ProgrammablePipeline::streamIndices(const void* indices, std::size_t size)
+{
+    // The element array binding is part of the vertex array object state
+    bindVertexArray();
+
+    return uploadStream(GLEXT_GL_ELEMENT_ARRAY_BUFFER, m_indexStream, GraphicsMemory::IndexBuffers, indices, size);
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::bindQuadIndices(std::size_t quadCount)
+{
+    bindVertexArray();
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, m_quadBuffer));
+
+    if (quadCount > m_quadCount)
+    {
+        std::size_t newCount = std::max(quadCount, m_quadCount * 2);
+
+        // Two triangles per quad: (0, 1, 2) and (0, 2, 3)
+        std::vector<Uint32> indices(newCount * 6);
+        for (std::size_t i = 0; i < newCount; ++i)
+        {
+            Uint32 first = static_cast<Uint32>(i * 4);
+            indices[i * 6 + 0] = first;
+            indices[i * 6 + 1] = first + 1;
+            indices[i * 6 + 2] = first + 2;
+            indices[i * 6 + 3] = first;
+            indices[i * 6 + 4] = first + 2;
+            indices[i * 6 + 5] = first + 3;
+        }
+
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(Uint32), &indices[0], GLEXT_GL_STATIC_DRAW));
+
+        priv::updateGraphicsMemory(GraphicsMemory::IndexBuffers, m_quadCount * 6 * sizeof(Uint32), 0, newCount * 6 * sizeof(Uint32), 0);
+        m_quadCount = newCount;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammablePipeline::isAvailable()
+{
+    // Multitexturing, which Shader::isAvailable() requires, is not needed here
+    return Shader::isProgramAvailable() && VertexBuffer::isAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammablePipeline::loadShader(Shader& shader, const char* fragmentSource, bool coreProfile)
+{
+    std::string vertex(coreProfile ? coreVertexHeader : compatibilityVertexHeader);
+    std::string fragment(coreProfile ? coreFragmentHeader : compatibilityFragmentHeader);
+    vertex += vertexShaderSource;
+    fragment += fragmentSource;
+
+    return shader.loadFromMemory(vertex, fragment);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammablePipeline::isCoreProfileActive()
+{
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    // Parse the version string rather than querying GL_MAJOR_VERSION, which
+    // raises an error on contexts older than 3.0; checking for it with
+    // glGetError would swallow the errors left by user code
+    const GLubyte* version = glGetString(GL_VERSION);
+
+    if (!version)
+        return false;
+
+    // The beginning of the returned string is "major.minor" (this is standard)
+    int majorVersion = 0;
+    int minorVersion = 0;
+
+    for (; (*version >= '0') && (*version <= '9'); ++version)
+        majorVersion = majorVersion * 10 + (*version - '0');
+
+    if (*version == '.')
+    {
+        for (++version; (*version >= '0') && (*version <= '9'); ++version)
+            minorVersion = minorVersion * 10 + (*version - '0');
+    }
+
+    // Profiles exist since 3.2
+    if ((majorVersion < 3) || ((majorVersion == 3) && (minorVersion < 2)))
+        return false;
+
+    int profile = 0;
+    glCheck(glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profile));
+
+    return (profile & GL_CONTEXT_CORE_PROFILE_BIT) != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::getUniformLocations(unsigned int program, UniformLocations& locations)
+{
+    GLEXT_GLhandle handle = castToGlHandle(program);
+
+    glCheck(locations.viewProjection = GLEXT_glGetUniformLocation(handle, "sf_viewProjectionMatrix"));
+    glCheck(locations.model = GLEXT_glGetUniformLocation(handle, "sf_modelMatrix"));
+    glCheck(locations.texture = GLEXT_glGetUniformLocation(handle, "sf_textureMatrix"));
+    glCheck(locations.textured = GLEXT_glGetUniformLocation(handle, "sf_textured"));
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::getUniformLocations(const Shader& shader, UniformLocations& locations)
+{
+    int* cache = shader.m_pipelineLocations;
+
+    if (cache[0] == -2)
+    {
+        getUniformLocations(shader.getNativeHandle(), locations);
+
+        cache[0] = locations.viewProjection;
+        cache[1] = locations.model;
+        cache[2] = locations.texture;
+        cache[3] = locations.textured;
+    }
+    else
+    {
+        locations.viewProjection = cache[0];
+        locations.model = cache[1];
+        locations.texture = cache[2];
+        locations.textured = cache[3];
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::uploadUniforms(const UniformLocations& locations, unsigned int flags)
+{
+    if ((flags & ViewProjectionDirty) && (locations.viewProjection != -1))
+        glCheck(GLEXT_glUniformMatrix4fv(locations.viewProjection, 1, GL_FALSE, m_viewProjection));
+
+    if ((flags & ModelDirty) && (locations.model != -1))
+        glCheck(GLEXT_glUniformMatrix4fv(locations.model, 1, GL_FALSE, m_model));
+
+    if (flags & TextureDirty)
+    {
+        if (locations.texture != -1)
+            glCheck(GLEXT_glUniformMatrix4fv(locations.texture, 1, GL_FALSE, m_texture));
+
+        if (locations.textured != -1)
+            glCheck(GLEXT_glUniform1f(locations.textured, m_textured ? 1.f : 0.f));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ProgrammablePipeline::uploadStream(unsigned int target, StreamBuffer& stream, GraphicsMemory::Category category,
+                                               const void* data, std::size_t bytes)
+{
+    GLStateCache::bindBuffer(target, stream.buffer);
+
+    // Keep uploads 4-byte aligned, as required for 32-bit indices
+    std::size_t offset = (stream.offset + 3) & ~static_cast<std::size_t>(3);
+
+    if (bytes > stream.size)
+    {
+        // Grow the buffer
+        std::size_t size = std::max(std::max(bytes, stream.size * 2), minimumStreamSize);
+        glCheck(GLEXT_glBufferData(target, size, NULL, GLEXT_GL_STREAM_DRAW));
+
+        priv::updateGraphicsMemory(category, stream.size, 0, size, 0);
+        stream.size = size;
+        offset = 0;
+    }
+    else if (offset + bytes > stream.size)
+    {
+        // The buffer is full: orphan it, so that we don't have
+        // to wait for pending draws that still read from it
+        glCheck(GLEXT_glBufferData(target, stream.size, NULL, GLEXT_GL_STREAM_DRAW));
+        offset = 0;
+    }
+
+    glCheck(GLEXT_glBufferSubData(target, offset, bytes, data));
+    stream.offset = offset + bytes;
+
+    return offset;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::bindVertexArray()
+{
+    if (!GLEXT_vertex_array_object)
+        return;
+
+    Uint64 contextId = Context::getActiveContextId();
+
+    if (contextId == m_vertexArrayContext)
+        return;
+
+    VertexArrayMap::iterator iter = m_vertexArrays.find(contextId);
+
+    if (iter != m_vertexArrays.end())
+    {
+        glCheck(GLEXT_glBindVertexArray(iter->second));
+    }
+    else
+    {
+        // Vertex array objects are not shared, each context gets its own
+        GLuint vertexArray = 0;
+        glCheck(GLEXT_glGenVertexArrays(1, &vertexArray));
+        glCheck(GLEXT_glBindVertexArray(vertexArray));
+
+        glCheck(GLEXT_glEnableVertexAttribArray(PositionAttribute));
+        glCheck(GLEXT_glEnableVertexAttribArray(ColorAttribute));
+        glCheck(GLEXT_glEnableVertexAttribArray(TexCoordsAttribute));
+
+        m_vertexArrays.insert(std::make_pair(contextId, static_cast<unsigned int>(vertexArray)));
+    }
+
+    m_vertexArrayContext = contextId;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ProgrammablePipeline::ProgrammablePipeline() :
+m_defaultShader     (),
+m_defaultLocations  (),
+m_defaultBound      (false),
+m_dirty             (AllDirty),
+m_textured          (false),
+m_vertexStream      (),
+m_indexStream       (),
+m_quadBuffer        (0),
+m_quadCount         (0),
+m_vertexArrays      (),
+m_vertexArrayContext(0),
+m_coreProfile       (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ProgrammablePipeline::~ProgrammablePipeline()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammablePipeline::create(bool /* coreProfile */)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammablePipeline::isCoreProfile() const
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::reset()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::release()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::setViewProjection(const Transform& /* transform */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::setModel(const Transform& /* transform */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::setTextureMatrix(const float* /* matrix */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::applyShader(const Shader* /* shader */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::invalidateShader()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::setVertexPointers(std::size_t /* offset */, const VertexFormat& /* format */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::streamVertices(const Vertex* /* vertices */, std::size_t /* vertexCount */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::streamVertices(const void* /* data */, std::size_t /* vertexCount */, const VertexFormat& /* format */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ProgrammablePipeline::streamIndices(const void* /* indices */, std::size_t /* size */)
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammablePipeline::bindQuadIndices(std::size_t /* quadCount */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammablePipeline::isAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammablePipeline::loadShader(Shader& /* shader */, const char* /* fragmentSource */, bool /* coreProfile */)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammablePipeline::isCoreProfileActive()
+{
+    return false;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
@@ -0,0 +1,365 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PROGRAMMABLEPIPELINE_HPP
+#define SFML_PROGRAMMABLEPIPELINE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GraphicsMemory.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexFormat.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Shader-based implementation of the RenderTarget pipeline
+///
+/// Replaces the fixed-function matrix stack and client-side
+/// arrays with a built-in default shader, matrix uniforms,
+/// generic vertex attributes, streaming buffers and vertex
+/// array objects, so that rendering works in core profile
+/// contexts.
+///
+////////////////////////////////////////////////////////////
+class ProgrammablePipeline : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Locations of the vertex attributes
+    ///
+    /// sf::Shader binds the sf_position, sf_color and
+    /// sf_texCoords attributes to these locations before linking.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum AttributeLocation
+    {
+        PositionAttribute  = 0, ///< vec2 sf_position
+        ColorAttribute     = 1, ///< vec4 sf_color (normalized)
+        TexCoordsAttribute = 2  ///< vec2 sf_texCoords
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ProgrammablePipeline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ProgrammablePipeline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compile the default shader and create the buffers
+    ///
+    /// Must be called with the render target's context active.
+    ///
+    /// \param coreProfile True if the active context is a core profile context
+    ///
+    /// \return True if the pipeline is ready to be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(bool coreProfile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the pipeline runs in a core profile context
+    ///
+    /// \return True in core profile contexts
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCoreProfile() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the OpenGL states owned by the pipeline
+    ///
+    /// Binds the vertex array object of the active context and
+    /// enables the vertex attribute arrays.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the OpenGL states owned by the pipeline
+    ///
+    /// Unbinds the shader, buffers and vertex array object so
+    /// that user OpenGL code starts from a clean state.
+    ///
+    ////////////////////////////////////////////////////////////
+    void release();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the view-projection matrix
+    ///
+    /// \param transform View transform
+    ///
+    ////////////////////////////////////////////////////////////
+    void setViewProjection(const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the model matrix
+    ///
+    /// \param transform Model transform
+    ///
+    ////////////////////////////////////////////////////////////
+    void setModel(const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the texture matrix
+    ///
+    /// \param matrix Array of 16 floats, or null if no texture is bound
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureMatrix(const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a shader and upload the pending uniforms
+    ///
+    /// \param shader User shader, or null to use the default shader
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyShader(const Shader* shader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget which shader is bound
+    ///
+    /// Call this when the current program was changed outside
+    /// of the pipeline.
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateShader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Point the vertex attributes to the bound array buffer
+    ///
+    /// \param offset Offset of the first vertex in the buffer, in bytes
+    /// \param format Layout of the vertices in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVertexPointers(std::size_t offset, const VertexFormat& format = VertexFormat::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload client vertices and point the attributes to them
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void streamVertices(const Vertex* vertices, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload client vertices stored in a compact format
+    ///
+    /// \param data        Pointer to the vertices
+    /// \param vertexCount Number of vertices
+    /// \param format      Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void streamVertices(const void* data, std::size_t vertexCount, const VertexFormat& format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload client indices to the streaming index buffer
+    ///
+    /// The buffer stays bound.
+    ///
+    /// \param indices Pointer to the indices
+    /// \param size    Size of the indices, in bytes
+    ///
+    /// \return Offset of the uploaded indices in the buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t streamIndices(const void* indices, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind an index buffer that draws quads as triangles
+    ///
+    /// Core profile contexts have no GL_QUADS primitive. The
+    /// buffer holds 32-bit indices forming two triangles per quad,
+    /// starting at offset 0.
+    ///
+    /// \param quadCount Number of quads to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindQuadIndices(std::size_t quadCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports the programmable pipeline
+    ///
+    /// \return True if GLSL programs and vertex buffers are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compile a fragment shader against the built-in vertex shader
+    ///
+    /// The fragment source is written in GLSL 1.10 and writes
+    /// sf_fragColor; it is adapted to GLSL 1.50 in core profile
+    /// contexts. The resulting program takes the built-in
+    /// attributes and uniforms, so it can replace the default
+    /// shader of the pipeline.
+    ///
+    /// \param shader         Shader to load
+    /// \param fragmentSource Source code of the fragment shader
+    /// \param coreProfile    True to target a core profile context
+    ///
+    /// \return True if the shader was successfully compiled
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool loadShader(Shader& shader, const char* fragmentSource, bool coreProfile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the active context is a core profile context
+    ///
+    /// \return True if the active context has no fixed-function pipeline
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isCoreProfileActive();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Locations of the built-in uniforms in a program
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UniformLocations
+    {
+        int viewProjection; ///< mat4 sf_viewProjectionMatrix
+        int model;          ///< mat4 sf_modelMatrix
+        int texture;        ///< mat4 sf_textureMatrix
+        int textured;       ///< float sf_textured
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Streaming buffer, filled front to back and orphaned when full
+    ///
+    ////////////////////////////////////////////////////////////
+    struct StreamBuffer
+    {
+        unsigned int buffer; ///< OpenGL buffer identifier
+        std::size_t  size;   ///< Size of the buffer, in bytes
+        std::size_t  offset; ///< Offset of the next upload, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Look up the built-in uniforms of a program
+    ///
+    /// \param program   Program handle
+    /// \param locations Structure receiving the locations
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getUniformLocations(unsigned int program, UniformLocations& locations);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Look up the built-in uniforms of a user shader
+    ///
+    /// The locations are only queried the first time, then
+    /// they are cached in the shader until it is reloaded.
+    ///
+    /// \param shader    Shader, which must be ready
+    /// \param locations Structure receiving the locations
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getUniformLocations(const Shader& shader, UniformLocations& locations);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload built-in uniforms to the bound program
+    ///
+    /// \param locations Locations of the uniforms in the bound program
+    /// \param flags     Combination of dirty flags selecting the uniforms
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadUniforms(const UniformLocations& locations, unsigned int flags);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload data to a streaming buffer
+    ///
+    /// \param target   OpenGL buffer target
+    /// \param stream   Streaming buffer
+    /// \param category Memory category of the buffer
+    /// \param data     Data to upload
+    /// \param bytes    Number of bytes to upload
+    ///
+    /// \return Offset of the data in the buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t uploadStream(unsigned int target, StreamBuffer& stream, GraphicsMemory::Category category, const void* data, std::size_t bytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the vertex array object of the active context
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindVertexArray();
+
+    ////////////////////////////////////////////////////////////
+    // Dirty flags of the built-in uniforms
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        ViewProjectionDirty = 1 << 0,
+        ModelDirty          = 1 << 1,
+        TextureDirty        = 1 << 2,
+        AllDirty            = ViewProjectionDirty | ModelDirty | TextureDirty
+    };
+
+    typedef std::map<Uint64, unsigned int> VertexArrayMap;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Shader           m_defaultShader;      ///< Shader used when the render states have none
+    UniformLocations m_defaultLocations;   ///< Uniform locations of the default shader
+    bool             m_defaultBound;       ///< Is the default shader currently bound?
+    unsigned int     m_dirty;              ///< Uniforms of the default shader that need an upload
+    float            m_viewProjection[16]; ///< Current view-projection matrix
+    float            m_model[16];          ///< Current model matrix
+    float            m_texture[16];        ///< Current texture matrix
+    bool             m_textured;           ///< Is a texture currently bound?
+    StreamBuffer     m_vertexStream;       ///< Streaming buffer for client vertices
+    StreamBuffer     m_indexStream;        ///< Streaming buffer for client indices
+    unsigned int     m_quadBuffer;         ///< Index buffer drawing quads as triangles
+    std::size_t      m_quadCount;          ///< Number of quads covered by the quad index buffer
+    VertexArrayMap   m_vertexArrays;       ///< Vertex array objects, per context
+    Uint64           m_vertexArrayContext; ///< Context whose vertex array object is bound
+    bool             m_coreProfile;        ///< Does the pipeline run in a core profile context?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PROGRAMMABLEPIPELINE_HPP
@@ -27,11 +27,19 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/DrawList.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/InstanceData.hpp>
+#include <SFML/Graphics/InstancedRenderer.hpp>
+#include <SFML/Graphics/OverdrawAnalyzer.hpp>
+#include <SFML/Graphics/SoftwareRasterizer.hpp>
+#include <SFML/Graphics/ProgrammablePipeline.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
@@ -39,6 +47,7 @@
 #include <cassert>
 #include <iostream>
 #include <algorithm>
+#include <functional>
 #include <map>
 
 
@@ -119,17 +128,206 @@ namespace
         assert(false);
         return GLEXT_GL_FUNC_ADD;
     }
+
+
+    // Strict weak ordering of blend modes, used to group queued draws by blend mode
+    bool isBlendModeLess(const sf::BlendMode& left, const sf::BlendMode& right)
+    {
+        if (left.colorSrcFactor != right.colorSrcFactor) return left.colorSrcFactor < right.colorSrcFactor;
+        if (left.colorDstFactor != right.colorDstFactor) return left.colorDstFactor < right.colorDstFactor;
+        if (left.colorEquation  != right.colorEquation)  return left.colorEquation  < right.colorEquation;
+        if (left.alphaSrcFactor != right.alphaSrcFactor) return left.alphaSrcFactor < right.alphaSrcFactor;
+        if (left.alphaDstFactor != right.alphaDstFactor) return left.alphaDstFactor < right.alphaDstFactor;
+        return left.alphaEquation < right.alphaEquation;
+    }
+
+
+    // Count the shader, texture and blend mode changes needed to submit queued draws in their current order
+    template <typename T>
+    std::size_t countStateChanges(const std::vector<T>& draws)
+    {
+        std::size_t changes = 0;
+
+        for (std::size_t i = 1; i < draws.size(); ++i)
+        {
+            const T& previous = draws[i - 1];
+            const T& current = draws[i];
+
+            if (current.states.shader != previous.states.shader)
+                ++changes;
+            if (current.textureId != previous.textureId)
+                ++changes;
+            if (current.states.blendMode != previous.states.blendMode)
+                ++changes;
+        }
+
+        return changes;
+    }
+
+
+    // Append a mesh vertex, as modified by an instance, to a vertex array
+    void appendInstanceVertex(std::vector<sf::Vertex>& output, const sf::Vertex& vertex, const sf::InstanceData& instance)
+    {
+        const sf::FloatRect& rect = instance.textureRect;
+
+        output.push_back(sf::Vertex(instance.transform.transformPoint(vertex.position),
+                                    vertex.color * instance.color,
+                                    sf::Vector2f(rect.left + vertex.texCoords.x * rect.width,
+                                                 rect.top  + vertex.texCoords.y * rect.height)));
+    }
+
+
+    // Primitive type used to draw expanded instances: connected primitives become
+    // independent ones, so that consecutive instances are not joined together
+    sf::PrimitiveType getExpandedType(sf::PrimitiveType type)
+    {
+        switch (type)
+        {
+            case sf::LineStrip:     return sf::Lines;
+            case sf::TriangleStrip: return sf::Triangles;
+            case sf::TriangleFan:   return sf::Triangles;
+            default:                return type;
+        }
+    }
+
+
+    // Number of vertices that a mesh occupies once expanded
+    std::size_t getExpandedVertexCount(sf::PrimitiveType type, std::size_t vertexCount)
+    {
+        switch (type)
+        {
+            case sf::LineStrip:     return (vertexCount < 2) ? 0 : (vertexCount - 1) * 2;
+            case sf::TriangleStrip: return (vertexCount < 3) ? 0 : (vertexCount - 2) * 3;
+            case sf::TriangleFan:   return (vertexCount < 3) ? 0 : (vertexCount - 2) * 3;
+            default:                return vertexCount;
+        }
+    }
+
+
+    // Append all the vertices of a mesh, as modified by an instance, to a vertex array
+    void expandInstance(std::vector<sf::Vertex>& output, const sf::Vertex* vertices, std::size_t vertexCount,
+                        sf::PrimitiveType type, const sf::InstanceData& instance)
+    {
+        switch (type)
+        {
+            case sf::LineStrip:
+            {
+                for (std::size_t i = 1; i < vertexCount; ++i)
+                {
+                    appendInstanceVertex(output, vertices[i - 1], instance);
+                    appendInstanceVertex(output, vertices[i], instance);
+                }
+                break;
+            }
+
+            case sf::TriangleStrip:
+            {
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    appendInstanceVertex(output, vertices[i - 2], instance);
+                    appendInstanceVertex(output, vertices[i - 1], instance);
+                    appendInstanceVertex(output, vertices[i], instance);
+                }
+                break;
+            }
+
+            case sf::TriangleFan:
+            {
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    appendInstanceVertex(output, vertices[0], instance);
+                    appendInstanceVertex(output, vertices[i - 1], instance);
+                    appendInstanceVertex(output, vertices[i], instance);
+                }
+                break;
+            }
+
+            default:
+            {
+                for (std::size_t i = 0; i < vertexCount; ++i)
+                    appendInstanceVertex(output, vertices[i], instance);
+                break;
+            }
+        }
+    }
+
+
+    // Tell the user, once, that software render targets can't read vertex buffers back
+    void warnSoftwareVertexBuffer()
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            sf::err() << "Vertex buffers can't be read back for software render targets on this platform, drawing skipped" << std::endl;
+            warned = true;
+        }
+    }
+
+
+    // Point the fixed-function vertex arrays to vertices stored in the given format
+    void setFormatPointers(const char* data, const sf::VertexFormat& format)
+    {
+        GLsizei stride = static_cast<GLsizei>(format.getStride());
+
+        GLenum positionType = GL_FLOAT;
+        if (format.getPositionType() == sf::VertexFormat::PositionHalf)
+            positionType = GLEXT_GL_HALF_FLOAT;
+        else if (format.getPositionType() == sf::VertexFormat::PositionShort)
+            positionType = GL_SHORT;
+
+        // Normalized texture coordinates are read as integers, the texture matrix scales them back to pixels
+        GLenum texCoordsType = (format.getTexCoordsType() == sf::VertexFormat::TexCoordsFloat) ? GL_FLOAT : GL_SHORT;
+
+        glCheck(glVertexPointer(2, positionType, stride, data));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, stride, data + format.getColorOffset()));
+        glCheck(glTexCoordPointer(2, texCoordsType, stride, data + format.getTexCoordsOffset()));
+    }
 }
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+RenderTarget::Statistics::Statistics() :
+drawCalls       (0),
+vertices        (0),
+vertexCacheHits (0),
+textureChanges  (0),
+shaderChanges   (0),
+blendModeChanges(0),
+stateResets     (0),
+contextSwitches (0)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
+m_viewKnown  (true),
 m_cache      (),
-m_id         (getUniqueId())
+m_id         (getUniqueId()),
+m_instancedRenderer(NULL),
+m_bufferVertices     (),
+m_instanceVertices (),
+m_formatVertices   (),
+m_pipeline         (NULL),
+m_backend          (FixedFunction),
+m_queue            (),
+m_queueVertices    (),
+m_queueIndices16   (),
+m_queueIndices32   (),
+m_queueInstances   (),
+m_queueing         (false),
+m_queueLayer       (0),
+m_queueBarrier     (0),
+m_queueAvoided     (0),
+m_statistics       (),
+m_frameStatistics  (),
+m_overdraw         (NULL),
+m_rasterizer       (NULL)
 {
     m_cache.glStatesSet = false;
 }
@@ -138,18 +336,47 @@ m_id         (getUniqueId())
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    delete m_instancedRenderer;
+    delete m_pipeline;
+    delete m_overdraw;
+    delete m_rasterizer;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    // Draws recorded before the clear must not be drawn over the cleared target;
+    // targets which can't submit them (draw lists) have nothing to clear
+    if (m_queueing && !submitQueue())
+        return;
+
+    if (m_rasterizer)
+    {
+        m_rasterizer->clear(color);
+        return;
+    }
+
     if (isActive(m_id) || setActive(true))
     {
+        // Core profile contexts need our states before anything can be bound
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
 
-        glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
+        // The overdraw analysis counts from zero
+        if (m_overdraw)
+        {
+            m_overdraw->reset();
+            glCheck(glClearColor(0.f, 0.f, 0.f, 0.f));
+        }
+        else
+        {
+            glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
+        }
+
         glCheck(glClear(GL_COLOR_BUFFER_BIT));
     }
 }
@@ -158,6 +385,12 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // Draws recorded before the change must be drawn with the previous view;
+    // targets which can't submit them (draw lists) are replayed with the view
+    // of the target they are drawn to, whatever view is set while recording
+    if (m_queueing && !submitQueue())
+        return;
+
     m_view = view;
     m_cache.viewChanged = true;
 }
@@ -177,6 +410,13 @@ const View& RenderTarget::getDefaultView() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderTarget::isViewKnown() const
+{
+    return m_viewKnown;
+}
+
+
 ////////////////////////////////////////////////////////////
 IntRect RenderTarget::getViewport(const View& view) const
 {
@@ -246,78 +486,7 @@ void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
 void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
                         PrimitiveType type, const RenderStates& states)
 {
-    // Nothing to draw?
-    if (!vertices || (vertexCount == 0))
-        return;
-
-    // GL_QUADS is unavailable on OpenGL ES
-    #ifdef SFML_OPENGL_ES
-        if (type == Quads)
-        {
-            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
-            return;
-        }
-    #endif
-
-    if (isActive(m_id) || setActive(true))
-    {
-        // Check if the vertex count is low enough so that we can pre-transform them
-        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
-
-        if (useVertexCache)
-        {
-            // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
-            {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
-            }
-        }
-
-        setupDraw(useVertexCache, states);
-
-        // Check if texture coordinates array is needed, and update client state accordingly
-        bool enableTexCoordsArray = (states.texture || states.shader);
-        if (!m_cache.enable || (enableTexCoordsArray != m_cache.texCoordsArrayEnabled))
-        {
-            if (enableTexCoordsArray)
-                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
-            else
-                glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
-        }
-
-        // If we switch between non-cache and cache mode or enable texture
-        // coordinates we need to set up the pointers to the vertices' components
-        if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache)
-        {
-            const char* data = reinterpret_cast<const char*>(vertices);
-
-            // If we pre-transform the vertices, we must use our internal vertex cache
-            if (useVertexCache)
-                data = reinterpret_cast<const char*>(m_cache.vertexCache);
-
-            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
-            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
-            if (enableTexCoordsArray)
-                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
-        }
-        else if (enableTexCoordsArray && !m_cache.texCoordsArrayEnabled)
-        {
-            // If we enter this block, we are already using our internal vertex cache
-            const char* data = reinterpret_cast<const char*>(m_cache.vertexCache);
-
-            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
-        }
-
-        drawPrimitives(type, 0, vertexCount);
-        cleanupDraw(states);
-
-        // Update the cache
-        m_cache.useVertexCache = useVertexCache;
-        m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
-    }
+    drawVertices(vertices, vertexCount, type, states, NULL, 0, 0);
 }
 
 
@@ -350,6 +519,19 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
     if (!vertexCount || !vertexBuffer.getNativeHandle())
         return;
 
+    // Vertex buffers live in graphics memory, the software rasterizer needs them in client memory
+    if (m_rasterizer)
+    {
+        m_bufferVertices.resize(vertexCount);
+
+        if (vertexBuffer.readVertices(firstVertex, vertexCount, &m_bufferVertices[0]))
+            drawVertices(&m_bufferVertices[0], vertexCount, vertexBuffer.getPrimitiveType(), states, NULL, 0, 0);
+        else
+            warnSoftwareVertexBuffer();
+
+        return;
+    }
+
     // GL_QUADS is unavailable on OpenGL ES
     #ifdef SFML_OPENGL_ES
         if (vertexBuffer.getPrimitiveType() == Quads)
@@ -359,25 +541,41 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
         }
     #endif
 
+    if (m_queueing)
+    {
+        queueDraw(NULL, &vertexBuffer, NULL, vertexBuffer.getPrimitiveType(), firstVertex, vertexCount, NULL, 0, 0, 0, states);
+        return;
+    }
+
     if (isActive(m_id) || setActive(true))
     {
-        setupDraw(false, states);
+        const VertexFormat& format = vertexBuffer.getFormat();
+
+        setupDraw(false, states, format);
 
         // Bind vertex buffer
-        VertexBuffer::bind(&vertexBuffer);
+        priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer.getNativeHandle());
 
-        // Always enable texture coordinates
-        if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
-            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        if (m_pipeline)
+        {
+            // Start the attributes at the first vertex, so that drawing
+            // quads through the quad index buffer starts at index 0
+            m_pipeline->setVertexPointers(firstVertex * format.getStride(), format);
+            firstVertex = 0;
+        }
+        else
+        {
+            // Always enable texture coordinates
+            if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
+                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
 
-        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
-        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
-        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+            setFormatPointers(NULL, format);
+        }
 
         drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
 
         // Unbind vertex buffer
-        VertexBuffer::bind(NULL);
+        priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, 0);
 
         cleanupDraw(states);
 
@@ -389,339 +587,1425 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTarget::setActive(bool active)
+void RenderTarget::draw(const void* vertices, std::size_t vertexCount, const VertexFormat& format,
+                        PrimitiveType type, const RenderStates& states)
 {
-    // Mark this RenderTarget as active or no longer active in the tracking map
+    // The vertices are already sf::Vertex
+    if (format == VertexFormat::Default)
     {
-        sf::Lock lock(mutex);
+        drawVertices(static_cast<const Vertex*>(vertices), vertexCount, type, states, NULL, 0, 0);
+        return;
+    }
 
-        Uint64 contextId = Context::getActiveContextId();
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
 
-        ContextRenderTargetMap::iterator iter = contextRenderTargetMap.find(contextId);
+    // Recorded draws, the software rasterizer and formats unknown to the driver need sf::Vertex
+    if (m_queueing || m_rasterizer || !format.isSupported())
+    {
+        m_formatVertices.resize(vertexCount);
+        format.unpack(vertices, vertexCount, &m_formatVertices[0]);
 
-        if (active)
+        drawVertices(&m_formatVertices[0], vertexCount, type, states, NULL, 0, 0);
+        return;
+    }
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (type == Quads)
         {
-            if (iter == contextRenderTargetMap.end())
-            {
-                contextRenderTargetMap[contextId] = m_id;
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
 
-                m_cache.enable = false;
-            }
-            else if (iter->second != m_id)
-            {
-                iter->second = m_id;
+    if (isActive(m_id) || setActive(true))
+    {
+        // Compact vertices can't be pre-transformed, the transform is always loaded
+        setupDraw(false, states, format);
 
-                m_cache.enable = false;
-            }
+        if (m_pipeline)
+        {
+            m_pipeline->streamVertices(vertices, vertexCount, format);
         }
         else
         {
-            if (iter != contextRenderTargetMap.end())
-                contextRenderTargetMap.erase(iter);
+            // Always enable texture coordinates
+            if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
+                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
 
-            m_cache.enable = false;
+            setFormatPointers(static_cast<const char*>(vertices), format);
+
+            m_cache.texCoordsArrayEnabled = true;
         }
-    }
 
-    return true;
+        drawPrimitives(type, 0, vertexCount);
+
+        cleanupDraw(states);
+
+        // The pointers no longer refer to the vertex cache
+        m_cache.useVertexCache = false;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::pushGLStates()
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+                        PrimitiveType type, const RenderStates& states)
 {
-    if (isActive(m_id) || setActive(true))
-    {
-        #ifdef SFML_DEBUG
-            // make sure that the user didn't leave an unchecked OpenGL error
-            GLenum error = glGetError();
-            if (error != GL_NO_ERROR)
-            {
-                err() << "OpenGL error (" << error << ") detected in user code, "
-                      << "you should check for errors with glGetError()"
-                      << std::endl;
-            }
-        #endif
-
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
-            glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
-        #endif
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
-    }
+    // Nothing to draw?
+    if (!indices || (indexCount == 0))
+        return;
 
-    resetGLStates();
+    drawVertices(vertices, vertexCount, type, states, indices, indexCount, sizeof(Uint16));
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::popGLStates()
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+                        PrimitiveType type, const RenderStates& states)
 {
-    if (isActive(m_id) || setActive(true))
-    {
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPopMatrix());
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPopClientAttrib());
-            glCheck(glPopAttrib());
+    // Nothing to draw?
+    if (!indices || (indexCount == 0))
+        return;
+
+    // 32-bit indices are optional on OpenGL ES
+    if (!GLEXT_element_index_uint)
+    {
+        err() << "32-bit indices are not supported on this platform, drawing skipped" << std::endl;
+        return;
+    }
+
+    drawVertices(vertices, vertexCount, type, states, indices, indexCount, sizeof(Uint32));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, indexBuffer, 0, indexBuffer.getIndexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex,
+                        std::size_t indexCount, const RenderStates& states)
+{
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Sanity check
+    if (firstIndex > indexBuffer.getIndexCount())
+        return;
+
+    // Clamp indexCount to something that makes sense
+    indexCount = std::min(indexCount, indexBuffer.getIndexCount() - firstIndex);
+
+    // Nothing to draw?
+    if (!indexCount || !vertexBuffer.getNativeHandle() || !indexBuffer.getNativeHandle())
+        return;
+
+    // The indices may refer to any vertex, so the software rasterizer needs the whole vertex buffer
+    if (m_rasterizer)
+    {
+        std::size_t vertexCount = vertexBuffer.getVertexCount();
+        std::size_t indexSize = IndexBuffer::getIndexSize(indexBuffer.getIndexType());
+
+        m_bufferVertices.resize(vertexCount);
+        m_bufferIndices.resize(indexCount * indexSize);
+
+        if (vertexBuffer.readVertices(0, vertexCount, &m_bufferVertices[0]) &&
+            indexBuffer.readIndices(firstIndex, indexCount, &m_bufferIndices[0]))
+            drawVertices(&m_bufferVertices[0], vertexCount, vertexBuffer.getPrimitiveType(), states, &m_bufferIndices[0], indexCount, indexSize);
+        else
+            warnSoftwareVertexBuffer();
+
+        return;
+    }
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (vertexBuffer.getPrimitiveType() == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
+
+    // 32-bit indices are optional on OpenGL ES
+    if ((indexBuffer.getIndexType() == IndexBuffer::Index32) && !GLEXT_element_index_uint)
+    {
+        err() << "32-bit indices are not supported on this platform, drawing skipped" << std::endl;
+        return;
+    }
+
+    if (m_queueing)
+    {
+        queueDraw(NULL, &vertexBuffer, &indexBuffer, vertexBuffer.getPrimitiveType(), 0, vertexBuffer.getVertexCount(), NULL,
+                  firstIndex, indexCount, IndexBuffer::getIndexSize(indexBuffer.getIndexType()), states);
+        return;
+    }
+
+    if (isActive(m_id) || setActive(true))
+    {
+        const VertexFormat& format = vertexBuffer.getFormat();
+
+        setupDraw(false, states, format);
+
+        // Bind vertex buffer
+        priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer.getNativeHandle());
+
+        if (m_pipeline)
+        {
+            // This also binds the vertex array object, which stores the index buffer binding
+            m_pipeline->setVertexPointers(0, format);
+        }
+        else
+        {
+            // Always enable texture coordinates
+            if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
+                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+
+            setFormatPointers(NULL, format);
+        }
+
+        // Bind index buffer
+        IndexBuffer::bind(&indexBuffer);
+
+        // With a bound index buffer, the index pointer is an offset into the buffer
+        std::size_t indexSize = IndexBuffer::getIndexSize(indexBuffer.getIndexType());
+        drawIndexedPrimitives(vertexBuffer.getPrimitiveType(), reinterpret_cast<const void*>(firstIndex * indexSize), indexCount, indexSize);
+
+        // Unbind vertex and index buffers
+        IndexBuffer::bind(NULL);
+        priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, 0);
+
+        cleanupDraw(states);
+
+        // Update the cache
+        m_cache.useVertexCache = false;
+        m_cache.texCoordsArrayEnabled = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const DrawList& drawList, const RenderStates& states)
+{
+    const RenderTarget& source = drawList;
+
+    // Replaying a list into itself would never end
+    if (&source == this)
+        return;
+
+    for (std::vector<QueuedDraw>::const_iterator it = source.m_queue.begin(); it != source.m_queue.end(); ++it)
+        drawQueued(source, *it, states.transform);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstanced(const VertexBuffer& mesh, const InstanceData* instances, std::size_t instanceCount,
+                                 const RenderStates& states)
+{
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Nothing to draw?
+    if (!mesh.getVertexCount() || !mesh.getNativeHandle())
+        return;
+
+    drawInstances(&mesh, NULL, mesh.getVertexCount(), mesh.getPrimitiveType(), instances, instanceCount, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstanced(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                                 const InstanceData* instances, std::size_t instanceCount, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    drawInstances(NULL, vertices, vertexCount, type, instances, instanceCount, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::beginQueue()
+{
+    if (m_queueing)
+        return;
+
+    m_queueing = true;
+    m_queueLayer = 0;
+    m_queueBarrier = 0;
+    m_queueAvoided = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setQueueLayer(int layer)
+{
+    m_queueLayer = layer;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::queueBarrier()
+{
+    ++m_queueBarrier;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTarget::flushQueue()
+{
+    if (!m_queueing)
+        return 0;
+
+    // Targets which can't submit their draws (draw lists) keep recording
+    if (!submitQueue())
+        return 0;
+
+    m_queueing = false;
+
+    return m_queueAvoided;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::setActive(bool active)
+{
+    // Mark this RenderTarget as active or no longer active in the tracking map
+    {
+        sf::Lock lock(mutex);
+
+        Uint64 contextId = Context::getActiveContextId();
+
+        ContextRenderTargetMap::iterator iter = contextRenderTargetMap.find(contextId);
+
+        if (active)
+        {
+            if (iter == contextRenderTargetMap.end())
+            {
+                contextRenderTargetMap[contextId] = m_id;
+
+                m_cache.enable = false;
+                ++m_statistics.contextSwitches;
+            }
+            else if (iter->second != m_id)
+            {
+                iter->second = m_id;
+
+                m_cache.enable = false;
+                ++m_statistics.contextSwitches;
+            }
+        }
+        else
+        {
+            if (iter != contextRenderTargetMap.end())
+                contextRenderTargetMap.erase(iter);
+
+            m_cache.enable = false;
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::pushGLStates()
+{
+    // Software targets have no OpenGL states
+    if (m_rasterizer)
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        #ifdef SFML_DEBUG
+            // make sure that the user didn't leave an unchecked OpenGL error
+            GLenum error = glGetError();
+            if (error != GL_NO_ERROR)
+            {
+                err() << "OpenGL error (" << error << ") detected in user code, "
+                      << "you should check for errors with glGetError()"
+                      << std::endl;
+            }
         #endif
+
+        // Core profile contexts have no attribute and matrix stacks
+        if (!priv::ProgrammablePipeline::isCoreProfileActive())
+        {
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
+                glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
+            #endif
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPushMatrix());
+        }
+    }
+
+    resetGLStates();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::popGLStates()
+{
+    if (m_rasterizer)
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        // The programmable pipeline's shader, buffers and vertex
+        // array object are not covered by the attribute stacks
+        if (m_pipeline)
+            m_pipeline->release();
+
+        if (!priv::ProgrammablePipeline::isCoreProfileActive())
+        {
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPopMatrix());
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPopClientAttrib());
+                glCheck(glPopAttrib());
+            #endif
+        }
+
+        // The restored bindings are not the cached ones anymore
+        priv::GLStateCache::invalidate();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::resetGLStates()
+{
+    if (m_rasterizer)
+    {
+        m_cache.glStatesSet = true;
+        return;
+    }
+
+    // Check here to make sure a context change does not happen after activate(true)
+    bool shaderAvailable = Shader::isAvailable();
+    bool vertexBufferAvailable = VertexBuffer::isAvailable();
+    bool pipelineAvailable = priv::ProgrammablePipeline::isAvailable();
+
+    // Workaround for states not being properly reset on
+    // macOS unless a context switch really takes place
+    #if defined(SFML_SYSTEM_MACOS)
+        setActive(false);
+    #endif
+
+    if (isActive(m_id) || setActive(true))
+    {
+        ++m_statistics.stateResets;
+
+        // The bindings may have been changed without going through SFML
+        priv::GLStateCache::invalidate();
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        // Select the backend: core profile contexts can only use the programmable one
+        bool coreProfile = priv::ProgrammablePipeline::isCoreProfileActive();
+
+        if ((coreProfile || (m_backend == Programmable)) && !m_pipeline)
+        {
+            if (pipelineAvailable)
+            {
+                m_pipeline = new priv::ProgrammablePipeline;
+
+                if (!m_pipeline->create(coreProfile))
+                {
+                    delete m_pipeline;
+                    m_pipeline = NULL;
+                }
+            }
+
+            if (!m_pipeline)
+                err() << "Failed to set up the programmable rendering backend, falling back to fixed-function rendering" << std::endl;
+        }
+        else if (!coreProfile && (m_backend == FixedFunction) && m_pipeline)
+        {
+            m_pipeline->release();
+            delete m_pipeline;
+            m_pipeline = NULL;
+        }
+
+        // Make sure that the texture unit which is active is the number 0
+        if (GLEXT_multitexture)
+        {
+            if (!m_pipeline)
+                glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+            priv::GLStateCache::activeTexture(0);
+        }
+
+        // Define the default OpenGL states
+        glCheck(glDisable(GL_CULL_FACE));
+        glCheck(glDisable(GL_DEPTH_TEST));
+        glCheck(glEnable(GL_BLEND));
+
+        if (m_pipeline)
+        {
+            m_pipeline->reset();
+            applyTransform(Transform::Identity);
+        }
+        else
+        {
+            // Client-side arrays can't be used while a vertex array object is bound
+            #ifndef SFML_OPENGL_ES
+                if (GLEXT_vertex_array_object)
+                    glCheck(GLEXT_glBindVertexArray(0));
+            #endif
+
+            glCheck(glDisable(GL_LIGHTING));
+            glCheck(glDisable(GL_ALPHA_TEST));
+            glCheck(glEnable(GL_TEXTURE_2D));
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glLoadIdentity());
+            glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+            glCheck(glEnableClientState(GL_COLOR_ARRAY));
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
+        m_cache.glStatesSet = true;
+
+        // Apply the default SFML states
+        applyBlendMode(BlendAlpha);
+        applyTexture(NULL);
+        if (shaderAvailable)
+            applyShader(NULL);
+
+        if (vertexBufferAvailable)
+            glCheck(VertexBuffer::bind(NULL));
+
+        m_cache.texCoordsArrayEnabled = true;
+
+        m_cache.useVertexCache = false;
+
+        m_cache.lastProgram = 0;
+
+        // Set the default view
+        setView(getView());
+
+        m_cache.enable = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBackend(Backend backend)
+{
+    m_backend = backend;
+
+    // The backend is (re)selected when the states are reset before the next draw
+    m_cache.glStatesSet = false;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTarget::Backend RenderTarget::getBackend() const
+{
+    return m_pipeline ? Programmable : FixedFunction;
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderTarget::Statistics& RenderTarget::getStatistics() const
+{
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderTarget::Statistics& RenderTarget::getFrameStatistics() const
+{
+    return m_frameStatistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::resetStatistics()
+{
+    m_statistics = Statistics();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setOverdrawAnalysis(bool enabled)
+{
+    if (enabled == (m_overdraw != NULL))
+        return;
+
+    // Draws recorded before the change must be drawn in the previous mode;
+    // targets which can't submit them (draw lists) draw nothing to analyze
+    if (m_queueing && !submitQueue())
+        return;
+
+    if (enabled)
+    {
+        m_overdraw = new priv::OverdrawAnalyzer;
+    }
+    else
+    {
+        delete m_overdraw;
+        m_overdraw = NULL;
+    }
+
+    // The counting shader may still be bound
+    m_cache.glStatesSet = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isOverdrawAnalysisEnabled() const
+{
+    return m_overdraw != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+OverdrawReport RenderTarget::getOverdrawReport()
+{
+    OverdrawReport report;
+
+    // The software rasterizer doesn't run the counting draws
+    if (!m_overdraw || m_rasterizer)
+        return report;
+
+    // Recorded draws are part of the analysis
+    if (m_queueing && !submitQueue())
+        return report;
+
+    if (isActive(m_id) || setActive(true))
+        m_overdraw->fillReport(getSize(), report);
+
+    return report;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::initialize()
+{
+    // Setup the default and current views
+    m_defaultView.reset(FloatRect(0, 0, static_cast<float>(getSize().x), static_cast<float>(getSize().y)));
+    m_view = m_defaultView;
+
+    // Set GL states only on first draw, so that we don't pollute user's states
+    m_cache.glStatesSet = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::endStatisticsFrame()
+{
+    m_frameStatistics = m_statistics;
+    m_statistics = Statistics();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyCurrentView()
+{
+    // Set the viewport
+    IntRect viewport = getViewport(m_view);
+    int top = getSize().y - (viewport.top + viewport.height);
+    glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
+
+    if (m_pipeline)
+    {
+        // The view-projection matrix is a uniform of the shader
+        m_pipeline->setViewProjection(m_view.getTransform());
+    }
+    else
+    {
+        // Set the projection matrix
+        glCheck(glMatrixMode(GL_PROJECTION));
+        glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+
+        // Go back to model-view mode
+        glCheck(glMatrixMode(GL_MODELVIEW));
+    }
+
+    m_cache.viewChanged = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyBlendMode(const BlendMode& mode)
+{
+    // Apply the blend mode, falling back to the non-separate versions if necessary
+    if (GLEXT_blend_func_separate)
+    {
+        glCheck(GLEXT_glBlendFuncSeparate(
+            factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor),
+            factorToGlConstant(mode.alphaSrcFactor), factorToGlConstant(mode.alphaDstFactor)));
+    }
+    else
+    {
+        glCheck(glBlendFunc(
+            factorToGlConstant(mode.colorSrcFactor),
+            factorToGlConstant(mode.colorDstFactor)));
+    }
+
+    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
+    {
+        if (GLEXT_blend_equation_separate)
+        {
+            glCheck(GLEXT_glBlendEquationSeparate(
+                equationToGlConstant(mode.colorEquation),
+                equationToGlConstant(mode.alphaEquation)));
+        }
+        else
+        {
+            glCheck(GLEXT_glBlendEquation(equationToGlConstant(mode.colorEquation)));
+        }
+    }
+    else if ((mode.colorEquation != BlendMode::Add) || (mode.alphaEquation != BlendMode::Add))
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            err() << "OpenGL extension EXT_blend_minmax and/or EXT_blend_subtract unavailable" << std::endl;
+            err() << "Selecting a blend equation not possible" << std::endl;
+            err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
+
+            warned = true;
+        }
+    }
+
+    m_cache.lastBlendMode = mode;
+    ++m_statistics.blendModeChanges;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyTransform(const Transform& transform)
+{
+    if (m_pipeline)
+    {
+        m_pipeline->setModel(transform);
+        return;
+    }
+
+    // No need to call glMatrixMode(GL_MODELVIEW), it is always the
+    // current mode (for optimization purpose, since it's the most used)
+    if (transform == Transform::Identity)
+        glCheck(glLoadIdentity());
+    else
+        glCheck(glLoadMatrixf(transform.getMatrix()));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyTexture(const Texture* texture)
+{
+    if (m_pipeline)
+    {
+        // Bind the texture directly and pass its matrix to the shader
+        if (texture)
+        {
+            float matrix[16];
+            texture->getTextureMatrix(Texture::Pixels, matrix);
+
+            priv::GLStateCache::bindTexture(texture->m_texture);
+            m_pipeline->setTextureMatrix(matrix);
+        }
+        else
+        {
+            priv::GLStateCache::bindTexture(0);
+            m_pipeline->setTextureMatrix(NULL);
+        }
+    }
+    else
+    {
+        Texture::bind(texture, Texture::Pixels, false);
+    }
+
+    m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+    ++m_statistics.textureChanges;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyShader(const Shader* shader)
+{
+    // The shaders of the programmable pipeline get their texture matrix as a uniform
+    Shader::bind(shader, false, !m_pipeline);
+
+    if (m_pipeline)
+        m_pipeline->invalidateShader();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyTexCoordsRange(const Texture* texture, const Vector2f& range)
+{
+    // Without a texture, the texture coordinates are not used
+    if (!texture)
+        return;
+
+    float matrix[16];
+    texture->getTextureMatrix(Texture::Pixels, matrix);
+
+    // Integer coordinates are fractions of the range, scale them back to pixels
+    for (int i = 0; i < 4; ++i)
+    {
+        matrix[i]     *= range.x / 32767.f;
+        matrix[i + 4] *= range.y / 32767.f;
+    }
+
+    if (m_pipeline)
+        m_pipeline->setTextureMatrix(matrix);
+    else
+        priv::GLStateCache::loadTextureMatrix(matrix);
+
+    // Make the next draw restore the regular matrix of its texture
+    m_cache.lastTextureId = ~static_cast<Uint64>(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& drawStates, const VertexFormat& format)
+{
+    // First set the persistent OpenGL states if it's the very first call
+    if (!m_cache.glStatesSet)
+        resetGLStates();
+
+    // The overdraw analysis replaces the states with its counting ones
+    const RenderStates& states = m_overdraw ? m_overdraw->beginDraw(drawStates, m_pipeline != NULL, m_pipeline && m_pipeline->isCoreProfile())
+                                            : drawStates;
+
+    // Another render target sharing this context may have left
+    // its programmable pipeline states bound, restore ours
+    if (!m_cache.enable)
+    {
+        if (m_pipeline)
+        {
+            m_pipeline->reset();
+        }
+    #ifndef SFML_OPENGL_ES
+        else if (GLEXT_vertex_array_object)
+        {
+            glCheck(GLEXT_glBindVertexArray(0));
+            applyShader(NULL);
+        }
+    #endif
+    }
+
+    if (useVertexCache)
+    {
+        // Since vertices are transformed, we must use an identity transform to render them
+        if (!m_cache.enable || !m_cache.useVertexCache)
+            applyTransform(Transform::Identity);
+    }
+    else
+    {
+        applyTransform(states.transform);
+    }
+
+    // Apply the view
+    if (!m_cache.enable || m_cache.viewChanged)
+        applyCurrentView();
+
+    // Apply the blend mode
+    if (!m_cache.enable || (states.blendMode != m_cache.lastBlendMode))
+        applyBlendMode(states.blendMode);
+
+    // Apply the texture
+    if (!m_cache.enable || (states.texture && states.texture->m_fboAttachment))
+    {
+        // If the texture is an FBO attachment, always rebind it
+        // in order to inform the OpenGL driver that we want changes
+        // made to it in other contexts to be visible here as well
+        // This saves us from having to call glFlush() in
+        // RenderTextureImplFBO which can be quite costly
+        // See: https://www.khronos.org/opengl/wiki/Memory_Model
+        applyTexture(states.texture);
+    }
+    else
+    {
+        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+        if (textureId != m_cache.lastTextureId)
+            applyTexture(states.texture);
+    }
+
+    // Normalized texture coordinates are scaled by the texture matrix, before the shader uniforms are uploaded
+    if (format.getTexCoordsType() == VertexFormat::TexCoordsNormalized)
+        applyTexCoordsRange(states.texture, format.getTexCoordsRange());
+
+    // Apply the shader, the programmable pipeline falls back to its default one
+    if (m_pipeline)
+        m_pipeline->applyShader(states.shader);
+    else if (states.shader)
+        applyShader(states.shader);
+
+    // Count the actual program changes between draws, the unbinding at the end of a draw
+    // is not one; without a shader nor a pipeline, the fixed-function program 0 is used
+    unsigned int program = (states.shader || m_pipeline) ? priv::GLStateCache::getProgram() : 0;
+    if (program != m_cache.lastProgram)
+    {
+        ++m_statistics.shaderChanges;
+        m_cache.lastProgram = program;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
+{
+    // Find the OpenGL primitive type
+    static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                   GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+    GLenum mode = modes[type];
+
+    // Core profile contexts have no GL_QUADS, draw them as pairs of triangles
+    if ((type == Quads) && m_pipeline && m_pipeline->isCoreProfile())
+    {
+        std::size_t firstQuad = firstVertex / 4;
+        std::size_t quadCount = vertexCount / 4;
+        m_pipeline->bindQuadIndices(firstQuad + quadCount);
+
+        glCheck(glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(quadCount * 6), GL_UNSIGNED_INT,
+                               reinterpret_cast<const void*>(firstQuad * 6 * sizeof(Uint32))));
+
+        ++m_statistics.drawCalls;
+        m_statistics.vertices += static_cast<unsigned int>(vertexCount);
+        return;
+    }
+
+    // Draw the primitives
+    glCheck(glDrawArrays(mode, firstVertex, static_cast<GLsizei>(vertexCount)));
+
+    ++m_statistics.drawCalls;
+    m_statistics.vertices += static_cast<unsigned int>(vertexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawIndexedPrimitives(PrimitiveType type, const void* indices, std::size_t indexCount, std::size_t indexSize)
+{
+    // Find the OpenGL primitive type
+    static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                   GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+    GLenum mode = modes[type];
+
+    // Core profile contexts have no GL_QUADS, and indexed quads can't be converted on the fly
+    if ((type == Quads) && m_pipeline && m_pipeline->isCoreProfile())
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            err() << "Indexed sf::Quads are not supported in core profile contexts, drawing skipped" << std::endl;
+            warned = true;
+        }
+
+        return;
+    }
+
+    // Draw the primitives
+    GLenum indexType = (indexSize == sizeof(Uint32)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    glCheck(glDrawElements(mode, static_cast<GLsizei>(indexCount), indexType, indices));
+
+    ++m_statistics.drawCalls;
+    m_statistics.vertices += static_cast<unsigned int>(indexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states,
+                                const void* indices, std::size_t indexCount, std::size_t indexSize)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (type == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
+
+    if (m_queueing)
+    {
+        queueDraw(vertices, NULL, NULL, type, 0, vertexCount, indices, 0, indexCount, indexSize, states);
+        return;
+    }
+
+    if (m_rasterizer)
+    {
+        if (states.shader)
+        {
+            static bool warned = false;
+
+            if (!warned)
+            {
+                err() << "Shaders are not supported by software render targets, they are ignored" << std::endl;
+                warned = true;
+            }
+        }
+
+        m_rasterizer->draw(vertices, vertexCount, type, indices, indexCount, indexSize, states, m_view.getTransform(),
+                           getViewport(m_view), states.texture ? states.texture->m_cacheId : 0);
+
+        ++m_statistics.drawCalls;
+        m_statistics.vertices += static_cast<unsigned int>(indices ? indexCount : vertexCount);
+        return;
+    }
+
+    if (isActive(m_id) || setActive(true))
+    {
+        // Check if the vertex count is low enough so that we can pre-transform them
+        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
+
+        if (useVertexCache)
+        {
+            // Pre-transform the vertices and store them into the vertex cache
+            for (std::size_t i = 0; i < vertexCount; ++i)
+            {
+                Vertex& vertex = m_cache.vertexCache[i];
+                vertex.position = states.transform * vertices[i].position;
+                vertex.color = vertices[i].color;
+                vertex.texCoords = vertices[i].texCoords;
+            }
+        }
+
+        setupDraw(useVertexCache, states);
+
+        if (useVertexCache)
+            ++m_statistics.vertexCacheHits;
+
+        if (m_pipeline)
+        {
+            // Client-side arrays don't exist in core profile contexts, upload the data to our streaming buffers
+            m_pipeline->streamVertices(useVertexCache ? m_cache.vertexCache : vertices, vertexCount);
+
+            if (indices)
+            {
+                std::size_t offset = m_pipeline->streamIndices(indices, indexCount * indexSize);
+                drawIndexedPrimitives(type, reinterpret_cast<const void*>(offset), indexCount, indexSize);
+            }
+            else
+            {
+                drawPrimitives(type, 0, vertexCount);
+            }
+
+            cleanupDraw(states);
+
+            // Update the cache
+            m_cache.useVertexCache = useVertexCache;
+            return;
+        }
+
+        // Check if texture coordinates array is needed, and update client state accordingly
+        bool enableTexCoordsArray = (states.texture || states.shader);
+        if (!m_cache.enable || (enableTexCoordsArray != m_cache.texCoordsArrayEnabled))
+        {
+            if (enableTexCoordsArray)
+                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+            else
+                glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
+
+        // If we switch between non-cache and cache mode or enable texture
+        // coordinates we need to set up the pointers to the vertices' components
+        if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache)
+        {
+            const char* data = reinterpret_cast<const char*>(vertices);
+
+            // If we pre-transform the vertices, we must use our internal vertex cache
+            if (useVertexCache)
+                data = reinterpret_cast<const char*>(m_cache.vertexCache);
+
+            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+            if (enableTexCoordsArray)
+                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+        }
+        else if (enableTexCoordsArray && !m_cache.texCoordsArrayEnabled)
+        {
+            // If we enter this block, we are already using our internal vertex cache
+            const char* data = reinterpret_cast<const char*>(m_cache.vertexCache);
+
+            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+        }
+
+        if (indices)
+            drawIndexedPrimitives(type, indices, indexCount, indexSize);
+        else
+            drawPrimitives(type, 0, vertexCount);
+
+        cleanupDraw(states);
+
+        // Update the cache
+        m_cache.useVertexCache = useVertexCache;
+        m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::resetGLStates()
+#ifndef SFML_OPENGL_ES
+
+void RenderTarget::drawInstancedPrimitives(PrimitiveType type, std::size_t vertexCount, std::size_t instanceCount)
 {
-    // Check here to make sure a context change does not happen after activate(true)
-    bool shaderAvailable = Shader::isAvailable();
-    bool vertexBufferAvailable = VertexBuffer::isAvailable();
+    // Find the OpenGL primitive type
+    static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                   GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+    GLenum mode = modes[type];
 
-    // Workaround for states not being properly reset on
-    // macOS unless a context switch really takes place
-    #if defined(SFML_SYSTEM_MACOS)
-        setActive(false);
+    // Draw the primitives
+    glCheck(GLEXT_glDrawArraysInstanced(mode, 0, static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount)));
+
+    ++m_statistics.drawCalls;
+    m_statistics.vertices += static_cast<unsigned int>(vertexCount * instanceCount);
+}
+
+#else
+
+void RenderTarget::drawInstancedPrimitives(PrimitiveType /* type */, std::size_t /* vertexCount */, std::size_t /* instanceCount */)
+{
+    // Hardware instancing is never used on OpenGL ES
+}
+
+#endif
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstances(const VertexBuffer* mesh, const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                                 const InstanceData* instances, std::size_t instanceCount, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!instances || (instanceCount == 0))
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (type == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
     #endif
 
-    if (isActive(m_id) || setActive(true))
+    if (m_queueing)
     {
-        // Make sure that extensions are initialized
-        priv::ensureExtensionsInit();
+        queueInstances(mesh, vertices, vertexCount, type, instances, instanceCount, states);
+        return;
+    }
 
-        // Make sure that the texture unit which is active is the number 0
-        if (GLEXT_multitexture)
+    if (!isActive(m_id) && !setActive(true))
+        return;
+
+    // Make sure that the backend is selected
+    if (!m_cache.glStatesSet)
+        resetGLStates();
+
+    const VertexFormat& format = mesh ? mesh->getFormat() : VertexFormat::Default;
+
+    // Hardware instancing, unless the user provides a shader that
+    // doesn't know about our per-instance attributes, or the
+    // programmable backend or the overdraw analysis is in use;
+    // the instance texture rectangles expect texture coordinates in pixels
+    if (!states.shader && !m_pipeline && !m_overdraw && !m_rasterizer && priv::InstancedRenderer::isAvailable() &&
+        (format.getTexCoordsType() == VertexFormat::TexCoordsFloat))
+    {
+        if (!m_instancedRenderer)
+            m_instancedRenderer = new priv::InstancedRenderer;
+
+        setupDraw(false, states);
+
+        bool drawn = m_instancedRenderer->bind(instances, instanceCount, states.texture != NULL);
+
+        if (drawn)
         {
-            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
-            glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
-        }
+            // Always enable texture coordinates
+            if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
+                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
 
-        // Define the default OpenGL states
-        glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
-        glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDisable(GL_ALPHA_TEST));
-        glCheck(glEnable(GL_TEXTURE_2D));
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glLoadIdentity());
-        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
-        glCheck(glEnableClientState(GL_COLOR_ARRAY));
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
-        m_cache.glStatesSet = true;
+            if (mesh)
+            {
+                priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, mesh->getNativeHandle());
 
-        // Apply the default SFML states
-        applyBlendMode(BlendAlpha);
-        applyTexture(NULL);
-        if (shaderAvailable)
-            applyShader(NULL);
+                setFormatPointers(NULL, format);
+            }
+            else
+            {
+                const char* data = reinterpret_cast<const char*>(vertices);
 
-        if (vertexBufferAvailable)
-            glCheck(VertexBuffer::bind(NULL));
+                glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+                glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            }
 
-        m_cache.texCoordsArrayEnabled = true;
+            drawInstancedPrimitives(type, vertexCount, instanceCount);
 
+            if (mesh)
+                priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, 0);
+
+            m_instancedRenderer->unbind();
+
+            m_cache.texCoordsArrayEnabled = true;
+        }
+
+        cleanupDraw(states);
+
+        // The states transform is loaded, the vertex cache pointers are no longer valid
         m_cache.useVertexCache = false;
 
-        // Set the default view
-        setView(getView());
+        if (drawn)
+            return;
+    }
 
-        m_cache.enable = true;
+    // Software instancing: we need the mesh in client memory
+    if (mesh)
+    {
+    #ifndef SFML_OPENGL_ES
+
+        m_bufferVertices.resize(vertexCount);
+
+        if (!mesh->readVertices(0, vertexCount, &m_bufferVertices[0]))
+            return;
+
+        vertices = &m_bufferVertices[0];
+
+    #else
+
+        // Vertex buffers can't be read back on OpenGL ES, draw the instances one by one
+        static bool warned = false;
+
+        if (!warned)
+        {
+            err() << "Vertex buffer instancing is not supported on OpenGL ES, instance colors and texture rectangles are ignored" << std::endl;
+            warned = true;
+        }
+
+        for (std::size_t i = 0; i < instanceCount; ++i)
+        {
+            RenderStates instanceStates(states);
+            instanceStates.transform *= instances[i].transform;
+            draw(*mesh, instanceStates);
+        }
+
+        return;
+
+    #endif
     }
-}
 
+    // Expand all the instances into a single vertex array
+    m_instanceVertices.clear();
+    m_instanceVertices.reserve(instanceCount * getExpandedVertexCount(type, vertexCount));
 
-////////////////////////////////////////////////////////////
-void RenderTarget::initialize()
-{
-    // Setup the default and current views
-    m_defaultView.reset(FloatRect(0, 0, static_cast<float>(getSize().x), static_cast<float>(getSize().y)));
-    m_view = m_defaultView;
+    for (std::size_t i = 0; i < instanceCount; ++i)
+        expandInstance(m_instanceVertices, vertices, vertexCount, type, instances[i]);
 
-    // Set GL states only on first draw, so that we don't pollute user's states
-    m_cache.glStatesSet = false;
+    if (!m_instanceVertices.empty())
+        drawVertices(&m_instanceVertices[0], m_instanceVertices.size(), getExpandedType(type), states, NULL, 0, 0);
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyCurrentView()
+void RenderTarget::cleanupDraw(const RenderStates& states)
 {
-    // Set the viewport
-    IntRect viewport = getViewport(m_view);
-    int top = getSize().y - (viewport.top + viewport.height);
-    glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
+    // Stop counting the pixels of the draw, if analyzed
+    if (m_overdraw)
+        m_overdraw->endDraw();
 
-    // Set the projection matrix
-    glCheck(glMatrixMode(GL_PROJECTION));
-    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+    // Unbind the shader, if any
+    if (states.shader || m_overdraw)
+        applyShader(NULL);
 
-    // Go back to model-view mode
-    glCheck(glMatrixMode(GL_MODELVIEW));
+    // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
+    // This prevents a bug where some drivers do not clear RenderTextures properly.
+    if (states.texture && states.texture->m_fboAttachment)
+        applyTexture(NULL);
 
-    m_cache.viewChanged = false;
+    // Re-enable the cache at the end of the draw if it was disabled
+    m_cache.enable = true;
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyBlendMode(const BlendMode& mode)
+void RenderTarget::queueDraw(const Vertex* vertices, const VertexBuffer* vertexBuffer, const IndexBuffer* indexBuffer, PrimitiveType type,
+                             std::size_t firstVertex, std::size_t vertexCount, const void* indices, std::size_t firstIndex,
+                             std::size_t indexCount, std::size_t indexSize, const RenderStates& states)
 {
-    // Apply the blend mode, falling back to the non-separate versions if necessary
-    if (GLEXT_blend_func_separate)
-    {
-        glCheck(GLEXT_glBlendFuncSeparate(
-            factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor),
-            factorToGlConstant(mode.alphaSrcFactor), factorToGlConstant(mode.alphaDstFactor)));
-    }
-    else
+    QueuedDraw draw;
+    draw.barrier      = m_queueBarrier;
+    draw.layer        = m_queueLayer;
+    draw.textureId    = states.texture ? states.texture->m_cacheId : 0;
+    draw.sequence     = m_queue.size();
+    draw.states       = states;
+    draw.type         = type;
+    draw.vertexBuffer = vertexBuffer;
+    draw.indexBuffer  = indexBuffer;
+    draw.firstVertex  = firstVertex;
+    draw.vertexCount  = vertexCount;
+    draw.firstIndex   = firstIndex;
+    draw.indexCount   = indexCount;
+    draw.indexSize    = indexSize;
+    draw.firstInstance = 0;
+    draw.instanceCount = 0;
+
+    // Vertex arrays may be modified or destroyed right after the call, keep a copy
+    if (vertices)
     {
-        glCheck(glBlendFunc(
-            factorToGlConstant(mode.colorSrcFactor),
-            factorToGlConstant(mode.colorDstFactor)));
-    }
+        draw.firstVertex = m_queueVertices.size();
+        m_queueVertices.insert(m_queueVertices.end(), vertices, vertices + vertexCount);
 
-    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
-    {
-        if (GLEXT_blend_equation_separate)
-        {
-            glCheck(GLEXT_glBlendEquationSeparate(
-                equationToGlConstant(mode.colorEquation),
-                equationToGlConstant(mode.alphaEquation)));
-        }
-        else
+        if (indices && (indexSize == sizeof(Uint32)))
         {
-            glCheck(GLEXT_glBlendEquation(equationToGlConstant(mode.colorEquation)));
+            const Uint32* begin = static_cast<const Uint32*>(indices);
+            draw.firstIndex = m_queueIndices32.size();
+            m_queueIndices32.insert(m_queueIndices32.end(), begin, begin + indexCount);
         }
-    }
-    else if ((mode.colorEquation != BlendMode::Add) || (mode.alphaEquation != BlendMode::Add))
-    {
-        static bool warned = false;
-
-        if (!warned)
+        else if (indices)
         {
-            err() << "OpenGL extension EXT_blend_minmax and/or EXT_blend_subtract unavailable" << std::endl;
-            err() << "Selecting a blend equation not possible" << std::endl;
-            err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
-
-            warned = true;
+            const Uint16* begin = static_cast<const Uint16*>(indices);
+            draw.firstIndex = m_queueIndices16.size();
+            m_queueIndices16.insert(m_queueIndices16.end(), begin, begin + indexCount);
         }
     }
 
-    m_cache.lastBlendMode = mode;
+    m_queue.push_back(draw);
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyTransform(const Transform& transform)
+bool RenderTarget::submitQueue()
 {
-    // No need to call glMatrixMode(GL_MODELVIEW), it is always the
-    // current mode (for optimization purpose, since it's the most used)
-    if (transform == Transform::Identity)
-        glCheck(glLoadIdentity());
-    else
-        glCheck(glLoadMatrixf(transform.getMatrix()));
-}
+    if (m_queue.empty())
+        return true;
 
+    // Sort the draws; the submission index makes equal states keep their painter's order
+    std::size_t changesBefore = countStateChanges(m_queue);
+    std::sort(m_queue.begin(), m_queue.end());
+    std::size_t changesAfter = countStateChanges(m_queue);
 
-////////////////////////////////////////////////////////////
-void RenderTarget::applyTexture(const Texture* texture)
-{
-    Texture::bind(texture, Texture::Pixels);
+    if (changesAfter < changesBefore)
+        m_queueAvoided += changesBefore - changesAfter;
 
-    m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+    // Submit the draws for real
+    m_queueing = false;
+
+    for (std::vector<QueuedDraw>::const_iterator it = m_queue.begin(); it != m_queue.end(); ++it)
+        drawQueued(*this, *it, Transform::Identity);
+
+    m_queueing = true;
+
+    clearQueue();
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyShader(const Shader* shader)
+void RenderTarget::queueInstances(const VertexBuffer* mesh, const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                                  const InstanceData* instances, std::size_t instanceCount, const RenderStates& states)
 {
-    Shader::bind(shader);
+    queueDraw(vertices, mesh, NULL, type, 0, vertexCount, NULL, 0, 0, 0, states);
+
+    QueuedDraw& draw = m_queue.back();
+    draw.firstInstance = m_queueInstances.size();
+    draw.instanceCount = instanceCount;
+    m_queueInstances.insert(m_queueInstances.end(), instances, instances + instanceCount);
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
+void RenderTarget::drawQueued(const RenderTarget& source, const QueuedDraw& draw, const Transform& transform)
 {
-    // First set the persistent OpenGL states if it's the very first call
-    if (!m_cache.glStatesSet)
-        resetGLStates();
+    RenderStates states(draw.states);
+    states.transform = transform * states.transform;
 
-    if (useVertexCache)
+    if (draw.instanceCount > 0)
     {
-        // Since vertices are transformed, we must use an identity transform to render them
-        if (!m_cache.enable || !m_cache.useVertexCache)
-            glCheck(glLoadIdentity());
+        const InstanceData* instances = &source.m_queueInstances[draw.firstInstance];
+
+        if (draw.vertexBuffer)
+            drawInstanced(*draw.vertexBuffer, instances, draw.instanceCount, states);
+        else
+            drawInstanced(&source.m_queueVertices[draw.firstVertex], draw.vertexCount, draw.type, instances, draw.instanceCount, states);
     }
-    else
+    else if (draw.vertexBuffer && draw.indexBuffer)
     {
-        applyTransform(states.transform);
+        this->draw(*draw.vertexBuffer, *draw.indexBuffer, draw.firstIndex, draw.indexCount, states);
     }
-
-    // Apply the view
-    if (!m_cache.enable || m_cache.viewChanged)
-        applyCurrentView();
-
-    // Apply the blend mode
-    if (!m_cache.enable || (states.blendMode != m_cache.lastBlendMode))
-        applyBlendMode(states.blendMode);
-
-    // Apply the texture
-    if (!m_cache.enable || (states.texture && states.texture->m_fboAttachment))
+    else if (draw.vertexBuffer)
     {
-        // If the texture is an FBO attachment, always rebind it
-        // in order to inform the OpenGL driver that we want changes
-        // made to it in other contexts to be visible here as well
-        // This saves us from having to call glFlush() in
-        // RenderTextureImplFBO which can be quite costly
-        // See: https://www.khronos.org/opengl/wiki/Memory_Model
-        applyTexture(states.texture);
+        this->draw(*draw.vertexBuffer, draw.firstVertex, draw.vertexCount, states);
     }
     else
     {
-        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
-        if (textureId != m_cache.lastTextureId)
-            applyTexture(states.texture);
-    }
+        const void* indices = NULL;
+        if (draw.indexCount > 0)
+        {
+            if (draw.indexSize == sizeof(Uint32))
+                indices = &source.m_queueIndices32[draw.firstIndex];
+            else
+                indices = &source.m_queueIndices16[draw.firstIndex];
+        }
 
-    // Apply the shader
-    if (states.shader)
-        applyShader(states.shader);
+        drawVertices(&source.m_queueVertices[draw.firstVertex], draw.vertexCount, draw.type, states,
+                     indices, draw.indexCount, draw.indexSize);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
+void RenderTarget::clearQueue()
 {
-    // Find the OpenGL primitive type
-    static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
-                                   GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
-    GLenum mode = modes[type];
-
-    // Draw the primitives
-    glCheck(glDrawArrays(mode, firstVertex, static_cast<GLsizei>(vertexCount)));
+    m_queue.clear();
+    m_queueVertices.clear();
+    m_queueIndices16.clear();
+    m_queueIndices32.clear();
+    m_queueInstances.clear();
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::cleanupDraw(const RenderStates& states)
+bool RenderTarget::QueuedDraw::operator <(const QueuedDraw& right) const
 {
-    // Unbind the shader, if any
-    if (states.shader)
-        applyShader(NULL);
+    if (barrier != right.barrier)
+        return barrier < right.barrier;
 
-    // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
-    // This prevents a bug where some drivers do not clear RenderTextures properly.
-    if (states.texture && states.texture->m_fboAttachment)
-        applyTexture(NULL);
+    if (layer != right.layer)
+        return layer < right.layer;
 
-    // Re-enable the cache at the end of the draw if it was disabled
-    m_cache.enable = true;
+    if (states.shader != right.states.shader)
+        return std::less<const Shader*>()(states.shader, right.states.shader);
+
+    if (textureId != right.textureId)
+        return textureId < right.textureId;
+
+    if (states.blendMode != right.states.blendMode)
+        return isBlendModeLess(states.blendMode, right.states.blendMode);
+
+    return sequence < right.sequence;
 }
 
 } // namespace sf
@@ -37,7 +37,8 @@ namespace sf
 RenderTexture::RenderTexture() :
 m_impl(NULL)
 {
-
+    // The target texture is accounted with the render texture attachments
+    m_texture.m_memoryCategory = GraphicsMemory::RenderTextures;
 }
 
 
@@ -167,6 +168,8 @@ void RenderTexture::display()
         m_texture.m_pixelsFlipped = true;
         m_texture.invalidateMipmap();
     }
+
+    endStatisticsFrame();
 }
 
 
@@ -183,4 +186,11 @@ const Texture& RenderTexture::getTexture() const
     return m_texture;
 }
 
+
+////////////////////////////////////////////////////////////
+Uint64 RenderTexture::getMemoryUsage() const
+{
+    return m_texture.getMemoryUsage() + (m_impl ? m_impl->getMemoryUsage() : 0);
+}
+
 } // namespace sf
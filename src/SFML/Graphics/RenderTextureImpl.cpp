@@ -38,6 +38,14 @@ RenderTextureImpl::~RenderTextureImpl()
     // Nothing to do
 }
 
+
+////////////////////////////////////////////////////////////
+Uint64 RenderTextureImpl::getMemoryUsage() const
+{
+    // No attachment by default
+    return 0;
+}
+
 } // namespace priv
 
 } // namespace sf
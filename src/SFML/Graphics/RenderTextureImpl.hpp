@@ -82,6 +82,16 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual void updateTexture(unsigned int textureId) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the graphics memory used by the attachments
+    ///
+    /// The target texture itself is not included.
+    ///
+    /// \return Estimated memory usage, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 getMemoryUsage() const;
 };
 
 } // namespace priv
@@ -28,6 +28,7 @@
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GraphicsMemoryTracker.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
@@ -104,7 +105,8 @@ m_height            (0),
 m_context           (NULL),
 m_textureId         (0),
 m_multisample       (false),
-m_stencil           (false)
+m_stencil           (false),
+m_memoryUsage       (0)
 {
     Lock lock(mutex);
 
@@ -142,6 +144,8 @@ RenderTextureImplFBO::~RenderTextureImplFBO()
         glCheck(GLEXT_glDeleteRenderbuffers(1, &depthStencilBuffer));
     }
 
+    priv::updateGraphicsMemory(GraphicsMemory::RenderTextures, m_memoryUsage, 0, 0, 0);
+
     // Move all frame buffer objects to stale set
     for (std::map<Uint64, unsigned int>::iterator iter = m_frameBuffers.begin(); iter != m_frameBuffers.end(); ++iter)
         staleFrameBuffers.insert(std::make_pair(iter->first, iter->second));
@@ -333,6 +337,13 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
         }
     }
 
+    // Account for the render buffers, depth and stencil are assumed to be packed in 32 bits
+    Uint64 samples = settings.antialiasingLevel ? settings.antialiasingLevel : 1;
+    Uint64 bufferSize = static_cast<Uint64>(width) * height * 4 * samples;
+    Uint64 memoryUsage = (m_colorBuffer ? bufferSize : 0) + (m_depthStencilBuffer ? bufferSize : 0);
+    priv::updateGraphicsMemory(GraphicsMemory::RenderTextures, m_memoryUsage, 0, memoryUsage, 0);
+    m_memoryUsage = memoryUsage;
+
     // Save our texture ID in order to be able to attach it to an FBO at any time
     m_textureId = textureId;
 
@@ -584,6 +595,13 @@ void RenderTextureImplFBO::updateTexture(unsigned int)
 
 }
 
+
+////////////////////////////////////////////////////////////
+Uint64 RenderTextureImplFBO::getMemoryUsage() const
+{
+    return m_memoryUsage;
+}
+
 } // namespace priv
 
 } // namespace sf
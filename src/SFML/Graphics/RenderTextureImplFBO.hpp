@@ -122,6 +122,14 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void updateTexture(unsigned textureId);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the graphics memory used by the attachments
+    ///
+    /// \return Estimated memory usage, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 getMemoryUsage() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -135,6 +143,7 @@ private:
     unsigned int                   m_textureId;               ///< The ID of the texture to attach to the FBO
     bool                           m_multisample;             ///< Whether we have to create a multisample frame buffer as well
     bool                           m_stencil;                 ///< Whether we have stencil attachment
+    Uint64                         m_memoryUsage;             ///< Memory allocated for the render buffers
 };
 
 } // namespace priv
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstddef>
+
+
+namespace
+{
+    // Check whether two sets of settings create identical render textures
+    bool isCompatible(const sf::ContextSettings& left, const sf::ContextSettings& right)
+    {
+        return (left.depthBits         == right.depthBits)         &&
+               (left.stencilBits       == right.stencilBits)       &&
+               (left.antialiasingLevel == right.antialiasingLevel) &&
+               (left.sRgbCapable       == right.sRgbCapable);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderTexturePool::RenderTexturePool() :
+m_idle    (),
+m_acquired(),
+m_maxIdle (8)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexturePool::~RenderTexturePool()
+{
+    clear();
+
+    for (std::vector<Entry>::iterator it = m_acquired.begin(); it != m_acquired.end(); ++it)
+        delete it->renderTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexture* RenderTexturePool::acquire(unsigned int width, unsigned int height, const ContextSettings& settings)
+{
+    // Look for the most recently released matching render texture
+    for (std::size_t i = m_idle.size(); i > 0; --i)
+    {
+        Entry& entry = m_idle[i - 1];
+        if ((entry.width == width) && (entry.height == height) && isCompatible(entry.settings, settings))
+        {
+            RenderTexture* renderTexture = entry.renderTexture;
+
+            // Reset the state that the previous user may have changed
+            renderTexture->setView(renderTexture->getDefaultView());
+            renderTexture->setSmooth(false);
+            renderTexture->setRepeated(false);
+
+            m_acquired.push_back(entry);
+            m_idle.erase(m_idle.begin() + static_cast<std::ptrdiff_t>(i - 1));
+
+            return renderTexture;
+        }
+    }
+
+    // None available, create a new one
+    RenderTexture* renderTexture = new RenderTexture;
+    if (!renderTexture->create(width, height, settings))
+    {
+        delete renderTexture;
+        return NULL;
+    }
+
+    Entry entry;
+    entry.renderTexture = renderTexture;
+    entry.width         = width;
+    entry.height        = height;
+    entry.settings      = settings;
+    m_acquired.push_back(entry);
+
+    return renderTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::release(RenderTexture* renderTexture)
+{
+    if (!renderTexture)
+        return;
+
+    for (std::vector<Entry>::iterator it = m_acquired.begin(); it != m_acquired.end(); ++it)
+    {
+        if (it->renderTexture == renderTexture)
+        {
+            m_idle.push_back(*it);
+            m_acquired.erase(it);
+            trim();
+            return;
+        }
+    }
+
+    err() << "Failed to release render texture: it was not acquired from this pool" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::clear()
+{
+    for (std::vector<Entry>::iterator it = m_idle.begin(); it != m_idle.end(); ++it)
+        delete it->renderTexture;
+
+    m_idle.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::setMaxIdleCount(std::size_t count)
+{
+    m_maxIdle = count;
+    trim();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getMaxIdleCount() const
+{
+    return m_maxIdle;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getIdleCount() const
+{
+    return m_idle.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getAcquiredCount() const
+{
+    return m_acquired.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::trim()
+{
+    if (m_idle.size() <= m_maxIdle)
+        return;
+
+    // Destroy the render textures that have been unused for the longest time
+    std::size_t excess = m_idle.size() - m_maxIdle;
+    for (std::size_t i = 0; i < excess; ++i)
+        delete m_idle[i].renderTexture;
+
+    m_idle.erase(m_idle.begin(), m_idle.begin() + static_cast<std::ptrdiff_t>(excess));
+}
+
+} // namespace sf
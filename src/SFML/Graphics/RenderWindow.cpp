@@ -120,4 +120,11 @@ void RenderWindow::onResize()
     setView(getView());
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderWindow::onDisplay()
+{
+    endStatisticsFrame();
+}
+
 } // namespace sf
@@ -0,0 +1,372 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SceneNode.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Grow a rectangle so that it contains another one, empty rectangles are ignored
+    void unite(sf::FloatRect& result, bool& hasResult, const sf::FloatRect& rect)
+    {
+        if ((rect.width <= 0.f) && (rect.height <= 0.f))
+            return;
+
+        if (!hasResult)
+        {
+            result = rect;
+            hasResult = true;
+            return;
+        }
+
+        float left   = std::min(result.left, rect.left);
+        float top    = std::min(result.top, rect.top);
+        float right  = std::max(result.left + result.width, rect.left + rect.width);
+        float bottom = std::max(result.top + result.height, rect.top + rect.height);
+
+        result = sf::FloatRect(left, top, right - left, bottom - top);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SceneNode::SceneNode() :
+m_parent                  (NULL),
+m_children                (),
+m_worldTransform          (),
+m_worldTransformNeedUpdate(true),
+m_globalBounds            (),
+m_globalBoundsNeedUpdate  (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode::~SceneNode()
+{
+    if (m_parent)
+        m_parent->detachChild(*this);
+
+    for (std::vector<SceneNode*>::iterator it = m_children.begin(); it != m_children.end(); ++it)
+    {
+        (*it)->m_parent = NULL;
+        (*it)->invalidateWorldTransform();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::attachChild(SceneNode& child)
+{
+    // Attaching a node below itself would create a cycle
+    for (const SceneNode* node = this; node; node = node->m_parent)
+    {
+        if (node == &child)
+        {
+            err() << "Cannot attach a scene node to itself or to one of its descendants" << std::endl;
+            return;
+        }
+    }
+
+    if (child.m_parent)
+        child.m_parent->detachChild(child);
+
+    m_children.push_back(&child);
+    child.m_parent = this;
+
+    child.invalidateWorldTransform();
+    invalidateBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::detachChild(SceneNode& child)
+{
+    std::vector<SceneNode*>::iterator it = std::find(m_children.begin(), m_children.end(), &child);
+    if (it == m_children.end())
+        return;
+
+    m_children.erase(it);
+    child.m_parent = NULL;
+
+    child.invalidateWorldTransform();
+    invalidateBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode* SceneNode::getParent()
+{
+    return m_parent;
+}
+
+
+////////////////////////////////////////////////////////////
+const SceneNode* SceneNode::getParent() const
+{
+    return m_parent;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SceneNode::getChildCount() const
+{
+    return m_children.size();
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode& SceneNode::getChild(std::size_t index)
+{
+    return *m_children[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const SceneNode& SceneNode::getChild(std::size_t index) const
+{
+    return *m_children[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setPosition(float x, float y)
+{
+    Transformable::setPosition(x, y);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setPosition(const Vector2f& position)
+{
+    Transformable::setPosition(position);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setRotation(float angle)
+{
+    Transformable::setRotation(angle);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setScale(float factorX, float factorY)
+{
+    Transformable::setScale(factorX, factorY);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setScale(const Vector2f& factors)
+{
+    Transformable::setScale(factors);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setOrigin(float x, float y)
+{
+    Transformable::setOrigin(x, y);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setOrigin(const Vector2f& origin)
+{
+    Transformable::setOrigin(origin);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::move(float offsetX, float offsetY)
+{
+    Transformable::move(offsetX, offsetY);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::move(const Vector2f& offset)
+{
+    Transformable::move(offset);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::rotate(float angle)
+{
+    Transformable::rotate(angle);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::scale(float factorX, float factorY)
+{
+    Transformable::scale(factorX, factorY);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::scale(const Vector2f& factor)
+{
+    Transformable::scale(factor);
+    invalidateTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+const Transform& SceneNode::getWorldTransform() const
+{
+    // The parent is recomputed first, if needed: an up-to-date
+    // node never has an outdated ancestor
+    if (m_worldTransformNeedUpdate)
+    {
+        if (m_parent)
+            m_worldTransform = m_parent->getWorldTransform() * getTransform();
+        else
+            m_worldTransform = getTransform();
+
+        m_worldTransformNeedUpdate = false;
+    }
+
+    return m_worldTransform;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect SceneNode::getLocalBounds() const
+{
+    return FloatRect();
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect SceneNode::getGlobalBounds() const
+{
+    if (m_globalBoundsNeedUpdate)
+    {
+        FloatRect bounds;
+        bool hasBounds = false;
+
+        unite(bounds, hasBounds, getWorldTransform().transformRect(getLocalBounds()));
+
+        for (std::vector<SceneNode*>::const_iterator it = m_children.begin(); it != m_children.end(); ++it)
+            unite(bounds, hasBounds, (*it)->getGlobalBounds());
+
+        m_globalBounds = bounds;
+        m_globalBoundsNeedUpdate = false;
+    }
+
+    return m_globalBounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::drawCurrent(RenderTarget& /* target */, const RenderStates& /* states */) const
+{
+    // Nothing by default
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::invalidateBounds()
+{
+    // The ancestors of a node with outdated bounds have outdated bounds too
+    for (SceneNode* node = this; node && !node->m_globalBoundsNeedUpdate; node = node->m_parent)
+        node->m_globalBoundsNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::draw(RenderTarget& target, RenderStates states) const
+{
+    // The transform of the states applies to the whole subtree,
+    // there's nothing to combine in the common case of the identity
+    Transform transform = states.transform;
+    bool identity = (transform == Transform::Identity);
+
+    drawSubtree(target, states, transform, identity);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::drawSubtree(RenderTarget& target, RenderStates& states, const Transform& transform, bool identity) const
+{
+    if (identity)
+        states.transform = getWorldTransform();
+    else
+        states.transform = transform * getWorldTransform();
+
+    drawCurrent(target, states);
+
+    for (std::vector<SceneNode*>::const_iterator it = m_children.begin(); it != m_children.end(); ++it)
+        (*it)->drawSubtree(target, states, transform, identity);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::invalidateTransform()
+{
+    // Bounds first: marking the subtree would stop the walk up at this node
+    invalidateBounds();
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::invalidateWorldTransform()
+{
+    // The subtree of a node with an outdated world transform is
+    // already outdated, so unchanged branches are never visited
+    if (m_worldTransformNeedUpdate)
+        return;
+
+    m_worldTransformNeedUpdate = true;
+    m_globalBoundsNeedUpdate = true;
+
+    for (std::vector<SceneNode*>::iterator it = m_children.begin(); it != m_children.end(); ++it)
+        (*it)->invalidateWorldTransform();
+}
+
+} // namespace sf
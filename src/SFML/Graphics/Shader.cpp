@@ -29,17 +29,59 @@
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/UniformBuffer.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/ProgrammablePipeline.hpp>
 #include <SFML/Window/Context.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <vector>
 
 
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Shader::CacheStatistics::CacheStatistics() :
+hits       (0),
+misses     (0),
+loadTime   (),
+compileTime()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle() :
+m_location(-1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle(int location) :
+m_location(location)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::UniformHandle::isValid() const
+{
+    return m_location != -1;
+}
+
+} // namespace sf
+
+
 #ifndef SFML_OPENGL_ES
 
 #if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
@@ -58,6 +100,23 @@ namespace
 {
     sf::Mutex maxTextureUnitsMutex;
     sf::Mutex isAvailableMutex;
+    sf::Mutex programCacheMutex;
+
+    std::string                 programCacheDirectory;
+    sf::Shader::CacheStatistics programCacheStatistics;
+
+    // Header of the program binary files
+    struct ProgramCacheHeader
+    {
+        char       magic[4]; // Identifies SFML program binary files
+        sf::Uint32 version;  // Version of the file layout
+        sf::Uint64 key;      // Key of the program, guards against file name collisions
+        sf::Uint32 format;   // Binary format of the OpenGL driver
+        sf::Uint32 size;     // Size of the binary that follows, in bytes
+    };
+
+    const char       programCacheMagic[4] = {'S', 'F', 'P', 'B'};
+    const sf::Uint32 programCacheVersion  = 1;
 
     GLint checkMaxTextureUnits()
     {
@@ -117,6 +176,326 @@ namespace
         return success;
     }
 
+    // Accumulate a string into a 64-bit FNV-1a hash; null strings and empty strings hash differently
+    void hashString(sf::Uint64& hash, const char* string)
+    {
+        const sf::Uint64 prime = (static_cast<sf::Uint64>(0x100) << 32) | 0x1b3;
+
+        hash = (hash ^ (string ? 1 : 0)) * prime;
+        if (string)
+        {
+            for (const char* c = string; *c; ++c)
+                hash = (hash ^ static_cast<unsigned char>(*c)) * prime;
+        }
+    }
+
+    // Compute the cache key of a program, from its sources and the OpenGL implementation running it
+    sf::Uint64 getProgramKey(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+    {
+        const GLubyte* vendor = glGetString(GL_VENDOR);
+        const GLubyte* renderer = glGetString(GL_RENDERER);
+        const GLubyte* version = glGetString(GL_VERSION);
+
+        sf::Uint64 hash = (static_cast<sf::Uint64>(0xcbf29ce4) << 32) | 0x84222325;
+        hashString(hash, vertexShaderCode);
+        hashString(hash, geometryShaderCode);
+        hashString(hash, fragmentShaderCode);
+        hashString(hash, reinterpret_cast<const char*>(vendor));
+        hashString(hash, reinterpret_cast<const char*>(renderer));
+        hashString(hash, reinterpret_cast<const char*>(version));
+
+        return hash;
+    }
+
+    // Get the path of the binary file of a program in the cache
+    std::string getProgramCachePath(const std::string& directory, sf::Uint64 key)
+    {
+        const char digits[] = "0123456789abcdef";
+
+        std::string name(16, '0');
+        for (std::size_t i = 0; i < 16; ++i)
+            name[15 - i] = digits[(key >> (i * 4)) & 0xf];
+
+        char last = *directory.rbegin();
+        if ((last == '/') || (last == '\\'))
+            return directory + name + ".bin";
+        else
+            return directory + "/" + name + ".bin";
+    }
+
+    // Read the binary of a program from the cache
+    bool readProgramBinary(const std::string& path, sf::Uint64 key, GLenum& format, std::vector<char>& binary)
+    {
+        std::ifstream file(path.c_str(), std::ios_base::binary);
+        if (!file)
+            return false;
+
+        ProgramCacheHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            return false;
+
+        if ((std::memcmp(header.magic, programCacheMagic, sizeof(header.magic)) != 0) ||
+            (header.version != programCacheVersion) || (header.key != key) || (header.size == 0))
+            return false;
+
+        binary.resize(header.size);
+        if (!file.read(&binary[0], static_cast<std::streamsize>(header.size)))
+            return false;
+
+        format = static_cast<GLenum>(header.format);
+        return true;
+    }
+
+    // Write the binary of a program to the cache
+    bool writeProgramBinary(const std::string& path, sf::Uint64 key, GLenum format, const std::vector<char>& binary)
+    {
+        std::ofstream file(path.c_str(), std::ios_base::binary | std::ios_base::trunc);
+        if (!file)
+            return false;
+
+        ProgramCacheHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, programCacheMagic, sizeof(header.magic));
+        header.version = programCacheVersion;
+        header.key     = key;
+        header.format  = static_cast<sf::Uint32>(format);
+        header.size    = static_cast<sf::Uint32>(binary.size());
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(&binary[0], static_cast<std::streamsize>(binary.size()));
+
+        return static_cast<bool>(file);
+    }
+
+    // Program being compiled and linked, possibly in the background
+    struct ProgramBuild
+    {
+        ProgramBuild() : program(0), cached(false), useCache(false), cacheKey(0) {}
+
+        GLEXT_GLhandle                                          program;  // Program object, 0 once adopted or deleted
+        std::vector<std::pair<GLEXT_GLhandle, const char*> >   shaders;  // Shader objects attached to the program, with their type name
+        bool                                                    cached;   // Was the program loaded from the binary cache?
+        bool                                                    useCache; // Should the program be saved to the binary cache?
+        sf::Uint64                                              cacheKey; // Key of the program in the binary cache
+        std::string                                             cachePath;// Path of the program in the binary cache
+        sf::Clock                                               clock;    // Measures the compilation time
+    };
+
+    // Check whether GLSL programs can be compiled and bound, a context must be active;
+    // unlike Shader::isAvailable(), multitexturing is not required: it is only needed
+    // to bind the textures of sampler uniforms, which the programmable pipeline doesn't use
+    bool areProgramsSupported()
+    {
+        sf::priv::ensureExtensionsInit();
+
+        return GLEXT_shading_language_100 &&
+               GLEXT_shader_objects       &&
+               GLEXT_vertex_shader        &&
+               GLEXT_fragment_shader;
+    }
+
+    // Make sure that the required kinds of shaders are supported, and report it otherwise
+    bool checkShaderSupport(bool geometry)
+    {
+        if (!areProgramsSupported())
+        {
+            sf::err() << "Failed to create a shader: your system doesn't support shaders "
+                  << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
+            return false;
+        }
+
+        if (geometry && !sf::Shader::isGeometryAvailable())
+        {
+            sf::err() << "Failed to create a shader: your system doesn't support geometry shaders "
+                  << "(you should test Shader::isGeometryAvailable() before trying to use geometry shaders)" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Try to load a program from the binary cache
+    bool loadCachedProgram(ProgramBuild& build, const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+    {
+        std::string cacheDirectory = sf::Shader::getCacheDirectory();
+        build.useCache = !cacheDirectory.empty() && sf::Shader::isCacheAvailable();
+        if (!build.useCache)
+            return false;
+
+        sf::Clock loadClock;
+
+        build.cacheKey = getProgramKey(vertexShaderCode, geometryShaderCode, fragmentShaderCode);
+        build.cachePath = getProgramCachePath(cacheDirectory, build.cacheKey);
+
+        GLenum format;
+        std::vector<char> binary;
+        if (readProgramBinary(build.cachePath, build.cacheKey, format, binary))
+        {
+            GLEXT_GLhandle cachedProgram;
+            glCheck(cachedProgram = GLEXT_glCreateProgramObject());
+            glCheck(GLEXT_glProgramBinary(castFromGlHandle(cachedProgram), format, &binary[0], static_cast<GLsizei>(binary.size())));
+
+            // The driver rejects binaries it can no longer use, compile them from source again
+            GLint success;
+            glCheck(GLEXT_glGetObjectParameteriv(cachedProgram, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+            if (success != GL_FALSE)
+            {
+                build.program = cachedProgram;
+                build.cached = true;
+
+                sf::Lock cacheLock(programCacheMutex);
+                ++programCacheStatistics.hits;
+                programCacheStatistics.loadTime += loadClock.getElapsedTime();
+
+                return true;
+            }
+
+            glCheck(GLEXT_glDeleteObject(cachedProgram));
+        }
+
+        sf::Lock cacheLock(programCacheMutex);
+        ++programCacheStatistics.misses;
+
+        return false;
+    }
+
+    // Create a shader, submit its compilation and attach it to the program
+    void submitShader(ProgramBuild& build, GLenum type, const char* typeName, const char* code)
+    {
+        GLEXT_GLhandle shader;
+        glCheck(shader = GLEXT_glCreateShaderObject(type));
+        glCheck(GLEXT_glShaderSource(shader, 1, &code, NULL));
+        glCheck(GLEXT_glCompileShader(shader));
+
+        // Attaching doesn't wait for the compilation, the result is checked after linking
+        glCheck(GLEXT_glAttachObject(build.program, shader));
+        build.shaders.push_back(std::make_pair(shader, typeName));
+    }
+
+    // Submit the compilation and link of a program; the driver may still be working on it when this function returns
+    void startProgramBuild(ProgramBuild& build, const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+    {
+        // Try to load the program from the binary cache first
+        if (loadCachedProgram(build, vertexShaderCode, geometryShaderCode, fragmentShaderCode))
+            return;
+
+        build.clock.restart();
+
+        // Create the program
+        glCheck(build.program = GLEXT_glCreateProgramObject());
+
+        // Create the shaders
+        if (vertexShaderCode)
+            submitShader(build, GLEXT_GL_VERTEX_SHADER, "vertex", vertexShaderCode);
+        if (geometryShaderCode)
+            submitShader(build, GLEXT_GL_GEOMETRY_SHADER, "geometry", geometryShaderCode);
+        if (fragmentShaderCode)
+            submitShader(build, GLEXT_GL_FRAGMENT_SHADER, "fragment", fragmentShaderCode);
+
+        // Bind the vertex attributes fed by the programmable rendering backend;
+        // attributes that the shader doesn't declare are simply ignored
+        glCheck(GLEXT_glBindAttribLocation(build.program, sf::priv::ProgrammablePipeline::PositionAttribute, "sf_position"));
+        glCheck(GLEXT_glBindAttribLocation(build.program, sf::priv::ProgrammablePipeline::ColorAttribute, "sf_color"));
+        glCheck(GLEXT_glBindAttribLocation(build.program, sf::priv::ProgrammablePipeline::TexCoordsAttribute, "sf_texCoords"));
+
+        // Ask the driver to keep the binary of the program, to store it in the cache
+        if (build.useCache)
+            glCheck(GLEXT_glProgramParameteri(castFromGlHandle(build.program), GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+
+        // Link the program
+        glCheck(GLEXT_glLinkProgram(build.program));
+    }
+
+    // Check whether the driver has finished building a program, without waiting for it
+    bool isProgramBuildComplete(const ProgramBuild& build)
+    {
+        // Without GL_KHR_parallel_shader_compile, querying the result is the only way to know
+        if (build.cached || !GLEXT_parallel_shader_compile)
+            return true;
+
+        GLint complete = GL_TRUE;
+        glCheck(GLEXT_glGetObjectParameteriv(build.program, GLEXT_GL_COMPLETION_STATUS, &complete));
+
+        return complete != GL_FALSE;
+    }
+
+    // Check the result of a program build, waiting for it if needed, and save it to the cache
+    bool finishProgramBuild(ProgramBuild& build)
+    {
+        bool success = true;
+
+        // Check the compile logs
+        for (std::size_t i = 0; i < build.shaders.size(); ++i)
+        {
+            GLEXT_GLhandle shader = build.shaders[i].first;
+
+            GLint compiled;
+            glCheck(GLEXT_glGetObjectParameteriv(shader, GLEXT_GL_OBJECT_COMPILE_STATUS, &compiled));
+            if (success && (compiled == GL_FALSE))
+            {
+                char log[1024];
+                glCheck(GLEXT_glGetInfoLog(shader, sizeof(log), 0, log));
+                sf::err() << "Failed to compile " << build.shaders[i].second << " shader:" << std::endl
+                      << log << std::endl;
+                success = false;
+            }
+
+            // The program keeps the shader alive while it's attached, we don't need it anymore
+            glCheck(GLEXT_glDeleteObject(shader));
+        }
+        build.shaders.clear();
+
+        // Check the link log
+        if (success && !build.cached)
+        {
+            GLint linked;
+            glCheck(GLEXT_glGetObjectParameteriv(build.program, GLEXT_GL_OBJECT_LINK_STATUS, &linked));
+            if (linked == GL_FALSE)
+            {
+                char log[1024];
+                glCheck(GLEXT_glGetInfoLog(build.program, sizeof(log), 0, log));
+                sf::err() << "Failed to link shader:" << std::endl
+                      << log << std::endl;
+                success = false;
+            }
+        }
+
+        if (!success)
+        {
+            glCheck(GLEXT_glDeleteObject(build.program));
+            build.program = 0;
+            return false;
+        }
+
+        if (build.cached)
+            return true;
+
+        {
+            sf::Lock cacheLock(programCacheMutex);
+            programCacheStatistics.compileTime += build.clock.getElapsedTime();
+        }
+
+        // Save the program in the cache for the next runs
+        if (build.useCache)
+        {
+            GLint length = 0;
+            glCheck(GLEXT_glGetObjectParameteriv(build.program, GLEXT_GL_PROGRAM_BINARY_LENGTH, &length));
+
+            if (length > 0)
+            {
+                std::vector<char> binary(static_cast<std::size_t>(length));
+                GLenum format = 0;
+                glCheck(GLEXT_glGetProgramBinary(castFromGlHandle(build.program), length, &length, &format, &binary[0]));
+                binary.resize(static_cast<std::size_t>(length));
+
+                if (binary.empty() || !writeProgramBinary(build.cachePath, build.cacheKey, format, binary))
+                    sf::err() << "Failed to save shader program to cache file \"" << build.cachePath << "\"" << std::endl;
+            }
+        }
+
+        return true;
+    }
+
     // Transforms an array of 2D vectors into a contiguous array of scalars
     template <typename T>
     std::vector<T> flatten(const sf::Vector2<T>* vectorArray, std::size_t length)
@@ -183,20 +562,16 @@ struct Shader::UniformBinder : private NonCopyable
     /// \brief Constructor: set up state before uniform is set
     ///
     ////////////////////////////////////////////////////////////
-    UniformBinder(Shader& shader, const std::string& name) :
+    UniformBinder(Shader& shader) :
     savedProgram(0),
-    currentProgram(castToGlHandle(shader.m_shaderProgram)),
-    location(-1)
+    currentProgram(shader.m_shaderProgram)
     {
         if (currentProgram)
         {
             // Enable program object
-            glCheck(savedProgram = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+            savedProgram = priv::GLStateCache::getProgram();
             if (currentProgram != savedProgram)
-                glCheck(GLEXT_glUseProgramObject(currentProgram));
-
-            // Store uniform location for further use outside constructor
-            location = shader.getUniformLocation(name);
+                priv::GLStateCache::useProgram(currentProgram);
         }
     }
 
@@ -208,13 +583,125 @@ struct Shader::UniformBinder : private NonCopyable
     {
         // Disable program object
         if (currentProgram && (currentProgram != savedProgram))
-            glCheck(GLEXT_glUseProgramObject(savedProgram));
+            priv::GLStateCache::useProgram(savedProgram);
     }
 
     TransientContextLock lock;           ///< Lock to keep context active while uniform is bound
-    GLEXT_GLhandle       savedProgram;   ///< Handle to the previously active program object
-    GLEXT_GLhandle       currentProgram; ///< Handle to the program object of the modified sf::Shader instance
-    GLint                location;       ///< Uniform location, used by the surrounding sf::Shader code
+    unsigned int         savedProgram;   ///< Handle to the previously active program object
+    unsigned int         currentProgram; ///< Handle to the program object of the modified sf::Shader instance
+};
+
+
+////////////////////////////////////////////////////////////
+struct Shader::AsyncLoad : private NonCopyable
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor: keep a copy of the sources
+    ///
+    ////////////////////////////////////////////////////////////
+    AsyncLoad(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode) :
+    vertexCode  (vertexShaderCode ? vertexShaderCode : ""),
+    geometryCode(geometryShaderCode ? geometryShaderCode : ""),
+    fragmentCode(fragmentShaderCode ? fragmentShaderCode : ""),
+    hasVertex   (vertexShaderCode != NULL),
+    hasGeometry (geometryShaderCode != NULL),
+    hasFragment (fragmentShaderCode != NULL),
+    build       (),
+    thread      (NULL),
+    mutex       (),
+    finished    (false),
+    success     (false)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor: wait for the build and destroy what wasn't adopted
+    ///
+    ////////////////////////////////////////////////////////////
+    ~AsyncLoad()
+    {
+        if (thread)
+        {
+            thread->wait();
+            delete thread;
+        }
+
+        TransientContextLock lock;
+
+        for (std::size_t i = 0; i < build.shaders.size(); ++i)
+            glCheck(GLEXT_glDeleteObject(build.shaders[i].first));
+
+        if (build.program)
+            glCheck(GLEXT_glDeleteObject(build.program));
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit the build to the driver
+    ///
+    ////////////////////////////////////////////////////////////
+    void start()
+    {
+        startProgramBuild(build, hasVertex ? vertexCode.c_str() : NULL,
+                                 hasGeometry ? geometryCode.c_str() : NULL,
+                                 hasFragment ? fragmentCode.c_str() : NULL);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build the program in the worker thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        {
+            // Shared with the other contexts, so that they can use the program
+            Context context;
+
+            start();
+            bool built = finishProgramBuild(build);
+
+            // Make sure that the program is complete before other contexts use it
+            glCheck(glFinish());
+
+            Lock lock(mutex);
+            success = built;
+        }
+
+        Lock lock(mutex);
+        finished = true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the build has finished, and finish it if possible
+    ///
+    ////////////////////////////////////////////////////////////
+    bool poll()
+    {
+        if (thread)
+        {
+            Lock lock(mutex);
+            return finished;
+        }
+
+        TransientContextLock lock;
+
+        if (!isProgramBuildComplete(build))
+            return false;
+
+        success = finishProgramBuild(build);
+        return true;
+    }
+
+    std::string  vertexCode;   ///< Source code of the vertex shader
+    std::string  geometryCode; ///< Source code of the geometry shader
+    std::string  fragmentCode; ///< Source code of the fragment shader
+    bool         hasVertex;    ///< Is there a vertex shader?
+    bool         hasGeometry;  ///< Is there a geometry shader?
+    bool         hasFragment;  ///< Is there a fragment shader?
+    ProgramBuild build;        ///< Program being built
+    Thread*      thread;       ///< Worker thread, when the driver can't compile in parallel itself
+    Mutex        mutex;        ///< Protects the state shared with the worker thread
+    bool         finished;     ///< Has the worker thread finished?
+    bool         success;      ///< Was the program built successfully?
 };
 
 
@@ -223,19 +710,33 @@ Shader::Shader() :
 m_shaderProgram (0),
 m_currentTexture(-1),
 m_textures      (),
-m_uniforms      ()
+m_uniforms      (),
+m_uniformBlocks (),
+m_deferUniforms (false),
+m_deferred      (),
+m_deferredDirty (false),
+m_status        (Unloaded),
+m_async         (NULL),
+m_fallback      (NULL)
 {
+    std::fill(m_pipelineLocations, m_pipelineLocations + 4, -2);
 }
 
 
 ////////////////////////////////////////////////////////////
 Shader::~Shader()
 {
+    // Wait for a load in progress
+    delete m_async;
+
     TransientContextLock lock;
 
     // Destroy effect program
     if (m_shaderProgram)
+    {
+        priv::GLStateCache::forgetProgram(m_shaderProgram);
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+    }
 }
 
 
@@ -422,216 +923,450 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& geomet
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::loadAsync(const std::string& shader, Type type)
+{
+    // Submit the compilation of the shader program
+    if (type == Vertex)
+        return compileAsync(shader.c_str(), NULL, NULL);
+    else if (type == Geometry)
+        return compileAsync(NULL, shader.c_str(), NULL);
+    else
+        return compileAsync(NULL, NULL, shader.c_str());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadAsync(const std::string& vertexShader, const std::string& fragmentShader)
+{
+    // Submit the compilation of the shader program
+    return compileAsync(vertexShader.c_str(), NULL, fragmentShader.c_str());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadAsync(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader)
+{
+    // Submit the compilation of the shader program
+    return compileAsync(vertexShader.c_str(), geometryShader.c_str(), fragmentShader.c_str());
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::Status Shader::getStatus() const
+{
+    updateAsyncLoad();
+
+    return m_status;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady() const
+{
+    return getStatus() == Ready;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setFallback(const Shader* fallback)
+{
+    m_fallback = fallback;
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader* Shader::getFallback() const
+{
+    return m_fallback;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, float x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1f(binder.location, x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2f(binder.location, v.x, v.y));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3f(binder.location, v.x, v.y, v.z));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4f(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, int x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1i(binder.location, x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2i(binder.location, v.x, v.y));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3i(binder.location, v.x, v.y, v.z));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4i(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, bool x)
 {
-    setUniform(name, static_cast<int>(x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec2& v)
 {
-    setUniform(name, Glsl::Ivec2(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec3& v)
 {
-    setUniform(name, Glsl::Ivec3(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec4& v)
 {
-    setUniform(name, Glsl::Ivec4(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Mat3& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniformHandle(name), matrix);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Mat4& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniformHandle(name), matrix);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Texture& texture)
 {
-    if (m_shaderProgram)
-    {
-        TransientContextLock lock;
-
-        // Find the location of the variable in the shader
-        int location = getUniformLocation(name);
-        if (location != -1)
-        {
-            // Store the location -> texture mapping
-            TextureTable::iterator it = m_textures.find(location);
-            if (it == m_textures.end())
-            {
-                // New entry, make sure there are enough texture units
-                GLint maxUnits = getMaxTextureUnits();
-                if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
-                {
-                    err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
-                    return;
-                }
-
-                m_textures[location] = &texture;
-            }
-            else
-            {
-                // Location already used, just replace the texture
-                it->second = &texture;
-            }
-        }
-    }
+    setUniform(getUniformHandle(name), texture);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, CurrentTextureType)
 {
-    if (m_shaderProgram)
-    {
-        TransientContextLock lock;
-
-        // Find the location of the variable in the shader
-        m_currentTexture = getUniformLocation(name);
-    }
+    setUniform(getUniformHandle(name), CurrentTexture);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const float* scalarArray, std::size_t length)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1fv(binder.location, static_cast<GLsizei>(length), scalarArray));
+    setUniformArray(getUniformHandle(name), scalarArray, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec2* vectorArray, std::size_t length)
 {
-    std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+    setUniformArray(getUniformHandle(name), vectorArray, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec3* vectorArray, std::size_t length)
 {
-    std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+    setUniformArray(getUniformHandle(name), vectorArray, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+    setUniformArray(getUniformHandle(name), vectorArray, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const std::string& name, const Glsl::Mat3* matrixArray, std::size_t length)
+{
+    setUniformArray(getUniformHandle(name), matrixArray, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length)
+{
+    setUniformArray(getUniformHandle(name), matrixArray, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformBlock(const std::string& name, const UniformBuffer& buffer)
+{
+    updateAsyncLoad();
+
+    if (!m_shaderProgram)
+        return;
+
+    if (!UniformBuffer::isAvailable())
+    {
+        static bool warned = false;
+        if (!warned)
+        {
+            err() << "Failed to set uniform block \"" << name << "\": your system doesn't support uniform buffers "
+                  << "(you should test UniformBuffer::isAvailable() before trying to use uniform blocks)" << std::endl;
+            warned = true;
+        }
+        return;
+    }
+
+    TransientContextLock lock;
+
+    GLuint index = GLEXT_GL_INVALID_INDEX;
+    glCheck(index = GLEXT_glGetUniformBlockIndex(m_shaderProgram, name.c_str()));
+    if (index == GLEXT_GL_INVALID_INDEX)
+    {
+        err() << "Uniform block \"" << name << "\" not found in shader" << std::endl;
+        return;
+    }
+
+    // Block indices are below the number of active blocks, so they can be used as binding points
+    UniformBlockTable::iterator it = m_uniformBlocks.find(index);
+    if (it == m_uniformBlocks.end())
+    {
+        glCheck(GLEXT_glUniformBlockBinding(m_shaderProgram, index, index));
+        m_uniformBlocks[index] = &buffer;
+    }
+    else
+    {
+        it->second = &buffer;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    updateAsyncLoad();
+
+    if (!m_shaderProgram)
+        return UniformHandle();
+
+    return UniformHandle(getUniformLocation(name));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, float x)
+{
+    setUniformValue(handle, Float1, &x, NULL, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec2& v)
+{
+    float values[2] = {v.x, v.y};
+    setUniformValue(handle, Float2, values, NULL, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec3& v)
+{
+    float values[3] = {v.x, v.y, v.z};
+    setUniformValue(handle, Float3, values, NULL, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec4& v)
+{
+    float values[4] = {v.x, v.y, v.z, v.w};
+    setUniformValue(handle, Float4, values, NULL, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, int x)
+{
+    setUniformValue(handle, Int1, NULL, &x, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec2& v)
+{
+    int values[2] = {v.x, v.y};
+    setUniformValue(handle, Int2, NULL, values, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec3& v)
+{
+    int values[3] = {v.x, v.y, v.z};
+    setUniformValue(handle, Int3, NULL, values, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec4& v)
+{
+    int values[4] = {v.x, v.y, v.z, v.w};
+    setUniformValue(handle, Int4, NULL, values, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, bool x)
+{
+    setUniform(handle, static_cast<int>(x));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec2& v)
+{
+    setUniform(handle, Glsl::Ivec2(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec3& v)
+{
+    setUniform(handle, Glsl::Ivec3(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec4& v)
+{
+    setUniform(handle, Glsl::Ivec4(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat3& matrix)
+{
+    setUniformValue(handle, Matrix3, matrix.array, NULL, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat4& matrix)
+{
+    setUniformValue(handle, Matrix4, matrix.array, NULL, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Texture& texture)
+{
+    if (m_shaderProgram && (handle.m_location != -1))
+    {
+        // Store the location -> texture mapping
+        TextureTable::iterator it = m_textures.find(handle.m_location);
+        if (it == m_textures.end())
+        {
+            TransientContextLock lock;
+
+            // New entry, make sure there are enough texture units
+            GLint maxUnits = getMaxTextureUnits();
+            if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
+            {
+                err() << "Impossible to use texture for shader: all available texture units are used" << std::endl;
+                return;
+            }
+
+            m_textures[handle.m_location] = &texture;
+        }
+        else
+        {
+            // Location already used, just replace the texture
+            it->second = &texture;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, CurrentTextureType)
+{
+    if (m_shaderProgram)
+        m_currentTexture = handle.m_location;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const float* scalarArray, std::size_t length)
+{
+    setUniformValue(handle, Float1, scalarArray, NULL, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec2* vectorArray, std::size_t length)
 {
     std::vector<float> contiguous = flatten(vectorArray, length);
+    setUniformValue(handle, Float2, &contiguous[0], NULL, length);
+}
+
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec3* vectorArray, std::size_t length)
+{
+    std::vector<float> contiguous = flatten(vectorArray, length);
+    setUniformValue(handle, Float3, &contiguous[0], NULL, length);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setUniformArray(const std::string& name, const Glsl::Mat3* matrixArray, std::size_t length)
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+    std::vector<float> contiguous = flatten(vectorArray, length);
+    setUniformValue(handle, Float4, &contiguous[0], NULL, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat3* matrixArray, std::size_t length)
 {
     const std::size_t matrixSize = 3 * 3;
 
@@ -639,14 +1374,12 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat3* matrixAr
     for (std::size_t i = 0; i < length; ++i)
         priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+    setUniformValue(handle, Matrix3, &contiguous[0], NULL, length);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length)
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat4* matrixArray, std::size_t length)
 {
     const std::size_t matrixSize = 4 * 4;
 
@@ -654,9 +1387,31 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
     for (std::size_t i = 0; i < length; ++i)
         priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+    setUniformValue(handle, Matrix4, &contiguous[0], NULL, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformUploadDeferred(bool deferred)
+{
+    // Pending values must not be lost when going back to immediate uploads
+    if (!deferred && m_deferredDirty && m_shaderProgram)
+    {
+        UniformBinder binder(*this);
+        uploadDeferredUniforms();
+    }
+
+    if (!deferred)
+        m_deferred.clear();
+
+    m_deferUniforms = deferred;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isUniformUploadDeferred() const
+{
+    return m_deferUniforms;
 }
 
 
@@ -733,30 +1488,50 @@ void Shader::setParameter(const std::string& name, CurrentTextureType)
 ////////////////////////////////////////////////////////////
 unsigned int Shader::getNativeHandle() const
 {
+    updateAsyncLoad();
+
     return m_shaderProgram;
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::bind(const Shader* shader)
+{
+    // User code may have changed the bindings behind the state cache
+    bind(shader, true, true);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bind(const Shader* shader, bool force, bool textureMatrices)
 {
     TransientContextLock lock;
 
     // Make sure that we can use shaders
-    if (!isAvailable())
+    if (!areProgramsSupported())
     {
         err() << "Failed to bind or unbind shader: your system doesn't support shaders "
               << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
         return;
     }
 
-    if (shader && shader->m_shaderProgram)
+    // Use the fallback of a shader which is not ready yet
+    if (shader)
+        shader = shader->getReadyShader();
+
+    if (shader)
     {
         // Enable the program
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
+        priv::GLStateCache::useProgram(shader->m_shaderProgram, force);
 
         // Bind the textures
-        shader->bindTextures();
+        shader->bindTextures(force, textureMatrices);
+
+        // Bind the uniform buffers, uploading the values that changed
+        shader->bindUniformBlocks(force);
+
+        // Upload the uniforms that changed while the shader was not bound
+        shader->uploadDeferredUniforms();
 
         // Bind the current texture
         if (shader->m_currentTexture != -1)
@@ -765,7 +1540,7 @@ void Shader::bind(const Shader* shader)
     else
     {
         // Bind no shader
-        glCheck(GLEXT_glUseProgramObject(0));
+        priv::GLStateCache::useProgram(0, force);
     }
 }
 
@@ -787,11 +1562,7 @@ bool Shader::isAvailable()
         // Make sure that extensions are initialized
         sf::priv::ensureExtensionsInit();
 
-        available = GLEXT_multitexture         &&
-                    GLEXT_shading_language_100 &&
-                    GLEXT_shader_objects       &&
-                    GLEXT_vertex_shader        &&
-                    GLEXT_fragment_shader;
+        available = GLEXT_multitexture && areProgramsSupported();
     }
 
     return available;
@@ -822,30 +1593,158 @@ bool Shader::isGeometryAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::isProgramAvailable()
+{
+    TransientContextLock contextLock;
+
+    return areProgramsSupported();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setCacheDirectory(const std::string& directory)
+{
+    Lock lock(programCacheMutex);
+
+    programCacheDirectory = directory;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string Shader::getCacheDirectory()
+{
+    Lock lock(programCacheMutex);
+
+    return programCacheDirectory;
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::CacheStatistics Shader::getCacheStatistics()
+{
+    Lock lock(programCacheMutex);
+
+    return programCacheStatistics;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isCacheAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        // Drivers may support the extension without providing any binary format
+        if (GLEXT_shader_objects && GLEXT_get_program_binary)
+        {
+            GLint formats = 0;
+            glCheck(glGetIntegerv(GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+
+            available = (formats > 0);
+        }
+    }
+
+    return available;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
 {
     TransientContextLock lock;
 
     // First make sure that we can use shaders
-    if (!isAvailable())
-    {
-        err() << "Failed to create a shader: your system doesn't support shaders "
-              << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
+    if (!checkShaderSupport(geometryShaderCode != NULL))
         return false;
-    }
 
-    // Make sure we can use geometry shaders
-    if (geometryShaderCode && !isGeometryAvailable())
+    // Destroy the shader if it was already created
+    unload();
+
+    // Build the program and wait for the result
+    ProgramBuild build;
+    startProgramBuild(build, vertexShaderCode, geometryShaderCode, fragmentShaderCode);
+    if (!finishProgramBuild(build))
     {
-        err() << "Failed to create a shader: your system doesn't support geometry shaders "
-              << "(you should test Shader::isGeometryAvailable() before trying to use geometry shaders)" << std::endl;
+        m_status = Failed;
         return false;
     }
 
+    m_shaderProgram = castFromGlHandle(build.program);
+    m_status = Ready;
+
+    // Force an OpenGL flush, so that the shader will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::compileAsync(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+{
+    TransientContextLock lock;
+
+    // First make sure that we can use shaders
+    if (!checkShaderSupport(geometryShaderCode != NULL))
+        return false;
+
     // Destroy the shader if it was already created
+    unload();
+
+    m_async = new AsyncLoad(vertexShaderCode, geometryShaderCode, fragmentShaderCode);
+    m_status = Compiling;
+
+    if (GLEXT_parallel_shader_compile)
+    {
+        // Let the driver compile in as many threads as it wants
+        static bool threadsSet = false;
+        if (!threadsSet)
+        {
+            glCheck(GLEXT_glMaxShaderCompilerThreads(0xFFFFFFFF));
+            threadsSet = true;
+        }
+
+        // The driver compiles in the background, we just have to submit the build
+        m_async->start();
+
+        // Start the compilation now, rather than at the next synchronization point
+        glCheck(glFlush());
+    }
+    else
+    {
+        // Compile in a thread of our own, with a context sharing its objects with ours
+        m_async->thread = new Thread(&AsyncLoad::run, m_async);
+        m_async->thread->launch();
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::unload()
+{
+    // Discard a load in progress
+    delete m_async;
+    m_async = NULL;
+
     if (m_shaderProgram)
     {
+        TransientContextLock lock;
+        priv::GLStateCache::forgetProgram(m_shaderProgram);
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
         m_shaderProgram = 0;
     }
@@ -854,158 +1753,200 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
     m_currentTexture = -1;
     m_textures.clear();
     m_uniforms.clear();
+    std::fill(m_pipelineLocations, m_pipelineLocations + 4, -2);
+    m_uniformBlocks.clear();
+    m_deferred.clear();
+    m_deferredDirty = false;
+    m_status = Unloaded;
+}
 
-    // Create the program
-    GLEXT_GLhandle shaderProgram;
-    glCheck(shaderProgram = GLEXT_glCreateProgramObject());
 
-    // Create the vertex shader if needed
-    if (vertexShaderCode)
+////////////////////////////////////////////////////////////
+void Shader::updateAsyncLoad() const
+{
+    if (!m_async || !m_async->poll())
+        return;
+
+    if (m_async->success)
     {
-        // Create and compile the shader
-        GLEXT_GLhandle vertexShader;
-        glCheck(vertexShader = GLEXT_glCreateShaderObject(GLEXT_GL_VERTEX_SHADER));
-        glCheck(GLEXT_glShaderSource(vertexShader, 1, &vertexShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(vertexShader));
+        // Adopt the program, so that the load doesn't destroy it
+        m_shaderProgram = castFromGlHandle(m_async->build.program);
+        m_async->build.program = 0;
+        m_status = Ready;
+    }
+    else
+    {
+        m_status = Failed;
+    }
 
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(vertexShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
-        {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(vertexShader, sizeof(log), 0, log));
-            err() << "Failed to compile vertex shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(vertexShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
-            return false;
-        }
+    delete m_async;
+    m_async = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader* Shader::getReadyShader() const
+{
+    // Limit the length of the chain, in case fallbacks form a cycle
+    const Shader* shader = this;
+    for (int i = 0; shader && (i < 16); ++i)
+    {
+        shader->updateAsyncLoad();
+        if (shader->m_shaderProgram)
+            return shader;
 
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, vertexShader));
-        glCheck(GLEXT_glDeleteObject(vertexShader));
+        shader = shader->m_fallback;
     }
 
-    // Create the geometry shader if needed
-    if (geometryShaderCode)
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindTextures(bool force, bool textureMatrices) const
+{
+    if (m_textures.empty())
+        return;
+
+    // Binding textures to other units than the first one requires multitexturing
+    if (!GLEXT_multitexture)
     {
-        // Create and compile the shader
-        GLEXT_GLhandle geometryShader = GLEXT_glCreateShaderObject(GLEXT_GL_GEOMETRY_SHADER);
-        glCheck(GLEXT_glShaderSource(geometryShader, 1, &geometryShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(geometryShader));
+        static bool warned = false;
 
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(geometryShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+        if (!warned)
         {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(geometryShader, sizeof(log), 0, log));
-            err() << "Failed to compile geometry shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(geometryShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
-            return false;
+            err() << "Failed to bind the textures of a shader: your system doesn't support multitexturing "
+                  << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
+
+            warned = true;
         }
 
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, geometryShader));
-        glCheck(GLEXT_glDeleteObject(geometryShader));
+        return;
     }
 
-    // Create the fragment shader if needed
-    if (fragmentShaderCode)
+    TextureTable::const_iterator it = m_textures.begin();
+    for (std::size_t i = 0; i < m_textures.size(); ++i)
     {
-        // Create and compile the shader
-        GLEXT_GLhandle fragmentShader;
-        glCheck(fragmentShader = GLEXT_glCreateShaderObject(GLEXT_GL_FRAGMENT_SHADER));
-        glCheck(GLEXT_glShaderSource(fragmentShader, 1, &fragmentShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(fragmentShader));
+        GLint index = static_cast<GLsizei>(i + 1);
+        glCheck(GLEXT_glUniform1i(it->first, index));
+        priv::GLStateCache::activeTexture(static_cast<unsigned int>(index), force);
 
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(fragmentShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
-        {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(fragmentShader, sizeof(log), 0, log));
-            err() << "Failed to compile fragment shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(fragmentShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
-            return false;
-        }
+        if (textureMatrices)
+            Texture::bind(it->second, Texture::Normalized, force);
+        else
+            priv::GLStateCache::bindTexture(it->second->m_texture, force);
 
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, fragmentShader));
-        glCheck(GLEXT_glDeleteObject(fragmentShader));
+        ++it;
     }
 
-    // Link the program
-    glCheck(GLEXT_glLinkProgram(shaderProgram));
+    // Make sure that the texture unit which is left active is the number 0
+    priv::GLStateCache::activeTexture(0, force);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindUniformBlocks(bool force) const
+{
+    for (UniformBlockTable::const_iterator it = m_uniformBlocks.begin(); it != m_uniformBlocks.end(); ++it)
+        UniformBuffer::bind(it->second, it->first, force);
+}
+
 
-    // Check the link log
-    GLint success;
-    glCheck(GLEXT_glGetObjectParameteriv(shaderProgram, GLEXT_GL_OBJECT_LINK_STATUS, &success));
-    if (success == GL_FALSE)
+////////////////////////////////////////////////////////////
+int Shader::getUniformLocation(const std::string& name)
+{
+    // Check the cache
+    UniformTable::const_iterator it = m_uniforms.find(name);
+    if (it != m_uniforms.end())
     {
-        char log[1024];
-        glCheck(GLEXT_glGetInfoLog(shaderProgram, sizeof(log), 0, log));
-        err() << "Failed to link shader:" << std::endl
-              << log << std::endl;
-        glCheck(GLEXT_glDeleteObject(shaderProgram));
-        return false;
+        // Already in cache, return it
+        return it->second;
     }
+    else
+    {
+        // Not in cache, request the location from OpenGL
+        TransientContextLock lock;
+        int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
+        m_uniforms.insert(std::make_pair(name, location));
 
-    m_shaderProgram = castFromGlHandle(shaderProgram);
-
-    // Force an OpenGL flush, so that the shader will appear updated
-    // in all contexts immediately (solves problems in multi-threaded apps)
-    glCheck(glFlush());
+        if (location == -1)
+            err() << "Uniform \"" << name << "\" not found in shader" << std::endl;
 
-    return true;
+        return location;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::bindTextures() const
+void Shader::setUniformValue(UniformHandle handle, UniformType type, const float* floats, const int* ints, std::size_t count)
 {
-    TextureTable::const_iterator it = m_textures.begin();
-    for (std::size_t i = 0; i < m_textures.size(); ++i)
+    if (!m_shaderProgram || (handle.m_location == -1))
+        return;
+
+    if (m_deferUniforms)
     {
-        GLint index = static_cast<GLsizei>(i + 1);
-        glCheck(GLEXT_glUniform1i(it->first, index));
-        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + index));
-        Texture::bind(it->second);
-        ++it;
+        // Number of components of each type of value
+        static const std::size_t components[] = {1, 2, 3, 4, 1, 2, 3, 4, 9, 16};
+        std::size_t size = components[type] * count;
+
+        // Keep the value until the shader is bound
+        DeferredUniform& uniform = m_deferred[handle.m_location];
+        uniform.type  = type;
+        uniform.count = count;
+        uniform.dirty = true;
+
+        if (floats)
+            uniform.floats.assign(floats, floats + size);
+        else
+            uniform.ints.assign(ints, ints + size);
+
+        m_deferredDirty = true;
+        return;
     }
 
-    // Make sure that the texture unit which is left active is the number 0
-    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+    UniformBinder binder(*this);
+    uploadUniform(handle.m_location, type, floats, ints, count);
 }
 
 
 ////////////////////////////////////////////////////////////
-int Shader::getUniformLocation(const std::string& name)
+void Shader::uploadDeferredUniforms() const
 {
-    // Check the cache
-    UniformTable::const_iterator it = m_uniforms.find(name);
-    if (it != m_uniforms.end())
+    if (!m_deferredDirty)
+        return;
+
+    for (DeferredTable::iterator it = m_deferred.begin(); it != m_deferred.end(); ++it)
     {
-        // Already in cache, return it
-        return it->second;
+        DeferredUniform& uniform = it->second;
+        if (uniform.dirty)
+        {
+            uploadUniform(it->first, uniform.type, uniform.floats.empty() ? NULL : &uniform.floats[0],
+                          uniform.ints.empty() ? NULL : &uniform.ints[0], uniform.count);
+            uniform.dirty = false;
+        }
     }
-    else
-    {
-        // Not in cache, request the location from OpenGL
-        int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
-        m_uniforms.insert(std::make_pair(name, location));
 
-        if (location == -1)
-            err() << "Uniform \"" << name << "\" not found in shader" << std::endl;
+    m_deferredDirty = false;
+}
 
-        return location;
+
+////////////////////////////////////////////////////////////
+void Shader::uploadUniform(int location, UniformType type, const float* floats, const int* ints, std::size_t count)
+{
+    GLsizei size = static_cast<GLsizei>(count);
+
+    switch (type)
+    {
+        case Float1:  glCheck(GLEXT_glUniform1fv(location, size, floats)); break;
+        case Float2:  glCheck(GLEXT_glUniform2fv(location, size, floats)); break;
+        case Float3:  glCheck(GLEXT_glUniform3fv(location, size, floats)); break;
+        case Float4:  glCheck(GLEXT_glUniform4fv(location, size, floats)); break;
+        case Int1:    glCheck(GLEXT_glUniform1i(location, ints[0])); break;
+        case Int2:    glCheck(GLEXT_glUniform2i(location, ints[0], ints[1])); break;
+        case Int3:    glCheck(GLEXT_glUniform3i(location, ints[0], ints[1], ints[2])); break;
+        case Int4:    glCheck(GLEXT_glUniform4i(location, ints[0], ints[1], ints[2], ints[3])); break;
+        case Matrix3: glCheck(GLEXT_glUniformMatrix3fv(location, size, GL_FALSE, floats)); break;
+        case Matrix4: glCheck(GLEXT_glUniformMatrix4fv(location, size, GL_FALSE, floats)); break;
     }
 }
 
@@ -1024,8 +1965,14 @@ Shader::CurrentTextureType Shader::CurrentTexture;
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
-m_currentTexture(-1)
+m_currentTexture(-1),
+m_deferUniforms (false),
+m_deferredDirty (false),
+m_status        (Unloaded),
+m_async         (NULL),
+m_fallback      (NULL)
 {
+    std::fill(m_pipelineLocations, m_pipelineLocations + 4, -2);
 }
 
 
@@ -1098,6 +2045,55 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& geomet
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::loadAsync(const std::string& shader, Type type)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadAsync(const std::string& vertexShader, const std::string& fragmentShader)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadAsync(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::Status Shader::getStatus() const
+{
+    return m_status;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady() const
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setFallback(const Shader* fallback)
+{
+    m_fallback = fallback;
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader* Shader::getFallback() const
+{
+    return m_fallback;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, float x)
 {
@@ -1230,6 +2226,164 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setUniformBlock(const std::string& name, const UniformBuffer& buffer)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    return UniformHandle();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, float x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, int x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, bool x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat3& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat4& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Texture& texture)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, CurrentTextureType)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const float* scalarArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec2* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec3* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat3* matrixArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat4* matrixArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformUploadDeferred(bool deferred)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isUniformUploadDeferred() const
+{
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
@@ -1303,6 +2457,12 @@ void Shader::bind(const Shader* shader)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::bind(const Shader* shader, bool force, bool textureMatrices)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::isAvailable()
 {
@@ -1317,6 +2477,40 @@ bool Shader::isGeometryAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::isProgramAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setCacheDirectory(const std::string& directory)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::string Shader::getCacheDirectory()
+{
+    return std::string();
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::CacheStatistics Shader::getCacheStatistics()
+{
+    return CacheStatistics();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isCacheAvailable()
+{
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
 {
@@ -1325,7 +2519,39 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
 
 
 ////////////////////////////////////////////////////////////
-void Shader::bindTextures() const
+bool Shader::compileAsync(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::unload()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::updateAsyncLoad() const
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader* Shader::getReadyShader() const
+{
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindTextures(bool force, bool textureMatrices) const
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindUniformBlocks(bool force) const
 {
 }
 
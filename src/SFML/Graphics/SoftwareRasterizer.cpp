@@ -0,0 +1,740 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SoftwareRasterizer.hpp>
+#include <SFML/Graphics/BlendEquation.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Size of the square tiles handed to the rasterizing threads, in pixels
+    const int tileSize = 64;
+
+    // Pending primitives are flushed beyond this count, to bound the memory they use
+    const std::size_t maxPendingPrimitives = 1 << 16;
+
+    // Map a texel coordinate into the texture, either repeating or clamping it
+    int wrap(int coordinate, int size, bool repeated)
+    {
+        if (repeated)
+        {
+            coordinate %= size;
+            return (coordinate < 0) ? coordinate + size : coordinate;
+        }
+
+        return std::min(std::max(coordinate, 0), size - 1);
+    }
+
+    // Round down to an integer, without the cost of std::floor
+    int floorToInt(float value)
+    {
+        int integer = static_cast<int>(value);
+        return (value < static_cast<float>(integer)) ? integer - 1 : integer;
+    }
+
+    const float inverse255 = 1.f / 255.f;
+
+    // Tell whether pixel centers lying exactly on an edge belong to the triangle (top-left rule)
+    bool isTopLeft(float dx, float dy)
+    {
+        return (dy < 0.f) || ((dy == 0.f) && (dx > 0.f));
+    }
+
+    // Restrict a span [first, last) of a row to where an edge function, worth weight
+    // at the origin pixel and growing by step per pixel, may be positive
+    bool clipSpan(float weight, float step, int origin, int& first, int& last)
+    {
+        if (step != 0.f)
+        {
+            // Pixel offset where the edge function crosses zero, kept in the int range
+            float crossing = std::min(std::max(-weight / step, -1e7f), 1e7f);
+
+            if (step > 0.f)
+                first = std::max(first, origin + static_cast<int>(crossing) - 1);
+            else
+                last = std::min(last, origin + static_cast<int>(crossing) + 2);
+        }
+        else if (weight < 0.f)
+        {
+            return false;
+        }
+
+        return first < last;
+    }
+
+
+    // Signed area of the parallelogram (a, b, p), positive inside the triangles we rasterize
+    float edge(float ax, float ay, float bx, float by, float px, float py)
+    {
+        return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SoftwareRasterizer::SoftwareRasterizer() :
+m_width      (0),
+m_height     (0),
+m_pixels     (),
+m_threadCount(4),
+m_transformed(),
+m_primitives (),
+m_states     (),
+m_textures   (),
+m_tiles      (),
+m_bins       (),
+m_nextTile   (0),
+m_tileMutex  (),
+m_workers    ()
+{
+    // The calling thread takes part in the flushes
+    m_workers.setThreadCount(m_threadCount - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::create(unsigned int width, unsigned int height)
+{
+    m_primitives.clear();
+    m_states.clear();
+
+    m_width = width;
+    m_height = height;
+    m_pixels.assign(static_cast<std::size_t>(width) * height * 4, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u SoftwareRasterizer::getSize() const
+{
+    return Vector2u(m_width, m_height);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::setThreadCount(unsigned int count)
+{
+    m_threadCount = std::max(count, 1u);
+
+    m_workers.setThreadCount(m_threadCount - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoftwareRasterizer::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::clear(const Color& color)
+{
+    // Nothing drawn before the clear can be visible after it
+    m_primitives.clear();
+    m_states.clear();
+
+    for (std::size_t i = 0; i < m_pixels.size(); i += 4)
+    {
+        m_pixels[i + 0] = color.r;
+        m_pixels[i + 1] = color.g;
+        m_pixels[i + 2] = color.b;
+        m_pixels[i + 3] = color.a;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::draw(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const void* indices,
+                              std::size_t indexCount, std::size_t indexSize, const RenderStates& states,
+                              const Transform& view, const IntRect& viewport, Uint64 textureId)
+{
+    // Clip to the viewport and to the target
+    IntRect clip;
+    if (!viewport.intersects(IntRect(0, 0, static_cast<int>(m_width), static_cast<int>(m_height)), clip))
+        return;
+
+    if (m_primitives.size() >= maxPendingPrimitives)
+        flush();
+
+    const Image* texture = states.texture ? getTextureCopy(*states.texture, textureId) : NULL;
+
+    DrawState state;
+    state.texels        = texture ? texture->getPixelsPtr() : NULL;
+    state.textureWidth  = texture ? static_cast<int>(texture->getSize().x) : 0;
+    state.textureHeight = texture ? static_cast<int>(texture->getSize().y) : 0;
+    state.smooth        = states.texture && states.texture->isSmooth();
+    state.repeated      = states.texture && states.texture->isRepeated();
+    state.blendMode     = states.blendMode;
+
+    if (states.blendMode == BlendAlpha)
+        state.blendPath = AlphaBlend;
+    else if (states.blendMode == BlendNone)
+        state.blendPath = NoBlend;
+    else
+        state.blendPath = GenericBlend;
+
+    m_states.push_back(state);
+
+    // Transform the vertices to pixels: view to normalized coordinates, then viewport to pixels
+    Transform toPixels(viewport.width / 2.f, 0.f,                 viewport.left + viewport.width / 2.f,
+                       0.f,                 -viewport.height / 2.f, viewport.top + viewport.height / 2.f,
+                       0.f,                 0.f,                  1.f);
+    toPixels *= view;
+    toPixels *= states.transform;
+
+    m_transformed.resize(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        const Vertex& vertex = vertices[i];
+        ScreenVertex& transformed = m_transformed[i];
+
+        Vector2f position = toPixels.transformPoint(vertex.position);
+        transformed.x        = position.x;
+        transformed.y        = position.y;
+        transformed.color[0] = vertex.color.r / 255.f;
+        transformed.color[1] = vertex.color.g / 255.f;
+        transformed.color[2] = vertex.color.b / 255.f;
+        transformed.color[3] = vertex.color.a / 255.f;
+        transformed.u        = vertex.texCoords.x;
+        transformed.v        = vertex.texCoords.y;
+    }
+
+    // Gather the vertices of each element, through the indices if any
+    std::size_t count = indices ? indexCount : vertexCount;
+    std::vector<const ScreenVertex*> elements;
+    elements.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t index = i;
+        if (indices)
+            index = (indexSize == sizeof(Uint32)) ? static_cast<const Uint32*>(indices)[i] : static_cast<const Uint16*>(indices)[i];
+
+        // Out of range indices would be undefined behavior for OpenGL, skip the draw
+        if (index >= vertexCount)
+            return;
+
+        elements.push_back(&m_transformed[index]);
+    }
+
+    // Assemble the primitives
+    ScreenVertex primitive[3];
+
+    switch (type)
+    {
+        case Points:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                primitive[0] = *elements[i];
+                addPrimitive(primitive, 1, clip);
+            }
+            break;
+
+        case Lines:
+        case LineStrip:
+            for (std::size_t i = 0; i + 1 < count; i += (type == Lines) ? 2 : 1)
+            {
+                primitive[0] = *elements[i];
+                primitive[1] = *elements[i + 1];
+                addPrimitive(primitive, 2, clip);
+            }
+            break;
+
+        case Triangles:
+        case TriangleStrip:
+            for (std::size_t i = 0; i + 2 < count; i += (type == Triangles) ? 3 : 1)
+            {
+                primitive[0] = *elements[i];
+                primitive[1] = *elements[i + 1];
+                primitive[2] = *elements[i + 2];
+                addPrimitive(primitive, 3, clip);
+            }
+            break;
+
+        case TriangleFan:
+            for (std::size_t i = 1; i + 1 < count; ++i)
+            {
+                primitive[0] = *elements[0];
+                primitive[1] = *elements[i];
+                primitive[2] = *elements[i + 1];
+                addPrimitive(primitive, 3, clip);
+            }
+            break;
+
+        case Quads:
+            for (std::size_t i = 0; i + 3 < count; i += 4)
+            {
+                primitive[0] = *elements[i];
+                primitive[1] = *elements[i + 1];
+                primitive[2] = *elements[i + 2];
+                addPrimitive(primitive, 3, clip);
+
+                primitive[1] = *elements[i + 2];
+                primitive[2] = *elements[i + 3];
+                addPrimitive(primitive, 3, clip);
+            }
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::flush()
+{
+    if (m_primitives.empty())
+        return;
+
+    // Split the target into tiles
+    int columns = (static_cast<int>(m_width) + tileSize - 1) / tileSize;
+    int rows = (static_cast<int>(m_height) + tileSize - 1) / tileSize;
+
+    m_tiles.clear();
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            Tile tile;
+            tile.left   = column * tileSize;
+            tile.top    = row * tileSize;
+            tile.right  = std::min(tile.left + tileSize, static_cast<int>(m_width));
+            tile.bottom = std::min(tile.top + tileSize, static_cast<int>(m_height));
+            m_tiles.push_back(tile);
+        }
+    }
+
+    // Bin the primitives into the tiles they touch, keeping their order
+    m_bins.resize(m_tiles.size());
+    for (std::size_t i = 0; i < m_bins.size(); ++i)
+        m_bins[i].clear();
+
+    for (std::size_t i = 0; i < m_primitives.size(); ++i)
+    {
+        const Primitive& primitive = m_primitives[i];
+
+        for (int row = primitive.top / tileSize; row <= (primitive.bottom - 1) / tileSize; ++row)
+            for (int column = primitive.left / tileSize; column <= (primitive.right - 1) / tileSize; ++column)
+                m_bins[row * columns + column].push_back(i);
+    }
+
+    // Rasterize the tiles on the worker threads and on this one
+    m_nextTile = 0;
+
+    unsigned int threadCount = std::min(m_threadCount, static_cast<unsigned int>(m_tiles.size()));
+    m_workers.run(&SoftwareRasterizer::rasterizeTilesTask, this, threadCount - 1);
+
+    m_primitives.clear();
+    m_states.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* SoftwareRasterizer::getPixels() const
+{
+    return m_pixels.empty() ? NULL : &m_pixels[0];
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::endFrame()
+{
+    flush();
+
+    // Nothing refers to the copies anymore, drop the ones of textures
+    // that were not drawn this frame (destroyed or modified since)
+    for (TextureMap::iterator it = m_textures.begin(); it != m_textures.end();)
+    {
+        if (it->second.used)
+        {
+            it->second.used = false;
+            ++it;
+        }
+        else
+        {
+            m_textures.erase(it++);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Image* SoftwareRasterizer::getTextureCopy(const Texture& texture, Uint64 textureId)
+{
+    // The cache identifier changes whenever the texture is modified, so a modified
+    // texture gets a new copy while the pending primitives keep using the previous one
+    TextureMap::iterator it = m_textures.find(textureId);
+
+    if (it == m_textures.end())
+    {
+        it = m_textures.insert(std::make_pair(textureId, TextureCopy())).first;
+        it->second.image = texture.copyToImage();
+    }
+
+    it->second.used = true;
+
+    return &it->second.image;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::addPrimitive(const ScreenVertex* vertices, unsigned int vertexCount, const IntRect& clip)
+{
+    Primitive primitive;
+    primitive.vertexCount = vertexCount;
+    primitive.state       = m_states.size() - 1;
+
+    float minX = vertices[0].x;
+    float minY = vertices[0].y;
+    float maxX = vertices[0].x;
+    float maxY = vertices[0].y;
+
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+        primitive.vertices[i] = vertices[i];
+        minX = std::min(minX, vertices[i].x);
+        minY = std::min(minY, vertices[i].y);
+        maxX = std::max(maxX, vertices[i].x);
+        maxY = std::max(maxY, vertices[i].y);
+    }
+
+    // Discard primitives whose positions are not finite
+    if (!(minX >= -1e7f) || !(maxX <= 1e7f) || !(minY >= -1e7f) || !(maxY <= 1e7f))
+        return;
+
+    // Conservative bounds: lines may step one pixel outside of their end points
+    primitive.left   = std::max(static_cast<int>(std::floor(minX)) - 1, clip.left);
+    primitive.top    = std::max(static_cast<int>(std::floor(minY)) - 1, clip.top);
+    primitive.right  = std::min(static_cast<int>(std::ceil(maxX)) + 1, clip.left + clip.width);
+    primitive.bottom = std::min(static_cast<int>(std::ceil(maxY)) + 1, clip.top + clip.height);
+
+    if ((primitive.left < primitive.right) && (primitive.top < primitive.bottom))
+        m_primitives.push_back(primitive);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::rasterizeTilesTask(void* rasterizer)
+{
+    static_cast<SoftwareRasterizer*>(rasterizer)->rasterizeTiles();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::rasterizeTiles()
+{
+    for (;;)
+    {
+        std::size_t index;
+
+        {
+            Lock lock(m_tileMutex);
+
+            if (m_nextTile >= m_tiles.size())
+                return;
+
+            index = m_nextTile++;
+        }
+
+        // Tiles don't overlap, so no lock is needed to write their pixels
+        Tile tile = m_tiles[index];
+        const std::vector<std::size_t>& bin = m_bins[index];
+
+        for (std::size_t i = 0; i < bin.size(); ++i)
+        {
+            const Primitive& primitive = m_primitives[bin[i]];
+            const DrawState& state = m_states[primitive.state];
+
+            // Restrict the tile to the clipped bounds of the primitive
+            Tile area;
+            area.left   = std::max(tile.left,   primitive.left);
+            area.top    = std::max(tile.top,    primitive.top);
+            area.right  = std::min(tile.right,  primitive.right);
+            area.bottom = std::min(tile.bottom, primitive.bottom);
+
+            if (primitive.vertexCount == 3)
+                rasterizeTriangle(primitive, state, area);
+            else if (primitive.vertexCount == 2)
+                rasterizeLine(primitive, state, area);
+            else
+                rasterizePoint(primitive, state, area);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::rasterizePoint(const Primitive& primitive, const DrawState& state, const Tile& area)
+{
+    const ScreenVertex& point = primitive.vertices[0];
+
+    int x = static_cast<int>(std::floor(point.x));
+    int y = static_cast<int>(std::floor(point.y));
+
+    if ((x >= area.left) && (x < area.right) && (y >= area.top) && (y < area.bottom))
+        writeFragment(x, y, point.color, point.u, point.v, state);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::rasterizeLine(const Primitive& primitive, const DrawState& state, const Tile& area)
+{
+    const ScreenVertex& start = primitive.vertices[0];
+    const ScreenVertex& end = primitive.vertices[1];
+
+    float dx = end.x - start.x;
+    float dy = end.y - start.y;
+
+    // Step along the major axis, one fragment per pixel center
+    // crossed; the end point is excluded, as OpenGL does
+    bool xMajor = std::fabs(dx) >= std::fabs(dy);
+    float startMajor = xMajor ? start.x : start.y;
+    float delta = xMajor ? dx : dy;
+
+    if (delta == 0.f)
+        return;
+
+    int first, last;
+    if (delta > 0.f)
+    {
+        first = static_cast<int>(std::ceil(startMajor - 0.5f));
+        last  = static_cast<int>(std::ceil(startMajor + delta - 0.5f)) - 1;
+    }
+    else
+    {
+        first = static_cast<int>(std::floor(startMajor + delta - 0.5f)) + 1;
+        last  = static_cast<int>(std::floor(startMajor - 0.5f));
+    }
+
+    // Only walk the part of the line inside the area
+    first = std::max(first, xMajor ? area.left : area.top);
+    last  = std::min(last, (xMajor ? area.right : area.bottom) - 1);
+
+    float color[4];
+
+    for (int major = first; major <= last; ++major)
+    {
+        float t = (major + 0.5f - startMajor) / delta;
+        float minor = (xMajor ? start.y + dy * t : start.x + dx * t);
+        int pixel = static_cast<int>(std::floor(minor));
+
+        int x = xMajor ? major : pixel;
+        int y = xMajor ? pixel : major;
+
+        if ((x < area.left) || (x >= area.right) || (y < area.top) || (y >= area.bottom))
+            continue;
+
+        for (int i = 0; i < 4; ++i)
+            color[i] = start.color[i] + (end.color[i] - start.color[i]) * t;
+
+        writeFragment(x, y, color, start.u + (end.u - start.u) * t, start.v + (end.v - start.v) * t, state);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::rasterizeTriangle(const Primitive& primitive, const DrawState& state, const Tile& area)
+{
+    const ScreenVertex* a = &primitive.vertices[0];
+    const ScreenVertex* b = &primitive.vertices[1];
+    const ScreenVertex* c = &primitive.vertices[2];
+
+    // Rasterize all the triangles with the same winding, back faces are not culled
+    float area2 = edge(a->x, a->y, b->x, b->y, c->x, c->y);
+    if (area2 == 0.f)
+        return;
+
+    if (area2 < 0.f)
+    {
+        std::swap(b, c);
+        area2 = -area2;
+    }
+
+    // Each edge function is the weight of the opposite vertex
+    bool topLeftA = isTopLeft(c->x - b->x, c->y - b->y);
+    bool topLeftB = isTopLeft(a->x - c->x, a->y - c->y);
+    bool topLeftC = isTopLeft(b->x - a->x, b->y - a->y);
+
+    float stepA = -(c->y - b->y);
+    float stepB = -(a->y - c->y);
+    float stepC = -(b->y - a->y);
+
+    // Gather the attributes (color, then texture coordinates) of the
+    // vertices; they are affine along a row, so they are interpolated
+    // by adding their horizontal gradient from one pixel to the next
+    float attributesA[6] = {a->color[0], a->color[1], a->color[2], a->color[3], a->u, a->v};
+    float attributesB[6] = {b->color[0], b->color[1], b->color[2], b->color[3], b->u, b->v};
+    float attributesC[6] = {c->color[0], c->color[1], c->color[2], c->color[3], c->u, c->v};
+
+    float inverseArea = 1.f / area2;
+    float gradient[6];
+    float attributes[6];
+
+    for (int i = 0; i < 6; ++i)
+        gradient[i] = (attributesA[i] * stepA + attributesB[i] * stepB + attributesC[i] * stepC) * inverseArea;
+
+    for (int y = area.top; y < area.bottom; ++y)
+    {
+        float px = area.left + 0.5f;
+        float py = y + 0.5f;
+
+        float weightA = edge(b->x, b->y, c->x, c->y, px, py);
+        float weightB = edge(c->x, c->y, a->x, a->y, px, py);
+        float weightC = edge(a->x, a->y, b->x, b->y, px, py);
+
+        // Narrow the row to the span where the edge functions may be positive;
+        // the bounds keep a pixel of margin, the exact test is done below
+        int first = area.left;
+        int last = area.right;
+
+        if (!clipSpan(weightA, stepA, area.left, first, last) ||
+            !clipSpan(weightB, stepB, area.left, first, last) ||
+            !clipSpan(weightC, stepC, area.left, first, last))
+            continue;
+
+        float offset = static_cast<float>(first - area.left);
+        weightA += stepA * offset;
+        weightB += stepB * offset;
+        weightC += stepC * offset;
+
+        for (int i = 0; i < 6; ++i)
+            attributes[i] = (attributesA[i] * weightA + attributesB[i] * weightB + attributesC[i] * weightC) * inverseArea;
+
+        for (int x = first; x < last; ++x)
+        {
+            if (!((weightA < 0.f) || ((weightA == 0.f) && !topLeftA) ||
+                  (weightB < 0.f) || ((weightB == 0.f) && !topLeftB) ||
+                  (weightC < 0.f) || ((weightC == 0.f) && !topLeftC)))
+                writeFragment(x, y, attributes, attributes[4], attributes[5], state);
+
+            weightA += stepA;
+            weightB += stepB;
+            weightC += stepC;
+
+            for (int i = 0; i < 6; ++i)
+                attributes[i] += gradient[i];
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::writeFragment(int x, int y, const float* color, float u, float v, const DrawState& state)
+{
+    float source[4] = {color[0], color[1], color[2], color[3]};
+
+    // Modulate the vertex color with the texture
+    if (state.texels)
+    {
+        const Uint8* texels = state.texels;
+        int width = state.textureWidth;
+        int height = state.textureHeight;
+
+        if (state.smooth)
+        {
+            // Bilinear filtering between the four nearest texel centers
+            float tx = u - 0.5f;
+            float ty = v - 0.5f;
+            int x0 = floorToInt(tx);
+            int y0 = floorToInt(ty);
+            float fx = tx - x0;
+            float fy = ty - y0;
+
+            int left   = wrap(x0,     width,  state.repeated);
+            int right  = wrap(x0 + 1, width,  state.repeated);
+            int top    = wrap(y0,     height, state.repeated) * width;
+            int bottom = wrap(y0 + 1, height, state.repeated) * width;
+
+            const Uint8* t00 = texels + (top + left) * 4;
+            const Uint8* t10 = texels + (top + right) * 4;
+            const Uint8* t01 = texels + (bottom + left) * 4;
+            const Uint8* t11 = texels + (bottom + right) * 4;
+
+            for (int i = 0; i < 4; ++i)
+            {
+                float upper = t00[i] + (t10[i] - t00[i]) * fx;
+                float lower = t01[i] + (t11[i] - t01[i]) * fx;
+                source[i] *= (upper + (lower - upper) * fy) * inverse255;
+            }
+        }
+        else
+        {
+            int tx = wrap(floorToInt(u), width, state.repeated);
+            int ty = wrap(floorToInt(v), height, state.repeated);
+
+            const Uint8* texel = texels + (ty * width + tx) * 4;
+            for (int i = 0; i < 4; ++i)
+                source[i] *= texel[i] * inverse255;
+        }
+    }
+
+    // Blend with the color buffer
+    Uint8* pixel = &m_pixels[(static_cast<std::size_t>(y) * m_width + x) * 4];
+    float result[4];
+
+    switch (state.blendPath)
+    {
+        case NoBlend:
+        {
+            for (int i = 0; i < 4; ++i)
+                result[i] = source[i];
+            break;
+        }
+
+        case AlphaBlend:
+        {
+            float inverseAlpha = 1.f - source[3];
+            for (int i = 0; i < 3; ++i)
+                result[i] = source[i] * source[3] + pixel[i] * inverse255 * inverseAlpha;
+            result[3] = source[3] + pixel[3] * inverse255 * inverseAlpha;
+            break;
+        }
+
+        default:
+        case GenericBlend:
+        {
+            float destination[4] = {pixel[0] * inverse255, pixel[1] * inverse255, pixel[2] * inverse255, pixel[3] * inverse255};
+            blendColors(state.blendMode, source, destination, result);
+            break;
+        }
+    }
+
+    for (int i = 0; i < 4; ++i)
+        pixel[i] = static_cast<Uint8>(std::min(std::max(result[i], 0.f), 1.f) * 255.f + 0.5f);
+}
+
+} // namespace priv
+
+} // namespace sf
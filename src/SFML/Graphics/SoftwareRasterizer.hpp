@@ -0,0 +1,337 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOFTWARERASTERIZER_HPP
+#define SFML_SOFTWARERASTERIZER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/WorkerPool.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Tile-based rasterizer rendering into client memory
+///
+/// Draw calls are transformed to pixel coordinates and binned
+/// as points, lines and triangles. When the pending primitives
+/// are flushed, the target is split into tiles which worker
+/// threads rasterize independently, each one applying all the
+/// primitives that touch its tile in submission order.
+///
+////////////////////////////////////////////////////////////
+class SoftwareRasterizer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoftwareRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the color buffer
+    ///
+    /// The content of the buffer is reset to transparent black.
+    ///
+    /// \param width  Width of the buffer, in pixels
+    /// \param height Height of the buffer, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the color buffer
+    ///
+    /// \return Size of the buffer, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads rasterizing the tiles
+    ///
+    /// \param count Number of threads, at least 1
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads rasterizing the tiles
+    ///
+    /// \return Number of threads
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fill the whole buffer with a color
+    ///
+    /// \param color Fill color
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bin the primitives of a draw call
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices
+    /// \param type        Type of primitives to draw
+    /// \param indices     Pointer to the indices, or null
+    /// \param indexCount  Number of indices
+    /// \param indexSize   Size of an index, in bytes
+    /// \param states      Render states to use for drawing
+    /// \param view        Transform of the current view
+    /// \param viewport    Viewport of the current view, in pixels
+    /// \param textureId   Cache identifier of the states texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const void* indices,
+              std::size_t indexCount, std::size_t indexSize, const RenderStates& states,
+              const Transform& view, const IntRect& viewport, Uint64 textureId);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the pending primitives
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Flush the pending primitives and forget the texture
+    ///        copies that were not used since the last frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void endFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pixels of the color buffer
+    ///
+    /// The pending primitives must be flushed first.
+    ///
+    /// \return Pointer to the RGBA pixels, top row first
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getPixels() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Vertex transformed to pixel coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ScreenVertex
+    {
+        float x;        ///< Horizontal position, in pixels
+        float y;        ///< Vertical position, in pixels
+        float color[4]; ///< Normalized RGBA color
+        float u;        ///< Horizontal texture coordinate, in texels
+        float v;        ///< Vertical texture coordinate, in texels
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Blending implementations
+    ///
+    ////////////////////////////////////////////////////////////
+    enum BlendPath
+    {
+        GenericBlend, ///< Any blend mode, factors evaluated for each fragment
+        AlphaBlend,   ///< sf::BlendAlpha
+        NoBlend       ///< sf::BlendNone
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render states shared by the primitives of a draw call
+    ///
+    ////////////////////////////////////////////////////////////
+    struct DrawState
+    {
+        const Uint8* texels;        ///< Texture pixels, null if untextured
+        int          textureWidth;  ///< Width of the texture, in texels
+        int          textureHeight; ///< Height of the texture, in texels
+        bool         smooth;        ///< Is the texture filtered?
+        bool         repeated;      ///< Is the texture repeated?
+        BlendMode    blendMode;     ///< Blend mode
+        BlendPath    blendPath;     ///< Implementation of the blend mode
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Point, line or triangle waiting to be rasterized
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Primitive
+    {
+        unsigned int vertexCount; ///< 1 for points, 2 for lines, 3 for triangles
+        std::size_t  state;       ///< Index of the draw state
+        ScreenVertex vertices[3]; ///< Vertices of the primitive
+        int          left;        ///< Left of the bounding box, clipped to the viewport
+        int          top;         ///< Top of the bounding box, clipped to the viewport
+        int          right;       ///< Right of the bounding box (excluded), clipped to the viewport
+        int          bottom;      ///< Bottom of the bounding box (excluded), clipped to the viewport
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Client copy of a texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct TextureCopy
+    {
+        bool  used;  ///< Was the copy drawn during the current frame?
+        Image image; ///< Pixels of the texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Area of the target rasterized by a single thread
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Tile
+    {
+        int left;   ///< Left of the tile
+        int top;    ///< Top of the tile
+        int right;  ///< Right of the tile (excluded)
+        int bottom; ///< Bottom of the tile (excluded)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the client copy of a texture
+    ///
+    /// \param texture   Texture to copy
+    /// \param textureId Cache identifier of the texture
+    ///
+    /// \return Pixels of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image* getTextureCopy(const Texture& texture, Uint64 textureId);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a primitive to the pending ones
+    ///
+    /// \param vertices    Transformed vertices of the primitive
+    /// \param vertexCount Number of vertices, 1 to 3
+    /// \param clip        Viewport of the draw call, clipped to the target
+    ///
+    ////////////////////////////////////////////////////////////
+    void addPrimitive(const ScreenVertex* vertices, unsigned int vertexCount, const IntRect& clip);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize tiles until there are none left
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizeTiles();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the tiles of a rasterizer, from a worker thread
+    ///
+    /// \param rasterizer Rasterizer to flush
+    ///
+    ////////////////////////////////////////////////////////////
+    static void rasterizeTilesTask(void* rasterizer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a point inside an area of a tile
+    ///
+    /// \param primitive Primitive to rasterize
+    /// \param state     Render states of the primitive
+    /// \param area      Area to rasterize, inside the tile and the primitive bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizePoint(const Primitive& primitive, const DrawState& state, const Tile& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a line inside an area of a tile
+    ///
+    /// \param primitive Primitive to rasterize
+    /// \param state     Render states of the primitive
+    /// \param area      Area to rasterize, inside the tile and the primitive bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizeLine(const Primitive& primitive, const DrawState& state, const Tile& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a triangle inside an area of a tile
+    ///
+    /// \param primitive Primitive to rasterize
+    /// \param state     Render states of the primitive
+    /// \param area      Area to rasterize, inside the tile and the primitive bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizeTriangle(const Primitive& primitive, const DrawState& state, const Tile& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shade a fragment and blend it into the color buffer
+    ///
+    /// \param x     Horizontal position of the pixel
+    /// \param y     Vertical position of the pixel
+    /// \param color Interpolated normalized vertex color
+    /// \param u     Interpolated horizontal texture coordinate
+    /// \param v     Interpolated vertical texture coordinate
+    /// \param state Render states of the fragment
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeFragment(int x, int y, const float* color, float u, float v, const DrawState& state);
+
+    typedef std::map<Uint64, TextureCopy> TextureMap;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int                           m_width;       ///< Width of the color buffer
+    unsigned int                           m_height;      ///< Height of the color buffer
+    std::vector<Uint8>                     m_pixels;      ///< RGBA color buffer, top row first
+    unsigned int                           m_threadCount; ///< Number of threads rasterizing the tiles
+    std::vector<ScreenVertex>              m_transformed; ///< Vertices of the current draw call, in pixels
+    std::vector<Primitive>                 m_primitives;  ///< Primitives waiting to be rasterized
+    std::vector<DrawState>                 m_states;      ///< Render states of the pending primitives
+    TextureMap                             m_textures;    ///< Client copies of the textures, by cache identifier
+    std::vector<Tile>                      m_tiles;       ///< Tiles of the flush in progress
+    std::vector<std::vector<std::size_t> > m_bins;        ///< Primitives touching each tile, in submission order
+    std::size_t                            m_nextTile;    ///< Next tile to hand to a thread
+    Mutex                                  m_tileMutex;   ///< Protects m_nextTile
+    WorkerPool                             m_workers;     ///< Threads helping the calling thread to rasterize the tiles
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOFTWARERASTERIZER_HPP
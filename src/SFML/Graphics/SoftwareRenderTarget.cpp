@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SoftwareRenderTarget.hpp>
+#include <SFML/Graphics/SoftwareRasterizer.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoftwareRenderTarget::SoftwareRenderTarget() :
+m_image()
+{
+    m_rasterizer = new priv::SoftwareRasterizer;
+}
+
+
+////////////////////////////////////////////////////////////
+SoftwareRenderTarget::~SoftwareRenderTarget()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoftwareRenderTarget::create(unsigned int width, unsigned int height)
+{
+    m_rasterizer->create(width, height);
+    m_image.create(width, height, Color::Transparent);
+
+    // Perform the common initialization
+    RenderTarget::initialize();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::setThreadCount(unsigned int count)
+{
+    m_rasterizer->setThreadCount(count);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoftwareRenderTarget::getThreadCount() const
+{
+    return m_rasterizer->getThreadCount();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::display()
+{
+    m_rasterizer->endFrame();
+
+    Vector2u size = m_rasterizer->getSize();
+    if (size.x && size.y)
+        m_image.create(size.x, size.y, m_rasterizer->getPixels());
+
+    endStatisticsFrame();
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u SoftwareRenderTarget::getSize() const
+{
+    return m_rasterizer->getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+const Image& SoftwareRenderTarget::getImage() const
+{
+    return m_image;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoftwareRenderTarget::setActive(bool /* active */)
+{
+    return true;
+}
+
+} // namespace sf
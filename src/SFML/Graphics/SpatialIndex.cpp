@@ -0,0 +1,369 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpatialIndex.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+namespace
+{
+    // Items covering more cells than this are tested by every query instead
+    const int maxCellsPerItem = 64;
+
+    // Check whether two rectangles overlap, touching edges included
+    // so that rectangles with a null size can still be found
+    bool overlap(const sf::FloatRect& a, const sf::FloatRect& b)
+    {
+        return (a.left <= b.left + b.width) && (b.left <= a.left + a.width) &&
+               (a.top <= b.top + b.height) && (b.top <= a.top + a.height);
+    }
+
+    // Convert a world coordinate to a cell coordinate, clamped to the range of int
+    int toCell(float value, float cellSize)
+    {
+        float cell = std::floor(value / cellSize);
+
+        if (cell <= -1e9f)
+            return -1000000000;
+
+        if (cell >= 1e9f)
+            return 1000000000;
+
+        return static_cast<int>(cell);
+    }
+
+    // Sort found items by insertion order
+    template <typename T>
+    struct InsertionOrder
+    {
+        explicit InsertionOrder(const std::vector<T>& items) : items(items) {}
+
+        bool operator ()(std::size_t left, std::size_t right) const
+        {
+            return items[left].order < items[right].order;
+        }
+
+        const std::vector<T>& items;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpatialIndex::SpatialIndex(float cellSize) :
+m_cellSize (cellSize > 0.f ? cellSize : 256.f),
+m_cells    (),
+m_large    (),
+m_items    (),
+m_freeIds  (),
+m_count    (0),
+m_nextOrder(0),
+m_query    (0),
+m_found    (),
+m_visible  ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::insert(const Drawable& drawable, const FloatRect& bounds)
+{
+    std::size_t id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        id = m_items.size();
+        m_items.push_back(Item());
+    }
+
+    Item& item = m_items[id];
+    item.drawable = &drawable;
+    item.bounds = bounds;
+    item.order = m_nextOrder++;
+    item.lastQuery = 0;
+
+    link(id);
+    ++m_count;
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::update(std::size_t id, const FloatRect& bounds)
+{
+    assert(id < m_items.size() && m_items[id].drawable);
+
+    Item& item = m_items[id];
+
+    // Still in the same cells: nothing to relink
+    int left, top, right, bottom;
+    getCellRange(bounds, left, top, right, bottom);
+
+    if ((left == item.left) && (top == item.top) && (right == item.right) && (bottom == item.bottom))
+    {
+        item.bounds = bounds;
+        return;
+    }
+
+    unlink(id);
+    item.bounds = bounds;
+    link(id);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::remove(std::size_t id)
+{
+    assert(id < m_items.size() && m_items[id].drawable);
+
+    unlink(id);
+
+    m_items[id].drawable = NULL;
+    m_freeIds.push_back(id);
+    --m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::clear()
+{
+    m_cells.clear();
+    m_large.clear();
+    m_items.clear();
+    m_freeIds.clear();
+    m_count = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::getCount() const
+{
+    return m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+const FloatRect& SpatialIndex::getBounds(std::size_t id) const
+{
+    assert(id < m_items.size() && m_items[id].drawable);
+
+    return m_items[id].bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::query(const FloatRect& area, std::vector<const Drawable*>& drawables) const
+{
+    drawables.clear();
+    m_found.clear();
+
+    // Items covering several cells are found several times, the query number lets us test them once
+    ++m_query;
+
+    int left, top, right, bottom;
+    getCellRange(area, left, top, right, bottom);
+
+    // When the area covers more cells than there are non-empty ones,
+    // walking the non-empty cells is cheaper than looking them all up
+    double areaCells = (static_cast<double>(right) - left + 1) * (static_cast<double>(bottom) - top + 1);
+
+    if (areaCells > static_cast<double>(m_cells.size()))
+    {
+        for (CellMap::const_iterator it = m_cells.begin(); it != m_cells.end(); ++it)
+        {
+            const CellKey& key = it->first;
+            if ((key.first >= left) && (key.first <= right) && (key.second >= top) && (key.second <= bottom))
+            {
+                for (Cell::const_iterator id = it->second.begin(); id != it->second.end(); ++id)
+                    testItem(*id, area);
+            }
+        }
+    }
+    else
+    {
+        for (int x = left; x <= right; ++x)
+        {
+            for (int y = top; y <= bottom; ++y)
+            {
+                CellMap::const_iterator it = m_cells.find(CellKey(x, y));
+                if (it == m_cells.end())
+                    continue;
+
+                for (Cell::const_iterator id = it->second.begin(); id != it->second.end(); ++id)
+                    testItem(*id, area);
+            }
+        }
+    }
+
+    for (Cell::const_iterator id = m_large.begin(); id != m_large.end(); ++id)
+        testItem(*id, area);
+
+    // Return the drawables in drawing order
+    std::sort(m_found.begin(), m_found.end(), InsertionOrder<Item>(m_items));
+
+    drawables.reserve(m_found.size());
+    for (std::vector<std::size_t>::const_iterator id = m_found.begin(); id != m_found.end(); ++id)
+        drawables.push_back(m_items[*id].drawable);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::query(const View& view, std::vector<const Drawable*>& drawables) const
+{
+    // The inverse view transform maps the corners of the viewport to the world
+    query(view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f)), drawables);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::draw(RenderTarget& target, RenderStates states) const
+{
+    // Without a known view (draw lists), everything may end up visible
+    if (!target.isViewKnown())
+    {
+        m_found.clear();
+        for (std::size_t id = 0; id < m_items.size(); ++id)
+        {
+            if (m_items[id].drawable)
+                m_found.push_back(id);
+        }
+
+        std::sort(m_found.begin(), m_found.end(), InsertionOrder<Item>(m_items));
+
+        for (std::vector<std::size_t>::const_iterator id = m_found.begin(); id != m_found.end(); ++id)
+            target.draw(*m_items[*id].drawable, states);
+
+        return;
+    }
+
+    FloatRect visible = target.getView().getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+
+    // The drawables are transformed by the states, bring the visible area back into their space
+    if (states.transform != Transform::Identity)
+        visible = states.transform.getInverse().transformRect(visible);
+
+    query(visible, m_visible);
+
+    for (std::vector<const Drawable*>::const_iterator it = m_visible.begin(); it != m_visible.end(); ++it)
+        target.draw(**it, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::getCellRange(const FloatRect& area, int& left, int& top, int& right, int& bottom) const
+{
+    left   = toCell(area.left, m_cellSize);
+    top    = toCell(area.top, m_cellSize);
+    right  = toCell(area.left + area.width, m_cellSize);
+    bottom = toCell(area.top + area.height, m_cellSize);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::link(std::size_t id)
+{
+    Item& item = m_items[id];
+
+    getCellRange(item.bounds, item.left, item.top, item.right, item.bottom);
+
+    double cellCount = (static_cast<double>(item.right) - item.left + 1) * (static_cast<double>(item.bottom) - item.top + 1);
+    item.large = (cellCount > maxCellsPerItem);
+
+    if (item.large)
+    {
+        m_large.push_back(id);
+        return;
+    }
+
+    for (int x = item.left; x <= item.right; ++x)
+        for (int y = item.top; y <= item.bottom; ++y)
+            m_cells[CellKey(x, y)].push_back(id);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::unlink(std::size_t id)
+{
+    const Item& item = m_items[id];
+
+    if (item.large)
+    {
+        m_large.erase(std::find(m_large.begin(), m_large.end(), id));
+        return;
+    }
+
+    for (int x = item.left; x <= item.right; ++x)
+    {
+        for (int y = item.top; y <= item.bottom; ++y)
+        {
+            CellMap::iterator it = m_cells.find(CellKey(x, y));
+            if (it == m_cells.end())
+                continue;
+
+            // The order within a cell doesn't matter, swap with the last one
+            Cell& cell = it->second;
+            Cell::iterator position = std::find(cell.begin(), cell.end(), id);
+            if (position != cell.end())
+            {
+                *position = cell.back();
+                cell.pop_back();
+            }
+
+            // Empty cells don't use memory
+            if (cell.empty())
+                m_cells.erase(it);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::testItem(std::size_t id, const FloatRect& area) const
+{
+    const Item& item = m_items[id];
+
+    if (item.lastQuery == m_query)
+        return;
+
+    item.lastQuery = m_query;
+
+    if (overlap(item.bounds, area))
+        m_found.push_back(id);
+}
+
+} // namespace sf
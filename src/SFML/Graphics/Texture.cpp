@@ -28,12 +28,15 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GraphicsMemoryTracker.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -53,6 +56,92 @@ namespace
 
         return id++;
     }
+
+    // Retrieve the OpenGL formats matching a pixel format,
+    // returns false if the format is not supported by the driver
+    bool getTextureFormat(sf::Image::PixelFormat format, bool sRgb, GLint& internalFormat, GLenum& dataFormat, GLenum& dataType)
+    {
+        dataType = GL_UNSIGNED_BYTE;
+
+        switch (format)
+        {
+            case sf::Image::RGB8:
+                internalFormat = sRgb ? GLEXT_GL_SRGB8 : GL_RGB;
+                dataFormat = GL_RGB;
+                return true;
+
+            case sf::Image::RG8:
+                internalFormat = GLEXT_GL_RG8;
+                dataFormat = GLEXT_GL_RG;
+                return GLEXT_texture_rg;
+
+            case sf::Image::R8:
+                internalFormat = GLEXT_GL_R8;
+                dataFormat = GLEXT_GL_RED;
+                return GLEXT_texture_rg;
+
+            case sf::Image::RGBA16F:
+                internalFormat = GLEXT_GL_RGBA16F;
+                dataFormat = GL_RGBA;
+                dataType = GLEXT_GL_HALF_FLOAT;
+                return GLEXT_texture_float && GLEXT_half_float_pixel;
+
+            default:
+                internalFormat = sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA;
+                dataFormat = GL_RGBA;
+                return true;
+        }
+    }
+
+    // Compute the memory used by the mipmap levels below the base level
+    sf::Uint64 getMipmapSize(unsigned int width, unsigned int height, std::size_t pixelSize)
+    {
+        sf::Uint64 size = 0;
+        while ((width > 1) || (height > 1))
+        {
+            width = std::max(width / 2, 1u);
+            height = std::max(height / 2, 1u);
+            size += static_cast<sf::Uint64>(width) * height * pixelSize;
+        }
+
+        return size;
+    }
+
+    // Convert an image to another pixel format
+    sf::Image convertImage(const sf::Image& image, sf::Image::PixelFormat format)
+    {
+        sf::Image converted;
+        converted.create(image.getSize().x, image.getSize().y, sf::Color(0, 0, 0, 0), format);
+        converted.copy(image, 0, 0);
+        return converted;
+    }
+
+    // Rows of compact pixels are not 4-bytes aligned, this
+    // class relaxes the unpack alignment during its lifetime
+    class UnpackAlignmentSaver
+    {
+    public:
+
+        UnpackAlignmentSaver(sf::Image::PixelFormat format) :
+        m_alignment(0)
+        {
+            if (sf::Image::getBytesPerPixel(format) % 4 != 0)
+            {
+                glCheck(glGetIntegerv(GL_UNPACK_ALIGNMENT, &m_alignment));
+                glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+            }
+        }
+
+        ~UnpackAlignmentSaver()
+        {
+            if (m_alignment)
+                glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, m_alignment));
+        }
+
+    private:
+
+        GLint m_alignment;
+    };
 }
 
 
@@ -62,6 +151,7 @@ namespace sf
 Texture::Texture() :
 m_size         (0, 0),
 m_actualSize   (0, 0),
+m_format       (Image::RGBA8),
 m_texture      (0),
 m_isSmooth     (false),
 m_sRgb         (false),
@@ -69,7 +159,10 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_memoryCategory(GraphicsMemory::Textures),
+m_memoryUsage  (0),
+m_memoryPadding(0)
 {
 }
 
@@ -78,6 +171,7 @@ m_cacheId      (getUniqueId())
 Texture::Texture(const Texture& copy) :
 m_size         (0, 0),
 m_actualSize   (0, 0),
+m_format       (Image::RGBA8),
 m_texture      (0),
 m_isSmooth     (copy.m_isSmooth),
 m_sRgb         (copy.m_sRgb),
@@ -85,11 +179,14 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_memoryCategory(copy.m_memoryCategory),
+m_memoryUsage  (0),
+m_memoryPadding(0)
 {
     if (copy.m_texture)
     {
-        if (create(copy.getSize().x, copy.getSize().y))
+        if (create(copy.getSize().x, copy.getSize().y, copy.m_format))
         {
             update(copy);
 
@@ -113,14 +210,18 @@ Texture::~Texture()
     {
         TransientContextLock lock;
 
+        priv::GLStateCache::forgetTexture(m_texture);
+
         GLuint texture = static_cast<GLuint>(m_texture);
         glCheck(glDeleteTextures(1, &texture));
+
+        setMemoryUsage(0, 0);
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Texture::create(unsigned int width, unsigned int height)
+bool Texture::create(unsigned int width, unsigned int height, Image::PixelFormat format)
 {
     // Check if texture parameters are valid before creating it
     if ((width == 0) || (height == 0))
@@ -203,9 +304,31 @@ bool Texture::create(unsigned int width, unsigned int height)
         m_sRgb = false;
     }
 
+    GLint internalFormat;
+    GLenum dataFormat;
+    GLenum dataType;
+
+    if (!getTextureFormat(format, m_sRgb, internalFormat, dataFormat, dataType))
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            err() << "Texture pixel format unsupported by the graphics driver" << std::endl;
+            err() << "Falling back to RGBA8, pixels will be converted on upload" << std::endl;
+
+            warned = true;
+        }
+
+        format = Image::RGBA8;
+        getTextureFormat(format, m_sRgb, internalFormat, dataFormat, dataType);
+    }
+
+    m_format = format;
+
     // Initialize the texture
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, (m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA), m_actualSize.x, m_actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    priv::GLStateCache::bindTexture(m_texture);
+    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_actualSize.x, m_actualSize.y, 0, dataFormat, dataType, NULL));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
@@ -214,6 +337,12 @@ bool Texture::create(unsigned int width, unsigned int height)
 
     m_hasMipmap = false;
 
+    // Account for the new storage, padding included
+    Uint64 pixelSize = Image::getBytesPerPixel(m_format);
+    Uint64 actualBytes = static_cast<Uint64>(m_actualSize.x) * m_actualSize.y * pixelSize;
+    Uint64 usedBytes = static_cast<Uint64>(m_size.x) * m_size.y * pixelSize;
+    setMemoryUsage(actualBytes, actualBytes - usedBytes);
+
     return true;
 }
 
@@ -254,7 +383,7 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
        ((area.left <= 0) && (area.top <= 0) && (area.width >= width) && (area.height >= height)))
     {
         // Load the entire image
-        if (create(image.getSize().x, image.getSize().y))
+        if (create(image.getSize().x, image.getSize().y, image.getPixelFormat()))
         {
             update(image);
 
@@ -277,20 +406,38 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
         if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
 
         // Create the texture and upload the pixels
-        if (create(rectangle.width, rectangle.height))
+        if (create(rectangle.width, rectangle.height, image.getPixelFormat()))
         {
+            // Convert the pixels if the texture had to fall back to another format
+            const Image* source = &image;
+            Image converted;
+            if (image.getPixelFormat() != m_format)
+            {
+                converted = convertImage(image, m_format);
+                source = &converted;
+            }
+
             TransientContextLock lock;
 
             // Make sure that the current texture binding will be preserved
             priv::TextureSaver save;
 
+            // Make sure that the pixel rows are read with the right alignment
+            UnpackAlignmentSaver alignment(m_format);
+
+            GLint internalFormat;
+            GLenum dataFormat;
+            GLenum dataType;
+            getTextureFormat(m_format, m_sRgb, internalFormat, dataFormat, dataType);
+
             // Copy the pixels to the texture, row by row
-            const Uint8* pixels = image.getPixelsPtr() + 4 * (rectangle.left + (width * rectangle.top));
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            std::size_t pixelSize = Image::getBytesPerPixel(m_format);
+            const Uint8* pixels = source->getPixelsPtr() + pixelSize * (rectangle.left + (width * rectangle.top));
+            priv::GLStateCache::bindTexture(m_texture);
             for (int i = 0; i < rectangle.height; ++i)
             {
-                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-                pixels += 4 * width;
+                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, dataFormat, dataType, pixels));
+                pixels += pixelSize * width;
             }
 
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
@@ -317,6 +464,20 @@ Vector2u Texture::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+Image::PixelFormat Texture::getPixelFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Texture::getMemoryUsage() const
+{
+    return m_memoryUsage;
+}
+
+
 ////////////////////////////////////////////////////////////
 Image Texture::copyToImage() const
 {
@@ -356,7 +517,7 @@ Image Texture::copyToImage() const
     if ((m_size == m_actualSize) && !m_pixelsFlipped)
     {
         // Texture is not padded nor flipped, we can use a direct copy
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        priv::GLStateCache::bindTexture(m_texture);
         glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
     }
     else
@@ -365,7 +526,7 @@ Image Texture::copyToImage() const
 
         // All the pixels will first be copied to a temporary array
         std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * 4);
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        priv::GLStateCache::bindTexture(m_texture);
         glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &allPixels[0]));
 
         // Then we copy the useful pixels from the temporary array to the final one
@@ -420,9 +581,17 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
         // Make sure that the current texture binding will be preserved
         priv::TextureSaver save;
 
+        // Make sure that the pixel rows are read with the right alignment
+        UnpackAlignmentSaver alignment(m_format);
+
+        GLint internalFormat;
+        GLenum dataFormat;
+        GLenum dataType;
+        getTextureFormat(m_format, m_sRgb, internalFormat, dataFormat, dataType);
+
         // Copy pixels from the given array to the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        priv::GLStateCache::bindTexture(m_texture);
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, dataFormat, dataType, pixels));
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
         m_hasMipmap = false;
         m_pixelsFlipped = false;
@@ -525,7 +694,7 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         priv::TextureSaver save;
 
         // Set the parameters of this texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        priv::GLStateCache::bindTexture(m_texture);
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
         m_hasMipmap = false;
         m_pixelsFlipped = false;
@@ -548,14 +717,23 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
 void Texture::update(const Image& image)
 {
     // Update the whole texture
-    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, 0, 0);
+    update(image, 0, 0);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Texture::update(const Image& image, unsigned int x, unsigned int y)
 {
-    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y);
+    if (image.getPixelFormat() == m_format)
+    {
+        update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y);
+    }
+    else
+    {
+        // Convert the pixels to the format of the texture first
+        Image converted = convertImage(image, m_format);
+        update(converted.getPixelsPtr(), converted.getSize().x, converted.getSize().y, x, y);
+    }
 }
 
 
@@ -580,7 +758,7 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
         priv::TextureSaver save;
 
         // Copy pixels from the back-buffer to the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        priv::GLStateCache::bindTexture(m_texture);
         glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 0, 0, window.getSize().x, window.getSize().y));
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
         m_hasMipmap = false;
@@ -608,7 +786,7 @@ void Texture::setSmooth(bool smooth)
             // Make sure that the current texture binding will be preserved
             priv::TextureSaver save;
 
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            priv::GLStateCache::bindTexture(m_texture);
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
 
             if (m_hasMipmap)
@@ -675,7 +853,7 @@ void Texture::setRepeated(bool repeated)
                 }
             }
 
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            priv::GLStateCache::bindTexture(m_texture);
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
         }
@@ -707,12 +885,16 @@ bool Texture::generateMipmap()
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    priv::GLStateCache::bindTexture(m_texture);
     glCheck(GLEXT_glGenerateMipmap(GL_TEXTURE_2D));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
 
     m_hasMipmap = true;
 
+    // The mipmap levels remain allocated until the texture is created again
+    Uint64 baseBytes = static_cast<Uint64>(m_actualSize.x) * m_actualSize.y * Image::getBytesPerPixel(m_format);
+    setMemoryUsage(baseBytes + getMipmapSize(m_actualSize.x, m_actualSize.y, Image::getBytesPerPixel(m_format)), m_memoryPadding);
+
     return true;
 }
 
@@ -728,65 +910,85 @@ void Texture::invalidateMipmap()
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    priv::GLStateCache::bindTexture(m_texture);
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
 
     m_hasMipmap = false;
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::setMemoryUsage(Uint64 bytes, Uint64 padding)
+{
+    priv::updateGraphicsMemory(m_memoryCategory, m_memoryUsage, m_memoryPadding, bytes, padding);
+
+    m_memoryUsage = bytes;
+    m_memoryPadding = padding;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::bind(const Texture* texture, CoordinateType coordinateType)
+{
+    // User code may have changed the bindings behind the state cache
+    bind(texture, coordinateType, true);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::bind(const Texture* texture, CoordinateType coordinateType, bool force)
 {
     TransientContextLock lock;
 
     if (texture && texture->m_texture)
     {
         // Bind the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
+        priv::GLStateCache::bindTexture(texture->m_texture, force);
 
         // Check if we need to define a special texture matrix
         if ((coordinateType == Pixels) || texture->m_pixelsFlipped)
         {
-            GLfloat matrix[16] = {1.f, 0.f, 0.f, 0.f,
-                                  0.f, 1.f, 0.f, 0.f,
-                                  0.f, 0.f, 1.f, 0.f,
-                                  0.f, 0.f, 0.f, 1.f};
-
-            // If non-normalized coordinates (= pixels) are requested, we need to
-            // setup scale factors that convert the range [0 .. size] to [0 .. 1]
-            if (coordinateType == Pixels)
-            {
-                matrix[0] = 1.f / texture->m_actualSize.x;
-                matrix[5] = 1.f / texture->m_actualSize.y;
-            }
-
-            // If pixels are flipped we must invert the Y axis
-            if (texture->m_pixelsFlipped)
-            {
-                matrix[5] = -matrix[5];
-                matrix[13] = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
-            }
+            GLfloat matrix[16];
+            texture->getTextureMatrix(coordinateType, matrix);
 
             // Load the matrix
-            glCheck(glMatrixMode(GL_TEXTURE));
-            glCheck(glLoadMatrixf(matrix));
-
-            // Go back to model-view mode (sf::RenderTarget relies on it)
-            glCheck(glMatrixMode(GL_MODELVIEW));
+            priv::GLStateCache::loadTextureMatrix(matrix, force);
         }
     }
     else
     {
         // Bind no texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+        priv::GLStateCache::bindTexture(0, force);
 
         // Reset the texture matrix
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glLoadIdentity());
+        priv::GLStateCache::loadTextureMatrix(NULL, force);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::getTextureMatrix(CoordinateType coordinateType, float* matrix) const
+{
+    static const float identity[16] = {1.f, 0.f, 0.f, 0.f,
+                                       0.f, 1.f, 0.f, 0.f,
+                                       0.f, 0.f, 1.f, 0.f,
+                                       0.f, 0.f, 0.f, 1.f};
 
-        // Go back to model-view mode (sf::RenderTarget relies on it)
-        glCheck(glMatrixMode(GL_MODELVIEW));
+    std::copy(identity, identity + 16, matrix);
+
+    // If non-normalized coordinates (= pixels) are requested, we need to
+    // setup scale factors that convert the range [0 .. size] to [0 .. 1]
+    if (coordinateType == Pixels)
+    {
+        matrix[0] = 1.f / m_actualSize.x;
+        matrix[5] = 1.f / m_actualSize.y;
+    }
+
+    // If pixels are flipped we must invert the Y axis
+    if (m_pixelsFlipped)
+    {
+        matrix[5] = -matrix[5];
+        matrix[13] = static_cast<float>(m_size.y) / m_actualSize.y;
     }
 }
 
@@ -828,6 +1030,7 @@ void Texture::swap(Texture& right)
 {
     std::swap(m_size,          right.m_size);
     std::swap(m_actualSize,    right.m_actualSize);
+    std::swap(m_format,        right.m_format);
     std::swap(m_texture,       right.m_texture);
     std::swap(m_isSmooth,      right.m_isSmooth);
     std::swap(m_sRgb,          right.m_sRgb);
@@ -836,6 +1039,12 @@ void Texture::swap(Texture& right)
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap,     right.m_hasMipmap);
 
+    // The memory category belongs to the owner of the texture, not to its contents
+    priv::moveGraphicsMemory(m_memoryCategory, right.m_memoryCategory, m_memoryUsage, m_memoryPadding);
+    priv::moveGraphicsMemory(right.m_memoryCategory, m_memoryCategory, right.m_memoryUsage, right.m_memoryPadding);
+    std::swap(m_memoryUsage,   right.m_memoryUsage);
+    std::swap(m_memoryPadding, right.m_memoryPadding);
+
     m_cacheId = getUniqueId();
     right.m_cacheId = getUniqueId();
 }
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
 
 
 namespace sf
@@ -35,14 +36,19 @@ namespace priv
 ////////////////////////////////////////////////////////////
 TextureSaver::TextureSaver()
 {
-    glCheck(glGetIntegerv(GL_TEXTURE_BINDING_2D, &m_textureBinding));
+    // Always query OpenGL: the binding to restore may have been set
+    // by the application without going through the state cache
+    GLint textureBinding = 0;
+    glCheck(glGetIntegerv(GL_TEXTURE_BINDING_2D, &textureBinding));
+
+    m_textureBinding = static_cast<unsigned int>(textureBinding);
 }
 
 
 ////////////////////////////////////////////////////////////
 TextureSaver::~TextureSaver()
 {
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_textureBinding));
+    GLStateCache::bindTexture(m_textureBinding);
 }
 
 } // namespace priv
@@ -46,7 +46,9 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
-    /// The current texture binding is saved.
+    /// The current texture binding is saved. It is queried
+    /// from OpenGL rather than from the state cache, so that a
+    /// binding made by the application is restored as well.
     ///
     ////////////////////////////////////////////////////////////
     TextureSaver();
@@ -64,7 +66,7 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    GLint m_textureBinding; ///< Texture binding to restore
+    unsigned int m_textureBinding; ///< Texture binding to restore
 };
 
 } // namespace priv
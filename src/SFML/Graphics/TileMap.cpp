@@ -0,0 +1,380 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Largest size of a chunk, so that its quads can be indexed with 16-bit indices
+    const unsigned int maxChunkSize = 128;
+
+    // Largest tileset for which normalized texture coordinates still address pixel corners accurately
+    const unsigned int maxNormalizedTilesetSize = 4096;
+
+    // Convert a coordinate to the index of the chunk containing it, clamped to the map;
+    // the end of a range doesn't include the chunk which starts exactly there
+    unsigned int toChunk(float value, float chunkSize, unsigned int chunkCount, bool end)
+    {
+        float chunk = end ? std::ceil(value / chunkSize) - 1.f : std::floor(value / chunkSize);
+
+        if (chunk < 0.f)
+            return 0;
+
+        if (chunk >= static_cast<float>(chunkCount))
+            return chunkCount - 1;
+
+        return static_cast<unsigned int>(chunk);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const Uint32 TileMap::Empty = 0xFFFFFFFF;
+
+
+////////////////////////////////////////////////////////////
+TileMap::Chunk::Chunk() :
+tiles    (),
+buffer   (Triangles, VertexBuffer::Static),
+vertices (),
+tileCount(0),
+dirty    (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TileMap::TileMap() :
+m_size       (0, 0),
+m_tileSize   (0, 0),
+m_chunkSize  (0),
+m_chunkCount (0, 0),
+m_tileset    (NULL),
+m_chunks     (),
+m_indices    (IndexBuffer::Index16, IndexBuffer::Static),
+m_quadIndices(),
+m_scratch    (),
+m_tilesetSize(0, 0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileMap::create(const Vector2u& size, const Vector2u& tileSize, unsigned int chunkSize)
+{
+    if (!size.x || !size.y || !tileSize.x || !tileSize.y)
+        return false;
+
+    m_size = size;
+    m_tileSize = tileSize;
+    m_chunkSize = std::max(1u, std::min(chunkSize, maxChunkSize));
+    m_chunkCount.x = (m_size.x + m_chunkSize - 1) / m_chunkSize;
+    m_chunkCount.y = (m_size.y + m_chunkSize - 1) / m_chunkSize;
+
+    // Edge chunks are stored whole, their tiles outside the map stay empty
+    m_chunks.clear();
+    m_chunks.resize(m_chunkCount.x * m_chunkCount.y);
+    for (std::vector<Chunk>::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+        it->tiles.resize(m_chunkSize * m_chunkSize, Empty);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTileset(const Texture& tileset)
+{
+    if (&tileset == m_tileset)
+        return;
+
+    m_tileset = &tileset;
+    invalidateChunks();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* TileMap::getTileset() const
+{
+    return m_tileset;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTile(unsigned int x, unsigned int y, Uint32 tile)
+{
+    if ((x >= m_size.x) || (y >= m_size.y))
+        return;
+
+    Chunk& chunk = m_chunks[(y / m_chunkSize) * m_chunkCount.x + x / m_chunkSize];
+    Uint32& current = chunk.tiles[(y % m_chunkSize) * m_chunkSize + x % m_chunkSize];
+
+    if (current != tile)
+    {
+        current = tile;
+        chunk.dirty = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 TileMap::getTile(unsigned int x, unsigned int y) const
+{
+    if ((x >= m_size.x) || (y >= m_size.y))
+        return Empty;
+
+    const Chunk& chunk = m_chunks[(y / m_chunkSize) * m_chunkCount.x + x / m_chunkSize];
+    return chunk.tiles[(y % m_chunkSize) * m_chunkSize + x % m_chunkSize];
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTiles(const Uint32* tiles)
+{
+    if (!tiles)
+        return;
+
+    for (unsigned int y = 0; y < m_size.y; ++y)
+        for (unsigned int x = 0; x < m_size.x; ++x)
+            setTile(x, y, tiles[y * m_size.x + x]);
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2u& TileMap::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2u& TileMap::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TileMap::getChunkSize() const
+{
+    return m_chunkSize;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getLocalBounds() const
+{
+    return FloatRect(0.f, 0.f, static_cast<float>(m_size.x * m_tileSize.x), static_cast<float>(m_size.y * m_tileSize.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_chunks.empty() || !m_tileset)
+        return;
+
+    // The texture coordinates of all the chunks depend on the size of the tileset
+    if (m_tileset->getSize() != m_tilesetSize)
+    {
+        m_tilesetSize = m_tileset->getSize();
+        invalidateChunks();
+    }
+
+    states.transform *= getTransform();
+    states.texture = m_tileset;
+
+    float chunkWidth = static_cast<float>(m_chunkSize * m_tileSize.x);
+    float chunkHeight = static_cast<float>(m_chunkSize * m_tileSize.y);
+
+    // Without a known view (draw lists), all the chunks may end up visible
+    unsigned int left   = 0;
+    unsigned int top    = 0;
+    unsigned int right  = m_chunkCount.x - 1;
+    unsigned int bottom = m_chunkCount.y - 1;
+
+    if (target.isViewKnown())
+    {
+        // Find the area of the map covered by the view
+        FloatRect visible = target.getView().getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+        visible = states.transform.getInverse().transformRect(visible);
+
+        if (!visible.intersects(getLocalBounds()))
+            return;
+
+        left   = toChunk(visible.left, chunkWidth, m_chunkCount.x, false);
+        top    = toChunk(visible.top, chunkHeight, m_chunkCount.y, false);
+        right  = toChunk(visible.left + visible.width, chunkWidth, m_chunkCount.x, true);
+        bottom = toChunk(visible.top + visible.height, chunkHeight, m_chunkCount.y, true);
+    }
+
+    bool useBuffers = VertexBuffer::isAvailable() && IndexBuffer::isAvailable();
+
+    // Two triangles per quad, the same indices serve all the chunks
+    std::size_t quadCount = m_chunkSize * m_chunkSize;
+    if (m_quadIndices.size() != quadCount * 6)
+    {
+        m_quadIndices.resize(quadCount * 6);
+        for (std::size_t i = 0; i < quadCount; ++i)
+        {
+            Uint16 first = static_cast<Uint16>(i * 4);
+            m_quadIndices[i * 6 + 0] = first;
+            m_quadIndices[i * 6 + 1] = static_cast<Uint16>(first + 1);
+            m_quadIndices[i * 6 + 2] = static_cast<Uint16>(first + 2);
+            m_quadIndices[i * 6 + 3] = first;
+            m_quadIndices[i * 6 + 4] = static_cast<Uint16>(first + 2);
+            m_quadIndices[i * 6 + 5] = static_cast<Uint16>(first + 3);
+        }
+    }
+
+    if (useBuffers && (m_indices.getIndexCount() != m_quadIndices.size()))
+    {
+        if (!m_indices.create(m_quadIndices.size()) || !m_indices.update(&m_quadIndices[0]))
+            useBuffers = false;
+    }
+
+    for (unsigned int y = top; y <= bottom; ++y)
+    {
+        for (unsigned int x = left; x <= right; ++x)
+        {
+            Chunk& chunk = m_chunks[y * m_chunkCount.x + x];
+
+            if (chunk.dirty)
+                updateChunk(chunk, useBuffers);
+
+            if (!chunk.tileCount)
+                continue;
+
+            // The geometry of a chunk is relative to its top-left corner
+            RenderStates chunkStates(states);
+            chunkStates.transform.translate(x * chunkWidth, y * chunkHeight);
+
+            if (useBuffers && chunk.buffer.getVertexCount())
+                target.draw(chunk.buffer, m_indices, 0, chunk.tileCount * 6, chunkStates);
+            else if (!chunk.vertices.empty())
+                target.draw(&chunk.vertices[0], chunk.vertices.size(), &m_quadIndices[0], chunk.tileCount * 6, Triangles, chunkStates);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::updateChunk(Chunk& chunk, bool useBuffers) const
+{
+    m_scratch.clear();
+
+    float tileWidth = static_cast<float>(m_tileSize.x);
+    float tileHeight = static_cast<float>(m_tileSize.y);
+    unsigned int columns = m_tilesetSize.x / m_tileSize.x;
+
+    // Positions are relative to the chunk, tiles outside the map are empty
+    for (unsigned int y = 0; (y < m_chunkSize) && columns; ++y)
+    {
+        for (unsigned int x = 0; x < m_chunkSize; ++x)
+        {
+            Uint32 tile = chunk.tiles[y * m_chunkSize + x];
+            if (tile == Empty)
+                continue;
+
+            float left = x * tileWidth;
+            float top = y * tileHeight;
+            float u = static_cast<float>(tile % columns) * tileWidth;
+            float v = static_cast<float>(tile / columns) * tileHeight;
+
+            m_scratch.push_back(Vertex(Vector2f(left, top), Vector2f(u, v)));
+            m_scratch.push_back(Vertex(Vector2f(left + tileWidth, top), Vector2f(u + tileWidth, v)));
+            m_scratch.push_back(Vertex(Vector2f(left + tileWidth, top + tileHeight), Vector2f(u + tileWidth, v + tileHeight)));
+            m_scratch.push_back(Vertex(Vector2f(left, top + tileHeight), Vector2f(u, v + tileHeight)));
+        }
+    }
+
+    chunk.tileCount = m_scratch.size() / 4;
+    chunk.dirty = false;
+
+    if (useBuffers)
+    {
+        chunk.vertices.clear();
+
+        if (!chunk.tileCount)
+            return;
+
+        // Reallocates the buffer if the format changed, the new data is uploaded below
+        chunk.buffer.setFormat(getChunkFormat());
+
+        if (!chunk.buffer.getNativeHandle())
+            chunk.buffer.create(m_scratch.size());
+
+        // Keep the chunk visible through the client-side path if the buffer can't hold it
+        if (!chunk.buffer.update(&m_scratch[0], m_scratch.size(), 0))
+        {
+            chunk.buffer.create(0);
+            chunk.vertices = m_scratch;
+        }
+    }
+    else
+    {
+        chunk.vertices = m_scratch;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+VertexFormat TileMap::getChunkFormat() const
+{
+    // Tile corners are whole pixels, so 16-bit integers store them exactly while they fit
+    bool shortPositions = (m_chunkSize * m_tileSize.x <= 32767) && (m_chunkSize * m_tileSize.y <= 32767);
+    bool normalizedTexCoords = (m_tilesetSize.x <= maxNormalizedTilesetSize) && (m_tilesetSize.y <= maxNormalizedTilesetSize);
+
+    return VertexFormat(shortPositions ? VertexFormat::PositionShort : VertexFormat::PositionFloat,
+                        normalizedTexCoords ? VertexFormat::TexCoordsNormalized : VertexFormat::TexCoordsFloat,
+                        Vector2f(m_tilesetSize));
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::invalidateChunks() const
+{
+    for (std::vector<Chunk>::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+        it->dirty = true;
+}
+
+} // namespace sf
@@ -0,0 +1,547 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Triangulation.hpp>
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+
+namespace
+{
+    // Kinds of vertices met by the sweep line, depending on the position of their neighbors and on their interior angle
+    enum VertexKind
+    {
+        StartVertex,
+        EndVertex,
+        SplitVertex,
+        MergeVertex,
+        RegularVertex
+    };
+
+    // Index standing for the current sweep point when searching the status for an edge
+    const std::size_t probe = static_cast<std::size_t>(-1);
+
+    // Compute the cross product of two vectors
+    float crossProduct(const sf::Vector2f& p1, const sf::Vector2f& p2)
+    {
+        return p1.x * p2.y - p1.y * p2.x;
+    }
+
+    // Order in which the sweep line meets the vertices: by decreasing y, then by increasing x
+    struct SweepOrder
+    {
+        explicit SweepOrder(const std::vector<sf::Vector2f>& polygonPoints) :
+        points(&polygonPoints)
+        {
+        }
+
+        bool operator ()(std::size_t a, std::size_t b) const
+        {
+            const sf::Vector2f& first = (*points)[a];
+            const sf::Vector2f& second = (*points)[b];
+
+            return (first.y > second.y) || ((first.y == second.y) && (first.x < second.x));
+        }
+
+        const std::vector<sf::Vector2f>* points;
+    };
+
+    // Edge leaving a vertex of the subdivided polygon
+    struct HalfEdge
+    {
+        HalfEdge(float edgeAngle, std::size_t edgeTarget) :
+        angle  (edgeAngle),
+        target (edgeTarget),
+        visited(false)
+        {
+        }
+
+        bool operator <(const HalfEdge& other) const
+        {
+            return angle < other.angle;
+        }
+
+        float       angle;
+        std::size_t target;
+        bool        visited;
+    };
+
+    // Monotone decomposition of a polygon followed by the triangulation of each piece,
+    // as described in "Computational Geometry: Algorithms and Applications", chapter 3
+    class Triangulator
+    {
+    public:
+
+        Triangulator(const std::vector<sf::Vector2f>& points, const std::vector<std::size_t>& contours) :
+        m_points   (points),
+        m_next     (points.size()),
+        m_previous (points.size()),
+        m_sweep    (),
+        m_status   (EdgeOrder(this)),
+        m_positions(points.size()),
+        m_inStatus (points.size(), false),
+        m_helpers  (points.size())
+        {
+            std::size_t first = 0;
+
+            for (std::size_t i = 0; i < contours.size(); ++i)
+            {
+                std::size_t end = std::min(first + contours[i], points.size());
+
+                // Ignore repeated points, they would make edges of null length
+                std::vector<std::size_t> contour;
+                for (std::size_t j = first; j < end; ++j)
+                {
+                    if (contour.empty() || (points[j] != points[contour.back()]))
+                        contour.push_back(j);
+                }
+
+                while ((contour.size() > 1) && (points[contour.back()] == points[contour.front()]))
+                    contour.pop_back();
+
+                first = end;
+
+                float area = 0.f;
+                for (std::size_t j = 0; j < contour.size(); ++j)
+                    area += crossProduct(points[contour[j]], points[contour[(j + 1) % contour.size()]]);
+
+                if ((contour.size() < 3) || (area == 0.f))
+                {
+                    // Holes without an outer boundary make no sense
+                    if (i == 0)
+                        return;
+
+                    continue;
+                }
+
+                // Orient the contours so that the inside of the polygon is on the left of every edge:
+                // counter-clockwise outer boundary, clockwise holes
+                bool reverse = (i == 0) ? (area < 0.f) : (area > 0.f);
+
+                for (std::size_t j = 0; j < contour.size(); ++j)
+                {
+                    std::size_t next = contour[(j + 1) % contour.size()];
+                    std::size_t previous = contour[(j + contour.size() - 1) % contour.size()];
+
+                    m_next[contour[j]] = reverse ? previous : next;
+                    m_previous[contour[j]] = reverse ? next : previous;
+                    m_vertices.push_back(contour[j]);
+                }
+            }
+        }
+
+        void triangulate(std::vector<sf::Uint32>& indices)
+        {
+            indices.clear();
+
+            if (m_vertices.empty())
+                return;
+
+            decompose();
+
+            // Link every vertex to its outgoing boundary edge and to both directions of the diagonals
+            std::vector<std::vector<HalfEdge> > outgoing(m_points.size());
+
+            for (std::size_t i = 0; i < m_vertices.size(); ++i)
+                addHalfEdge(outgoing, m_vertices[i], m_next[m_vertices[i]]);
+
+            for (std::size_t i = 0; i < m_diagonals.size(); ++i)
+            {
+                addHalfEdge(outgoing, m_diagonals[i].first, m_diagonals[i].second);
+                addHalfEdge(outgoing, m_diagonals[i].second, m_diagonals[i].first);
+            }
+
+            for (std::size_t i = 0; i < m_vertices.size(); ++i)
+                std::sort(outgoing[m_vertices[i]].begin(), outgoing[m_vertices[i]].end());
+
+            // Walk around each monotone piece, keeping it on the left: at each vertex, the next edge
+            // of the piece is the first one clockwise from the edge that led to the vertex
+            std::vector<std::size_t> piece;
+
+            for (std::size_t i = 0; i < m_vertices.size(); ++i)
+            {
+                for (std::size_t j = 0; j < outgoing[m_vertices[i]].size(); ++j)
+                {
+                    std::size_t from = m_vertices[i];
+                    std::size_t edge = j;
+
+                    piece.clear();
+
+                    while (!outgoing[from][edge].visited)
+                    {
+                        outgoing[from][edge].visited = true;
+                        piece.push_back(from);
+
+                        std::size_t to = outgoing[from][edge].target;
+                        const std::vector<HalfEdge>& candidates = outgoing[to];
+
+                        HalfEdge back(angle(to, from), from);
+                        std::size_t position = std::lower_bound(candidates.begin(), candidates.end(), back) - candidates.begin();
+
+                        edge = (position > 0 ? position : candidates.size()) - 1;
+                        from = to;
+                    }
+
+                    triangulateMonotone(piece, indices);
+                }
+            }
+        }
+
+    private:
+
+        struct EdgeOrder
+        {
+            explicit EdgeOrder(const Triangulator* owner) :
+            triangulator(owner)
+            {
+            }
+
+            bool operator ()(std::size_t a, std::size_t b) const
+            {
+                return triangulator->isLeftOf(a, b);
+            }
+
+            const Triangulator* triangulator;
+        };
+
+        typedef std::set<std::size_t, EdgeOrder> Status;
+
+        // Split the polygon into y-monotone pieces, by adding diagonals from the split and merge vertices
+        void decompose()
+        {
+            std::vector<std::size_t> order(m_vertices);
+            std::sort(order.begin(), order.end(), SweepOrder(m_points));
+
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                std::size_t vertex = order[i];
+                std::size_t previous = m_previous[vertex];
+
+                m_sweep = m_points[vertex];
+
+                switch (getKind(vertex))
+                {
+                    case StartVertex:
+                    {
+                        insertEdge(vertex);
+                        break;
+                    }
+
+                    case EndVertex:
+                    {
+                        removeEdge(previous, vertex);
+                        break;
+                    }
+
+                    case SplitVertex:
+                    {
+                        std::size_t left = findLeftEdge();
+                        if (left != probe)
+                        {
+                            m_diagonals.push_back(std::make_pair(vertex, m_helpers[left]));
+                            m_helpers[left] = vertex;
+                        }
+
+                        insertEdge(vertex);
+                        break;
+                    }
+
+                    case MergeVertex:
+                    {
+                        removeEdge(previous, vertex);
+                        updateLeftEdge(vertex);
+                        break;
+                    }
+
+                    case RegularVertex:
+                    {
+                        // The inside of the polygon is on the right when the boundary goes down
+                        if (SweepOrder(m_points)(previous, vertex))
+                        {
+                            removeEdge(previous, vertex);
+                            insertEdge(vertex);
+                        }
+                        else
+                        {
+                            updateLeftEdge(vertex);
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+
+        VertexKind getKind(std::size_t vertex) const
+        {
+            std::size_t previous = m_previous[vertex];
+            std::size_t next = m_next[vertex];
+
+            SweepOrder above(m_points);
+            bool convex = crossProduct(m_points[vertex] - m_points[previous], m_points[next] - m_points[vertex]) > 0.f;
+
+            if (above(vertex, previous) && above(vertex, next))
+                return convex ? StartVertex : SplitVertex;
+
+            if (above(previous, vertex) && above(next, vertex))
+                return convex ? EndVertex : MergeVertex;
+
+            return RegularVertex;
+        }
+
+        void insertEdge(std::size_t edge)
+        {
+            m_helpers[edge] = edge;
+            m_positions[edge] = m_status.insert(edge).first;
+            m_inStatus[edge] = true;
+        }
+
+        void removeEdge(std::size_t edge, std::size_t vertex)
+        {
+            if (!m_inStatus[edge])
+                return;
+
+            if (getKind(m_helpers[edge]) == MergeVertex)
+                m_diagonals.push_back(std::make_pair(vertex, m_helpers[edge]));
+
+            m_status.erase(m_positions[edge]);
+            m_inStatus[edge] = false;
+        }
+
+        void updateLeftEdge(std::size_t vertex)
+        {
+            std::size_t left = findLeftEdge();
+            if (left == probe)
+                return;
+
+            if (getKind(m_helpers[left]) == MergeVertex)
+                m_diagonals.push_back(std::make_pair(vertex, m_helpers[left]));
+
+            m_helpers[left] = vertex;
+        }
+
+        std::size_t findLeftEdge() const
+        {
+            Status::const_iterator it = m_status.lower_bound(probe);
+            if (it == m_status.begin())
+                return probe;
+
+            return *--it;
+        }
+
+        // Position of an edge along a horizontal line; horizontal edges
+        // are where the sweep line currently crosses them
+        float getEdgeX(std::size_t edge, float y) const
+        {
+            if (edge == probe)
+                return m_sweep.x;
+
+            const sf::Vector2f& start = m_points[edge];
+            const sf::Vector2f& end = m_points[m_next[edge]];
+
+            if (start.y == end.y)
+                return std::min(std::max(m_sweep.x, std::min(start.x, end.x)), std::max(start.x, end.x));
+
+            return start.x + (y - start.y) * (end.x - start.x) / (end.y - start.y);
+        }
+
+        bool isLeftOf(std::size_t a, std::size_t b) const
+        {
+            float xa = getEdgeX(a, m_sweep.y);
+            float xb = getEdgeX(b, m_sweep.y);
+
+            if ((xa != xb) || (a == probe) || (b == probe))
+                return xa < xb;
+
+            // Edges which meet on the sweep line are ordered below it
+            float y = std::max(std::min(m_points[a].y, m_points[m_next[a]].y), std::min(m_points[b].y, m_points[m_next[b]].y));
+            if (y < m_sweep.y)
+            {
+                xa = getEdgeX(a, y);
+                xb = getEdgeX(b, y);
+
+                if (xa != xb)
+                    return xa < xb;
+            }
+
+            return a < b;
+        }
+
+        float angle(std::size_t from, std::size_t to) const
+        {
+            return std::atan2(m_points[to].y - m_points[from].y, m_points[to].x - m_points[from].x);
+        }
+
+        void addHalfEdge(std::vector<std::vector<HalfEdge> >& outgoing, std::size_t from, std::size_t to) const
+        {
+            outgoing[from].push_back(HalfEdge(angle(from, to), to));
+        }
+
+        // Triangulate a y-monotone piece whose vertices are given counter-clockwise
+        void triangulateMonotone(const std::vector<std::size_t>& piece, std::vector<sf::Uint32>& indices) const
+        {
+            std::size_t count = piece.size();
+            if (count < 3)
+                return;
+
+            SweepOrder above(m_points);
+
+            std::size_t top = 0;
+            std::size_t bottom = 0;
+            for (std::size_t i = 1; i < count; ++i)
+            {
+                if (above(piece[i], piece[top]))
+                    top = i;
+                if (above(piece[bottom], piece[i]))
+                    bottom = i;
+            }
+
+            // Going counter-clockwise from the top, the left chain comes first;
+            // merge both chains into a single list sorted from top to bottom
+            std::vector<std::size_t> sorted(1, top);
+            std::vector<bool> onLeft(count, false);
+            onLeft[top] = true;
+
+            std::size_t left = (top + 1) % count;
+            std::size_t right = (top + count - 1) % count;
+
+            while ((left != bottom) || (right != bottom))
+            {
+                if ((right == bottom) || ((left != bottom) && above(piece[left], piece[right])))
+                {
+                    onLeft[left] = true;
+                    sorted.push_back(left);
+                    left = (left + 1) % count;
+                }
+                else
+                {
+                    sorted.push_back(right);
+                    right = (right + count - 1) % count;
+                }
+            }
+
+            sorted.push_back(bottom);
+
+            // Cut triangles from the top as soon as the diagonals they need are inside the piece
+            std::vector<std::size_t> stack(sorted.begin(), sorted.begin() + 2);
+
+            for (std::size_t i = 2; i + 1 < count; ++i)
+            {
+                std::size_t current = sorted[i];
+
+                if (onLeft[current] != onLeft[stack.back()])
+                {
+                    // Opposite chains: all the vertices on the stack can be linked to the current one
+                    while (stack.size() > 1)
+                    {
+                        std::size_t last = stack.back();
+                        stack.pop_back();
+                        addTriangle(piece, current, last, stack.back(), indices);
+                    }
+
+                    stack.clear();
+                    stack.push_back(sorted[i - 1]);
+                    stack.push_back(current);
+                }
+                else
+                {
+                    // Same chain: link the vertices on the stack while the diagonals don't leave the piece
+                    std::size_t last = stack.back();
+                    stack.pop_back();
+
+                    while (!stack.empty())
+                    {
+                        sf::Vector2f toCurrent = m_points[piece[current]] - m_points[piece[stack.back()]];
+                        sf::Vector2f toLast = m_points[piece[last]] - m_points[piece[stack.back()]];
+                        float turn = crossProduct(toCurrent, toLast);
+
+                        if (onLeft[current] ? (turn >= 0.f) : (turn <= 0.f))
+                            break;
+
+                        addTriangle(piece, current, last, stack.back(), indices);
+                        last = stack.back();
+                        stack.pop_back();
+                    }
+
+                    stack.push_back(last);
+                    stack.push_back(current);
+                }
+            }
+
+            // The bottom vertex closes the remaining triangles
+            while (stack.size() > 1)
+            {
+                std::size_t last = stack.back();
+                stack.pop_back();
+                addTriangle(piece, bottom, last, stack.back(), indices);
+            }
+        }
+
+        // Add a triangle, with its corners in the same order as the outer boundary (positive cross product)
+        void addTriangle(const std::vector<std::size_t>& piece, std::size_t a, std::size_t b, std::size_t c, std::vector<sf::Uint32>& indices) const
+        {
+            const sf::Vector2f& first = m_points[piece[a]];
+            if (crossProduct(m_points[piece[b]] - first, m_points[piece[c]] - first) < 0.f)
+                std::swap(b, c);
+
+            indices.push_back(static_cast<sf::Uint32>(piece[a]));
+            indices.push_back(static_cast<sf::Uint32>(piece[b]));
+            indices.push_back(static_cast<sf::Uint32>(piece[c]));
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        const std::vector<sf::Vector2f>&                   m_points;    ///< Points of all the contours
+        std::vector<std::size_t>                           m_vertices;  ///< Points kept in the triangulation
+        std::vector<std::size_t>                           m_next;      ///< Next point of each point, with the inside on the left
+        std::vector<std::size_t>                           m_previous;  ///< Previous point of each point
+        sf::Vector2f                                       m_sweep;     ///< Vertex currently reached by the sweep line
+        Status                                             m_status;    ///< Edges crossing the sweep line with the inside on their right, from left to right
+        std::vector<Status::iterator>                      m_positions; ///< Position of each edge in the status
+        std::vector<bool>                                  m_inStatus;  ///< Is each edge in the status?
+        std::vector<std::size_t>                           m_helpers;   ///< Lowest vertex above the sweep line which sees each edge
+        std::vector<std::pair<std::size_t, std::size_t> >  m_diagonals; ///< Diagonals splitting the polygon into monotone pieces
+    };
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void triangulatePolygon(const std::vector<Vector2f>& points, const std::vector<std::size_t>& contours, std::vector<Uint32>& indices)
+{
+    Triangulator triangulator(points, contours);
+    triangulator.triangulate(indices);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TRIANGULATION_HPP
+#define SFML_TRIANGULATION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Split a simple polygon with holes into triangles
+///
+/// The first contour is the outer boundary of the polygon,
+/// the others are holes inside it. Contours may be given in
+/// either winding order; they must not intersect each other
+/// nor themselves. Repeated consecutive points are ignored,
+/// as are contours with less than three distinct points.
+///
+/// The polygon is split into y-monotone pieces by a sweep
+/// line, which are then triangulated in linear time: the
+/// whole triangulation runs in O(n log n).
+///
+/// All the triangles have the same winding, whatever the
+/// orientation of the input contours: the cross product
+/// (b - a) x (c - a) of their corners a, b, c is never
+/// negative. With the y axis pointing down, as in SFML
+/// coordinates, they appear clockwise on screen.
+///
+/// \param points   Points of all the contours, one contour after the other
+/// \param contours Number of points of each contour
+/// \param indices  Filled with the indices, in \a points, of the corners of the triangles
+///
+////////////////////////////////////////////////////////////
+void triangulatePolygon(const std::vector<Vector2f>& points, const std::vector<std::size_t>& contours, std::vector<Uint32>& indices);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_TRIANGULATION_HPP
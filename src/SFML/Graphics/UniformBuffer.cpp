@@ -0,0 +1,466 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/UniformBuffer.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GraphicsMemoryTracker.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+
+    // Size of a vec4, to which matrix columns and array elements are padded
+    const std::size_t vec4Size = 4 * sizeof(float);
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+UniformBuffer::UniformBuffer() :
+m_buffer    (0),
+m_data      (),
+m_dirtyBegin(0),
+m_dirtyEnd  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+UniformBuffer::UniformBuffer(const UniformBuffer& copy) :
+m_buffer    (0),
+m_data      (),
+m_dirtyBegin(0),
+m_dirtyEnd  (0)
+{
+    if (copy.m_buffer && !copy.m_data.empty())
+    {
+        if (!create(copy.m_data.size()))
+        {
+            err() << "Could not create uniform buffer for copying" << std::endl;
+            return;
+        }
+
+        setData(&copy.m_data[0], copy.m_data.size());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+UniformBuffer::~UniformBuffer()
+{
+    if (m_buffer)
+    {
+        TransientContextLock contextLock;
+
+        priv::GLStateCache::forgetBuffer(m_buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+
+        priv::updateGraphicsMemory(GraphicsMemory::UniformBuffers, getMemoryUsage(), 0, 0, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::create(std::size_t size)
+{
+#ifdef SFML_OPENGL_ES
+
+    return false;
+
+#else
+
+    if (!isAvailable())
+        return false;
+
+    TransientContextLock contextLock;
+
+    if (!m_buffer)
+        glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+
+    if (!m_buffer)
+    {
+        err() << "Could not create uniform buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    priv::updateGraphicsMemory(GraphicsMemory::UniformBuffers, getMemoryUsage(), 0, size, 0);
+
+    m_data.assign(size, 0);
+    m_dirtyBegin = 0;
+    m_dirtyEnd = 0;
+
+    priv::GLStateCache::bindBuffer(GLEXT_GL_UNIFORM_BUFFER, m_buffer);
+    glCheck(GLEXT_glBufferData(GLEXT_GL_UNIFORM_BUFFER, size, m_data.empty() ? NULL : &m_data[0], GLEXT_GL_DYNAMIC_DRAW));
+    priv::GLStateCache::bindBuffer(GLEXT_GL_UNIFORM_BUFFER, 0);
+
+    return true;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t UniformBuffer::getSize() const
+{
+    return m_data.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, float x)
+{
+    write(offset, &x, sizeof(x), 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, const Glsl::Vec2& vector)
+{
+    float values[2] = {vector.x, vector.y};
+    write(offset, values, sizeof(values), 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, const Glsl::Vec3& vector)
+{
+    float values[3] = {vector.x, vector.y, vector.z};
+    write(offset, values, sizeof(values), 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, const Glsl::Vec4& vector)
+{
+    float values[4] = {vector.x, vector.y, vector.z, vector.w};
+    write(offset, values, sizeof(values), 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, int x)
+{
+    Int32 value = x;
+    write(offset, &value, sizeof(value), 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, const Glsl::Ivec2& vector)
+{
+    Int32 values[2] = {vector.x, vector.y};
+    write(offset, values, sizeof(values), 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, const Glsl::Ivec3& vector)
+{
+    Int32 values[3] = {vector.x, vector.y, vector.z};
+    write(offset, values, sizeof(values), 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, const Glsl::Ivec4& vector)
+{
+    Int32 values[4] = {vector.x, vector.y, vector.z, vector.w};
+    write(offset, values, sizeof(values), 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, bool x)
+{
+    // Booleans take 4 bytes in uniform blocks
+    setUniform(offset, static_cast<int>(x));
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, const Glsl::Bvec2& vector)
+{
+    setUniform(offset, Glsl::Ivec2(vector));
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, const Glsl::Bvec3& vector)
+{
+    setUniform(offset, Glsl::Ivec3(vector));
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, const Glsl::Bvec4& vector)
+{
+    setUniform(offset, Glsl::Ivec4(vector));
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, const Glsl::Mat3& matrix)
+{
+    setUniformArray(offset, &matrix, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniform(std::size_t offset, const Glsl::Mat4& matrix)
+{
+    setUniformArray(offset, &matrix, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniformArray(std::size_t offset, const float* scalarArray, std::size_t length)
+{
+    write(offset, scalarArray, sizeof(float), vec4Size, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniformArray(std::size_t offset, const Glsl::Vec2* vectorArray, std::size_t length)
+{
+    std::vector<float> contiguous(2 * length);
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        contiguous[2 * i]     = vectorArray[i].x;
+        contiguous[2 * i + 1] = vectorArray[i].y;
+    }
+
+    write(offset, contiguous.empty() ? NULL : &contiguous[0], 2 * sizeof(float), vec4Size, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniformArray(std::size_t offset, const Glsl::Vec3* vectorArray, std::size_t length)
+{
+    std::vector<float> contiguous(3 * length);
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        contiguous[3 * i]     = vectorArray[i].x;
+        contiguous[3 * i + 1] = vectorArray[i].y;
+        contiguous[3 * i + 2] = vectorArray[i].z;
+    }
+
+    write(offset, contiguous.empty() ? NULL : &contiguous[0], 3 * sizeof(float), vec4Size, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniformArray(std::size_t offset, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+    std::vector<float> contiguous(4 * length);
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        contiguous[4 * i]     = vectorArray[i].x;
+        contiguous[4 * i + 1] = vectorArray[i].y;
+        contiguous[4 * i + 2] = vectorArray[i].z;
+        contiguous[4 * i + 3] = vectorArray[i].w;
+    }
+
+    write(offset, contiguous.empty() ? NULL : &contiguous[0], 4 * sizeof(float), vec4Size, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniformArray(std::size_t offset, const Glsl::Mat3* matrixArray, std::size_t length)
+{
+    // Each column of a mat3 is padded like a vec4
+    std::vector<float> columns(9 * length);
+    for (std::size_t i = 0; i < length; ++i)
+        std::copy(matrixArray[i].array, matrixArray[i].array + 9, &columns[9 * i]);
+
+    write(offset, columns.empty() ? NULL : &columns[0], 3 * sizeof(float), vec4Size, 3 * length);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setUniformArray(std::size_t offset, const Glsl::Mat4* matrixArray, std::size_t length)
+{
+    std::vector<float> columns(16 * length);
+    for (std::size_t i = 0; i < length; ++i)
+        std::copy(matrixArray[i].array, matrixArray[i].array + 16, &columns[16 * i]);
+
+    write(offset, columns.empty() ? NULL : &columns[0], 16 * sizeof(float), 16 * sizeof(float), length);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setData(const void* data, std::size_t size, std::size_t offset)
+{
+    write(offset, data, size, 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+UniformBuffer& UniformBuffer::operator =(const UniformBuffer& right)
+{
+    UniformBuffer temp(right);
+
+    swap(temp);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::swap(UniformBuffer& right)
+{
+    std::swap(m_buffer,     right.m_buffer);
+    std::swap(m_dirtyBegin, right.m_dirtyBegin);
+    std::swap(m_dirtyEnd,   right.m_dirtyEnd);
+    m_data.swap(right.m_data);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 UniformBuffer::getMemoryUsage() const
+{
+    return m_buffer ? m_data.size() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int UniformBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::bind(const UniformBuffer* uniformBuffer, unsigned int binding)
+{
+    // User code may have changed the bindings behind the state cache
+    bind(uniformBuffer, binding, true);
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::bind(const UniformBuffer* uniformBuffer, unsigned int binding, bool force)
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!isAvailable())
+        return;
+
+    TransientContextLock lock;
+
+    if (uniformBuffer)
+        uniformBuffer->upload();
+
+    priv::GLStateCache::bindBufferBase(GLEXT_GL_UNIFORM_BUFFER, binding, uniformBuffer ? uniformBuffer->m_buffer : 0, force);
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::isAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = Shader::isAvailable() && GLEXT_vertex_buffer_object && GLEXT_uniform_buffer_object;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::write(std::size_t offset, const void* data, std::size_t size, std::size_t stride, std::size_t count)
+{
+    if (!data || !count)
+        return;
+
+    std::size_t end = offset + stride * (count - 1) + size;
+    if (end > m_data.size())
+    {
+        err() << "Failed to set uniform buffer values: range [" << offset << ", " << end
+              << ") exceeds the size of the buffer (" << m_data.size() << " bytes)" << std::endl;
+        return;
+    }
+
+    const Uint8* source = static_cast<const Uint8*>(data);
+    for (std::size_t i = 0; i < count; ++i)
+        std::memcpy(&m_data[offset + i * stride], source + i * size, size);
+
+    // Extend the range of bytes to upload
+    if (m_dirtyBegin == m_dirtyEnd)
+    {
+        m_dirtyBegin = offset;
+        m_dirtyEnd = end;
+    }
+    else
+    {
+        m_dirtyBegin = std::min(m_dirtyBegin, offset);
+        m_dirtyEnd = std::max(m_dirtyEnd, end);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::upload() const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_buffer || (m_dirtyBegin == m_dirtyEnd))
+        return;
+
+    priv::GLStateCache::bindBuffer(GLEXT_GL_UNIFORM_BUFFER, m_buffer);
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_UNIFORM_BUFFER, m_dirtyBegin, m_dirtyEnd - m_dirtyBegin, &m_data[m_dirtyBegin]));
+    priv::GLStateCache::bindBuffer(GLEXT_GL_UNIFORM_BUFFER, 0);
+
+    m_dirtyBegin = 0;
+    m_dirtyEnd = 0;
+
+#endif // SFML_OPENGL_ES
+}
+
+} // namespace sf
@@ -29,10 +29,13 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GraphicsMemoryTracker.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
 #include <cstring>
+#include <vector>
 
 namespace
 {
@@ -57,7 +60,8 @@ VertexBuffer::VertexBuffer() :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (Stream)
+m_usage        (Stream),
+m_format       ()
 {
 }
 
@@ -67,7 +71,8 @@ VertexBuffer::VertexBuffer(PrimitiveType type) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (Stream)
+m_usage        (Stream),
+m_format       ()
 {
 }
 
@@ -77,7 +82,8 @@ VertexBuffer::VertexBuffer(VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (usage)
+m_usage        (usage),
+m_format       ()
 {
 }
 
@@ -87,7 +93,8 @@ VertexBuffer::VertexBuffer(PrimitiveType type, VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (usage)
+m_usage        (usage),
+m_format       ()
 {
 }
 
@@ -97,7 +104,8 @@ VertexBuffer::VertexBuffer(const VertexBuffer& copy) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(copy.m_primitiveType),
-m_usage        (copy.m_usage)
+m_usage        (copy.m_usage),
+m_format       (copy.m_format)
 {
     if (copy.m_buffer && copy.m_size)
     {
@@ -120,7 +128,10 @@ VertexBuffer::~VertexBuffer()
     {
         TransientContextLock contextLock;
 
+        priv::GLStateCache::forgetBuffer(m_buffer);
         glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+
+        priv::updateGraphicsMemory(GraphicsMemory::VertexBuffers, getMemoryUsage(), 0, 0, 0);
     }
 }
 
@@ -131,6 +142,12 @@ bool VertexBuffer::create(std::size_t vertexCount)
     if (!isAvailable())
         return false;
 
+    if (!m_format.isSupported())
+    {
+        err() << "Could not create vertex buffer, its vertex format is not supported" << std::endl;
+        return false;
+    }
+
     TransientContextLock contextLock;
 
     if (!m_buffer)
@@ -142,9 +159,11 @@ bool VertexBuffer::create(std::size_t vertexCount)
         return false;
     }
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
-    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * vertexCount, 0, usageToGlEnum(m_usage)));
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+    priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer);
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, m_format.getStride() * vertexCount, 0, usageToGlEnum(m_usage)));
+    priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, 0);
+
+    priv::updateGraphicsMemory(GraphicsMemory::VertexBuffers, getMemoryUsage(), 0, m_format.getStride() * vertexCount, 0);
 
     m_size = vertexCount;
 
@@ -179,21 +198,40 @@ bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsig
     if (offset && (offset + vertexCount > m_size))
         return false;
 
+    const std::size_t stride = m_format.getStride();
+
+    // Convert the vertices if the buffer doesn't store them as sf::Vertex
+    const void* data = vertices;
+    std::vector<Uint8> packed;
+
+    if (m_format != VertexFormat::Default)
+    {
+        packed.resize(stride * vertexCount);
+
+        if (!packed.empty())
+        {
+            m_format.pack(vertices, vertexCount, &packed[0]);
+            data = &packed[0];
+        }
+    }
+
     TransientContextLock contextLock;
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+    priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer);
 
     // Check if we need to resize or orphan the buffer
     if (vertexCount >= m_size)
     {
-        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * vertexCount, 0, usageToGlEnum(m_usage)));
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, stride * vertexCount, 0, usageToGlEnum(m_usage)));
+
+        priv::updateGraphicsMemory(GraphicsMemory::VertexBuffers, getMemoryUsage(), 0, stride * vertexCount, 0);
 
         m_size = vertexCount;
     }
 
-    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * offset, sizeof(Vertex) * vertexCount, vertices));
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, stride * offset, stride * vertexCount, data));
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+    priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, 0);
 
     return true;
 }
@@ -211,6 +249,11 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
     if (!m_buffer || !vertexBuffer.m_buffer)
         return false;
 
+    if (m_format != vertexBuffer.m_format)
+        return false;
+
+    const std::size_t stride = m_format.getStride();
+
     TransientContextLock contextLock;
 
     // Make sure that extensions are initialized
@@ -221,7 +264,7 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, vertexBuffer.m_buffer));
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, m_buffer));
 
-        glCheck(GLEXT_glCopyBufferSubData(GLEXT_GL_COPY_READ_BUFFER, GLEXT_GL_COPY_WRITE_BUFFER, 0, 0, sizeof(Vertex) * vertexBuffer.m_size));
+        glCheck(GLEXT_glCopyBufferSubData(GLEXT_GL_COPY_READ_BUFFER, GLEXT_GL_COPY_WRITE_BUFFER, 0, 0, stride * vertexBuffer.m_size));
 
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, 0));
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, 0));
@@ -229,28 +272,32 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
         return true;
     }
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
-    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * vertexBuffer.m_size, 0, usageToGlEnum(m_usage)));
+    priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer);
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, stride * vertexBuffer.m_size, 0, usageToGlEnum(m_usage)));
+
+    // The buffer was reallocated to the size of the source
+    priv::updateGraphicsMemory(GraphicsMemory::VertexBuffers, getMemoryUsage(), 0, stride * vertexBuffer.m_size, 0);
+    m_size = vertexBuffer.m_size;
 
     void* destination = 0;
     glCheck(destination = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_WRITE_ONLY));
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer.m_buffer));
+    priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer.m_buffer);
 
     void* source = 0;
     glCheck(source = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_READ_ONLY));
 
-    std::memcpy(destination, source, sizeof(Vertex) * vertexBuffer.m_size);
+    std::memcpy(destination, source, stride * vertexBuffer.m_size);
 
     GLboolean sourceResult = GL_FALSE;
     glCheck(sourceResult = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+    priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer);
 
     GLboolean destinationResult = GL_FALSE;
     glCheck(destinationResult = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+    priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, 0);
 
     if ((sourceResult == GL_FALSE) || (destinationResult == GL_FALSE))
         return false;
@@ -279,6 +326,14 @@ void VertexBuffer::swap(VertexBuffer& right)
     std::swap(m_buffer,        right.m_buffer);
     std::swap(m_primitiveType, right.m_primitiveType);
     std::swap(m_usage,         right.m_usage);
+    std::swap(m_format,        right.m_format);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 VertexBuffer::getMemoryUsage() const
+{
+    return m_buffer ? m_format.getStride() * m_size : 0;
 }
 
 
@@ -297,7 +352,8 @@ void VertexBuffer::bind(const VertexBuffer* vertexBuffer)
 
     TransientContextLock lock;
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer ? vertexBuffer->m_buffer : 0));
+    // User code may have changed the bindings behind the state cache
+    priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer ? vertexBuffer->m_buffer : 0, true);
 }
 
 
@@ -329,6 +385,41 @@ VertexBuffer::Usage VertexBuffer::getUsage() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool VertexBuffer::setFormat(const VertexFormat& format)
+{
+    if (!format.isSupported())
+        return false;
+
+    if (format == m_format)
+        return true;
+
+    // The current storage is accounted for with the previous vertex size:
+    // release it before the format changes, so that create() starts from zero
+    std::size_t size = m_size;
+    if (m_buffer && size)
+    {
+        priv::updateGraphicsMemory(GraphicsMemory::VertexBuffers, getMemoryUsage(), 0, 0, 0);
+        m_size = 0;
+    }
+
+    m_format = format;
+
+    // Reallocate the storage with the new vertex size
+    if (m_buffer && size)
+        return create(size);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const VertexFormat& VertexBuffer::getFormat() const
+{
+    return m_format;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool VertexBuffer::isAvailable()
 {
@@ -360,4 +451,45 @@ void VertexBuffer::draw(RenderTarget& target, RenderStates states) const
         target.draw(*this, 0, m_size, states);
 }
 
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::readVertices(std::size_t firstVertex, std::size_t vertexCount, Vertex* vertices) const
+{
+#ifdef SFML_OPENGL_ES
+
+    return false;
+
+#else
+
+    if (!m_buffer || (firstVertex + vertexCount > m_size))
+        return false;
+
+    if (!vertexCount)
+        return true;
+
+    const std::size_t stride = m_format.getStride();
+
+    TransientContextLock contextLock;
+
+    priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer);
+
+    if (m_format == VertexFormat::Default)
+    {
+        glCheck(GLEXT_glGetBufferSubData(GLEXT_GL_ARRAY_BUFFER, stride * firstVertex, stride * vertexCount, vertices));
+    }
+    else
+    {
+        // Read the compact vertices back, then convert them
+        std::vector<Uint8> data(stride * vertexCount);
+        glCheck(GLEXT_glGetBufferSubData(GLEXT_GL_ARRAY_BUFFER, stride * firstVertex, data.size(), &data[0]));
+        m_format.unpack(&data[0], vertexCount, vertices);
+    }
+
+    priv::GLStateCache::bindBuffer(GLEXT_GL_ARRAY_BUFFER, 0);
+
+    return true;
+
+#endif // SFML_OPENGL_ES
+}
+
 } // namespace sf
@@ -0,0 +1,303 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VertexFormat.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/HalfFloat.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <cmath>
+#include <cstring>
+
+
+namespace
+{
+    sf::Mutex isSupportedMutex;
+
+    // Convert a value to a rounded and clamped 16-bit signed integer
+    sf::Int16 toShort(float value)
+    {
+        if (value >= 32767.f)
+            return 32767;
+
+        if (value <= -32767.f)
+            return -32767;
+
+        return static_cast<sf::Int16>(std::floor(value + 0.5f));
+    }
+
+    // Gives access to a context for the extension checks
+    struct ExtensionCheck : sf::GlResource
+    {
+        // Check whether the driver can read half float vertex attributes
+        static bool isHalfFloatVertexSupported()
+        {
+            sf::Lock lock(isSupportedMutex);
+
+            static bool checked = false;
+            static bool supported = false;
+
+            if (!checked)
+            {
+                checked = true;
+
+                TransientContextLock contextLock;
+
+                // Make sure that extensions are initialized
+                sf::priv::ensureExtensionsInit();
+
+                supported = GLEXT_half_float_vertex;
+            }
+
+            return supported;
+        }
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const VertexFormat VertexFormat::Default;
+
+
+////////////////////////////////////////////////////////////
+VertexFormat::VertexFormat() :
+m_positionType  (PositionFloat),
+m_texCoordsType (TexCoordsFloat),
+m_texCoordsRange(1.f, 1.f)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VertexFormat::VertexFormat(PositionType position, TexCoordsType texCoords, const Vector2f& texCoordsRange) :
+m_positionType  (position),
+m_texCoordsType (texCoords),
+m_texCoordsRange(texCoordsRange)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VertexFormat::PositionType VertexFormat::getPositionType() const
+{
+    return m_positionType;
+}
+
+
+////////////////////////////////////////////////////////////
+VertexFormat::TexCoordsType VertexFormat::getTexCoordsType() const
+{
+    return m_texCoordsType;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& VertexFormat::getTexCoordsRange() const
+{
+    return m_texCoordsRange;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexFormat::getStride() const
+{
+    return getTexCoordsOffset() + (m_texCoordsType == TexCoordsFloat ? 2 * sizeof(float) : 2 * sizeof(Int16));
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexFormat::getColorOffset() const
+{
+    return m_positionType == PositionFloat ? 2 * sizeof(float) : 2 * sizeof(Int16);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexFormat::getTexCoordsOffset() const
+{
+    return getColorOffset() + 4;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexFormat::pack(const Vertex* vertices, std::size_t vertexCount, void* data) const
+{
+    if (!vertices || !data)
+        return;
+
+    const std::size_t stride = getStride();
+    const std::size_t colorOffset = getColorOffset();
+    const std::size_t texCoordsOffset = getTexCoordsOffset();
+
+    const float texCoordsScaleX = (m_texCoordsRange.x != 0.f) ? 32767.f / m_texCoordsRange.x : 0.f;
+    const float texCoordsScaleY = (m_texCoordsRange.y != 0.f) ? 32767.f / m_texCoordsRange.y : 0.f;
+
+    Uint8* destination = static_cast<Uint8*>(data);
+
+    for (std::size_t i = 0; i < vertexCount; ++i, destination += stride)
+    {
+        const Vertex& vertex = vertices[i];
+
+        // Copy through local arrays, the destination is not necessarily aligned
+        switch (m_positionType)
+        {
+            case PositionFloat:
+            {
+                float position[2] = {vertex.position.x, vertex.position.y};
+                std::memcpy(destination, position, sizeof(position));
+                break;
+            }
+
+            case PositionHalf:
+            {
+                Uint16 position[2] = {priv::floatToHalf(vertex.position.x), priv::floatToHalf(vertex.position.y)};
+                std::memcpy(destination, position, sizeof(position));
+                break;
+            }
+
+            case PositionShort:
+            {
+                Int16 position[2] = {toShort(vertex.position.x), toShort(vertex.position.y)};
+                std::memcpy(destination, position, sizeof(position));
+                break;
+            }
+        }
+
+        Uint8 color[4] = {vertex.color.r, vertex.color.g, vertex.color.b, vertex.color.a};
+        std::memcpy(destination + colorOffset, color, sizeof(color));
+
+        if (m_texCoordsType == TexCoordsFloat)
+        {
+            float texCoords[2] = {vertex.texCoords.x, vertex.texCoords.y};
+            std::memcpy(destination + texCoordsOffset, texCoords, sizeof(texCoords));
+        }
+        else
+        {
+            Int16 texCoords[2] = {toShort(vertex.texCoords.x * texCoordsScaleX), toShort(vertex.texCoords.y * texCoordsScaleY)};
+            std::memcpy(destination + texCoordsOffset, texCoords, sizeof(texCoords));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexFormat::unpack(const void* data, std::size_t vertexCount, Vertex* vertices) const
+{
+    if (!data || !vertices)
+        return;
+
+    const std::size_t stride = getStride();
+    const std::size_t colorOffset = getColorOffset();
+    const std::size_t texCoordsOffset = getTexCoordsOffset();
+
+    const float texCoordsScaleX = m_texCoordsRange.x / 32767.f;
+    const float texCoordsScaleY = m_texCoordsRange.y / 32767.f;
+
+    const Uint8* source = static_cast<const Uint8*>(data);
+
+    for (std::size_t i = 0; i < vertexCount; ++i, source += stride)
+    {
+        Vertex& vertex = vertices[i];
+
+        switch (m_positionType)
+        {
+            case PositionFloat:
+            {
+                float position[2];
+                std::memcpy(position, source, sizeof(position));
+                vertex.position = Vector2f(position[0], position[1]);
+                break;
+            }
+
+            case PositionHalf:
+            {
+                Uint16 position[2];
+                std::memcpy(position, source, sizeof(position));
+                vertex.position = Vector2f(priv::halfToFloat(position[0]), priv::halfToFloat(position[1]));
+                break;
+            }
+
+            case PositionShort:
+            {
+                Int16 position[2];
+                std::memcpy(position, source, sizeof(position));
+                vertex.position = Vector2f(position[0], position[1]);
+                break;
+            }
+        }
+
+        const Uint8* color = source + colorOffset;
+        vertex.color = Color(color[0], color[1], color[2], color[3]);
+
+        if (m_texCoordsType == TexCoordsFloat)
+        {
+            float texCoords[2];
+            std::memcpy(texCoords, source + texCoordsOffset, sizeof(texCoords));
+            vertex.texCoords = Vector2f(texCoords[0], texCoords[1]);
+        }
+        else
+        {
+            Int16 texCoords[2];
+            std::memcpy(texCoords, source + texCoordsOffset, sizeof(texCoords));
+            vertex.texCoords = Vector2f(texCoords[0] * texCoordsScaleX, texCoords[1] * texCoordsScaleY);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexFormat::isSupported() const
+{
+    // Floats and shorts are core since OpenGL 1.1
+    if (m_positionType != PositionHalf)
+        return true;
+
+    return ExtensionCheck::isHalfFloatVertexSupported();
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator ==(const VertexFormat& left, const VertexFormat& right)
+{
+    if ((left.getPositionType() != right.getPositionType()) || (left.getTexCoordsType() != right.getTexCoordsType()))
+        return false;
+
+    return (left.getTexCoordsType() == VertexFormat::TexCoordsFloat) || (left.getTexCoordsRange() == right.getTexCoordsRange());
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator !=(const VertexFormat& left, const VertexFormat& right)
+{
+    return !(left == right);
+}
+
+} // namespace sf
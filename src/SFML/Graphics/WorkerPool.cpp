@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/WorkerPool.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+WorkerPool::WorkerPool() :
+m_threads (),
+m_start   (new Semaphore),
+m_done    (new Semaphore),
+m_task    (NULL),
+m_userData(NULL),
+m_stopping(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+WorkerPool::~WorkerPool()
+{
+    setThreadCount(0);
+
+    delete m_done;
+    delete m_start;
+}
+
+
+////////////////////////////////////////////////////////////
+void WorkerPool::setThreadCount(unsigned int count)
+{
+    if (count == m_threads.size())
+        return;
+
+    // Wake up all the threads and let them exit
+    if (!m_threads.empty())
+    {
+        m_stopping = true;
+        m_start->post(static_cast<unsigned int>(m_threads.size()));
+
+        for (std::size_t i = 0; i < m_threads.size(); ++i)
+        {
+            m_threads[i]->wait();
+            delete m_threads[i];
+        }
+
+        m_threads.clear();
+        m_stopping = false;
+    }
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        m_threads.push_back(new Thread(&WorkerPool::work, this));
+        m_threads.back()->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int WorkerPool::getThreadCount() const
+{
+    return static_cast<unsigned int>(m_threads.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void WorkerPool::run(Task task, void* userData, unsigned int count)
+{
+    count = std::min(count, getThreadCount());
+
+    m_task = task;
+    m_userData = userData;
+
+    // Any sleeping thread may take a signal, exactly count of them run the task
+    m_start->post(count);
+
+    task(userData);
+
+    for (unsigned int i = 0; i < count; ++i)
+        m_done->wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void WorkerPool::work()
+{
+    for (;;)
+    {
+        m_start->wait();
+
+        if (m_stopping)
+            return;
+
+        m_task(m_userData);
+
+        m_done->post(1);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_WORKERPOOL_HPP
+#define SFML_WORKERPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Semaphore;
+class Thread;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Set of persistent threads running a task on demand
+///
+/// The threads are created once and sleep between two tasks,
+/// so that running a task doesn't create any thread nor
+/// allocate any memory.
+///
+////////////////////////////////////////////////////////////
+class WorkerPool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Type of the tasks run by the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*Task)(void*);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a pool without any thread.
+    ///
+    ////////////////////////////////////////////////////////////
+    WorkerPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the threads to finish and destroys them.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~WorkerPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads of the pool
+    ///
+    /// The existing threads are stopped and the new ones are
+    /// started. Must not be called while a task is running.
+    ///
+    /// \param count Number of threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads of the pool
+    ///
+    /// \return Number of threads
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run a task on some threads of the pool and on the calling thread
+    ///
+    /// \a task is called once on the calling thread and once
+    /// on each of \a count threads of the pool; the function
+    /// returns when all the calls have returned. \a count is
+    /// clamped to the number of threads.
+    ///
+    /// \param task     Function to run
+    /// \param userData Argument to pass to the task
+    /// \param count    Number of threads of the pool to use
+    ///
+    ////////////////////////////////////////////////////////////
+    void run(Task task, void* userData, unsigned int count);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the threads of the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    void work();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Thread*> m_threads;  ///< Threads of the pool
+    Semaphore*           m_start;    ///< Signaled once per thread that must run the task
+    Semaphore*           m_done;     ///< Signaled by each thread once it has run the task
+    Task                 m_task;     ///< Task in progress
+    void*                m_userData; ///< Argument of the task in progress
+    bool                 m_stopping; ///< Are the threads asked to exit?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_WORKERPOOL_HPP
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SEMAPHOREIMPL_HPP
+#define SFML_SEMAPHOREIMPL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <pthread.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Unix implementation of semaphores
+////////////////////////////////////////////////////////////
+class SemaphoreImpl : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SemaphoreImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SemaphoreImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Increase the counter of the semaphore
+    ///
+    /// \param count Value to add to the counter, must be positive
+    ///
+    ////////////////////////////////////////////////////////////
+    void post(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the counter is positive and decrease it
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int    m_count;     ///< Value of the counter
+    pthread_mutex_t m_mutex;     ///< pthread handle of the mutex protecting the counter
+    pthread_cond_t  m_condition; ///< pthread handle of the condition signaled when the counter increases
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SEMAPHOREIMPL_HPP
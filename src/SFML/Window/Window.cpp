@@ -375,6 +375,8 @@ void Window::display()
     if (setActive())
         m_context->display();
 
+    onDisplay();
+
     // Limit the framerate if needed
     if (m_frameTimeLimit != Time::Zero)
     {
@@ -405,6 +407,13 @@ void Window::onResize()
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::onDisplay()
+{
+    // Nothing by default
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Window::filterEvent(const Event& event)
 {